@@ -0,0 +1,132 @@
+#include <furi.h>
+#include <furi_hal_usb_hid.h>
+
+#include "../test.h" // IWYU pragma: keep
+
+// Report packer is a part of Bad USB application, it is built into the test as is
+#include <applications/main/bad_usb/helpers/ducky_turbo.c>
+
+#define BAD_USB_TEST_REPORTS_MAX 16
+
+typedef struct {
+    uint16_t keys[HID_KB_MAX_KEYS];
+    size_t count;
+} BadUsbTestReport;
+
+typedef struct {
+    BadUsbTestReport reports[BAD_USB_TEST_REPORTS_MAX];
+    size_t reports_count;
+    bool send_result;
+} BadUsbTestHid;
+
+static BadUsbTestHid bad_usb_test_hid;
+
+static bool bad_usb_test_send(void* context, const uint16_t* keys, size_t count) {
+    BadUsbTestHid* hid = context;
+    furi_check(hid->reports_count < BAD_USB_TEST_REPORTS_MAX);
+    furi_check(count <= HID_KB_MAX_KEYS);
+
+    BadUsbTestReport* report = &hid->reports[hid->reports_count++];
+    memcpy(report->keys, keys, count * sizeof(uint16_t));
+    report->count = count;
+
+    return hid->send_result;
+}
+
+static bool bad_usb_test_type(const char* text) {
+    memset(&bad_usb_test_hid, 0, sizeof(bad_usb_test_hid));
+    bad_usb_test_hid.send_result = true;
+
+    DuckyTurbo turbo;
+    ducky_turbo_start(&turbo, bad_usb_test_send, &bad_usb_test_hid);
+    for(size_t i = 0; text[i] != '\0'; i++) {
+        ducky_turbo_push(&turbo, hid_asciimap[(uint8_t)text[i]]);
+    }
+    return ducky_turbo_finish(&turbo);
+}
+
+static void bad_usb_test_check_report(size_t index, const char* keys) {
+    mu_assert(index < bad_usb_test_hid.reports_count, "Missing report");
+
+    const BadUsbTestReport* report = &bad_usb_test_hid.reports[index];
+    mu_assert_int_eq(strlen(keys), report->count);
+    for(size_t i = 0; i < report->count; i++) {
+        mu_assert_int_eq(hid_asciimap[(uint8_t)keys[i]], report->keys[i]);
+    }
+}
+
+MU_TEST(bad_usb_turbo_distinct_keys) {
+    mu_check(bad_usb_test_type("abc"));
+
+    mu_assert_int_eq(2, bad_usb_test_hid.reports_count);
+    bad_usb_test_check_report(0, "abc");
+    bad_usb_test_check_report(1, "");
+}
+
+MU_TEST(bad_usb_turbo_full_report) {
+    mu_check(bad_usb_test_type("abcdefgh"));
+
+    // New keys do not repeat previous ones, no release in between
+    mu_assert_int_eq(3, bad_usb_test_hid.reports_count);
+    bad_usb_test_check_report(0, "abcdef");
+    bad_usb_test_check_report(1, "gh");
+    bad_usb_test_check_report(2, "");
+}
+
+MU_TEST(bad_usb_turbo_repeated_key) {
+    mu_check(bad_usb_test_type("abba"));
+
+    // Second "b" is still down in the previous report, it has to be released first
+    mu_assert_int_eq(4, bad_usb_test_hid.reports_count);
+    bad_usb_test_check_report(0, "ab");
+    bad_usb_test_check_report(1, "");
+    bad_usb_test_check_report(2, "ba");
+    bad_usb_test_check_report(3, "");
+}
+
+MU_TEST(bad_usb_turbo_modifier_change) {
+    mu_check(bad_usb_test_type("abCD"));
+
+    mu_assert_int_eq(4, bad_usb_test_hid.reports_count);
+    bad_usb_test_check_report(0, "ab");
+    bad_usb_test_check_report(1, "");
+    bad_usb_test_check_report(2, "CD");
+    bad_usb_test_check_report(3, "");
+}
+
+MU_TEST(bad_usb_turbo_skip_unmapped) {
+    mu_check(bad_usb_test_type("a\x01" "b"));
+
+    mu_assert_int_eq(2, bad_usb_test_hid.reports_count);
+    bad_usb_test_check_report(0, "ab");
+    bad_usb_test_check_report(1, "");
+}
+
+MU_TEST(bad_usb_turbo_send_error) {
+    memset(&bad_usb_test_hid, 0, sizeof(bad_usb_test_hid));
+    bad_usb_test_hid.send_result = false;
+
+    DuckyTurbo turbo;
+    ducky_turbo_start(&turbo, bad_usb_test_send, &bad_usb_test_hid);
+    ducky_turbo_push(&turbo, hid_asciimap['a']);
+    mu_check(!ducky_turbo_finish(&turbo));
+
+    // Keys are released even if the report was not delivered
+    mu_assert_int_eq(2, bad_usb_test_hid.reports_count);
+}
+
+MU_TEST_SUITE(bad_usb_turbo) {
+    MU_RUN_TEST(bad_usb_turbo_distinct_keys);
+    MU_RUN_TEST(bad_usb_turbo_full_report);
+    MU_RUN_TEST(bad_usb_turbo_repeated_key);
+    MU_RUN_TEST(bad_usb_turbo_modifier_change);
+    MU_RUN_TEST(bad_usb_turbo_skip_unmapped);
+    MU_RUN_TEST(bad_usb_turbo_send_error);
+}
+
+int run_minunit_test_bad_usb(void) {
+    MU_RUN_SUITE(bad_usb_turbo);
+    return MU_EXIT_CODE;
+}
+
+TEST_API_DEFINE(run_minunit_test_bad_usb)
@@ -13,6 +13,8 @@
 
 #include <stdint.h>
 
+#define TAG "CompressTest"
+
 #define COMPRESS_UNIT_TESTS_PATH(path) EXT_PATH("unit_tests/compress/" path)
 
 static void compress_test_reference_comp_decomp() {
@@ -338,11 +340,246 @@ static void compress_test_heatshrink_tar() {
     furi_record_close(RECORD_STORAGE);
 }
 
+#define TAR_EXTRACT_PATH      COMPRESS_UNIT_TESTS_PATH("extract_test.tar")
+#define TAR_EXTRACT_DIR       COMPRESS_UNIT_TESTS_PATH("extract_out")
+#define TAR_EXTRACT_FILE      TAR_EXTRACT_DIR "/big.bin"
+#define TAR_EXTRACT_DATA_SIZE (20000)
+
+typedef struct {
+    int32_t processed;
+    int32_t total;
+    size_t calls;
+    bool is_monotonic;
+} TarExtractProgress;
+
+static void tar_extract_progress_cb(int32_t processed, int32_t total, void* context) {
+    TarExtractProgress* progress = context;
+    progress->is_monotonic &= processed >= progress->processed;
+    progress->processed = processed;
+    progress->total = total;
+    progress->calls++;
+}
+
+/* File spans several extraction blocks and ends with a partial one */
+static void compress_test_tar_extract_blocks() {
+    Storage* api = furi_record_open(RECORD_STORAGE);
+    uint8_t* data = malloc(TAR_EXTRACT_DATA_SIZE);
+    uint8_t* readback = malloc(TAR_EXTRACT_DATA_SIZE);
+    furi_hal_random_fill_buf(data, TAR_EXTRACT_DATA_SIZE);
+
+    TarArchive* archive = tar_archive_alloc(api);
+    mu_assert(
+        tar_archive_open(archive, TAR_EXTRACT_PATH, TarOpenModeWrite), "Failed to create tar");
+    mu_assert(
+        tar_archive_store_data(archive, "big.bin", data, TAR_EXTRACT_DATA_SIZE),
+        "Failed to store data");
+    mu_assert(tar_archive_store_data(archive, "empty.bin", data, 0), "Failed to store empty file");
+    mu_assert(tar_archive_finalize(archive), "Failed to finalize tar");
+    tar_archive_free(archive);
+
+    storage_simply_remove_recursive(api, TAR_EXTRACT_DIR);
+    mu_assert(storage_simply_mkdir(api, TAR_EXTRACT_DIR), "Failed to create extract dir");
+
+    TarExtractProgress progress = {.is_monotonic = true};
+    archive = tar_archive_alloc(api);
+    mu_assert(tar_archive_open(archive, TAR_EXTRACT_PATH, TarOpenModeRead), "Failed to open tar");
+    tar_archive_set_progress_callback(archive, tar_extract_progress_cb, &progress);
+    mu_assert(tar_archive_unpack_to(archive, TAR_EXTRACT_DIR, NULL), "Failed to unpack tar");
+    tar_archive_free(archive);
+
+    mu_assert(progress.calls > 2, "Progress is not reported per block");
+    mu_assert(progress.is_monotonic, "Progress is not monotonic");
+    mu_assert(progress.processed <= progress.total, "Progress is out of range");
+
+    File* file = storage_file_alloc(api);
+    mu_assert(
+        storage_file_open(file, TAR_EXTRACT_FILE, FSAM_READ, FSOM_OPEN_EXISTING),
+        "Failed to open extracted file");
+    mu_assert_int_eq(TAR_EXTRACT_DATA_SIZE, storage_file_size(file));
+    mu_assert_int_eq(
+        TAR_EXTRACT_DATA_SIZE, storage_file_read(file, readback, TAR_EXTRACT_DATA_SIZE));
+    mu_assert(memcmp(readback, data, TAR_EXTRACT_DATA_SIZE) == 0, "Extracted data mismatch");
+    storage_file_free(file);
+
+    FileInfo fileinfo;
+    mu_assert(
+        storage_common_stat(api, TAR_EXTRACT_DIR "/empty.bin", &fileinfo) == FSE_OK,
+        "Empty file is not extracted");
+    mu_assert_int_eq(0, fileinfo.size);
+
+    storage_simply_remove_recursive(api, TAR_EXTRACT_DIR);
+    storage_simply_remove(api, TAR_EXTRACT_PATH);
+
+    free(readback);
+    free(data);
+    furi_record_close(RECORD_STORAGE);
+}
+
+#define HS_CHECKPOINT_BLOCK_SIZE  (1024)
+#define HS_CHECKPOINT_BLOCK_COUNT (4)
+#define HS_CHECKPOINT_DATA_SIZE   (HS_CHECKPOINT_BLOCK_SIZE * HS_CHECKPOINT_BLOCK_COUNT)
+
+typedef struct {
+    const uint8_t* data;
+    size_t size;
+    size_t position;
+} HsCheckpointStream;
+
+static int32_t hs_checkpoint_stream_read(void* context, uint8_t* buffer, size_t size) {
+    HsCheckpointStream* stream = context;
+    size = MIN(size, stream->size - stream->position);
+    memcpy(buffer, &stream->data[stream->position], size);
+    stream->position += size;
+    return size;
+}
+
+static bool hs_checkpoint_stream_seek(void* context, size_t offset) {
+    HsCheckpointStream* stream = context;
+    if(offset > stream->size) return false;
+    stream->position = offset;
+    return true;
+}
+
+static void compress_test_heatshrink_checkpoints() {
+    CompressConfigHeatshrink config = {
+        .window_sz2 = 8,
+        .lookahead_sz2 = 4,
+        .input_buffer_sz = 128,
+    };
+    Compress* compress = compress_alloc(CompressTypeHeatshrink, &config);
+
+    uint8_t* data = malloc(HS_CHECKPOINT_DATA_SIZE);
+    for(size_t i = 0; i < HS_CHECKPOINT_DATA_SIZE; i++) {
+        data[i] = "Flipper"[i % 7] + i / 256;
+    }
+
+    /* Stream of separately compressed blocks, without per-block headers */
+    const size_t block_buffer_size = HS_CHECKPOINT_BLOCK_SIZE * 2;
+    uint8_t* block = malloc(block_buffer_size);
+    uint8_t* compressed = malloc(block_buffer_size * HS_CHECKPOINT_BLOCK_COUNT);
+    CompressStreamCheckpoint checkpoints[HS_CHECKPOINT_BLOCK_COUNT];
+    size_t compressed_size = 0;
+    for(size_t i = 0; i < HS_CHECKPOINT_BLOCK_COUNT; i++) {
+        size_t block_size = 0;
+        mu_assert(
+            compress_encode(
+                compress,
+                &data[i * HS_CHECKPOINT_BLOCK_SIZE],
+                HS_CHECKPOINT_BLOCK_SIZE,
+                block,
+                block_buffer_size,
+                &block_size),
+            "Compression failed");
+        mu_assert(block[0] == 0x01, "Block is not compressed");
+
+        checkpoints[i].compressed_offset = compressed_size;
+        checkpoints[i].uncompressed_offset = i * HS_CHECKPOINT_BLOCK_SIZE;
+        memcpy(&compressed[compressed_size], &block[4], block_size - 4);
+        compressed_size += block_size - 4;
+    }
+
+    HsCheckpointStream stream = {.data = compressed, .size = compressed_size};
+    CompressStreamDecoder* decoder = compress_stream_decoder_alloc(
+        CompressTypeHeatshrink, &config, hs_checkpoint_stream_read, &stream);
+    compress_stream_decoder_set_checkpoints(
+        decoder, checkpoints, HS_CHECKPOINT_BLOCK_COUNT, hs_checkpoint_stream_seek, &stream);
+
+    uint8_t* decoded = malloc(HS_CHECKPOINT_DATA_SIZE);
+    mu_assert(
+        compress_stream_decoder_read(decoder, decoded, HS_CHECKPOINT_DATA_SIZE),
+        "Sequential read failed");
+    mu_assert(memcmp(decoded, data, HS_CHECKPOINT_DATA_SIZE) == 0, "Sequential data mismatch");
+
+    /* Backward, across blocks and within a block */
+    static const size_t positions[] = {3000, 100, 2047, 2048, 2100, 0, 4000, 1500};
+    for(size_t i = 0; i < COUNT_OF(positions); i++) {
+        const size_t size = MIN(700U, HS_CHECKPOINT_DATA_SIZE - positions[i]);
+        mu_assert(compress_stream_decoder_seek(decoder, positions[i]), "Seek failed");
+        mu_assert_int_eq(positions[i], compress_stream_decoder_tell(decoder));
+        mu_assert(compress_stream_decoder_read(decoder, decoded, size), "Read failed");
+        mu_assert(memcmp(decoded, &data[positions[i]], size) == 0, "Data mismatch after seek");
+    }
+
+    compress_stream_decoder_free(decoder);
+    free(decoded);
+    free(compressed);
+    free(block);
+    free(data);
+    compress_free(compress);
+}
+
+#define HS_ENCODER_DATA_SIZE (4096)
+
+static void compress_test_encoder_memory() {
+    static const size_t budgets[] = {0, 4096, 256};
+
+    uint8_t* data = malloc(HS_ENCODER_DATA_SIZE);
+    uint8_t* encoded = malloc(HS_ENCODER_DATA_SIZE + 1);
+    uint8_t* decoded = malloc(HS_ENCODER_DATA_SIZE);
+    for(size_t i = 0; i < HS_ENCODER_DATA_SIZE; i++) {
+        /* Repeating words with random gaps */
+        data[i] = (furi_hal_random_get() % 4) ? "furippa flipper "[i % 16] : i;
+    }
+
+    CompressConfigHeatshrink config = {
+        .window_sz2 = 10,
+        .lookahead_sz2 = 5,
+        .input_buffer_sz = 128,
+    };
+    Compress* compress = compress_alloc(CompressTypeHeatshrink, &config);
+
+    for(size_t i = 0; i < COUNT_OF(budgets); i++) {
+        compress_set_encoder_memory(compress, budgets[i]);
+
+        size_t encoded_size = 0, decoded_size = 0;
+        const uint32_t start = DWT->CYCCNT;
+        mu_assert(
+            compress_encode(
+                compress,
+                data,
+                HS_ENCODER_DATA_SIZE,
+                encoded,
+                HS_ENCODER_DATA_SIZE + 1,
+                &encoded_size),
+            "Compression failed");
+        const uint32_t cycles = DWT->CYCCNT - start;
+        mu_assert(encoded[0] == 0x01, "Data is not compressed");
+
+        mu_assert(
+            compress_decode(
+                compress,
+                encoded,
+                encoded_size,
+                decoded,
+                HS_ENCODER_DATA_SIZE,
+                &decoded_size),
+            "Decompression failed");
+        mu_assert_int_eq(HS_ENCODER_DATA_SIZE, decoded_size);
+        mu_assert(memcmp(decoded, data, HS_ENCODER_DATA_SIZE) == 0, "Data mismatch");
+
+        FURI_LOG_I(
+            TAG,
+            "Memory %zu: %zu bytes, %lu cycles per byte",
+            budgets[i],
+            encoded_size,
+            cycles / HS_ENCODER_DATA_SIZE);
+    }
+
+    compress_free(compress);
+
+    free(decoded);
+    free(encoded);
+    free(data);
+}
+
 MU_TEST_SUITE(test_compress) {
     MU_RUN_TEST(compress_test_random_comp_decomp);
     MU_RUN_TEST(compress_test_reference_comp_decomp);
     MU_RUN_TEST(compress_test_heatshrink_stream);
     MU_RUN_TEST(compress_test_heatshrink_tar);
+    MU_RUN_TEST(compress_test_tar_extract_blocks);
+    MU_RUN_TEST(compress_test_heatshrink_checkpoints);
+    MU_RUN_TEST(compress_test_encoder_memory);
 }
 
 int run_minunit_test_compress(void) {
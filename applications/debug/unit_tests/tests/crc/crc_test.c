@@ -0,0 +1,217 @@
+#include <furi.h>
+#include <furi_hal.h>
+
+#include <toolbox/crc16_calc.h>
+#include <toolbox/crc32_calc.h>
+#include <nfc/helpers/iso14443_crc.h>
+#include <nfc/helpers/iso13239_crc.h>
+#include <nfc/helpers/felica_crc.h>
+
+#include "../test.h" // IWYU pragma: keep
+
+#define TAG "CrcTest"
+
+#define CRC_TEST_DATA_SIZE       (512)
+#define CRC_TEST_FRAME_SIZE      (18)
+#define CRC_TEST_BENCH_BUFF_SIZE (4096)
+#define CRC_TEST_BENCH_FRAMES    (1000)
+
+// Bit-serial reference implementations, as they were before lookup tables
+
+static uint16_t crc_test_ref_ccitt(uint16_t crc, const uint8_t* data, size_t size) {
+    for(size_t i = 0; i < size; i++) {
+        crc ^= ((uint16_t)data[i] << 8);
+        for(size_t j = 0; j < 8; j++) {
+            crc = (crc & 0x8000) ? ((crc << 1) ^ 0x1021) : (crc << 1);
+        }
+    }
+    return crc;
+}
+
+static uint16_t crc_test_ref_ccitt_reflected(uint16_t crc, const uint8_t* data, size_t size) {
+    for(size_t i = 0; i < size; i++) {
+        crc ^= data[i];
+        for(size_t j = 0; j < 8; j++) {
+            crc = (crc & 1U) ? ((crc >> 1) ^ 0x8408) : (crc >> 1);
+        }
+    }
+    return crc;
+}
+
+static uint32_t crc_test_ref_crc32(uint32_t crc, const uint8_t* data, size_t size) {
+    crc = ~crc;
+    for(size_t i = 0; i < size; i++) {
+        crc ^= data[i];
+        for(size_t j = 0; j < 8; j++) {
+            crc = (crc & 1U) ? ((crc >> 1) ^ 0xEDB88320) : (crc >> 1);
+        }
+    }
+    return ~crc;
+}
+
+MU_TEST(crc_test_known_values) {
+    const char* check = "123456789";
+    const size_t check_size = strlen(check);
+
+    // Catalogued check values of CRC-16/XMODEM, CRC-16/IBM-SDLC, CRC-16/ISO-IEC-14443-3-A
+    // and CRC-32/ISO-HDLC
+    mu_assert_int_eq(0x31C3, crc16_calc_ccitt(0x0000, check, check_size));
+    mu_assert_int_eq(0x906E, (uint16_t)~crc16_calc_ccitt_reflected(0xFFFF, check, check_size));
+    mu_assert_int_eq(0xBF05, crc16_calc_ccitt_reflected(0x6363, check, check_size));
+    mu_assert_int_eq(0xCBF43926, crc32_calc_buffer(0, check, check_size));
+}
+
+MU_TEST(crc_test_single_bytes) {
+    const uint16_t inits16[] = {0x0000, 0xFFFF, 0x6363, 0xE012};
+    const uint32_t inits32[] = {0x00000000, 0xFFFFFFFF, 0x12345678};
+
+    for(size_t i = 0; i < 256; i++) {
+        uint8_t byte = i;
+        for(size_t j = 0; j < COUNT_OF(inits16); j++) {
+            mu_assert_int_eq(
+                crc_test_ref_ccitt(inits16[j], &byte, 1), crc16_calc_ccitt(inits16[j], &byte, 1));
+            mu_assert_int_eq(
+                crc_test_ref_ccitt_reflected(inits16[j], &byte, 1),
+                crc16_calc_ccitt_reflected(inits16[j], &byte, 1));
+        }
+        for(size_t j = 0; j < COUNT_OF(inits32); j++) {
+            mu_assert_int_eq(
+                crc_test_ref_crc32(inits32[j], &byte, 1), crc32_calc_buffer(inits32[j], &byte, 1));
+        }
+    }
+}
+
+MU_TEST(crc_test_all_sizes) {
+    uint8_t* data = malloc(CRC_TEST_DATA_SIZE);
+    furi_hal_random_fill_buf(data, CRC_TEST_DATA_SIZE);
+
+    // Every size and alignment of the word-wise CRC-32 loop
+    for(size_t offset = 0; offset < 4; offset++) {
+        for(size_t size = 0; size <= CRC_TEST_DATA_SIZE - offset; size++) {
+            const uint8_t* chunk = data + offset;
+            mu_assert_int_eq(
+                crc_test_ref_crc32(0, chunk, size), crc32_calc_buffer(0, chunk, size));
+            mu_assert_int_eq(
+                crc_test_ref_ccitt(0, chunk, size), crc16_calc_ccitt(0, chunk, size));
+            mu_assert_int_eq(
+                crc_test_ref_ccitt_reflected(0xFFFF, chunk, size),
+                crc16_calc_ccitt_reflected(0xFFFF, chunk, size));
+        }
+    }
+
+    // Calculation split in several calls
+    for(size_t split = 0; split <= CRC_TEST_DATA_SIZE; split += 7) {
+        uint32_t crc = crc32_calc_buffer(0, data, split);
+        crc = crc32_calc_buffer(crc, data + split, CRC_TEST_DATA_SIZE - split);
+        mu_assert_int_eq(crc_test_ref_crc32(0, data, CRC_TEST_DATA_SIZE), crc);
+    }
+
+    free(data);
+}
+
+MU_TEST(crc_test_nfc_helpers) {
+    BitBuffer* buf = bit_buffer_alloc(CRC_TEST_DATA_SIZE);
+    uint8_t data[64];
+
+    for(size_t size = 1; size <= sizeof(data); size++) {
+        furi_hal_random_fill_buf(data, size);
+        uint16_t crc;
+
+        bit_buffer_copy_bytes(buf, data, size);
+        iso14443_crc_append(Iso14443CrcTypeA, buf);
+        bit_buffer_write_bytes_mid(buf, &crc, size, sizeof(crc));
+        mu_assert_int_eq(crc_test_ref_ccitt_reflected(0x6363, data, size), crc);
+        mu_assert(iso14443_crc_check(Iso14443CrcTypeA, buf), "iso14443_crc_check() failed");
+
+        bit_buffer_copy_bytes(buf, data, size);
+        iso14443_crc_append(Iso14443CrcTypeB, buf);
+        bit_buffer_write_bytes_mid(buf, &crc, size, sizeof(crc));
+        mu_assert_int_eq((uint16_t)~crc_test_ref_ccitt_reflected(0xFFFF, data, size), crc);
+        mu_assert(iso14443_crc_check(Iso14443CrcTypeB, buf), "iso14443_crc_check() failed");
+
+        bit_buffer_copy_bytes(buf, data, size);
+        iso13239_crc_append(Iso13239CrcTypeDefault, buf);
+        bit_buffer_write_bytes_mid(buf, &crc, size, sizeof(crc));
+        mu_assert_int_eq((uint16_t)~crc_test_ref_ccitt_reflected(0xFFFF, data, size), crc);
+        mu_assert(iso13239_crc_check(Iso13239CrcTypeDefault, buf), "iso13239_crc_check() failed");
+
+        bit_buffer_copy_bytes(buf, data, size);
+        iso13239_crc_append(Iso13239CrcTypePicopass, buf);
+        bit_buffer_write_bytes_mid(buf, &crc, size, sizeof(crc));
+        mu_assert_int_eq(crc_test_ref_ccitt_reflected(0xE012, data, size), crc);
+        mu_assert(iso13239_crc_check(Iso13239CrcTypePicopass, buf), "iso13239_crc_check() failed");
+
+        bit_buffer_copy_bytes(buf, data, size);
+        felica_crc_append(buf);
+        bit_buffer_write_bytes_mid(buf, &crc, size, sizeof(crc));
+        uint16_t crc_ref = crc_test_ref_ccitt(0x0000, data, size);
+        mu_assert_int_eq((uint16_t)((crc_ref << 8) | (crc_ref >> 8)), crc);
+        mu_assert(felica_crc_check(buf), "felica_crc_check() failed");
+
+        bit_buffer_set_byte(buf, 0, bit_buffer_get_byte(buf, 0) ^ 0x01);
+        mu_assert(!felica_crc_check(buf), "felica_crc_check() passed on corrupted data");
+    }
+
+    bit_buffer_free(buf);
+}
+
+static void crc_test_report(const char* name, size_t bytes, uint32_t ref_cycles, uint32_t cycles) {
+    const uint32_t cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+    FURI_LOG_I(
+        TAG,
+        "%s: %lu -> %lu cycles, %lu -> %lu KB/s",
+        name,
+        ref_cycles,
+        cycles,
+        (uint32_t)((uint64_t)bytes * cycles_per_us * 1000 / MAX(ref_cycles, 1U)),
+        (uint32_t)((uint64_t)bytes * cycles_per_us * 1000 / MAX(cycles, 1U)));
+}
+
+MU_TEST(crc_test_benchmark) {
+    uint8_t* data = malloc(CRC_TEST_BENCH_BUFF_SIZE);
+    furi_hal_random_fill_buf(data, CRC_TEST_BENCH_BUFF_SIZE);
+    volatile uint32_t sink = 0;
+    uint32_t start;
+
+    // NTAG READ response: 16 data bytes and CRC_A, one per listener frame
+    start = DWT->CYCCNT;
+    for(size_t i = 0; i < CRC_TEST_BENCH_FRAMES; i++) {
+        sink = crc_test_ref_ccitt_reflected(0x6363, data + i, CRC_TEST_FRAME_SIZE);
+    }
+    uint32_t ref_cycles = DWT->CYCCNT - start;
+    start = DWT->CYCCNT;
+    for(size_t i = 0; i < CRC_TEST_BENCH_FRAMES; i++) {
+        sink = crc16_calc_ccitt_reflected(0x6363, data + i, CRC_TEST_FRAME_SIZE);
+    }
+    uint32_t cycles = DWT->CYCCNT - start;
+    crc_test_report(
+        "CRC-16 frames", CRC_TEST_BENCH_FRAMES * CRC_TEST_FRAME_SIZE, ref_cycles, cycles);
+    mu_assert(cycles < ref_cycles, "Table CRC-16 is slower than reference");
+
+    start = DWT->CYCCNT;
+    sink = crc_test_ref_crc32(0, data, CRC_TEST_BENCH_BUFF_SIZE);
+    ref_cycles = DWT->CYCCNT - start;
+    start = DWT->CYCCNT;
+    sink = crc32_calc_buffer(0, data, CRC_TEST_BENCH_BUFF_SIZE);
+    cycles = DWT->CYCCNT - start;
+    crc_test_report("CRC-32 buffer", CRC_TEST_BENCH_BUFF_SIZE, ref_cycles, cycles);
+    mu_assert(cycles < ref_cycles, "Slice-by-4 CRC-32 is slower than reference");
+
+    UNUSED(sink);
+    free(data);
+}
+
+MU_TEST_SUITE(test_crc) {
+    MU_RUN_TEST(crc_test_known_values);
+    MU_RUN_TEST(crc_test_single_bytes);
+    MU_RUN_TEST(crc_test_all_sizes);
+    MU_RUN_TEST(crc_test_nfc_helpers);
+    MU_RUN_TEST(crc_test_benchmark);
+}
+
+int run_minunit_test_crc(void) {
+    MU_RUN_SUITE(test_crc);
+    return MU_EXIT_CODE;
+}
+
+TEST_API_DEFINE(run_minunit_test_crc)
@@ -14,6 +14,9 @@ static const char* const storage_test_dirwalk_paths[] = {
     "111/2",
     "111/22",
     "111/22/33",
+    "111/22/33/44",
+    "111/22/33/44/55",
+    "111/22/33/44/55/66",
 };
 
 static const char* const storage_test_dirwalk_files[] = {
@@ -25,6 +28,8 @@ static const char* const storage_test_dirwalk_files[] = {
     "111/22/33/file2.test",
     "111/22/33/file3.ext_test",
     "111/22/33/file4.ext_test",
+    "111/22/33/44/file1.test",
+    "111/22/33/44/55/66/file1.test",
 };
 
 typedef struct {
@@ -43,6 +48,9 @@ const StorageTestPathDesc storage_test_dirwalk_full[] = {
     {.path = "111/2", .is_dir = true},
     {.path = "111/22", .is_dir = true},
     {.path = "111/22/33", .is_dir = true},
+    {.path = "111/22/33/44", .is_dir = true},
+    {.path = "111/22/33/44/55", .is_dir = true},
+    {.path = "111/22/33/44/55/66", .is_dir = true},
     {.path = "file1.test", .is_dir = false},
     {.path = "file2.test", .is_dir = false},
     {.path = "file3.ext_test", .is_dir = false},
@@ -51,6 +59,8 @@ const StorageTestPathDesc storage_test_dirwalk_full[] = {
     {.path = "111/22/33/file2.test", .is_dir = false},
     {.path = "111/22/33/file3.ext_test", .is_dir = false},
     {.path = "111/22/33/file4.ext_test", .is_dir = false},
+    {.path = "111/22/33/44/file1.test", .is_dir = false},
+    {.path = "111/22/33/44/55/66/file1.test", .is_dir = false},
 };
 
 const StorageTestPathDesc storage_test_dirwalk_no_recursive[] = {
@@ -68,6 +78,8 @@ const StorageTestPathDesc storage_test_dirwalk_filter[] = {
     {.path = "1/file1.test", .is_dir = false},
     {.path = "111/22/33/file1.test", .is_dir = false},
     {.path = "111/22/33/file2.test", .is_dir = false},
+    {.path = "111/22/33/44/file1.test", .is_dir = false},
+    {.path = "111/22/33/44/55/66/file1.test", .is_dir = false},
 };
 
 typedef struct {
@@ -254,6 +266,74 @@ MU_TEST_1(test_dirwalk_filter, Storage* storage) {
     storage_test_paths_free(paths);
 }
 
+// Deeper than the levels that keep their own handle open, so parents are reopened and rewound
+#define DIRWALK_DEEP_PATH   EXT_PATH("dirwalk_deep")
+#define DIRWALK_DEEP_LEVELS 12
+
+static void storage_test_paths_add(
+    StorageTestPathDict_t* data,
+    FuriString* prefix,
+    const char* name,
+    bool is_dir) {
+    FuriString* key = furi_string_alloc_printf("%s%s", furi_string_get_cstr(prefix), name);
+    StorageTestPath value = {
+        .is_dir = is_dir,
+        .visited = false,
+    };
+
+    StorageTestPathDict_set_at(*data, key, value);
+    furi_string_free(key);
+}
+
+MU_TEST_1(test_dirwalk_deep, Storage* storage) {
+    FuriString* path = furi_string_alloc();
+    FuriString* dir_path = furi_string_alloc_set(DIRWALK_DEEP_PATH);
+    FuriString* prefix = furi_string_alloc();
+    StorageTestPathDict_t* paths = storage_test_paths_alloc(NULL, 0);
+
+    // Entries are listed in creation order, so "z.test" is only found after the walk returns
+    // from the subfolder
+    storage_common_mkdir(storage, DIRWALK_DEEP_PATH);
+    for(size_t level = 0; level < DIRWALK_DEEP_LEVELS; level++) {
+        furi_string_printf(path, "%s/a.test", furi_string_get_cstr(dir_path));
+        write_file_13DA(storage, furi_string_get_cstr(path));
+        storage_test_paths_add(paths, prefix, "a.test", false);
+
+        furi_string_printf(path, "%s/d", furi_string_get_cstr(dir_path));
+        storage_common_mkdir(storage, furi_string_get_cstr(path));
+        storage_test_paths_add(paths, prefix, "d", true);
+
+        furi_string_printf(path, "%s/z.test", furi_string_get_cstr(dir_path));
+        write_file_13DA(storage, furi_string_get_cstr(path));
+        storage_test_paths_add(paths, prefix, "z.test", false);
+
+        furi_string_cat_str(dir_path, "/d");
+        furi_string_cat_str(prefix, "d/");
+    }
+
+    FileInfo fileinfo;
+    DirWalk* dir_walk = dir_walk_alloc(storage);
+    mu_check(dir_walk_open(dir_walk, DIRWALK_DEEP_PATH));
+
+    DirWalkResult result;
+    while((result = dir_walk_read(dir_walk, path, &fileinfo)) == DirWalkOK) {
+        furi_string_right(path, strlen(DIRWALK_DEEP_PATH "/"));
+        mu_check(storage_test_paths_mark(paths, path, file_info_is_dir(&fileinfo)));
+    }
+    mu_check(result == DirWalkLast);
+
+    dir_walk_free(dir_walk);
+    storage_simply_remove_recursive(storage, DIRWALK_DEEP_PATH);
+
+    furi_string_free(prefix);
+    furi_string_free(dir_path);
+    furi_string_free(path);
+
+    mu_check(storage_test_paths_check(paths) == false);
+
+    storage_test_paths_free(paths);
+}
+
 MU_TEST_SUITE(test_dirwalk_suite) {
     Storage* storage = furi_record_open(RECORD_STORAGE);
     storage_dirs_create(storage, EXT_PATH("dirwalk"));
@@ -261,6 +341,7 @@ MU_TEST_SUITE(test_dirwalk_suite) {
     MU_RUN_TEST_1(test_dirwalk_full, storage);
     MU_RUN_TEST_1(test_dirwalk_no_recursive, storage);
     MU_RUN_TEST_1(test_dirwalk_filter, storage);
+    MU_RUN_TEST_1(test_dirwalk_deep, storage);
 
     storage_simply_remove_recursive(storage, EXT_PATH("dirwalk"));
     furi_record_close(RECORD_STORAGE);
@@ -0,0 +1,182 @@
+#include <furi.h>
+#include <storage/storage.h>
+#include <gui/modules/file_browser_worker.h>
+
+#include "../test.h" // IWYU pragma: keep
+
+#define TAG "FileBrowserBenchmark"
+
+#define FILE_BROWSER_BENCHMARK_ROOT         EXT_PATH(".tmp/unit_tests")
+#define FILE_BROWSER_BENCHMARK_DIR          FILE_BROWSER_BENCHMARK_ROOT "/browser_benchmark"
+#define FILE_BROWSER_BENCHMARK_OTHER        FILE_BROWSER_BENCHMARK_ROOT "/browser_benchmark.txt"
+#define FILE_BROWSER_BENCHMARK_NEW_FILE     FILE_BROWSER_BENCHMARK_DIR "/new.txt"
+#define FILE_BROWSER_BENCHMARK_FILES        (5000)
+#define FILE_BROWSER_BENCHMARK_WINDOW       (50)
+#define FILE_BROWSER_BENCHMARK_TIMEOUT      (60000)
+#define FILE_BROWSER_BENCHMARK_SETTLE_DELAY (3000)
+#define FILE_BROWSER_BENCHMARK_EXTENSION    ".txt"
+
+#define FILE_BROWSER_BENCHMARK_FLAG_FOLDER (1 << 0)
+#define FILE_BROWSER_BENCHMARK_FLAG_LIST   (1 << 1)
+
+typedef struct {
+    FuriThreadId thread_id;
+    uint32_t item_cnt;
+    uint32_t list_cnt;
+} FileBrowserBenchmarkContext;
+
+static void file_browser_benchmark_folder_callback(
+    void* context,
+    uint32_t item_cnt,
+    int32_t file_idx,
+    bool is_root) {
+    UNUSED(file_idx);
+    UNUSED(is_root);
+    FileBrowserBenchmarkContext* benchmark = context;
+    benchmark->item_cnt = item_cnt;
+    furi_thread_flags_set(benchmark->thread_id, FILE_BROWSER_BENCHMARK_FLAG_FOLDER);
+}
+
+static void file_browser_benchmark_list_callback(void* context, uint32_t list_load_offset) {
+    UNUSED(list_load_offset);
+    FileBrowserBenchmarkContext* benchmark = context;
+    benchmark->list_cnt = 0;
+}
+
+static void file_browser_benchmark_item_callback(
+    void* context,
+    FuriString* item_path,
+    bool is_folder,
+    bool is_last) {
+    UNUSED(item_path);
+    UNUSED(is_folder);
+    FileBrowserBenchmarkContext* benchmark = context;
+    if(is_last) {
+        furi_thread_flags_set(benchmark->thread_id, FILE_BROWSER_BENCHMARK_FLAG_LIST);
+    } else {
+        benchmark->list_cnt++;
+    }
+}
+
+static bool file_browser_benchmark_create_file(Storage* storage, const char* path) {
+    File* file = storage_file_alloc(storage);
+    bool success = storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS);
+    storage_file_free(file);
+    return success;
+}
+
+static uint32_t file_browser_benchmark_load_window(
+    BrowserWorker* browser,
+    FileBrowserBenchmarkContext* benchmark,
+    const char* name) {
+    const uint32_t offset = FILE_BROWSER_BENCHMARK_FILES - FILE_BROWSER_BENCHMARK_WINDOW;
+    uint32_t start_tick = furi_get_tick();
+    file_browser_worker_load(browser, offset, FILE_BROWSER_BENCHMARK_WINDOW);
+    uint32_t flags = furi_thread_flags_wait(
+        FILE_BROWSER_BENCHMARK_FLAG_LIST, FuriFlagWaitAny, FILE_BROWSER_BENCHMARK_TIMEOUT);
+    uint32_t elapsed_ms = furi_get_tick() - start_tick;
+    if(flags != FILE_BROWSER_BENCHMARK_FLAG_LIST) return 0;
+
+    FURI_LOG_I(
+        TAG,
+        "%s: %lu items at offset %lu in %lu ms",
+        name,
+        benchmark->list_cnt,
+        offset,
+        elapsed_ms);
+
+    return benchmark->list_cnt;
+}
+
+MU_TEST(file_browser_benchmark_large_folder) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_remove_recursive(storage, FILE_BROWSER_BENCHMARK_DIR);
+    mu_assert(storage_simply_mkdir(storage, FILE_BROWSER_BENCHMARK_DIR), "Cannot create folder");
+
+    FuriString* path = furi_string_alloc();
+    uint32_t start_tick = furi_get_tick();
+    bool files_ok = true;
+    for(uint32_t i = 0; (i < FILE_BROWSER_BENCHMARK_FILES) && files_ok; i++) {
+        furi_string_printf(
+            path, "%s/%04lu" FILE_BROWSER_BENCHMARK_EXTENSION, FILE_BROWSER_BENCHMARK_DIR, i);
+        files_ok = file_browser_benchmark_create_file(storage, furi_string_get_cstr(path));
+    }
+    FURI_LOG_I(
+        TAG,
+        "Created %u files in %lu ms",
+        FILE_BROWSER_BENCHMARK_FILES,
+        furi_get_tick() - start_tick);
+
+    // Let folder timestamp get older than its resolution, otherwise the index is rechecked
+    furi_delay_ms(FILE_BROWSER_BENCHMARK_SETTLE_DELAY);
+
+    FileBrowserBenchmarkContext benchmark = {
+        .thread_id = furi_thread_get_current_id(),
+    };
+
+    // Worker enters its start folder right away, benchmarked folder is entered separately
+    furi_string_set(path, FILE_BROWSER_BENCHMARK_ROOT);
+    BrowserWorker* browser = file_browser_worker_alloc(
+        path, NULL, FILE_BROWSER_BENCHMARK_EXTENSION, false, false);
+    file_browser_worker_set_callback_context(browser, &benchmark);
+    file_browser_worker_set_folder_callback(browser, file_browser_benchmark_folder_callback);
+    file_browser_worker_set_list_callback(browser, file_browser_benchmark_list_callback);
+    file_browser_worker_set_item_callback(browser, file_browser_benchmark_item_callback);
+
+    start_tick = furi_get_tick();
+    furi_string_set(path, FILE_BROWSER_BENCHMARK_DIR);
+    file_browser_worker_folder_enter(browser, path, 0);
+    uint32_t flags = 0;
+    while(files_ok && (benchmark.item_cnt != FILE_BROWSER_BENCHMARK_FILES)) {
+        flags = furi_thread_flags_wait(
+            FILE_BROWSER_BENCHMARK_FLAG_FOLDER, FuriFlagWaitAny, FILE_BROWSER_BENCHMARK_TIMEOUT);
+        if(flags != FILE_BROWSER_BENCHMARK_FLAG_FOLDER) break;
+    }
+    FURI_LOG_I(
+        TAG,
+        "Folder scan: %lu items in %lu ms",
+        benchmark.item_cnt,
+        furi_get_tick() - start_tick);
+
+    uint32_t from_index = 0, after_other_write = 0, after_folder_change = 0;
+    if(benchmark.item_cnt == FILE_BROWSER_BENCHMARK_FILES) {
+        from_index = file_browser_benchmark_load_window(browser, &benchmark, "Index");
+
+        // Write outside of the folder must not invalidate the index
+        file_browser_benchmark_create_file(storage, FILE_BROWSER_BENCHMARK_OTHER);
+        after_other_write =
+            file_browser_benchmark_load_window(browser, &benchmark, "Other folder written");
+
+        // New entry invalidates the index, window is read from the folder
+        file_browser_benchmark_create_file(storage, FILE_BROWSER_BENCHMARK_NEW_FILE);
+        after_folder_change =
+            file_browser_benchmark_load_window(browser, &benchmark, "Folder changed");
+    }
+
+    file_browser_worker_free(browser);
+
+    start_tick = furi_get_tick();
+    storage_simply_remove_recursive(storage, FILE_BROWSER_BENCHMARK_DIR);
+    storage_simply_remove(storage, FILE_BROWSER_BENCHMARK_OTHER);
+    FURI_LOG_I(TAG, "Removed folder in %lu ms", furi_get_tick() - start_tick);
+
+    furi_string_free(path);
+    furi_record_close(RECORD_STORAGE);
+
+    mu_assert(files_ok, "Cannot create files");
+    mu_assert(benchmark.item_cnt == FILE_BROWSER_BENCHMARK_FILES, "Folder scan failed");
+    mu_assert(from_index == FILE_BROWSER_BENCHMARK_WINDOW, "Wrong window from index");
+    mu_assert(after_other_write == FILE_BROWSER_BENCHMARK_WINDOW, "Wrong window after write");
+    mu_assert(after_folder_change == FILE_BROWSER_BENCHMARK_WINDOW, "Wrong window after change");
+}
+
+MU_TEST_SUITE(file_browser_benchmark) {
+    MU_RUN_TEST(file_browser_benchmark_large_folder);
+}
+
+int run_minunit_test_file_browser_benchmark(void) {
+    MU_RUN_SUITE(file_browser_benchmark);
+    return MU_EXIT_CODE;
+}
+
+TEST_API_DEFINE(run_minunit_test_file_browser_benchmark)
@@ -488,3 +488,161 @@ void test_furi_event_loop(void) {
     furi_event_flag_free(data.event_flag);
     furi_semaphore_free(data.semaphore);
 }
+
+#define TIMER_BENCH_COUNT (512UL)
+
+typedef enum {
+    TestFuriEventLoopTimerShort,
+    TestFuriEventLoopTimerMedium,
+    TestFuriEventLoopTimerLong,
+    TestFuriEventLoopTimerCancelled,
+    TestFuriEventLoopTimerPeriodic,
+    TestFuriEventLoopTimerNum,
+} TestFuriEventLoopTimerId;
+
+// Spread over the first three levels of the timer wheel
+static const uint32_t test_furi_event_loop_timer_intervals[TestFuriEventLoopTimerNum] = {
+    [TestFuriEventLoopTimerShort] = 3,
+    [TestFuriEventLoopTimerMedium] = 40,
+    [TestFuriEventLoopTimerLong] = 300,
+    [TestFuriEventLoopTimerCancelled] = 10,
+    [TestFuriEventLoopTimerPeriodic] = 16,
+};
+
+typedef struct {
+    FuriEventLoop* event_loop;
+    FuriEventLoopTimer* timers[TestFuriEventLoopTimerNum];
+    uint32_t start_tick;
+    uint32_t fire_ticks[TestFuriEventLoopTimerNum];
+    uint32_t fire_count[TestFuriEventLoopTimerNum];
+
+    FuriEventLoopTimer** bench_timers;
+    FuriEventLoopTimer* bench_step_timer;
+    size_t bench_step;
+    uint32_t bench_start;
+    uint32_t arm_cycles;
+    uint32_t cancel_cycles;
+} TestFuriEventLoopTimer;
+
+typedef struct {
+    TestFuriEventLoopTimer* test;
+    TestFuriEventLoopTimerId id;
+} TestFuriEventLoopTimerContext;
+
+static void test_furi_event_loop_timer_callback(void* context) {
+    TestFuriEventLoopTimerContext* timer_context = context;
+    TestFuriEventLoopTimer* test = timer_context->test;
+
+    test->fire_count[timer_context->id]++;
+    test->fire_ticks[timer_context->id] = furi_get_tick();
+
+    if(timer_context->id == TestFuriEventLoopTimerLong) {
+        furi_event_loop_stop(test->event_loop);
+    }
+}
+
+static void test_furi_event_loop_timer_bench_callback(void* context) {
+    UNUSED(context);
+}
+
+// Timer requests are processed before expired timers, so each step sees the previous one done
+static void test_furi_event_loop_timer_bench_step(void* context) {
+    TestFuriEventLoopTimer* test = context;
+    const uint32_t cycles = DWT->CYCCNT - test->bench_start;
+
+    if(test->bench_step == 0) {
+        test->bench_start = DWT->CYCCNT;
+        for(size_t i = 0; i < TIMER_BENCH_COUNT; i++) {
+            furi_event_loop_timer_start(test->bench_timers[i], 1000 + i * 37);
+        }
+    } else if(test->bench_step == 1) {
+        test->arm_cycles = cycles;
+        test->bench_start = DWT->CYCCNT;
+        for(size_t i = 0; i < TIMER_BENCH_COUNT; i++) {
+            furi_event_loop_timer_stop(test->bench_timers[i]);
+        }
+    } else {
+        test->cancel_cycles = cycles;
+        furi_event_loop_stop(test->event_loop);
+        return;
+    }
+
+    test->bench_step++;
+    furi_event_loop_timer_start(test->bench_step_timer, 0);
+}
+
+void test_furi_event_loop_timer(void) {
+    TestFuriEventLoopTimer test = {.event_loop = furi_event_loop_alloc()};
+    TestFuriEventLoopTimerContext contexts[TestFuriEventLoopTimerNum];
+
+    for(size_t i = 0; i < TestFuriEventLoopTimerNum; i++) {
+        contexts[i] = (TestFuriEventLoopTimerContext){.test = &test, .id = i};
+        test.timers[i] = furi_event_loop_timer_alloc(
+            test.event_loop,
+            test_furi_event_loop_timer_callback,
+            i == TestFuriEventLoopTimerPeriodic ? FuriEventLoopTimerTypePeriodic :
+                                                  FuriEventLoopTimerTypeOnce,
+            &contexts[i]);
+        furi_event_loop_timer_start(test.timers[i], test_furi_event_loop_timer_intervals[i]);
+    }
+    furi_event_loop_timer_stop(test.timers[TestFuriEventLoopTimerCancelled]);
+
+    test.start_tick = furi_get_tick();
+    furi_event_loop_run(test.event_loop);
+
+    mu_assert_int_eq(0, test.fire_count[TestFuriEventLoopTimerCancelled]);
+    mu_assert(test.fire_count[TestFuriEventLoopTimerPeriodic] >= 5, "Periodic timer is late");
+    for(size_t i = TestFuriEventLoopTimerShort; i <= TestFuriEventLoopTimerLong; i++) {
+        mu_assert_int_eq(1, test.fire_count[i]);
+        mu_assert(
+            test.fire_ticks[i] - test.start_tick >= test_furi_event_loop_timer_intervals[i],
+            "Timer fired early");
+        mu_assert(!furi_event_loop_timer_is_running(test.timers[i]), "Timer is running");
+    }
+    mu_assert(
+        test.fire_ticks[TestFuriEventLoopTimerShort] <=
+                test.fire_ticks[TestFuriEventLoopTimerMedium] &&
+            test.fire_ticks[TestFuriEventLoopTimerMedium] <=
+                test.fire_ticks[TestFuriEventLoopTimerLong],
+        "Wrong timer order");
+
+    for(size_t i = 0; i < TestFuriEventLoopTimerNum; i++) {
+        furi_event_loop_timer_free(test.timers[i]);
+    }
+
+    // Arm and cancel cost
+    test.bench_timers = malloc(TIMER_BENCH_COUNT * sizeof(FuriEventLoopTimer*));
+    for(size_t i = 0; i < TIMER_BENCH_COUNT; i++) {
+        test.bench_timers[i] = furi_event_loop_timer_alloc(
+            test.event_loop,
+            test_furi_event_loop_timer_bench_callback,
+            FuriEventLoopTimerTypeOnce,
+            NULL);
+    }
+
+    test.bench_step_timer = furi_event_loop_timer_alloc(
+        test.event_loop, test_furi_event_loop_timer_bench_step, FuriEventLoopTimerTypeOnce, &test);
+    furi_event_loop_timer_start(test.bench_step_timer, 0);
+    furi_event_loop_run(test.event_loop);
+
+    // Only on-device figures, there is no host build to compare the old sorted list on
+    const uint32_t cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+    const uint32_t arm_ns = test.arm_cycles * 1000ULL / cycles_per_us / TIMER_BENCH_COUNT;
+    const uint32_t cancel_ns = test.cancel_cycles * 1000ULL / cycles_per_us / TIMER_BENCH_COUNT;
+    FURI_LOG_I(
+        TAG,
+        "%lu timers, per timer: arm %lu cycles (%lu ns), cancel %lu cycles (%lu ns)",
+        TIMER_BENCH_COUNT,
+        test.arm_cycles / TIMER_BENCH_COUNT,
+        arm_ns,
+        test.cancel_cycles / TIMER_BENCH_COUNT,
+        cancel_ns);
+
+    for(size_t i = 0; i < TIMER_BENCH_COUNT; i++) {
+        furi_event_loop_timer_free(test.bench_timers[i]);
+    }
+    furi_event_loop_timer_free(test.bench_step_timer);
+    free(test.bench_timers);
+
+    furi_event_loop_free(test.event_loop);
+}
@@ -0,0 +1,98 @@
+#include <furi.h>
+#include <furi_hal.h>
+#include "../test.h" // IWYU pragma: keep
+
+#define TAG "LogTest"
+
+#define LOG_TEST_CAPTURE_SIZE (512)
+#define LOG_TEST_BENCH_CALLS  (32)
+
+static char log_test_capture[LOG_TEST_CAPTURE_SIZE];
+static size_t log_test_capture_size;
+
+static void log_test_capture_callback(const uint8_t* data, size_t size, void* context) {
+    UNUSED(context);
+    size = MIN(size, LOG_TEST_CAPTURE_SIZE - 1 - log_test_capture_size);
+    memcpy(log_test_capture + log_test_capture_size, data, size);
+    log_test_capture_size += size;
+    log_test_capture[log_test_capture_size] = '\0';
+}
+
+static void log_test_capture_reset(void) {
+    log_test_capture_size = 0;
+    log_test_capture[0] = '\0';
+}
+
+static void log_test_output(void) {
+    log_test_capture_reset();
+    FURI_LOG_I(
+        TAG,
+        "%d|%5u|%-4x|%08lX|%c|%lld|%.2f|%*d|%.3s|%s|%%",
+        -42,
+        17U,
+        0xab,
+        0xdeadbeefUL,
+        'z',
+        -1234567890123LL,
+        3.14159,
+        6,
+        7,
+        "abcdef",
+        "str");
+    furi_log_flush();
+}
+
+static uint32_t log_test_benchmark(void) {
+    const uint32_t start = DWT->CYCCNT;
+    for(size_t i = 0; i < LOG_TEST_BENCH_CALLS; i++) {
+        FURI_LOG_I(TAG, "Benchmark %zu of %d: %s", i, LOG_TEST_BENCH_CALLS, "payload");
+    }
+    return (DWT->CYCCNT - start) / LOG_TEST_BENCH_CALLS;
+}
+
+void test_furi_log(void) {
+    const FuriLogLevel level = furi_log_get_level();
+    const FuriLogDeferredMode mode = furi_log_get_deferred_mode();
+    FuriLogHandler handler = {.callback = log_test_capture_callback};
+    furi_log_set_level(FuriLogLevelInfo);
+    furi_log_set_deferred_mode(FuriLogDeferredModeOff);
+    mu_assert(furi_log_add_handler(handler), "furi_log_add_handler() failed");
+
+    // Same message in both modes, only the tick may differ
+    const char* expected = "|-42|   17|ab  |DEADBEEF|z|-1234567890123|3.14|     7|abc|str|%\r\n";
+    log_test_output();
+    const bool immediate_match = strstr(log_test_capture, expected);
+
+    furi_log_set_deferred_mode(FuriLogDeferredModeText);
+    log_test_output();
+    const bool deferred_match = strstr(log_test_capture, expected);
+
+    // %n can't be deferred and goes through the caller
+    FuriLogDeferredStats stats_before, stats_after;
+    furi_log_get_deferred_stats(&stats_before);
+    int written = 0;
+    FURI_LOG_I(TAG, "Immediate%n", &written);
+    furi_log_get_deferred_stats(&stats_after);
+    const uint32_t immediate = stats_after.immediate - stats_before.immediate;
+
+    // Per call overhead, without the time spent by the log thread
+    furi_log_set_deferred_mode(FuriLogDeferredModeOff);
+    const uint32_t immediate_cycles = log_test_benchmark();
+    furi_log_set_deferred_mode(FuriLogDeferredModeText);
+    const uint32_t deferred_cycles = log_test_benchmark();
+    furi_log_flush();
+    furi_log_get_deferred_stats(&stats_after);
+
+    // Handler must be gone before any assert returns
+    furi_log_remove_handler(handler);
+    furi_log_set_deferred_mode(mode);
+    furi_log_set_level(level);
+
+    FURI_LOG_I(
+        TAG, "Cycles per call: immediate %lu, deferred %lu", immediate_cycles, deferred_cycles);
+
+    mu_assert(immediate_match, "Immediate output mismatch");
+    mu_assert(deferred_match, "Deferred output mismatch");
+    mu_assert_int_eq(1, immediate);
+    mu_assert_int_eq(stats_before.dropped, stats_after.dropped);
+}
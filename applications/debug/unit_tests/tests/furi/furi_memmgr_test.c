@@ -1,9 +1,22 @@
 #include "../test.h" // IWYU pragma: keep
+#include <furi.h>
+#include <furi_hal.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
 #include <stdint.h>
 
+#define TAG "MemmgrTest"
+
+#define MEMMGR_TEST_BENCH_CALLS (1000)
+
+#define MEMMGR_TEST_PROFILE_CAPACITY  (64)
+#define MEMMGR_TEST_PROFILE_DUMP_SIZE (4 * 1024)
+
+// Dump layout, see furi/core/memmgr_heap.c
+#define MEMMGR_TEST_PROFILE_HEADER_SIZE (20)
+#define MEMMGR_TEST_PROFILE_EVENT_FREE  (1UL << 30)
+
 void test_furi_memmgr(void) {
     void* ptr;
 
@@ -37,3 +50,108 @@ void test_furi_memmgr(void) {
     }
     free(ptr);
 }
+
+static uint32_t memmgr_test_class_hits(void) {
+    uint32_t hits = 0;
+    for(size_t i = 0; i < MEMMGR_HEAP_CLASS_COUNT; i++) {
+        MemmgrHeapClassStats stats;
+        memmgr_heap_get_class_stats(i, &stats);
+        hits += stats.hits;
+    }
+    return hits;
+}
+
+void test_furi_memmgr_size_class(void) {
+    // freed small block is handed out again for the same size
+    const uint32_t hits = memmgr_test_class_hits();
+    void* ptr = malloc(32);
+    memset(ptr, 0x5A, 32);
+    free(ptr);
+    uint8_t* again = malloc(32);
+    mu_assert_pointers_eq(ptr, again);
+    mu_assert(memmgr_test_class_hits() > hits, "Size class was not used");
+    // and is still zero-initialized
+    for(int i = 0; i < 32; i++) {
+        mu_assert_int_eq(0, again[i]);
+    }
+    free(again);
+
+    // small block churn, as done by strings and containers
+    uint32_t start = DWT->CYCCNT;
+    for(size_t i = 0; i < MEMMGR_TEST_BENCH_CALLS; i++) {
+        free(malloc(8 + (i % 8) * 8));
+    }
+    const uint32_t cycles = (DWT->CYCCNT - start) / MEMMGR_TEST_BENCH_CALLS;
+    FURI_LOG_I(TAG, "Cycles per malloc and free: %lu", cycles);
+}
+
+typedef struct {
+    uint8_t* data;
+    size_t size;
+} MemmgrTestDump;
+
+static bool memmgr_test_dump_callback(const void* data, size_t size, void* context) {
+    MemmgrTestDump* dump = context;
+    if(dump->size + size > MEMMGR_TEST_PROFILE_DUMP_SIZE) return false;
+    memcpy(dump->data + dump->size, data, size);
+    dump->size += size;
+    return true;
+}
+
+static const uint32_t*
+    memmgr_test_find(const uint32_t* records, size_t count, void* pointer, uint32_t event) {
+    for(size_t i = 0; i < count; i++) {
+        if(records[i * 4 + 1] == (uint32_t)pointer && (records[i * 4 + 3] >> 30) == event >> 30) {
+            return &records[i * 4];
+        }
+    }
+    return NULL;
+}
+
+void test_furi_memmgr_profile(void) {
+    MemmgrTestDump dump = {.data = malloc(MEMMGR_TEST_PROFILE_DUMP_SIZE)};
+
+    memmgr_heap_profile_start(MEMMGR_TEST_PROFILE_CAPACITY);
+    void* ptr = malloc(48);
+    free(ptr);
+
+    MemmgrHeapProfileInfo info;
+    memmgr_heap_profile_get_info(&info);
+    mu_assert(info.running, "Profile is not running");
+    mu_assert_int_eq(MEMMGR_TEST_PROFILE_CAPACITY, info.capacity);
+    mu_assert(info.count >= 2, "Events are missing");
+
+    mu_assert(
+        memmgr_heap_profile_dump(memmgr_test_dump_callback, &dump),
+        "memmgr_heap_profile_dump() failed");
+    memmgr_heap_profile_get_info(&info);
+    mu_assert(!info.running, "Profile is running after dump");
+
+    uint32_t header[5];
+    memcpy(header, dump.data, sizeof(header));
+    mu_assert_int_eq(MEMMGR_HEAP_PROFILE_DUMP_MAGIC, header[0]);
+    mu_assert_int_eq(info.count, header[3]);
+
+    const uint32_t* records = (const uint32_t*)(dump.data + MEMMGR_TEST_PROFILE_HEADER_SIZE);
+    const uint32_t* alloc = memmgr_test_find(records, info.count, ptr, 0);
+    const uint32_t* release =
+        memmgr_test_find(records, info.count, ptr, MEMMGR_TEST_PROFILE_EVENT_FREE);
+    mu_assert(alloc && release && alloc < release, "Allocation events are missing");
+    mu_assert_int_eq(48, alloc[3] & 0xFFFFFF);
+    // Return address is in this function
+    const uint32_t function = (uint32_t)test_furi_memmgr_profile & ~1UL;
+    mu_assert(alloc[2] > function && alloc[2] - function < 1024, "Wrong call site");
+    mu_assert((alloc[3] >> 24 & 0x3F) == (release[3] >> 24 & 0x3F), "Threads differ");
+
+    // Names of threads follow the records
+    const char* thread_name = furi_thread_get_name(furi_thread_get_current_id());
+    const uint8_t* names = (const uint8_t*)&records[info.count * 4];
+    const size_t names_size = dump.size - (names - dump.data);
+    bool name_found = false;
+    for(size_t i = 0; i + strlen(thread_name) <= names_size && !name_found; i++) {
+        name_found = memcmp(names + i, thread_name, strlen(thread_name)) == 0;
+    }
+    mu_assert(name_found, "Thread name is missing");
+
+    free(dump.data);
+}
@@ -43,3 +43,81 @@ void test_furi_pubsub(void) {
     // delete pubsub case
     furi_pubsub_free(test_pubsub);
 }
+
+#define PUBSUB_ASYNC_QUEUE_LENGTH (2)
+
+typedef struct {
+    FuriEventLoop* event_loop;
+    uint32_t values[PUBSUB_ASYNC_QUEUE_LENGTH];
+    size_t count;
+} PubSubAsyncContext;
+
+static void test_pubsub_async_handler(const void* arg, void* ctx) {
+    PubSubAsyncContext* context = ctx;
+    context->values[context->count++] = *(const uint32_t*)arg;
+    if(context->count == PUBSUB_ASYNC_QUEUE_LENGTH) {
+        furi_event_loop_stop(context->event_loop);
+    }
+}
+
+void test_furi_pubsub_async(void) {
+    PubSubAsyncContext context = {.event_loop = furi_event_loop_alloc()};
+    FuriPubSub* test_pubsub = furi_pubsub_alloc();
+
+    FuriPubSubSubscription* sync_subscription =
+        furi_pubsub_subscribe(test_pubsub, test_pubsub_handler, (void*)&context_value);
+    FuriPubSubSubscription* async_subscription = furi_pubsub_subscribe_async(
+        test_pubsub,
+        context.event_loop,
+        sizeof(uint32_t),
+        PUBSUB_ASYNC_QUEUE_LENGTH,
+        test_pubsub_async_handler,
+        &context);
+    mu_assert_pointers_not_eq(async_subscription, NULL);
+
+    // Messages are copied, publisher doesn't wait for the subscriber
+    uint32_t value = notify_value_0;
+    furi_pubsub_publish(test_pubsub, &value);
+    value = notify_value_1;
+    furi_pubsub_publish(test_pubsub, &value);
+    // Queue is full, message is dropped
+    value = context_value;
+    furi_pubsub_publish(test_pubsub, &value);
+    mu_assert_int_eq(0, context.count);
+    // Synchronous subscriber is called right away
+    mu_assert_int_eq(context_value, pubsub_value);
+
+    furi_event_loop_run(context.event_loop);
+    mu_assert_int_eq(PUBSUB_ASYNC_QUEUE_LENGTH, context.count);
+    mu_assert_int_eq(notify_value_0, context.values[0]);
+    mu_assert_int_eq(notify_value_1, context.values[1]);
+
+    FuriPubSubSubscriptionStats subscription_stats;
+    furi_pubsub_subscription_get_stats(test_pubsub, async_subscription, &subscription_stats);
+    mu_assert_int_eq(2, subscription_stats.delivered);
+    mu_assert_int_eq(1, subscription_stats.dropped);
+    mu_assert_int_eq(PUBSUB_ASYNC_QUEUE_LENGTH, subscription_stats.queue_length);
+    mu_assert_int_eq(PUBSUB_ASYNC_QUEUE_LENGTH, subscription_stats.queue_peak);
+
+    FuriPubSubStats stats;
+    furi_pubsub_get_stats(test_pubsub, &stats);
+    mu_assert_int_eq(3, stats.published);
+    mu_assert_int_eq(2, stats.subscribers);
+    mu_assert_int_eq(1, stats.async_subscribers);
+    mu_assert_int_eq(1, stats.dropped);
+    mu_assert_int_eq(1, stats.overflows);
+    mu_assert(stats.latency_max_us >= stats.latency_avg_us, "Wrong publish latency");
+
+    furi_pubsub_reset_stats(test_pubsub);
+    furi_pubsub_get_stats(test_pubsub, &stats);
+    mu_assert_int_eq(0, stats.published);
+    mu_assert_int_eq(0, stats.dropped);
+
+    // Pending messages are discarded
+    furi_pubsub_publish(test_pubsub, &value);
+    furi_pubsub_unsubscribe(test_pubsub, async_subscription);
+    furi_pubsub_unsubscribe(test_pubsub, sync_subscription);
+
+    furi_pubsub_free(test_pubsub);
+    furi_event_loop_free(context.event_loop);
+}
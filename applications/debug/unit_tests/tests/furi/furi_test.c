@@ -6,10 +6,16 @@
 void test_furi_create_open(void);
 void test_furi_concurrent_access(void);
 void test_furi_pubsub(void);
+void test_furi_pubsub_async(void);
 void test_furi_memmgr(void);
+void test_furi_memmgr_size_class(void);
+void test_furi_memmgr_profile(void);
 void test_furi_event_loop(void);
+void test_furi_event_loop_timer(void);
 void test_errno_saving(void);
 void test_furi_primitives(void);
+void test_furi_log(void);
+void test_furi_trace(void);
 void test_stdin(void);
 void test_stdout(void);
 
@@ -36,16 +42,32 @@ MU_TEST(mu_test_furi_pubsub) {
     test_furi_pubsub();
 }
 
+MU_TEST(mu_test_furi_pubsub_async) {
+    test_furi_pubsub_async();
+}
+
 MU_TEST(mu_test_furi_memmgr) {
     // this test is not accurate, but gives a basic understanding
     // that memory management is working fine
     test_furi_memmgr();
 }
 
+MU_TEST(mu_test_furi_memmgr_size_class) {
+    test_furi_memmgr_size_class();
+}
+
+MU_TEST(mu_test_furi_memmgr_profile) {
+    test_furi_memmgr_profile();
+}
+
 MU_TEST(mu_test_furi_event_loop) {
     test_furi_event_loop();
 }
 
+MU_TEST(mu_test_furi_event_loop_timer) {
+    test_furi_event_loop_timer();
+}
+
 MU_TEST(mu_test_errno_saving) {
     test_errno_saving();
 }
@@ -54,6 +76,14 @@ MU_TEST(mu_test_furi_primitives) {
     test_furi_primitives();
 }
 
+MU_TEST(mu_test_furi_log) {
+    test_furi_log();
+}
+
+MU_TEST(mu_test_furi_trace) {
+    test_furi_trace();
+}
+
 MU_TEST(mu_test_stdio) {
     test_stdin();
     test_stdout();
@@ -66,11 +96,17 @@ MU_TEST_SUITE(test_suite) {
     // v2 tests
     MU_RUN_TEST(mu_test_furi_create_open);
     MU_RUN_TEST(mu_test_furi_pubsub);
+    MU_RUN_TEST(mu_test_furi_pubsub_async);
     MU_RUN_TEST(mu_test_furi_memmgr);
+    MU_RUN_TEST(mu_test_furi_memmgr_size_class);
+    MU_RUN_TEST(mu_test_furi_memmgr_profile);
     MU_RUN_TEST(mu_test_furi_event_loop);
+    MU_RUN_TEST(mu_test_furi_event_loop_timer);
     MU_RUN_TEST(mu_test_stdio);
     MU_RUN_TEST(mu_test_errno_saving);
     MU_RUN_TEST(mu_test_furi_primitives);
+    MU_RUN_TEST(mu_test_furi_log);
+    MU_RUN_TEST(mu_test_furi_trace);
 }
 
 int run_minunit_test_furi(void) {
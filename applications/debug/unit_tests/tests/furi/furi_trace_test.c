@@ -0,0 +1,110 @@
+#include <furi.h>
+#include <furi_hal.h>
+#include "../test.h" // IWYU pragma: keep
+
+#define TAG "TraceTest"
+
+#define TRACE_TEST_CAPACITY    (256)
+#define TRACE_TEST_DUMP_SIZE   (8 * 1024)
+#define TRACE_TEST_BENCH_CALLS (100)
+
+// Dump layout, see furi/core/trace.c
+#define TRACE_TEST_HEADER_SIZE (20)
+#define TRACE_TEST_RECORD_SIZE (16)
+
+typedef struct {
+    uint8_t* data;
+    size_t size;
+} TraceTestDump;
+
+static bool trace_test_dump_callback(const void* data, size_t size, void* context) {
+    TraceTestDump* dump = context;
+    if(dump->size + size > TRACE_TEST_DUMP_SIZE) return false;
+    memcpy(dump->data + dump->size, data, size);
+    dump->size += size;
+    return true;
+}
+
+static const uint32_t* trace_test_find(const uint32_t* records, size_t count, uint32_t type) {
+    for(size_t i = 0; i < count; i++) {
+        if(records[i * 4 + 3] == type) return &records[i * 4];
+    }
+    return NULL;
+}
+
+static bool trace_test_contains(const uint8_t* data, size_t size, const char* str, size_t length) {
+    for(size_t i = 0; i + length <= size; i++) {
+        if(memcmp(data + i, str, length) == 0) return true;
+    }
+    return false;
+}
+
+void test_furi_trace(void) {
+    TraceTestDump dump = {.data = malloc(TRACE_TEST_DUMP_SIZE)};
+
+    furi_trace_start(TRACE_TEST_CAPACITY);
+    FURI_TRACE_BEGIN("TraceTestSpan");
+    FURI_TRACE_COUNTER("TraceTestCounter", 42);
+    FURI_TRACE_INSTANT("TraceTestInstant");
+    FURI_TRACE_END("TraceTestSpan");
+    furi_delay_tick(2);
+
+    FuriTraceInfo info;
+    furi_trace_get_info(&info);
+    mu_assert(info.running, "Trace is not running");
+    mu_assert_int_eq(TRACE_TEST_CAPACITY, info.capacity);
+
+    mu_assert(furi_trace_dump(trace_test_dump_callback, &dump), "furi_trace_dump() failed");
+    furi_trace_get_info(&info);
+    mu_assert(!info.running, "Trace is running after dump");
+    // Delay switches threads at least twice
+    mu_assert(info.count >= 6, "Events are missing");
+
+    uint32_t header[5];
+    memcpy(header, dump.data, sizeof(header));
+    mu_assert_int_eq(FURI_TRACE_DUMP_MAGIC, header[0]);
+    mu_assert_int_eq(FURI_TRACE_DUMP_VERSION | (TRACE_TEST_RECORD_SIZE << 16), header[1]);
+    mu_assert_int_eq(info.count, header[3]);
+
+    const uint32_t* records = (const uint32_t*)(dump.data + TRACE_TEST_HEADER_SIZE);
+    const uint32_t* begin = trace_test_find(records, info.count, FuriTraceEventTypeBegin);
+    const uint32_t* counter = trace_test_find(records, info.count, FuriTraceEventTypeCounter);
+    const uint32_t* instant = trace_test_find(records, info.count, FuriTraceEventTypeInstant);
+    const uint32_t* end = trace_test_find(records, info.count, FuriTraceEventTypeEnd);
+    mu_assert(begin && counter && instant && end, "Trace point events are missing");
+    mu_assert(begin < counter && counter < instant && instant < end, "Wrong event order");
+    mu_assert(begin[1] == end[1], "Span ids differ");
+    mu_assert_int_eq(42, counter[2]);
+    mu_assert(
+        trace_test_find(records, info.count, FuriTraceEventTypeThreadSwitch),
+        "Thread switches are missing");
+
+    for(size_t i = 1; i < info.count; i++) {
+        mu_assert(
+            (int32_t)(records[i * 4] - records[(i - 1) * 4]) >= 0, "Timestamps go backwards");
+    }
+
+    // Names of trace points and threads follow the records
+    const uint8_t* names = dump.data + TRACE_TEST_HEADER_SIZE +
+                           info.count * TRACE_TEST_RECORD_SIZE;
+    const size_t names_size = dump.size - (names - dump.data);
+    const char* thread_name = furi_thread_get_name(furi_thread_get_current_id());
+    mu_assert(
+        trace_test_contains(names, names_size, "TraceTestSpan", strlen("TraceTestSpan")),
+        "Trace point name is missing");
+    mu_assert(
+        trace_test_contains(names, names_size, thread_name, MIN(strlen(thread_name), 4U)),
+        "Thread name is missing");
+
+    // Per event overhead
+    furi_trace_start(TRACE_TEST_CAPACITY);
+    uint32_t start = DWT->CYCCNT;
+    for(size_t i = 0; i < TRACE_TEST_BENCH_CALLS; i++) {
+        FURI_TRACE_INSTANT("TraceTestBench");
+    }
+    const uint32_t cycles = (DWT->CYCCNT - start) / TRACE_TEST_BENCH_CALLS;
+    furi_trace_stop();
+    FURI_LOG_I(TAG, "Cycles per event: %lu", cycles);
+
+    free(dump.data);
+}
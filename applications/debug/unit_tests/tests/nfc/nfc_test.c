@@ -9,6 +9,7 @@
 #include <nfc/protocols/iso14443_3a/iso14443_3a.h>
 #include <nfc/protocols/iso14443_3a/iso14443_3a_poller.h>
 #include <nfc/protocols/iso14443_3a/iso14443_3a_poller_sync.h>
+#include <nfc/protocols/iso14443_4a/iso14443_4a_listener.h>
 #include <nfc/protocols/mf_ultralight/mf_ultralight.h>
 #include <nfc/protocols/mf_ultralight/mf_ultralight_poller_sync.h>
 #include <nfc/protocols/mf_classic/mf_classic_poller_sync.h>
@@ -22,9 +23,12 @@
 #include <nfc/protocols/slix/slix_poller_i.h>
 
 #include <nfc/nfc_poller.h>
+#include <nfc/nfc_scanner.h>
 
 #include <toolbox/keys_dict.h>
+#include <toolbox/stream/file_stream.h>
 #include <nfc/nfc.h>
+#include <nfc/protocols/mf_classic/mf_classic_nonce_log.h>
 
 #include "../test.h" // IWYU pragma: keep
 
@@ -32,6 +36,12 @@
 
 #define NFC_TEST_NFC_DEV_PATH                  EXT_PATH("unit_tests/nfc/nfc_device_test.nfc")
 #define NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH EXT_PATH("unit_tests/mf_dict.nfc")
+#define NFC_TEST_NONCE_LOG_BIN_PATH            EXT_PATH("unit_tests/nfc/nonce_log_test.bin")
+#define NFC_TEST_NONCE_LOG_TEXT_PATH           EXT_PATH("unit_tests/nfc/nonce_log_test.log")
+#define NFC_TEST_NESTED_USER_DICT_BACKUP_PATH  EXT_PATH("unit_tests/nfc/nested_user_dict.bak")
+
+#define NFC_TEST_NESTED_USER_DICT_PATH \
+    EXT_PATH("nfc/assets/mf_classic_dict_user_nested.nfc")
 
 #define NFC_TEST_FLAG_WORKER_DONE (1)
 
@@ -50,6 +60,14 @@ typedef struct {
     FuriThreadId thread_id;
 } NfcTestMfClassicSendFrameTest;
 
+typedef struct {
+    FuriThreadId thread_id;
+    const MfClassicData* data;
+    uint32_t nested_phases;
+    bool key_requested;
+    bool success;
+} NfcTestMfClassicNestedContext;
+
 typedef enum {
     NfcTestSlixPollerSetPasswordStateGetRandomNumber,
     NfcTestSlixPollerSetPasswordStateSetPassword,
@@ -63,6 +81,13 @@ typedef struct {
     SlixError error;
 } NfcTestSlixPollerSetPasswordContext;
 
+typedef struct {
+    FuriThreadId thread_id;
+    size_t protocol_num;
+    NfcProtocol protocols[NfcProtocolNum];
+    size_t apdu_num;
+} NfcTestScannerContext;
+
 typedef struct {
     Storage* storage;
 } NfcTest;
@@ -652,6 +677,227 @@ MU_TEST(mf_classic_dict_test) {
         "Remove test dict failed");
 }
 
+MU_TEST(mf_classic_nonce_log_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_remove(storage, NFC_TEST_NONCE_LOG_BIN_PATH);
+    storage_simply_remove(storage, NFC_TEST_NONCE_LOG_TEXT_PATH);
+
+    // More records than fit in log buffer
+    const size_t hard_record_num = 100;
+    MfClassicNonceLog* log = mf_classic_nonce_log_alloc(NFC_TEST_NONCE_LOG_BIN_PATH);
+    for(size_t i = 0; i < hard_record_num; i++) {
+        MfClassicNonceLogRecord record = {
+            .cuid = 0x04a1b2c3,
+            .sector = 5,
+            .flags = MfClassicNonceLogFlagKeyB,
+            .nonces[0] = {.nt = 0x01020304 + i, .ks = 0xdeadbeef, .par = 0x0a},
+        };
+        mu_assert(mf_classic_nonce_log_add(log, &record), "mf_classic_nonce_log_add() failed");
+        if(i == 0) {
+            // Records are written in chunks, not one by one
+            mu_assert(
+                !storage_file_exists(storage, NFC_TEST_NONCE_LOG_BIN_PATH),
+                "Record written before buffer is full");
+        }
+    }
+    MfClassicNonceLogRecord weak_record = {
+        .cuid = 0x04a1b2c3,
+        .sector = 15,
+        .flags = MfClassicNonceLogFlagPair | MfClassicNonceLogFlagDist,
+        .dist = 160,
+        .nonces[0] = {.nt = 0x11223344, .ks = 0x55667788, .par = 0x01},
+        .nonces[1] = {.nt = 0x99aabbcc, .ks = 0x0, .par = 0x0f},
+    };
+    mu_assert(mf_classic_nonce_log_add(log, &weak_record), "mf_classic_nonce_log_add() failed");
+    mu_assert(
+        mf_classic_nonce_log_get_count(log) == hard_record_num + 1,
+        "mf_classic_nonce_log_get_count() failed");
+    mf_classic_nonce_log_free(log);
+
+    mu_assert(
+        mf_classic_nonce_log_export(NFC_TEST_NONCE_LOG_BIN_PATH, NFC_TEST_NONCE_LOG_TEXT_PATH),
+        "mf_classic_nonce_log_export() failed");
+    Stream* stream = file_stream_alloc(storage);
+    FuriString* line = furi_string_alloc();
+    mu_assert(
+        file_stream_open(stream, NFC_TEST_NONCE_LOG_TEXT_PATH, FSAM_READ, FSOM_OPEN_EXISTING),
+        "file_stream_open() failed");
+
+    size_t line_num = 0;
+    while(stream_read_line(stream, line)) {
+        if(line_num == 0) {
+            mu_assert(
+                furi_string_equal_str(
+                    line, "Sec 5 key B cuid 04a1b2c3 nt0 01020304 ks0 deadbeef par0 1010\n"),
+                "First line mismatch");
+        } else if(line_num == hard_record_num) {
+            mu_assert(
+                furi_string_equal_str(
+                    line,
+                    "Sec 15 key A cuid 04a1b2c3 nt0 11223344 ks0 55667788 par0 0001 "
+                    "nt1 99aabbcc ks1 00000000 par1 1111 dist 160\n"),
+                "Last line mismatch");
+        }
+        line_num++;
+    }
+    mu_assert(line_num == hard_record_num + 1, "Wrong number of lines");
+    file_stream_close(stream);
+
+    // Next session starts a new binary log instead of appending to the old one
+    log = mf_classic_nonce_log_alloc(NFC_TEST_NONCE_LOG_BIN_PATH);
+    mu_assert(mf_classic_nonce_log_add(log, &weak_record), "mf_classic_nonce_log_add() failed");
+    mf_classic_nonce_log_free(log);
+
+    mu_assert(
+        storage_simply_remove(storage, NFC_TEST_NONCE_LOG_TEXT_PATH), "Remove text log failed");
+    mu_assert(
+        mf_classic_nonce_log_export(NFC_TEST_NONCE_LOG_BIN_PATH, NFC_TEST_NONCE_LOG_TEXT_PATH),
+        "mf_classic_nonce_log_export() failed");
+    mu_assert(
+        file_stream_open(stream, NFC_TEST_NONCE_LOG_TEXT_PATH, FSAM_READ, FSOM_OPEN_EXISTING),
+        "file_stream_open() failed");
+    line_num = 0;
+    while(stream_read_line(stream, line)) {
+        line_num++;
+    }
+    mu_assert(line_num == 1, "Binary log not restarted");
+
+    furi_string_free(line);
+    file_stream_close(stream);
+    stream_free(stream);
+
+    mu_assert(
+        storage_simply_remove(storage, NFC_TEST_NONCE_LOG_BIN_PATH), "Remove binary log failed");
+    mu_assert(
+        storage_simply_remove(storage, NFC_TEST_NONCE_LOG_TEXT_PATH), "Remove text log failed");
+    furi_record_close(RECORD_STORAGE);
+}
+
+static NfcCommand mf_classic_nested_dict_attack_callback(NfcGenericEvent event, void* context) {
+    furi_check(event.protocol == NfcProtocolMfClassic);
+
+    NfcTestMfClassicNestedContext* nested_context = context;
+    MfClassicPollerEvent* mfc_event = event.event_data;
+
+    NfcCommand command = NfcCommandContinue;
+    if(mfc_event->type == MfClassicPollerEventTypeRequestMode) {
+        mfc_event->data->poller_mode.mode = MfClassicPollerModeDictAttackEnhanced;
+        mfc_event->data->poller_mode.data = nested_context->data;
+    } else if(mfc_event->type == MfClassicPollerEventTypeRequestKey) {
+        // Only the default key, the last sector has to be found by the nested attack
+        MfClassicPollerEventDataKeyRequest* key_request = &mfc_event->data->key_request_data;
+        key_request->key_provided = !nested_context->key_requested;
+        memset(key_request->key.data, 0xff, sizeof(MfClassicKey));
+        nested_context->key_requested = true;
+    } else if(
+        mfc_event->type == MfClassicPollerEventTypeNextSector ||
+        mfc_event->type == MfClassicPollerEventTypeKeyAttackStop) {
+        nested_context->key_requested = false;
+    } else if(mfc_event->type == MfClassicPollerEventTypeDataUpdate) {
+        nested_context->nested_phases |= 1UL << mfc_event->data->data_update.nested_phase;
+    } else if(mfc_event->type == MfClassicPollerEventTypeSuccess) {
+        nested_context->success = true;
+        command = NfcCommandStop;
+    } else if(mfc_event->type == MfClassicPollerEventTypeFail) {
+        command = NfcCommandStop;
+    }
+
+    if(command == NfcCommandStop) {
+        furi_thread_flags_set(nested_context->thread_id, NFC_TEST_FLAG_WORKER_DONE);
+    }
+
+    return command;
+}
+
+MU_TEST(mf_classic_nested_dict_attack_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+
+    // Keep the user nested dictionary, the test replaces it with its own key
+    const MfClassicKey nested_key = {.data = {0x4e, 0x45, 0x53, 0x54, 0x45, 0x44}};
+    storage_simply_remove(storage, NFC_TEST_NESTED_USER_DICT_BACKUP_PATH);
+    bool user_dict_present =
+        storage_common_stat(storage, NFC_TEST_NESTED_USER_DICT_PATH, NULL) == FSE_OK;
+    if(user_dict_present) {
+        mu_assert(
+            storage_common_rename(
+                storage, NFC_TEST_NESTED_USER_DICT_PATH, NFC_TEST_NESTED_USER_DICT_BACKUP_PATH) ==
+                FSE_OK,
+            "User nested dict backup failed");
+    }
+    KeysDict* dict = keys_dict_alloc(
+        NFC_TEST_NESTED_USER_DICT_PATH, KeysDictModeOpenAlways, sizeof(MfClassicKey));
+    mu_assert(keys_dict_add_key(dict, nested_key.data, sizeof(MfClassicKey)), "add key failed");
+    keys_dict_free(dict);
+
+    // Default keys everywhere except the last sector
+    NfcDevice* nfc_device = nfc_device_alloc();
+    nfc_data_generator_fill_data(NfcDataGeneratorTypeMfClassicMini, nfc_device);
+    MfClassicData* card_data = mf_classic_alloc();
+    mf_classic_copy(card_data, nfc_device_get_data(nfc_device, NfcProtocolMfClassic));
+    const uint8_t sectors_num = mf_classic_get_total_sectors_num(card_data->type);
+    MfClassicSectorTrailer* sec_tr =
+        mf_classic_get_sector_trailer_by_sector(card_data, sectors_num - 1);
+    sec_tr->key_a = nested_key;
+    sec_tr->key_b = nested_key;
+    nfc_device_set_data(nfc_device, NfcProtocolMfClassic, card_data);
+
+    Nfc* poller = nfc_alloc();
+    Nfc* listener = nfc_alloc();
+    NfcListener* mfc_listener = nfc_listener_alloc(
+        listener, NfcProtocolMfClassic, nfc_device_get_data(nfc_device, NfcProtocolMfClassic));
+    nfc_listener_start(mfc_listener, NULL, NULL);
+
+    MfClassicData* mfc_data = mf_classic_alloc();
+    mfc_data->type = card_data->type;
+    NfcTestMfClassicNestedContext nested_context = {
+        .thread_id = furi_thread_get_current_id(),
+        .data = mfc_data,
+    };
+    NfcPoller* mfc_poller = nfc_poller_alloc(poller, NfcProtocolMfClassic);
+    nfc_poller_start(mfc_poller, mf_classic_nested_dict_attack_callback, &nested_context);
+    uint32_t flags = furi_thread_flags_wait(NFC_TEST_FLAG_WORKER_DONE, FuriFlagWaitAny, 60000);
+    nfc_poller_stop(mfc_poller);
+
+    uint8_t sectors_read = 0;
+    uint8_t keys_found = 0;
+    const MfClassicData* result = nfc_poller_get_data(mfc_poller);
+    mf_classic_get_read_sectors_and_keys(result, &sectors_read, &keys_found);
+    bool nested_key_found =
+        mf_classic_is_key_found(result, sectors_num - 1, MfClassicKeyTypeA) &&
+        memcmp(
+            mf_classic_get_sector_trailer_by_sector(result, sectors_num - 1)->key_a.data,
+            nested_key.data,
+            sizeof(MfClassicKey)) == 0;
+
+    nfc_poller_free(mfc_poller);
+    mf_classic_free(mfc_data);
+    nfc_listener_stop(mfc_listener);
+    nfc_listener_free(mfc_listener);
+    nfc_free(listener);
+    nfc_free(poller);
+    mf_classic_free(card_data);
+    nfc_device_free(nfc_device);
+
+    storage_simply_remove(storage, NFC_TEST_NESTED_USER_DICT_PATH);
+    if(user_dict_present) {
+        storage_common_rename(
+            storage, NFC_TEST_NESTED_USER_DICT_BACKUP_PATH, NFC_TEST_NESTED_USER_DICT_PATH);
+    }
+    furi_record_close(RECORD_STORAGE);
+
+    mu_assert(flags == NFC_TEST_FLAG_WORKER_DONE, "Poller timed out");
+    mu_assert(nested_context.success, "Nested dict attack failed");
+    mu_assert(
+        nested_context.nested_phases & (1UL << MfClassicNestedPhaseDictAttack),
+        "Nested dict attack phase not reached");
+    mu_assert(
+        nested_context.nested_phases & (1UL << MfClassicNestedPhaseDictAttackVerify),
+        "Key candidate not verified");
+    mu_assert(nested_key_found, "Nested key not found");
+    mu_assert(keys_found == sectors_num * 2, "Not all keys found");
+    mu_assert(sectors_read == sectors_num, "Not all sectors read");
+}
+
 static FelicaError
     felica_do_request_response(FelicaData* felica_data, const FelicaCardKey* card_key) {
     NfcDeviceData* nfc_device = nfc_device_alloc();
@@ -823,6 +1069,149 @@ MU_TEST(slix_set_password_access_all_passwords_cap) {
         EXT_PATH("unit_tests/nfc/Slix_cap_accept_all_pass.nfc"), 0x12341234, false);
 }
 
+static void nfc_test_scanner_callback(NfcScannerEvent event, void* context) {
+    NfcTestScannerContext* scanner_context = context;
+
+    // Scanner keeps reporting until stopped, take the first result only
+    if(event.type == NfcScannerEventTypeDetected && scanner_context->protocol_num == 0) {
+        scanner_context->protocol_num = event.data.protocol_num;
+        memcpy(
+            scanner_context->protocols,
+            event.data.protocols,
+            event.data.protocol_num * sizeof(NfcProtocol));
+        furi_thread_flags_set(scanner_context->thread_id, NFC_TEST_FLAG_WORKER_DONE);
+    }
+}
+
+static NfcCommand nfc_test_scanner_iso14443_4a_listener_callback(
+    NfcGenericEvent event,
+    void* context) {
+    NfcTestScannerContext* scanner_context = context;
+    Iso14443_4aListenerEvent* iso14443_4a_event = event.event_data;
+
+    // Card does not answer, so every APDU is a probe of some child protocol
+    if(iso14443_4a_event->type == Iso14443_4aListenerEventTypeReceivedData) {
+        scanner_context->apdu_num++;
+    }
+
+    return NfcCommandContinue;
+}
+
+static void nfc_scanner_test_device(
+    NfcDevice* nfc_device,
+    NfcProtocol listener_protocol,
+    NfcGenericCallback listener_callback,
+    NfcTestScannerContext* scanner_context) {
+    Nfc* poller = nfc_alloc();
+    Nfc* listener = nfc_alloc();
+
+    NfcListener* nfc_listener = nfc_listener_alloc(
+        listener, listener_protocol, nfc_device_get_data(nfc_device, listener_protocol));
+    nfc_listener_start(nfc_listener, listener_callback, scanner_context);
+
+    scanner_context->thread_id = furi_thread_get_current_id();
+    NfcScanner* scanner = nfc_scanner_alloc(poller);
+
+    uint32_t tick = furi_get_tick();
+    nfc_scanner_start(scanner, nfc_test_scanner_callback, scanner_context);
+    uint32_t flags = furi_thread_flags_wait(NFC_TEST_FLAG_WORKER_DONE, FuriFlagWaitAny, 10000);
+    uint32_t time_to_detect = furi_get_tick() - tick;
+
+    nfc_scanner_stop(scanner);
+    nfc_scanner_free(scanner);
+
+    nfc_listener_stop(nfc_listener);
+    nfc_listener_free(nfc_listener);
+    nfc_free(listener);
+    nfc_free(poller);
+
+    if(flags == NFC_TEST_FLAG_WORKER_DONE) {
+        FURI_LOG_I(
+            TAG,
+            "%s: detected in %lu ms",
+            nfc_device_get_name(nfc_device, NfcDeviceNameTypeFull),
+            time_to_detect);
+    } else {
+        scanner_context->protocol_num = 0;
+    }
+}
+
+static void nfc_scanner_test(NfcDataGeneratorType type, NfcProtocol protocol) {
+    NfcDevice* nfc_device = nfc_device_alloc();
+    nfc_data_generator_fill_data(type, nfc_device);
+
+    NfcTestScannerContext scanner_context = {};
+    nfc_scanner_test_device(nfc_device, protocol, NULL, &scanner_context);
+    nfc_device_free(nfc_device);
+
+    mu_assert(scanner_context.protocol_num == 1, "Wrong number of detected protocols");
+    mu_assert(scanner_context.protocols[0] == protocol, "Wrong protocol detected");
+}
+
+MU_TEST(nfc_scanner_mf_ultralight_test) {
+    nfc_scanner_test(NfcDataGeneratorTypeNTAG215, NfcProtocolMfUltralight);
+}
+
+MU_TEST(nfc_scanner_mf_classic_test) {
+    nfc_scanner_test(NfcDataGeneratorTypeMfClassic1k_7b, NfcProtocolMfClassic);
+}
+
+MU_TEST(nfc_scanner_shared_session_test) {
+    // DESFire and MIFARE Plus are probed on one ISO14443-4A activation. The card ignores
+    // DESFire commands and is recognized as MIFARE Plus S SL3 by its ATS.
+    NfcDevice* nfc_device = nfc_device_alloc();
+    mu_assert(
+        nfc_device_load(nfc_device, EXT_PATH("unit_tests/nfc/MfPlus_S_2K_SL3.nfc")),
+        "nfc_device_load() failed\r\n");
+
+    NfcTestScannerContext scanner_context = {};
+    nfc_scanner_test_device(
+        nfc_device,
+        NfcProtocolIso14443_4a,
+        nfc_test_scanner_iso14443_4a_listener_callback,
+        &scanner_context);
+    nfc_device_free(nfc_device);
+
+    mu_assert(scanner_context.protocol_num == 1, "Wrong number of detected protocols");
+    mu_assert(scanner_context.protocols[0] == NfcProtocolMfPlus, "Wrong protocol detected");
+    // DESFire GetKeyVersion and MIFARE Plus GetVersion at least
+    mu_assert(scanner_context.apdu_num >= 2, "Not all children were probed");
+}
+
+MU_TEST(nfc_poller_detect_children_test) {
+    Nfc* poller = nfc_alloc();
+    Nfc* listener = nfc_alloc();
+
+    NfcDevice* nfc_device = nfc_device_alloc();
+    mu_assert(
+        nfc_device_load(nfc_device, EXT_PATH("unit_tests/nfc/MfPlus_S_2K_SL3.nfc")),
+        "nfc_device_load() failed\r\n");
+    NfcListener* nfc_listener = nfc_listener_alloc(
+        listener,
+        NfcProtocolIso14443_4a,
+        nfc_device_get_data(nfc_device, NfcProtocolIso14443_4a));
+    NfcTestScannerContext scanner_context = {};
+    nfc_listener_start(
+        nfc_listener, nfc_test_scanner_iso14443_4a_listener_callback, &scanner_context);
+
+    // Single activation for both children
+    const NfcProtocol children[] = {NfcProtocolMfDesfire, NfcProtocolMfPlus};
+    bool detected[COUNT_OF(children)];
+    NfcPoller* nfc_poller = nfc_poller_alloc(poller, NfcProtocolIso14443_4a);
+    nfc_poller_detect_children(nfc_poller, children, detected, COUNT_OF(children));
+    nfc_poller_free(nfc_poller);
+
+    nfc_listener_stop(nfc_listener);
+    nfc_listener_free(nfc_listener);
+    nfc_device_free(nfc_device);
+    nfc_free(listener);
+    nfc_free(poller);
+
+    mu_assert(!detected[0], "DESFire must not be detected");
+    mu_assert(detected[1], "MIFARE Plus not detected after failed DESFire probe");
+    mu_assert(scanner_context.apdu_num >= 2, "Not all children were probed");
+}
+
 MU_TEST_SUITE(nfc) {
     nfc_test_alloc();
 
@@ -864,6 +1253,8 @@ MU_TEST_SUITE(nfc) {
     MU_RUN_TEST(mf_classic_value_block);
     MU_RUN_TEST(mf_classic_send_frame_test);
     MU_RUN_TEST(mf_classic_dict_test);
+    MU_RUN_TEST(mf_classic_nonce_log_test);
+    MU_RUN_TEST(mf_classic_nested_dict_attack_test);
     MU_RUN_TEST(felica_read);
     MU_RUN_TEST(felica_read_auth);
 
@@ -872,6 +1263,11 @@ MU_TEST_SUITE(nfc) {
     MU_RUN_TEST(slix_set_password_default_cap_incorrect_pass);
     MU_RUN_TEST(slix_set_password_access_all_passwords_cap);
 
+    MU_RUN_TEST(nfc_scanner_mf_ultralight_test);
+    MU_RUN_TEST(nfc_scanner_mf_classic_test);
+    MU_RUN_TEST(nfc_scanner_shared_session_test);
+    MU_RUN_TEST(nfc_poller_detect_children_test);
+
     nfc_test_free();
 }
 
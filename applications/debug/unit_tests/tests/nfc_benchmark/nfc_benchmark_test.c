@@ -0,0 +1,530 @@
+#include <furi.h>
+#include <furi_hal.h>
+#include <storage/storage.h>
+#include <toolbox/stream/file_stream.h>
+#include <bit_lib/bit_lib.h>
+
+#include <nfc/nfc.h>
+#include <nfc/nfc_mock.h>
+#include <nfc/nfc_device.h>
+#include <nfc/nfc_poller.h>
+#include <nfc/nfc_listener.h>
+#include <nfc/helpers/nfc_data_generator.h>
+#include <nfc/protocols/mf_ultralight/mf_ultralight_poller_sync.h>
+#include <nfc/protocols/mf_classic/mf_classic_poller.h>
+#include <nfc/protocols/mf_classic/mf_classic_nonce_solver.h>
+#include <nfc/helpers/crypto1.h>
+#include <nfc/helpers/nfc_util.h>
+#include <nfc/helpers/iso14443_crc.h>
+#include <nfc/protocols/iso14443_4a/iso14443_4a_poller.h>
+#include <nfc/protocols/iso14443_4a/iso14443_4a_listener.h>
+#include <nfc/protocols/felica/felica_poller_sync.h>
+#include <nfc/protocols/slix/slix_poller.h>
+
+#include "../test.h" // IWYU pragma: keep
+
+#define TAG "NfcBenchmark"
+
+#define NFC_BENCHMARK_FLAG_WORKER_DONE (1)
+
+// Wrong keys tried before the right one, each costs a response timeout
+#define NFC_BENCHMARK_MF_CLASSIC_DICT_WRONG_KEYS (3)
+
+#define NFC_BENCHMARK_ISO14443_4A_APDU_NUM  (100)
+#define NFC_BENCHMARK_ISO14443_4A_APDU_SIZE (16)
+
+#define NFC_BENCHMARK_NONCE_SOLVER_DICT_PATH      EXT_PATH("unit_tests/mf_nonce_dict.nfc")
+#define NFC_BENCHMARK_NONCE_SOLVER_USER_DICT_PATH EXT_PATH("unit_tests/mf_nonce_user_dict.nfc")
+#define NFC_BENCHMARK_NONCE_SOLVER_DICT_KEYS      (2000)
+#define NFC_BENCHMARK_NONCE_SOLVER_TIMEOUT        (60000)
+
+typedef struct {
+    const char* name;
+    uint32_t start_tick;
+    size_t heap_free;
+} NfcBenchmark;
+
+typedef struct {
+    FuriThreadId thread_id;
+    bool success;
+} NfcBenchmarkSlixContext;
+
+typedef struct {
+    FuriThreadId thread_id;
+    const MfClassicKey* dict;
+    size_t dict_size;
+    size_t dict_idx;
+    const MfClassicData* data;
+    bool success;
+} NfcBenchmarkMfClassicContext;
+
+typedef struct {
+    Nfc* nfc;
+    BitBuffer* tx_buffer;
+} NfcBenchmarkIso14443_4aListenerContext;
+
+typedef struct {
+    FuriThreadId thread_id;
+    size_t apdu_num;
+    bool success;
+} NfcBenchmarkIso14443_4aPollerContext;
+
+static void nfc_benchmark_setup(void) {
+    // Logging every frame takes more time than the transaction itself
+    nfc_mock_set_frame_log(false);
+}
+
+static void nfc_benchmark_teardown(void) {
+    nfc_mock_set_frame_log(true);
+}
+
+static void nfc_benchmark_start(NfcBenchmark* benchmark, const char* name) {
+    benchmark->name = name;
+    benchmark->heap_free = memmgr_get_free_heap();
+    nfc_mock_stats_reset();
+    benchmark->start_tick = furi_get_tick();
+}
+
+static void nfc_benchmark_report(NfcBenchmark* benchmark) {
+    uint32_t elapsed_ms = furi_get_tick() - benchmark->start_tick;
+
+    NfcMockStats stats = {};
+    nfc_mock_stats_get(&stats);
+    mu_assert(stats.transactions > 0, "No transactions");
+
+    uint32_t tps = (uint64_t)stats.transactions * 1000 / MAX(elapsed_ms, 1U);
+    uint32_t bytes_x100 = (stats.tx_bytes + stats.rx_bytes) * 100 / stats.transactions;
+    uint32_t cpu_us = (stats.poller_cycles + stats.listener_cycles) / stats.transactions /
+                      furi_hal_cortex_instructions_per_microsecond();
+    size_t heap_peak = benchmark->heap_free > stats.heap_free_min ?
+                           benchmark->heap_free - stats.heap_free_min :
+                           0;
+
+    FURI_LOG_I(
+        TAG,
+        "%s: %lu frames (%lu timeouts) in %lu ms, %lu tx/s, %lu.%02lu B/tx",
+        benchmark->name,
+        stats.transactions,
+        stats.timeouts,
+        elapsed_ms,
+        tps,
+        bytes_x100 / 100,
+        bytes_x100 % 100);
+    FURI_LOG_I(TAG, "%s: heap peak %zu B, %lu us CPU/frame", benchmark->name, heap_peak, cpu_us);
+}
+
+MU_TEST(nfc_benchmark_mf_ultralight_read) {
+    Nfc* poller = nfc_alloc();
+    Nfc* listener = nfc_alloc();
+
+    NfcDevice* nfc_device = nfc_device_alloc();
+    mu_assert(
+        nfc_device_load(nfc_device, EXT_PATH("unit_tests/nfc/Ntag215.nfc")),
+        "nfc_device_load() failed");
+    NfcListener* mfu_listener = nfc_listener_alloc(
+        listener,
+        NfcProtocolMfUltralight,
+        nfc_device_get_data(nfc_device, NfcProtocolMfUltralight));
+    nfc_listener_start(mfu_listener, NULL, NULL);
+
+    MfUltralightData* mfu_data = mf_ultralight_alloc();
+
+    NfcBenchmark benchmark;
+    nfc_benchmark_start(&benchmark, "MfUltralight read");
+    MfUltralightError error = mf_ultralight_poller_sync_read_card(poller, mfu_data, NULL);
+    nfc_benchmark_report(&benchmark);
+
+    mf_ultralight_free(mfu_data);
+    nfc_listener_stop(mfu_listener);
+    nfc_listener_free(mfu_listener);
+    nfc_device_free(nfc_device);
+    nfc_free(listener);
+    nfc_free(poller);
+
+    mu_assert(error == MfUltralightErrorNone, "mf_ultralight_poller_sync_read_card() failed");
+}
+
+static NfcCommand nfc_benchmark_mf_classic_callback(NfcGenericEvent event, void* context) {
+    furi_check(event.protocol == NfcProtocolMfClassic);
+
+    NfcBenchmarkMfClassicContext* mfc_context = context;
+    MfClassicPollerEvent* mfc_event = event.event_data;
+
+    NfcCommand command = NfcCommandContinue;
+    if(mfc_event->type == MfClassicPollerEventTypeRequestMode) {
+        mfc_event->data->poller_mode.mode = MfClassicPollerModeDictAttackStandard;
+        mfc_event->data->poller_mode.data = mfc_context->data;
+    } else if(mfc_event->type == MfClassicPollerEventTypeRequestKey) {
+        MfClassicPollerEventDataKeyRequest* key_request = &mfc_event->data->key_request_data;
+        key_request->key_provided = mfc_context->dict_idx < mfc_context->dict_size;
+        if(key_request->key_provided) {
+            key_request->key = mfc_context->dict[mfc_context->dict_idx++];
+        }
+    } else if(
+        mfc_event->type == MfClassicPollerEventTypeNextSector ||
+        mfc_event->type == MfClassicPollerEventTypeKeyAttackStop) {
+        mfc_context->dict_idx = 0;
+    } else if(mfc_event->type == MfClassicPollerEventTypeSuccess) {
+        mfc_context->success = true;
+        command = NfcCommandStop;
+    } else if(mfc_event->type == MfClassicPollerEventTypeFail) {
+        command = NfcCommandStop;
+    }
+
+    if(command == NfcCommandStop) {
+        furi_thread_flags_set(mfc_context->thread_id, NFC_BENCHMARK_FLAG_WORKER_DONE);
+    }
+
+    return command;
+}
+
+MU_TEST(nfc_benchmark_mf_classic_dict_attack) {
+    Nfc* poller = nfc_alloc();
+    Nfc* listener = nfc_alloc();
+
+    NfcDevice* nfc_device = nfc_device_alloc();
+    nfc_data_generator_fill_data(NfcDataGeneratorTypeMfClassic1k_7b, nfc_device);
+    NfcListener* mfc_listener = nfc_listener_alloc(
+        listener, NfcProtocolMfClassic, nfc_device_get_data(nfc_device, NfcProtocolMfClassic));
+    nfc_listener_start(mfc_listener, NULL, NULL);
+
+    // Generated card uses default keys, put them at the end of dictionary
+    MfClassicKey dict[NFC_BENCHMARK_MF_CLASSIC_DICT_WRONG_KEYS + 1];
+    furi_hal_random_fill_buf((uint8_t*)dict, sizeof(dict));
+    memset(dict[COUNT_OF(dict) - 1].data, 0xff, sizeof(MfClassicKey));
+
+    // Attack starts from a blank 1K, the poller fills it in
+    MfClassicData* mfc_data = mf_classic_alloc();
+    mfc_data->type = MfClassicType1k;
+    NfcBenchmarkMfClassicContext mfc_context = {
+        .thread_id = furi_thread_get_current_id(),
+        .dict = dict,
+        .dict_size = COUNT_OF(dict),
+        .data = mfc_data,
+    };
+
+    NfcPoller* mfc_poller = nfc_poller_alloc(poller, NfcProtocolMfClassic);
+
+    NfcBenchmark benchmark;
+    nfc_benchmark_start(&benchmark, "MfClassic dict attack");
+    nfc_poller_start(mfc_poller, nfc_benchmark_mf_classic_callback, &mfc_context);
+    uint32_t flags =
+        furi_thread_flags_wait(NFC_BENCHMARK_FLAG_WORKER_DONE, FuriFlagWaitAny, 60000);
+    nfc_poller_stop(mfc_poller);
+    nfc_benchmark_report(&benchmark);
+
+    uint8_t sectors_read = 0;
+    uint8_t keys_found = 0;
+    mf_classic_get_read_sectors_and_keys(
+        nfc_poller_get_data(mfc_poller), &sectors_read, &keys_found);
+    const uint8_t sectors_num = mf_classic_get_total_sectors_num(MfClassicType1k);
+
+    nfc_poller_free(mfc_poller);
+    mf_classic_free(mfc_data);
+    nfc_listener_stop(mfc_listener);
+    nfc_listener_free(mfc_listener);
+    nfc_device_free(nfc_device);
+    nfc_free(listener);
+    nfc_free(poller);
+
+    mu_assert(flags == NFC_BENCHMARK_FLAG_WORKER_DONE, "Poller timed out");
+    mu_assert(mfc_context.success, "Dict attack failed");
+    mu_assert(keys_found == sectors_num * 2, "Not all keys found");
+    mu_assert(sectors_read == sectors_num, "Not all sectors read");
+}
+
+static void nfc_benchmark_nonce_encrypt(
+    const MfClassicKey* key,
+    uint32_t cuid,
+    uint32_t nt,
+    MfClassicNonceSolverNonce* nonce) {
+    Crypto1 crypto;
+    crypto1_init(&crypto, bit_lib_bytes_to_num_be(key->data, sizeof(MfClassicKey)));
+    uint32_t ks = crypto1_word(&crypto, nt ^ cuid, 0);
+
+    nonce->cuid = cuid;
+    nonce->nt_enc = nt ^ ks;
+    nonce->par = ((nfc_util_even_parity8(nt >> 24) ^ FURI_BIT(ks, 16)) << 3) |
+                 ((nfc_util_even_parity8(nt >> 16) ^ FURI_BIT(ks, 8)) << 2) |
+                 ((nfc_util_even_parity8(nt >> 8) ^ FURI_BIT(ks, 0)) << 1);
+}
+
+MU_TEST(nfc_benchmark_mf_classic_nonce_solver) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_remove(storage, NFC_BENCHMARK_NONCE_SOLVER_USER_DICT_PATH);
+
+    // Key of the recorded nonces is the last one in dictionary, so every key is checked
+    MfClassicKey key = {};
+    Stream* stream = file_stream_alloc(storage);
+    mu_assert(
+        file_stream_open(
+            stream, NFC_BENCHMARK_NONCE_SOLVER_DICT_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS),
+        "file_stream_open() failed");
+    for(size_t i = 0; i < NFC_BENCHMARK_NONCE_SOLVER_DICT_KEYS; i++) {
+        furi_hal_random_fill_buf(key.data, sizeof(MfClassicKey));
+        for(size_t j = 0; j < sizeof(MfClassicKey); j++) {
+            stream_write_format(stream, "%02X", key.data[j]);
+        }
+        stream_write_cstring(stream, "\n");
+    }
+    file_stream_close(stream);
+    stream_free(stream);
+
+    MfClassicNonceSolverJob job = {
+        .sector = 1,
+        .key_type = MfClassicKeyTypeB,
+        .is_weak = false,
+        .nonce_count = MF_CLASSIC_NONCE_SOLVER_NONCES_MAX,
+    };
+    uint32_t cuid = furi_hal_random_get();
+    for(size_t i = 0; i < job.nonce_count; i++) {
+        uint32_t nt = furi_hal_random_get();
+        nfc_benchmark_nonce_encrypt(&key, cuid, nt, &job.nonces[i]);
+        mu_assert(
+            crypto1_decrypt_nt_enc(cuid, job.nonces[i].nt_enc, key) == nt,
+            "Nonce encryption failed");
+    }
+
+    MfClassicNonceSolver* solver = mf_classic_nonce_solver_alloc(
+        NFC_BENCHMARK_NONCE_SOLVER_DICT_PATH, NFC_BENCHMARK_NONCE_SOLVER_USER_DICT_PATH);
+
+    uint32_t start_tick = furi_get_tick();
+    mf_classic_nonce_solver_submit(solver, &job);
+
+    MfClassicNonceSolverResult result = {};
+    bool key_found = false;
+    while(
+        mf_classic_nonce_solver_get_result(solver, &result, NFC_BENCHMARK_NONCE_SOLVER_TIMEOUT)) {
+        if(memcmp(result.key.data, key.data, sizeof(MfClassicKey)) == 0) {
+            key_found = true;
+            break;
+        }
+    }
+    uint32_t elapsed_ms = furi_get_tick() - start_tick;
+
+    MfClassicNonceSolverProgress progress = {};
+    mf_classic_nonce_solver_get_progress(solver, &progress);
+    mf_classic_nonce_solver_free(solver);
+
+    FURI_LOG_I(
+        TAG,
+        "MfClassic nonce solver: %zu keys x %zu nonces in %lu ms, %lu keys/s",
+        progress.keys_total,
+        job.nonce_count,
+        elapsed_ms,
+        progress.keys_per_second);
+
+    storage_simply_remove(storage, NFC_BENCHMARK_NONCE_SOLVER_DICT_PATH);
+    furi_record_close(RECORD_STORAGE);
+
+    mu_assert(key_found, "Key not found");
+    mu_assert(result.sector == job.sector, "Wrong sector");
+    mu_assert(result.key_type == job.key_type, "Wrong key type");
+}
+
+MU_TEST(nfc_benchmark_felica_read) {
+    Nfc* poller = nfc_alloc();
+    Nfc* listener = nfc_alloc();
+
+    NfcDevice* nfc_device = nfc_device_alloc();
+    mu_assert(
+        nfc_device_load(nfc_device, EXT_PATH("unit_tests/nfc/Felica.nfc")),
+        "nfc_device_load() failed");
+    NfcListener* felica_listener = nfc_listener_alloc(
+        listener, NfcProtocolFelica, nfc_device_get_data(nfc_device, NfcProtocolFelica));
+    nfc_listener_start(felica_listener, NULL, NULL);
+
+    FelicaData* felica_data = felica_alloc();
+
+    NfcBenchmark benchmark;
+    nfc_benchmark_start(&benchmark, "Felica read");
+    FelicaError error = felica_poller_sync_read(poller, felica_data, NULL);
+    nfc_benchmark_report(&benchmark);
+
+    felica_free(felica_data);
+    nfc_listener_stop(felica_listener);
+    nfc_listener_free(felica_listener);
+    nfc_device_free(nfc_device);
+    nfc_free(listener);
+    nfc_free(poller);
+
+    mu_assert(error == FelicaErrorNone, "felica_poller_sync_read() failed");
+}
+
+static NfcCommand nfc_benchmark_slix_callback(NfcGenericEvent event, void* context) {
+    furi_check(event.protocol == NfcProtocolSlix);
+
+    NfcBenchmarkSlixContext* slix_context = context;
+    const SlixPollerEvent* slix_event = event.event_data;
+
+    NfcCommand command = NfcCommandContinue;
+    if(slix_event->type == SlixPollerEventTypeReady) {
+        slix_context->success = true;
+        command = NfcCommandStop;
+    } else if(slix_event->type == SlixPollerEventTypeError) {
+        command = NfcCommandStop;
+    } else if(slix_event->type == SlixPollerEventTypePrivacyUnlockRequest) {
+        slix_event->data->privacy_password.password_set = false;
+    }
+
+    if(command == NfcCommandStop) {
+        furi_thread_flags_set(slix_context->thread_id, NFC_BENCHMARK_FLAG_WORKER_DONE);
+    }
+
+    return command;
+}
+
+MU_TEST(nfc_benchmark_iso15693_read) {
+    Nfc* poller = nfc_alloc();
+    Nfc* listener = nfc_alloc();
+
+    NfcDevice* nfc_device = nfc_device_alloc();
+    mu_assert(
+        nfc_device_load(nfc_device, EXT_PATH("unit_tests/nfc/Slix_cap_default.nfc")),
+        "nfc_device_load() failed");
+    NfcListener* slix_listener = nfc_listener_alloc(
+        listener, NfcProtocolSlix, nfc_device_get_data(nfc_device, NfcProtocolSlix));
+    nfc_listener_start(slix_listener, NULL, NULL);
+
+    NfcPoller* slix_poller = nfc_poller_alloc(poller, NfcProtocolSlix);
+    NfcBenchmarkSlixContext slix_context = {.thread_id = furi_thread_get_current_id()};
+
+    NfcBenchmark benchmark;
+    nfc_benchmark_start(&benchmark, "Iso15693 read");
+    nfc_poller_start(slix_poller, nfc_benchmark_slix_callback, &slix_context);
+    uint32_t flags =
+        furi_thread_flags_wait(NFC_BENCHMARK_FLAG_WORKER_DONE, FuriFlagWaitAny, 10000);
+    nfc_poller_stop(slix_poller);
+    nfc_benchmark_report(&benchmark);
+
+    nfc_poller_free(slix_poller);
+    nfc_listener_stop(slix_listener);
+    nfc_listener_free(slix_listener);
+    nfc_device_free(nfc_device);
+    nfc_free(listener);
+    nfc_free(poller);
+
+    mu_assert(flags == NFC_BENCHMARK_FLAG_WORKER_DONE, "Poller timed out");
+    mu_assert(slix_context.success, "Slix read failed");
+}
+
+static NfcCommand
+    nfc_benchmark_iso14443_4a_listener_callback(NfcGenericEvent event, void* context) {
+    furi_check(event.protocol == NfcProtocolIso14443_4a);
+
+    NfcBenchmarkIso14443_4aListenerContext* listener_context = context;
+    const Iso14443_4aListenerEvent* iso14443_4a_event = event.event_data;
+
+    // Echo the block back, the poller side block layer accepts its own PCB
+    if(iso14443_4a_event->type == Iso14443_4aListenerEventTypeReceivedData) {
+        bit_buffer_copy(listener_context->tx_buffer, iso14443_4a_event->data->buffer);
+        iso14443_crc_append(Iso14443CrcTypeA, listener_context->tx_buffer);
+        nfc_listener_tx(listener_context->nfc, listener_context->tx_buffer);
+    }
+
+    return NfcCommandContinue;
+}
+
+static NfcCommand nfc_benchmark_iso14443_4a_poller_callback(NfcGenericEvent event, void* context) {
+    furi_check(event.protocol == NfcProtocolIso14443_4a);
+
+    NfcBenchmarkIso14443_4aPollerContext* poller_context = context;
+    const Iso14443_4aPollerEvent* iso14443_4a_event = event.event_data;
+
+    if(iso14443_4a_event->type == Iso14443_4aPollerEventTypeReady) {
+        BitBuffer* tx_buffer = bit_buffer_alloc(NFC_BENCHMARK_ISO14443_4A_APDU_SIZE);
+        BitBuffer* rx_buffer = bit_buffer_alloc(NFC_BENCHMARK_ISO14443_4A_APDU_SIZE);
+
+        poller_context->success = true;
+        for(size_t i = 0; i < NFC_BENCHMARK_ISO14443_4A_APDU_NUM; i++) {
+            bit_buffer_reset(tx_buffer);
+            for(size_t j = 0; j < NFC_BENCHMARK_ISO14443_4A_APDU_SIZE; j++) {
+                bit_buffer_append_byte(tx_buffer, i + j);
+            }
+            Iso14443_4aError error =
+                iso14443_4a_poller_send_block(event.instance, tx_buffer, rx_buffer);
+            if(error != Iso14443_4aErrorNone ||
+               bit_buffer_get_size_bytes(rx_buffer) != NFC_BENCHMARK_ISO14443_4A_APDU_SIZE ||
+               memcmp(
+                   bit_buffer_get_data(rx_buffer),
+                   bit_buffer_get_data(tx_buffer),
+                   NFC_BENCHMARK_ISO14443_4A_APDU_SIZE) != 0) {
+                poller_context->success = false;
+                break;
+            }
+            poller_context->apdu_num++;
+        }
+
+        bit_buffer_free(rx_buffer);
+        bit_buffer_free(tx_buffer);
+    }
+
+    furi_thread_flags_set(poller_context->thread_id, NFC_BENCHMARK_FLAG_WORKER_DONE);
+
+    return NfcCommandStop;
+}
+
+MU_TEST(nfc_benchmark_iso14443_4a_exchange) {
+    Nfc* poller = nfc_alloc();
+    Nfc* listener = nfc_alloc();
+
+    NfcDevice* nfc_device = nfc_device_alloc();
+    mu_assert(
+        nfc_device_load(nfc_device, EXT_PATH("unit_tests/nfc/MfPlus_S_2K_SL3.nfc")),
+        "nfc_device_load() failed");
+    NfcListener* iso14443_4a_listener = nfc_listener_alloc(
+        listener,
+        NfcProtocolIso14443_4a,
+        nfc_device_get_data(nfc_device, NfcProtocolIso14443_4a));
+    NfcBenchmarkIso14443_4aListenerContext listener_context = {
+        .nfc = listener,
+        .tx_buffer = bit_buffer_alloc(NFC_BENCHMARK_ISO14443_4A_APDU_SIZE + 3),
+    };
+    nfc_listener_start(
+        iso14443_4a_listener, nfc_benchmark_iso14443_4a_listener_callback, &listener_context);
+
+    NfcPoller* iso14443_4a_poller = nfc_poller_alloc(poller, NfcProtocolIso14443_4a);
+    NfcBenchmarkIso14443_4aPollerContext poller_context = {
+        .thread_id = furi_thread_get_current_id(),
+    };
+
+    NfcBenchmark benchmark;
+    nfc_benchmark_start(&benchmark, "Iso14443_4a exchange");
+    nfc_poller_start(
+        iso14443_4a_poller, nfc_benchmark_iso14443_4a_poller_callback, &poller_context);
+    uint32_t flags =
+        furi_thread_flags_wait(NFC_BENCHMARK_FLAG_WORKER_DONE, FuriFlagWaitAny, 10000);
+    nfc_poller_stop(iso14443_4a_poller);
+    nfc_benchmark_report(&benchmark);
+
+    nfc_poller_free(iso14443_4a_poller);
+    nfc_listener_stop(iso14443_4a_listener);
+    nfc_listener_free(iso14443_4a_listener);
+    bit_buffer_free(listener_context.tx_buffer);
+    nfc_device_free(nfc_device);
+    nfc_free(listener);
+    nfc_free(poller);
+
+    mu_assert(flags == NFC_BENCHMARK_FLAG_WORKER_DONE, "Poller timed out");
+    mu_assert(poller_context.success, "Block exchange failed");
+    mu_assert(
+        poller_context.apdu_num == NFC_BENCHMARK_ISO14443_4A_APDU_NUM, "Not all blocks sent");
+}
+
+MU_TEST_SUITE(nfc_benchmark) {
+    MU_SUITE_CONFIGURE(&nfc_benchmark_setup, &nfc_benchmark_teardown);
+
+    MU_RUN_TEST(nfc_benchmark_mf_ultralight_read);
+    MU_RUN_TEST(nfc_benchmark_mf_classic_dict_attack);
+    MU_RUN_TEST(nfc_benchmark_mf_classic_nonce_solver);
+    MU_RUN_TEST(nfc_benchmark_iso14443_4a_exchange);
+    MU_RUN_TEST(nfc_benchmark_felica_read);
+    MU_RUN_TEST(nfc_benchmark_iso15693_read);
+}
+
+int run_minunit_test_nfc_benchmark(void) {
+    MU_RUN_SUITE(nfc_benchmark);
+    return MU_EXIT_CODE;
+}
+
+TEST_API_DEFINE(run_minunit_test_nfc_benchmark)
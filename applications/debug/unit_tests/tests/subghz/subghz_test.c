@@ -5,8 +5,10 @@
 #include <lib/subghz/transmitter.h>
 #include <lib/subghz/subghz_keystore.h>
 #include <lib/subghz/subghz_file_encoder_worker.h>
+#include <lib/subghz/subghz_raw_codec.h>
 #include <lib/subghz/protocols/protocol_items.h>
 #include <flipper_format/flipper_format_i.h>
+#include <toolbox/stream/file_stream.h>
 #include <lib/subghz/devices/devices.h>
 #include <lib/subghz/devices/cc1101_configs.h>
 
@@ -17,7 +19,10 @@
 #define NICE_FLOR_S_DIR_NAME    EXT_PATH("subghz/assets/nice_flor_s")
 #define ALUTECH_AT_4N_DIR_NAME  EXT_PATH("subghz/assets/alutech_at_4n")
 #define TEST_RANDOM_DIR_NAME    EXT_PATH("unit_tests/subghz/test_random_raw.sub")
+#define TEST_RANDOM_CONVERTED   EXT_PATH("unit_tests/subghz/test_random_raw_converted.sub")
 #define TEST_RANDOM_COUNT_PARSE 329
+#define TEST_RAW_BLOCK_NAME     EXT_PATH("unit_tests/subghz/raw_block.tmp")
+#define TEST_RAW_TRUNCATED_NAME EXT_PATH("unit_tests/subghz/raw_truncated.tmp")
 #define TEST_TIMEOUT            10000
 
 static SubGhzEnvironment* environment_handler;
@@ -839,6 +844,120 @@ MU_TEST(subghz_random_test) {
     mu_assert(subghz_decode_random_test(TEST_RANDOM_DIR_NAME), "Random test error\r\n");
 }
 
+static bool subghz_raw_codec_test(SubGhzRawEncoding encoding) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    bool result = false;
+
+    do {
+        if(!subghz_raw_convert(storage, TEST_RANDOM_DIR_NAME, TEST_RANDOM_CONVERTED, encoding)) {
+            break;
+        }
+
+        FileInfo original;
+        FileInfo converted;
+        if(storage_common_stat(storage, TEST_RANDOM_DIR_NAME, &original) != FSE_OK ||
+           storage_common_stat(storage, TEST_RANDOM_CONVERTED, &converted) != FSE_OK) {
+            break;
+        }
+        FURI_LOG_I(TAG, "RAW size %llu -> %llu", original.size, converted.size);
+        if(encoding != SubGhzRawEncodingText && converted.size >= original.size) break;
+
+        result = subghz_decode_random_test(TEST_RANDOM_CONVERTED);
+    } while(false);
+
+    storage_simply_remove(storage, TEST_RANDOM_CONVERTED);
+    furi_record_close(RECORD_STORAGE);
+
+    return result;
+}
+
+MU_TEST(subghz_raw_codec_varint_test) {
+    mu_assert(subghz_raw_codec_test(SubGhzRawEncodingVarint), "RAW varint codec error\r\n");
+}
+
+MU_TEST(subghz_raw_codec_heatshrink_test) {
+    mu_assert(
+        subghz_raw_codec_test(SubGhzRawEncodingHeatshrink), "RAW heatshrink codec error\r\n");
+}
+
+MU_TEST(subghz_raw_codec_text_test) {
+    mu_assert(subghz_raw_codec_test(SubGhzRawEncodingText), "RAW text codec error\r\n");
+}
+
+MU_TEST(subghz_raw_codec_incompressible_test) {
+    // Full block of 5-byte varints that heatshrink can only expand
+    int32_t* samples = malloc(SUBGHZ_RAW_CODEC_BLOCK_SAMPLES * sizeof(int32_t));
+    int32_t* decoded = malloc(SUBGHZ_RAW_CODEC_BLOCK_SAMPLES * sizeof(int32_t));
+    uint32_t seed = 0x12345678;
+    for(size_t i = 0; i < SUBGHZ_RAW_CODEC_BLOCK_SAMPLES; i++) {
+        seed = seed * 1103515245 + 12345;
+        samples[i] = (int32_t)(seed | 0x40000000) * ((i % 2) ? -1 : 1);
+    }
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    Stream* stream = file_stream_alloc(storage);
+    size_t count = 0;
+
+    if(file_stream_open(stream, TEST_RAW_BLOCK_NAME, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS)) {
+        SubGhzRawWriter* writer = subghz_raw_writer_alloc(stream, SubGhzRawEncodingHeatshrink);
+        bool written = subghz_raw_writer_write(writer, samples, SUBGHZ_RAW_CODEC_BLOCK_SAMPLES);
+        subghz_raw_writer_free(writer);
+
+        if(written) {
+            stream_rewind(stream);
+            SubGhzRawReader* reader = subghz_raw_reader_alloc(stream);
+            count = subghz_raw_reader_read(reader, decoded, SUBGHZ_RAW_CODEC_BLOCK_SAMPLES);
+            subghz_raw_reader_free(reader);
+        }
+    }
+
+    file_stream_close(stream);
+    stream_free(stream);
+    storage_simply_remove(storage, TEST_RAW_BLOCK_NAME);
+    furi_record_close(RECORD_STORAGE);
+
+    bool equal = count == SUBGHZ_RAW_CODEC_BLOCK_SAMPLES &&
+                 memcmp(samples, decoded, count * sizeof(int32_t)) == 0;
+    free(decoded);
+    free(samples);
+
+    mu_assert(equal, "RAW incompressible block error\r\n");
+}
+
+MU_TEST(subghz_raw_codec_truncated_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    bool truncated = false;
+    bool rejected = false;
+
+    // Cut the last block of a binary recording in the middle
+    if(subghz_raw_convert(
+           storage, TEST_RANDOM_DIR_NAME, TEST_RANDOM_CONVERTED, SubGhzRawEncodingVarint)) {
+        File* file = storage_file_alloc(storage);
+        if(storage_file_open(file, TEST_RANDOM_CONVERTED, FSAM_WRITE, FSOM_OPEN_EXISTING)) {
+            truncated = storage_file_seek(file, storage_file_size(file) - 3, true) &&
+                        storage_file_truncate(file);
+        }
+        storage_file_close(file);
+        storage_file_free(file);
+    }
+
+    if(truncated) {
+        rejected = !subghz_raw_convert(
+                       storage,
+                       TEST_RANDOM_CONVERTED,
+                       TEST_RAW_TRUNCATED_NAME,
+                       SubGhzRawEncodingHeatshrink) &&
+                   !storage_file_exists(storage, TEST_RAW_TRUNCATED_NAME);
+    }
+
+    storage_simply_remove(storage, TEST_RAW_TRUNCATED_NAME);
+    storage_simply_remove(storage, TEST_RANDOM_CONVERTED);
+    furi_record_close(RECORD_STORAGE);
+
+    mu_assert(truncated, "RAW truncated file setup error\r\n");
+    mu_assert(rejected, "RAW truncated block accepted\r\n");
+}
+
 MU_TEST_SUITE(subghz) {
     subghz_test_init();
     MU_RUN_TEST(subghz_keystore_test);
@@ -917,6 +1036,11 @@ MU_TEST_SUITE(subghz) {
     MU_RUN_TEST(subghz_encoder_dickert_test);
 
     MU_RUN_TEST(subghz_random_test);
+    MU_RUN_TEST(subghz_raw_codec_varint_test);
+    MU_RUN_TEST(subghz_raw_codec_heatshrink_test);
+    MU_RUN_TEST(subghz_raw_codec_text_test);
+    MU_RUN_TEST(subghz_raw_codec_incompressible_test);
+    MU_RUN_TEST(subghz_raw_codec_truncated_test);
     subghz_test_deinit();
 }
 
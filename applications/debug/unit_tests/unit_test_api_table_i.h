@@ -1,4 +1,8 @@
 #include <update_util/resources/manifest.h>
+#include <nfc/nfc_mock.h>
+#include <nfc/helpers/felica_crc.h>
+#include <nfc/protocols/mf_classic/mf_classic_nonce_solver.h>
+#include <nfc/protocols/mf_classic/mf_classic_nonce_log.h>
 #include <nfc/protocols/slix/slix_i.h>
 #include <nfc/protocols/iso15693_3/iso15693_3_poller_i.h>
 #include <FreeRTOS.h>
@@ -15,6 +19,33 @@ static constexpr auto unit_tests_api_table = sort(create_array_t<sym_entry>(
     API_METHOD(resource_manifest_reader_open, bool, (ResourceManifestReader*, const char*)),
     API_METHOD(resource_manifest_reader_next, ResourceManifestEntry*, (ResourceManifestReader*)),
     API_METHOD(resource_manifest_reader_previous, ResourceManifestEntry*, (ResourceManifestReader*)),
+    API_METHOD(nfc_mock_stats_reset, void, ()),
+    API_METHOD(nfc_mock_stats_get, void, (NfcMockStats*)),
+    API_METHOD(nfc_mock_set_frame_log, void, (bool)),
+    API_METHOD(mf_classic_nonce_solver_alloc, MfClassicNonceSolver*, (const char*, const char*)),
+    API_METHOD(mf_classic_nonce_solver_free, void, (MfClassicNonceSolver*)),
+    API_METHOD(
+        mf_classic_nonce_solver_submit,
+        void,
+        (MfClassicNonceSolver*, const MfClassicNonceSolverJob*)),
+    API_METHOD(
+        mf_classic_nonce_solver_get_result,
+        bool,
+        (MfClassicNonceSolver*, MfClassicNonceSolverResult*, uint32_t)),
+    API_METHOD(
+        mf_classic_nonce_solver_get_progress,
+        void,
+        (MfClassicNonceSolver*, MfClassicNonceSolverProgress*)),
+    API_METHOD(mf_classic_nonce_log_alloc, MfClassicNonceLog*, (const char*)),
+    API_METHOD(mf_classic_nonce_log_free, void, (MfClassicNonceLog*)),
+    API_METHOD(
+        mf_classic_nonce_log_add,
+        bool,
+        (MfClassicNonceLog*, const MfClassicNonceLogRecord*)),
+    API_METHOD(mf_classic_nonce_log_get_count, size_t, (MfClassicNonceLog*)),
+    API_METHOD(mf_classic_nonce_log_export, bool, (const char*, const char*)),
+    API_METHOD(felica_crc_append, void, (BitBuffer*)),
+    API_METHOD(felica_crc_check, bool, (const BitBuffer*)),
     API_METHOD(slix_process_iso15693_3_error, SlixError, (Iso15693_3Error)),
     API_METHOD(iso15693_3_poller_get_data, const Iso15693_3Data*, (Iso15693_3Poller*)),
     API_METHOD(rpc_system_storage_get_error, PB_CommandStatus, (FS_Error)),
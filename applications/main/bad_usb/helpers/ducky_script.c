@@ -7,6 +7,7 @@
 #include <storage/storage.h>
 #include "ducky_script.h"
 #include "ducky_script_i.h"
+#include "ducky_turbo.h"
 #include <dolphin/dolphin.h>
 
 #define TAG "BadUsb"
@@ -155,6 +156,25 @@ bool ducky_string(BadUsbScript* bad_usb, const char* param) {
     return true;
 }
 
+static uint16_t ducky_string_get_keycode(BadUsbScript* bad_usb, const char chr) {
+    if(chr == '\n') {
+        return HID_KEYBOARD_RETURN;
+    }
+    return BADUSB_ASCII_TO_KEY(bad_usb, chr);
+}
+
+bool ducky_string_turbo(BadUsbScript* bad_usb, const char* param) {
+    DuckyTurbo turbo;
+    ducky_turbo_start(&turbo, bad_usb->hid->kb_set_pressed, bad_usb->hid_inst);
+
+    for(uint32_t i = 0; param[i] != '\0'; i++) {
+        ducky_turbo_push(&turbo, ducky_string_get_keycode(bad_usb, param[i]));
+    }
+
+    bad_usb->stringdelay = 0;
+    return ducky_turbo_finish(&turbo);
+}
+
 static bool ducky_string_next(BadUsbScript* bad_usb) {
     if(bad_usb->string_print_pos >= furi_string_size(bad_usb->string_print)) {
         return true;
@@ -435,6 +455,7 @@ static int32_t bad_usb_worker(void* context) {
                 bad_usb->defdelay = 0;
                 bad_usb->stringdelay = 0;
                 bad_usb->defstringdelay = 0;
+                bad_usb->turbo = false;
                 bad_usb->repeat_cnt = 0;
                 bad_usb->key_hold_nb = 0;
                 bad_usb->file_end = false;
@@ -459,6 +480,7 @@ static int32_t bad_usb_worker(void* context) {
                 bad_usb->defdelay = 0;
                 bad_usb->stringdelay = 0;
                 bad_usb->defstringdelay = 0;
+                bad_usb->turbo = false;
                 bad_usb->repeat_cnt = 0;
                 bad_usb->file_end = false;
                 storage_file_seek(script_file, 0, true);
@@ -65,8 +65,12 @@ static int32_t ducky_fnc_string(BadUsbScript* bad_usb, const char* line, int32_t
 
     if(bad_usb->stringdelay == 0 &&
        bad_usb->defstringdelay == 0) { // stringdelay not set - run command immediately
-        bool state = ducky_string(bad_usb, furi_string_get_cstr(bad_usb->string_print));
-        if(!state) {
+        if(bad_usb->turbo && (bad_usb->key_hold_nb == 0)) {
+            // Unmapped characters are skipped, so only a report transfer can fail here
+            if(!ducky_string_turbo(bad_usb, furi_string_get_cstr(bad_usb->string_print))) {
+                return ducky_error(bad_usb, "HID report send failed");
+            }
+        } else if(!ducky_string(bad_usb, furi_string_get_cstr(bad_usb->string_print))) {
             return ducky_error(bad_usb, "Invalid string %s", line);
         }
     } else { // stringdelay is set - run command in thread to keep handling external events
@@ -76,6 +80,20 @@ static int32_t ducky_fnc_string(BadUsbScript* bad_usb, const char* line, int32_t
     return 0;
 }
 
+static int32_t ducky_fnc_turbo(BadUsbScript* bad_usb, const char* line, int32_t param) {
+    UNUSED(param);
+
+    line = &line[ducky_get_command_len(line) + 1];
+    if(strncmp(line, "ON", strlen("ON")) == 0) {
+        bad_usb->turbo = true;
+    } else if(strncmp(line, "OFF", strlen("OFF")) == 0) {
+        bad_usb->turbo = false;
+    } else {
+        return ducky_error(bad_usb, "Invalid turbo mode %s", line);
+    }
+    return 0;
+}
+
 static int32_t ducky_fnc_repeat(BadUsbScript* bad_usb, const char* line, int32_t param) {
     UNUSED(param);
 
@@ -203,6 +221,7 @@ static const DuckyCmd ducky_commands[] = {
     {"STRING_DELAY", ducky_fnc_strdelay, -1},
     {"DEFAULT_STRING_DELAY", ducky_fnc_defstrdelay, -1},
     {"DEFAULTSTRINGDELAY", ducky_fnc_defstrdelay, -1},
+    {"TURBO_MODE", ducky_fnc_turbo, -1},
     {"REPEAT", ducky_fnc_repeat, -1},
     {"SYSRQ", ducky_fnc_sysrq, -1},
     {"ALTCHAR", ducky_fnc_altchar, -1},
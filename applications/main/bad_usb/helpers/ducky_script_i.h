@@ -35,6 +35,7 @@ struct BadUsbScript {
     uint32_t stringdelay;
     uint32_t defstringdelay;
     uint16_t layout[128];
+    bool turbo;
 
     FuriString* line;
     FuriString* line_prev;
@@ -67,6 +68,8 @@ bool ducky_altstring(BadUsbScript* bad_usb, const char* param);
 
 bool ducky_string(BadUsbScript* bad_usb, const char* param);
 
+bool ducky_string_turbo(BadUsbScript* bad_usb, const char* param);
+
 int32_t ducky_execute_cmd(BadUsbScript* bad_usb, const char* line);
 
 int32_t ducky_error(BadUsbScript* bad_usb, const char* text, ...);
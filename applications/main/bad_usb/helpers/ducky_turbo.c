@@ -0,0 +1,72 @@
+#include "ducky_turbo.h"
+
+static bool ducky_turbo_has_key(const uint16_t* keys, size_t keys_len, uint16_t keycode) {
+    for(size_t i = 0; i < keys_len; i++) {
+        if((keys[i] & 0xFF) == (keycode & 0xFF)) return true;
+    }
+    return false;
+}
+
+static bool ducky_turbo_can_append(const DuckyTurbo* turbo, uint16_t keycode) {
+    if(turbo->keys_len == 0) return true;
+    if(turbo->keys_len >= HID_KB_MAX_KEYS) return false;
+    // All keys in one report share the same modifiers
+    if((turbo->keys[0] >> 8) != (keycode >> 8)) return false;
+    // Host only registers a key once per report
+    return !ducky_turbo_has_key(turbo->keys, turbo->keys_len, keycode);
+}
+
+static void ducky_turbo_send(DuckyTurbo* turbo) {
+    // Key that is still down from previous report or modifier change needs a release first
+    bool need_release = false;
+    if(turbo->sent_len > 0) {
+        need_release = ((turbo->sent[0] >> 8) != (turbo->keys[0] >> 8));
+        for(size_t i = 0; (i < turbo->keys_len) && !need_release; i++) {
+            need_release = ducky_turbo_has_key(turbo->sent, turbo->sent_len, turbo->keys[i]);
+        }
+    }
+    if(need_release) {
+        turbo->state &= turbo->send(turbo->context, NULL, 0);
+    }
+
+    turbo->state &= turbo->send(turbo->context, turbo->keys, turbo->keys_len);
+    memcpy(turbo->sent, turbo->keys, turbo->keys_len * sizeof(uint16_t));
+    turbo->sent_len = turbo->keys_len;
+    turbo->keys_len = 0;
+}
+
+void ducky_turbo_start(DuckyTurbo* turbo, DuckyTurboSendCallback send, void* context) {
+    furi_check(turbo);
+    furi_check(send);
+
+    turbo->send = send;
+    turbo->context = context;
+    turbo->keys_len = 0;
+    turbo->sent_len = 0;
+    turbo->state = true;
+}
+
+void ducky_turbo_push(DuckyTurbo* turbo, uint16_t keycode) {
+    furi_check(turbo);
+
+    if((keycode & 0xFF) == HID_KEYBOARD_NONE) return;
+
+    if(!ducky_turbo_can_append(turbo, keycode)) {
+        ducky_turbo_send(turbo);
+    }
+    turbo->keys[turbo->keys_len++] = keycode;
+}
+
+bool ducky_turbo_finish(DuckyTurbo* turbo) {
+    furi_check(turbo);
+
+    if(turbo->keys_len > 0) {
+        ducky_turbo_send(turbo);
+    }
+    if(turbo->sent_len > 0) {
+        turbo->state &= turbo->send(turbo->context, NULL, 0);
+        turbo->sent_len = 0;
+    }
+
+    return turbo->state;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <furi.h>
+#include <furi_hal_usb_hid.h>
+
+/** Sends keyboard report with given keys pressed, zero count releases all keys */
+typedef bool (*DuckyTurboSendCallback)(void* context, const uint16_t* keys, size_t count);
+
+/** Packs consecutive keystrokes into multi-key keyboard reports */
+typedef struct {
+    DuckyTurboSendCallback send;
+    void* context;
+    uint16_t keys[HID_KB_MAX_KEYS];
+    size_t keys_len;
+    uint16_t sent[HID_KB_MAX_KEYS];
+    size_t sent_len;
+    bool state;
+} DuckyTurbo;
+
+/** Start packing
+ *
+ * @param turbo DuckyTurbo instance
+ * @param send callback to send reports with
+ * @param context callback context
+ */
+void ducky_turbo_start(DuckyTurbo* turbo, DuckyTurboSendCallback send, void* context);
+
+/** Add keystroke, report is sent when the key does not fit into current one
+ *
+ * @param turbo DuckyTurbo instance
+ * @param keycode key code with modifiers
+ */
+void ducky_turbo_push(DuckyTurbo* turbo, uint16_t keycode);
+
+/** Send remaining keys and release everything
+ *
+ * @param turbo DuckyTurbo instance
+ * @return true if all reports were sent
+ */
+bool ducky_turbo_finish(DuckyTurbo* turbo);
+
+#ifdef __cplusplus
+}
+#endif
@@ -102,6 +102,8 @@ typedef struct {
     MfClassicBackdoor backdoor;
     uint16_t nested_target_key;
     uint16_t msb_count;
+    uint16_t nonce_jobs_pending;
+    uint32_t nonce_search_eta_s;
     bool enhanced_dict;
 } NfcMfClassicDictAttackContext;
 
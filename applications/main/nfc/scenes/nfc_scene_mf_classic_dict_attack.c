@@ -69,6 +69,8 @@ NfcCommand nfc_dict_attack_worker_callback(NfcGenericEvent event, void* context)
         instance->nfc_dict_context.backdoor = data_update->backdoor;
         instance->nfc_dict_context.nested_target_key = data_update->nested_target_key;
         instance->nfc_dict_context.msb_count = data_update->msb_count;
+        instance->nfc_dict_context.nonce_jobs_pending = data_update->nonce_jobs_pending;
+        instance->nfc_dict_context.nonce_search_eta_s = data_update->nonce_search_eta_s;
         view_dispatcher_send_custom_event(
             instance->view_dispatcher, NfcCustomEventDictAttackDataUpdate);
     } else if(mfc_event->type == MfClassicPollerEventTypeNextSector) {
@@ -133,6 +135,8 @@ static void nfc_scene_mf_classic_dict_attack_update_view(NfcApp* instance) {
         dict_attack_set_backdoor(instance->dict_attack, mfc_dict->backdoor);
         dict_attack_set_nested_target_key(instance->dict_attack, mfc_dict->nested_target_key);
         dict_attack_set_msb_count(instance->dict_attack, mfc_dict->msb_count);
+        dict_attack_set_nonce_search(
+            instance->dict_attack, mfc_dict->nonce_jobs_pending, mfc_dict->nonce_search_eta_s);
     }
 }
 
@@ -381,6 +385,8 @@ void nfc_scene_mf_classic_dict_attack_on_exit(void* context) {
     instance->nfc_dict_context.backdoor = MfClassicBackdoorUnknown;
     instance->nfc_dict_context.nested_target_key = 0;
     instance->nfc_dict_context.msb_count = 0;
+    instance->nfc_dict_context.nonce_jobs_pending = 0;
+    instance->nfc_dict_context.nonce_search_eta_s = 0;
     instance->nfc_dict_context.enhanced_dict = false;
 
     // Clean up temporary files used for nested dictionary attack
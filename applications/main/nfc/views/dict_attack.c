@@ -26,6 +26,8 @@ typedef struct {
     MfClassicBackdoor backdoor;
     uint16_t nested_target_key;
     uint16_t msb_count;
+    uint16_t nonce_jobs_pending;
+    uint32_t nonce_search_eta_s;
 } DictAttackViewModel;
 
 static void dict_attack_draw_callback(Canvas* canvas, void* model) {
@@ -46,7 +48,6 @@ static void dict_attack_draw_callback(Canvas* canvas, void* model) {
             break;
         case MfClassicNestedPhaseDictAttack:
         case MfClassicNestedPhaseDictAttackVerify:
-        case MfClassicNestedPhaseDictAttackResume:
             furi_string_set(m->header, "Nested Dictionary");
             break;
         case MfClassicNestedPhaseCalibrate:
@@ -85,6 +86,13 @@ static void dict_attack_draw_callback(Canvas* canvas, void* model) {
                 sizeof(draw_str),
                 "Reuse key check for sector: %d",
                 m->key_attack_current_sector);
+        } else if(m->nonce_jobs_pending > 0) {
+            snprintf(
+                draw_str,
+                sizeof(draw_str),
+                "Key search: %d queued, ~%lus",
+                m->nonce_jobs_pending,
+                m->nonce_search_eta_s);
         } else {
             snprintf(draw_str, sizeof(draw_str), "Unlocking sector: %d", m->current_sector);
         }
@@ -92,8 +100,7 @@ static void dict_attack_draw_callback(Canvas* canvas, void* model) {
         float dict_progress = 0;
         if(m->nested_phase == MfClassicNestedPhaseAnalyzePRNG ||
            m->nested_phase == MfClassicNestedPhaseDictAttack ||
-           m->nested_phase == MfClassicNestedPhaseDictAttackVerify ||
-           m->nested_phase == MfClassicNestedPhaseDictAttackResume) {
+           m->nested_phase == MfClassicNestedPhaseDictAttackVerify) {
             // Phase: Nested dictionary attack
             uint8_t target_sector =
                 m->nested_target_key / (m->prng_type == MfClassicPrngTypeWeak ? 2 : 16);
@@ -207,6 +214,8 @@ void dict_attack_reset(DictAttack* instance) {
             model->backdoor = MfClassicBackdoorUnknown;
             model->nested_target_key = 0;
             model->msb_count = 0;
+            model->nonce_jobs_pending = 0;
+            model->nonce_search_eta_s = 0;
             furi_string_reset(model->header);
         },
         false);
@@ -355,3 +364,16 @@ void dict_attack_set_msb_count(DictAttack* instance, uint16_t msb_count) {
     with_view_model(
         instance->view, DictAttackViewModel * model, { model->msb_count = msb_count; }, true);
 }
+
+void dict_attack_set_nonce_search(DictAttack* instance, uint16_t jobs_pending, uint32_t eta_s) {
+    furi_assert(instance);
+
+    with_view_model(
+        instance->view,
+        DictAttackViewModel * model,
+        {
+            model->nonce_jobs_pending = jobs_pending;
+            model->nonce_search_eta_s = eta_s;
+        },
+        true);
+}
@@ -56,6 +56,8 @@ void dict_attack_set_nested_target_key(DictAttack* instance, uint16_t target_key
 
 void dict_attack_set_msb_count(DictAttack* instance, uint16_t msb_count);
 
+void dict_attack_set_nonce_search(DictAttack* instance, uint16_t jobs_pending, uint32_t eta_s);
+
 #ifdef __cplusplus
 }
 #endif
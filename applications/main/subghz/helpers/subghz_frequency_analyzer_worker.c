@@ -6,6 +6,14 @@
 
 #define TAG "SubghzFrequencyAnalyzerWorker"
 
+#define SUBGHZ_FREQUENCY_ANALYZER_SETTLE_US           1000
+#define SUBGHZ_FREQUENCY_ANALYZER_RSSI_SAMPLES        4
+#define SUBGHZ_FREQUENCY_ANALYZER_SAMPLE_INTERVAL_US  250
+#define SUBGHZ_FREQUENCY_ANALYZER_HOT_HOLD            4 // sweeps channel stays hot after signal
+#define SUBGHZ_FREQUENCY_ANALYZER_HOT_SWEEPS_MAX      8 // hot-only sweeps between full ones
+#define SUBGHZ_FREQUENCY_ANALYZER_CALIBRATION_TIMEOUT 30000 // ms, VCO drifts with temperature
+#define SUBGHZ_FREQUENCY_ANALYZER_SPECTRUM_DECAY      2.0f // dB per visit
+
 static const uint8_t subghz_preset_ook_58khz[][2] = {
     {CC1101_MDMCFG4, 0b11110111}, // Rx BW filter is 58.035714kHz
     /* End  */
@@ -18,6 +26,13 @@ static const uint8_t subghz_preset_ook_650khz[][2] = {
     {0, 0},
 };
 
+typedef struct {
+    uint32_t frequency;
+    uint8_t fscal[3]; // FSCAL3, FSCAL2, FSCAL1 found by calibration
+    uint8_t hot;
+    float rssi; // peak hold with decay
+} SubGhzFrequencyAnalyzerChannel;
+
 struct SubGhzFrequencyAnalyzerWorker {
     FuriThread* thread;
 
@@ -28,8 +43,19 @@ struct SubGhzFrequencyAnalyzerWorker {
 
     float filVal;
 
+    SubGhzFrequencyAnalyzerChannel channels[SUBGHZ_FREQUENCY_ANALYZER_CHANNELS_MAX];
+    size_t channels_count;
+    uint32_t calibration_tick;
+    uint8_t hot_sweeps;
+
+    uint32_t metrics_tick;
+    uint32_t metrics_dwells;
+    SubGhzFrequencyAnalyzerSpectrum spectrum;
+
     SubGhzFrequencyAnalyzerWorkerPairCallback pair_callback;
     void* context;
+    SubGhzFrequencyAnalyzerWorkerSpectrumCallback spectrum_callback;
+    void* spectrum_context;
 };
 
 static void subghz_frequency_analyzer_worker_load_registers(const uint8_t data[][2]) {
@@ -58,6 +84,238 @@ static uint32_t subghz_frequency_analyzer_worker_expRunningAverageAdaptive(
     return (uint32_t)instance->filVal;
 }
 
+static int subghz_frequency_analyzer_worker_channel_cmp(const void* a, const void* b) {
+    const SubGhzFrequencyAnalyzerChannel* channel_a = a;
+    const SubGhzFrequencyAnalyzerChannel* channel_b = b;
+    if(channel_a->frequency < channel_b->frequency) return -1;
+    if(channel_a->frequency > channel_b->frequency) return 1;
+    return 0;
+}
+
+/** Build channel list from settings, sorted ascending
+ * 
+ * Neighbour channels are close to each other, so synthesizer settles faster.
+ */
+static void
+    subghz_frequency_analyzer_worker_load_channels(SubGhzFrequencyAnalyzerWorker* instance) {
+    instance->channels_count = 0;
+    for(size_t i = 0; i < subghz_setting_get_frequency_count(instance->setting); i++) {
+        uint32_t frequency = subghz_setting_get_frequency(instance->setting, i);
+        if(!furi_hal_subghz_is_frequency_valid(frequency)) continue;
+        if(instance->channels_count == SUBGHZ_FREQUENCY_ANALYZER_CHANNELS_MAX) {
+            FURI_LOG_W(TAG, "Too many frequencies, only %zu used", instance->channels_count);
+            break;
+        }
+        SubGhzFrequencyAnalyzerChannel* channel = &instance->channels[instance->channels_count++];
+        memset(channel, 0, sizeof(SubGhzFrequencyAnalyzerChannel));
+        channel->frequency = frequency;
+        channel->rssi = SUBGHZ_FREQUENCY_ANALYZER_SPECTRUM_FLOOR;
+    }
+
+    qsort(
+        instance->channels,
+        instance->channels_count,
+        sizeof(SubGhzFrequencyAnalyzerChannel),
+        subghz_frequency_analyzer_worker_channel_cmp);
+
+    // Drop duplicates
+    size_t count = 0;
+    for(size_t i = 0; i < instance->channels_count; i++) {
+        if(count && instance->channels[count - 1].frequency == instance->channels[i].frequency) {
+            continue;
+        }
+        instance->channels[count++] = instance->channels[i];
+    }
+    instance->channels_count = count;
+}
+
+/** Calibrate synthesizer once for every channel and remember results
+ * 
+ * Sweep then only restores FSCAL registers instead of running SCAL on each step.
+ */
+static void subghz_frequency_analyzer_worker_calibrate(SubGhzFrequencyAnalyzerWorker* instance) {
+    uint32_t tick = furi_get_tick();
+
+    furi_hal_spi_acquire(&furi_hal_spi_bus_handle_subghz);
+    for(size_t i = 0; i < instance->channels_count; i++) {
+        SubGhzFrequencyAnalyzerChannel* channel = &instance->channels[i];
+        cc1101_switch_to_idle(&furi_hal_spi_bus_handle_subghz);
+        channel->frequency =
+            cc1101_set_frequency(&furi_hal_spi_bus_handle_subghz, channel->frequency);
+        cc1101_calibrate(&furi_hal_spi_bus_handle_subghz);
+        furi_check(cc1101_wait_status_state(
+            &furi_hal_spi_bus_handle_subghz, CC1101StateIDLE, 10000));
+        cc1101_read_reg(&furi_hal_spi_bus_handle_subghz, CC1101_FSCAL3, &channel->fscal[0]);
+        cc1101_read_reg(&furi_hal_spi_bus_handle_subghz, CC1101_FSCAL2, &channel->fscal[1]);
+        cc1101_read_reg(&furi_hal_spi_bus_handle_subghz, CC1101_FSCAL1, &channel->fscal[2]);
+    }
+    furi_hal_spi_release(&furi_hal_spi_bus_handle_subghz);
+
+    instance->calibration_tick = furi_get_tick();
+    FURI_LOG_D(
+        TAG,
+        "Calibrated %zu channels in %lums",
+        instance->channels_count,
+        instance->calibration_tick - tick);
+}
+
+/** Stay in RX and take several RSSI samples
+ * 
+ * @return peak RSSI over dwell time
+ */
+static float subghz_frequency_analyzer_worker_dwell(SubGhzFrequencyAnalyzerWorker* instance) {
+    furi_delay_us(SUBGHZ_FREQUENCY_ANALYZER_SETTLE_US);
+
+    float rssi_peak = furi_hal_subghz_get_rssi();
+    for(size_t i = 1; i < SUBGHZ_FREQUENCY_ANALYZER_RSSI_SAMPLES; i++) {
+        furi_delay_us(SUBGHZ_FREQUENCY_ANALYZER_SAMPLE_INTERVAL_US);
+        float rssi = furi_hal_subghz_get_rssi();
+        if(rssi > rssi_peak) rssi_peak = rssi;
+    }
+
+    instance->metrics_dwells++;
+    return rssi_peak;
+}
+
+static size_t
+    subghz_frequency_analyzer_worker_get_hot_count(SubGhzFrequencyAnalyzerWorker* instance) {
+    size_t hot_count = 0;
+    for(size_t i = 0; i < instance->channels_count; i++) {
+        if(instance->channels[i].hot) hot_count++;
+    }
+    return hot_count;
+}
+
+/** Coarse pass over all channels or only hot ones */
+static void subghz_frequency_analyzer_worker_sweep(
+    SubGhzFrequencyAnalyzerWorker* instance,
+    FrequencyRSSI* frequency_rssi,
+    bool full) {
+    float rssi_min = 26.0f;
+    float rssi_avg = 0;
+    size_t rssi_avg_samples = 0;
+
+    for(size_t i = 0; i < instance->channels_count; i++) {
+        SubGhzFrequencyAnalyzerChannel* channel = &instance->channels[i];
+        if(!full && !channel->hot) continue;
+
+        furi_hal_spi_acquire(&furi_hal_spi_bus_handle_subghz);
+        cc1101_switch_to_idle(&furi_hal_spi_bus_handle_subghz);
+        cc1101_set_frequency(&furi_hal_spi_bus_handle_subghz, channel->frequency);
+        cc1101_write_burst(
+            &furi_hal_spi_bus_handle_subghz,
+            CC1101_FSCAL3,
+            channel->fscal,
+            sizeof(channel->fscal));
+        cc1101_switch_to_rx(&furi_hal_spi_bus_handle_subghz);
+        furi_hal_spi_release(&furi_hal_spi_bus_handle_subghz);
+
+        float rssi = subghz_frequency_analyzer_worker_dwell(instance);
+
+        rssi_avg += rssi;
+        rssi_avg_samples++;
+
+        if(rssi < rssi_min) rssi_min = rssi;
+
+        if(rssi > SUBGHZ_FREQUENCY_ANALYZER_THRESHOLD) {
+            channel->hot = SUBGHZ_FREQUENCY_ANALYZER_HOT_HOLD;
+        } else if(channel->hot) {
+            channel->hot--;
+        }
+
+        channel->rssi -= SUBGHZ_FREQUENCY_ANALYZER_SPECTRUM_DECAY;
+        if(channel->rssi < rssi) channel->rssi = rssi;
+
+        if(frequency_rssi->rssi_coarse < rssi) {
+            frequency_rssi->rssi_coarse = rssi;
+            frequency_rssi->frequency_coarse = channel->frequency;
+        }
+    }
+
+    if(rssi_avg_samples) {
+        FURI_LOG_T(
+            TAG,
+            "RSSI: avg %f, max %f at %lu, min %f",
+            (double)(rssi_avg / rssi_avg_samples),
+            (double)frequency_rssi->rssi_coarse,
+            frequency_rssi->frequency_coarse,
+            (double)rssi_min);
+    }
+}
+
+/** Fine pass around coarse peak
+ * 
+ * Steps are much smaller than synthesizer calibration range,
+ * so calibration is done only once in the center.
+ */
+static void subghz_frequency_analyzer_worker_fine_sweep(
+    SubGhzFrequencyAnalyzerWorker* instance,
+    FrequencyRSSI* frequency_rssi) {
+    furi_hal_spi_acquire(&furi_hal_spi_bus_handle_subghz);
+    cc1101_switch_to_idle(&furi_hal_spi_bus_handle_subghz);
+    cc1101_set_frequency(&furi_hal_spi_bus_handle_subghz, frequency_rssi->frequency_coarse);
+    cc1101_calibrate(&furi_hal_spi_bus_handle_subghz);
+    furi_check(
+        cc1101_wait_status_state(&furi_hal_spi_bus_handle_subghz, CC1101StateIDLE, 10000));
+    furi_hal_spi_release(&furi_hal_spi_bus_handle_subghz);
+
+    //for example -0.3 ... 433.92 ... +0.3 step 20KHz
+    for(uint32_t i = frequency_rssi->frequency_coarse - 300000;
+        i < frequency_rssi->frequency_coarse + 300000;
+        i += 20000) {
+        if(furi_hal_subghz_is_frequency_valid(i)) {
+            furi_hal_spi_acquire(&furi_hal_spi_bus_handle_subghz);
+            cc1101_switch_to_idle(&furi_hal_spi_bus_handle_subghz);
+            uint32_t frequency = cc1101_set_frequency(&furi_hal_spi_bus_handle_subghz, i);
+            cc1101_switch_to_rx(&furi_hal_spi_bus_handle_subghz);
+            furi_hal_spi_release(&furi_hal_spi_bus_handle_subghz);
+
+            float rssi = subghz_frequency_analyzer_worker_dwell(instance);
+
+            FURI_LOG_T(TAG, "#:%lu:%f", frequency, (double)rssi);
+
+            if(frequency_rssi->rssi_fine < rssi) {
+                frequency_rssi->rssi_fine = rssi;
+                frequency_rssi->frequency_fine = frequency;
+            }
+        }
+    }
+}
+
+static void subghz_frequency_analyzer_worker_publish_spectrum(
+    SubGhzFrequencyAnalyzerWorker* instance,
+    size_t hot_count) {
+    SubGhzFrequencyAnalyzerSpectrum* spectrum = &instance->spectrum;
+
+    uint32_t elapsed = furi_get_tick() - instance->metrics_tick;
+    if(elapsed >= 1000) {
+        spectrum->channels_per_second = instance->metrics_dwells * 1000 / elapsed;
+        FURI_LOG_D(
+            TAG,
+            "%u ch/s, full sweep %ums, %zu hot",
+            spectrum->channels_per_second,
+            spectrum->full_sweep_ms,
+            hot_count);
+        instance->metrics_tick += elapsed;
+        instance->metrics_dwells = 0;
+    }
+
+    spectrum->channels_count = instance->channels_count;
+    spectrum->hot_count = hot_count;
+    if(instance->channels_count) {
+        spectrum->frequency_min = instance->channels[0].frequency;
+        spectrum->frequency_max = instance->channels[instance->channels_count - 1].frequency;
+    }
+    for(size_t i = 0; i < instance->channels_count; i++) {
+        float level = instance->channels[i].rssi - SUBGHZ_FREQUENCY_ANALYZER_SPECTRUM_FLOOR;
+        spectrum->level[i] = CLAMP(level, (float)UINT8_MAX, 0.0f);
+    }
+
+    if(instance->spectrum_callback) {
+        instance->spectrum_callback(instance->spectrum_context, spectrum);
+    }
+}
+
 /** Worker thread
  * 
  * @param context 
@@ -68,8 +326,6 @@ static int32_t subghz_frequency_analyzer_worker_thread(void* context) {
 
     FrequencyRSSI frequency_rssi = {
         .frequency_coarse = 0, .rssi_coarse = 0, .frequency_fine = 0, .rssi_fine = 0};
-    float rssi = 0;
-    uint32_t frequency = 0;
     float rssi_temp = -127.0f;
     uint32_t frequency_temp = 0;
 
@@ -99,95 +355,48 @@ static int32_t subghz_frequency_analyzer_worker_thread(void* context) {
 
     furi_hal_subghz_set_path(FuriHalSubGhzPathIsolate);
 
+    subghz_frequency_analyzer_worker_load_channels(instance);
+    subghz_frequency_analyzer_worker_calibrate(instance);
+    instance->hot_sweeps = 0;
+    instance->metrics_tick = furi_get_tick();
+    instance->metrics_dwells = 0;
+
     while(instance->worker_running) {
         furi_delay_ms(10);
 
-        float rssi_min = 26.0f;
-        float rssi_avg = 0;
-        size_t rssi_avg_samples = 0;
-
         frequency_rssi.rssi_coarse = -127.0f;
         frequency_rssi.rssi_fine = -127.0f;
         furi_hal_subghz_idle();
-        subghz_frequency_analyzer_worker_load_registers(subghz_preset_ook_650khz);
-
-        // First stage: coarse scan
-        for(size_t i = 0; i < subghz_setting_get_frequency_count(instance->setting); i++) {
-            if(furi_hal_subghz_is_frequency_valid(
-                   subghz_setting_get_frequency(instance->setting, i))) {
-                furi_hal_spi_acquire(&furi_hal_spi_bus_handle_subghz);
-                cc1101_switch_to_idle(&furi_hal_spi_bus_handle_subghz);
-                frequency = cc1101_set_frequency(
-                    &furi_hal_spi_bus_handle_subghz,
-                    subghz_setting_get_frequency(instance->setting, i));
-
-                cc1101_calibrate(&furi_hal_spi_bus_handle_subghz);
-
-                furi_check(cc1101_wait_status_state(
-                    &furi_hal_spi_bus_handle_subghz, CC1101StateIDLE, 10000));
-
-                cc1101_switch_to_rx(&furi_hal_spi_bus_handle_subghz);
-                furi_hal_spi_release(&furi_hal_spi_bus_handle_subghz);
-
-                furi_delay_ms(2);
-
-                rssi = furi_hal_subghz_get_rssi();
 
-                rssi_avg += rssi;
-                rssi_avg_samples++;
+        if(furi_get_tick() - instance->calibration_tick >
+           SUBGHZ_FREQUENCY_ANALYZER_CALIBRATION_TIMEOUT) {
+            subghz_frequency_analyzer_worker_calibrate(instance);
+        }
 
-                if(rssi < rssi_min) rssi_min = rssi;
+        subghz_frequency_analyzer_worker_load_registers(subghz_preset_ook_650khz);
 
-                if(frequency_rssi.rssi_coarse < rssi) {
-                    frequency_rssi.rssi_coarse = rssi;
-                    frequency_rssi.frequency_coarse = frequency;
-                }
-            }
+        // First stage: coarse scan, rescan only hot channels between full sweeps
+        bool full = !subghz_frequency_analyzer_worker_get_hot_count(instance) ||
+                    (instance->hot_sweeps >= SUBGHZ_FREQUENCY_ANALYZER_HOT_SWEEPS_MAX);
+        uint32_t sweep_tick = furi_get_tick();
+        subghz_frequency_analyzer_worker_sweep(instance, &frequency_rssi, full);
+        if(full) {
+            instance->spectrum.full_sweep_ms = furi_get_tick() - sweep_tick;
+            instance->hot_sweeps = 0;
+        } else {
+            instance->hot_sweeps++;
         }
 
-        FURI_LOG_T(
-            TAG,
-            "RSSI: avg %f, max %f at %lu, min %f",
-            (double)(rssi_avg / rssi_avg_samples),
-            (double)frequency_rssi.rssi_coarse,
-            frequency_rssi.frequency_coarse,
-            (double)rssi_min);
-
         // Second stage: fine scan
         if(frequency_rssi.rssi_coarse > SUBGHZ_FREQUENCY_ANALYZER_THRESHOLD) {
             furi_hal_subghz_idle();
             subghz_frequency_analyzer_worker_load_registers(subghz_preset_ook_58khz);
-            //for example -0.3 ... 433.92 ... +0.3 step 20KHz
-            for(uint32_t i = frequency_rssi.frequency_coarse - 300000;
-                i < frequency_rssi.frequency_coarse + 300000;
-                i += 20000) {
-                if(furi_hal_subghz_is_frequency_valid(i)) {
-                    furi_hal_spi_acquire(&furi_hal_spi_bus_handle_subghz);
-                    cc1101_switch_to_idle(&furi_hal_spi_bus_handle_subghz);
-                    frequency = cc1101_set_frequency(&furi_hal_spi_bus_handle_subghz, i);
-
-                    cc1101_calibrate(&furi_hal_spi_bus_handle_subghz);
-
-                    furi_check(cc1101_wait_status_state(
-                        &furi_hal_spi_bus_handle_subghz, CC1101StateIDLE, 10000));
-
-                    cc1101_switch_to_rx(&furi_hal_spi_bus_handle_subghz);
-                    furi_hal_spi_release(&furi_hal_spi_bus_handle_subghz);
-
-                    furi_delay_ms(2);
-
-                    rssi = furi_hal_subghz_get_rssi();
-
-                    FURI_LOG_T(TAG, "#:%lu:%f", frequency, (double)rssi);
-
-                    if(frequency_rssi.rssi_fine < rssi) {
-                        frequency_rssi.rssi_fine = rssi;
-                        frequency_rssi.frequency_fine = frequency;
-                    }
-                }
-            }
+            subghz_frequency_analyzer_worker_fine_sweep(instance, &frequency_rssi);
         }
 
+        subghz_frequency_analyzer_worker_publish_spectrum(
+            instance, subghz_frequency_analyzer_worker_get_hot_count(instance));
+
         // Deliver results fine
         if(frequency_rssi.rssi_fine > SUBGHZ_FREQUENCY_ANALYZER_THRESHOLD) {
             FURI_LOG_D(
@@ -281,6 +490,15 @@ void subghz_frequency_analyzer_worker_set_pair_callback(
     instance->context = context;
 }
 
+void subghz_frequency_analyzer_worker_set_spectrum_callback(
+    SubGhzFrequencyAnalyzerWorker* instance,
+    SubGhzFrequencyAnalyzerWorkerSpectrumCallback callback,
+    void* context) {
+    furi_assert(instance);
+    instance->spectrum_callback = callback;
+    instance->spectrum_context = context;
+}
+
 void subghz_frequency_analyzer_worker_start(SubGhzFrequencyAnalyzerWorker* instance) {
     furi_assert(instance);
     furi_assert(!instance->worker_running);
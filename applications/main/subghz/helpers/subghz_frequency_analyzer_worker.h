@@ -3,7 +3,9 @@
 #include <furi_hal.h>
 #include "../subghz_i.h"
 
-#define SUBGHZ_FREQUENCY_ANALYZER_THRESHOLD -93.0f
+#define SUBGHZ_FREQUENCY_ANALYZER_THRESHOLD      -93.0f
+#define SUBGHZ_FREQUENCY_ANALYZER_CHANNELS_MAX   128
+#define SUBGHZ_FREQUENCY_ANALYZER_SPECTRUM_FLOOR -110.0f
 
 typedef struct SubGhzFrequencyAnalyzerWorker SubGhzFrequencyAnalyzerWorker;
 
@@ -13,6 +15,21 @@ typedef void (*SubGhzFrequencyAnalyzerWorkerPairCallback)(
     float rssi,
     bool signal);
 
+/** Per-channel RSSI with peak hold and sweep metrics, channels are sorted by frequency */
+typedef struct {
+    uint8_t channels_count;
+    uint8_t hot_count; /**< Channels rescanned between full sweeps */
+    uint16_t channels_per_second;
+    uint16_t full_sweep_ms; /**< Duration of the last full sweep */
+    uint32_t frequency_min;
+    uint32_t frequency_max;
+    uint8_t level[SUBGHZ_FREQUENCY_ANALYZER_CHANNELS_MAX]; /**< dB above spectrum floor */
+} SubGhzFrequencyAnalyzerSpectrum;
+
+typedef void (*SubGhzFrequencyAnalyzerWorkerSpectrumCallback)(
+    void* context,
+    const SubGhzFrequencyAnalyzerSpectrum* spectrum);
+
 typedef struct {
     uint32_t frequency_coarse;
     float rssi_coarse;
@@ -44,6 +61,17 @@ void subghz_frequency_analyzer_worker_set_pair_callback(
     SubGhzFrequencyAnalyzerWorkerPairCallback callback,
     void* context);
 
+/** Spectrum callback SubGhzFrequencyAnalyzerWorker, called from worker thread after each sweep
+ * 
+ * @param instance SubGhzFrequencyAnalyzerWorker instance
+ * @param callback SubGhzFrequencyAnalyzerWorkerSpectrumCallback callback
+ * @param context 
+ */
+void subghz_frequency_analyzer_worker_set_spectrum_callback(
+    SubGhzFrequencyAnalyzerWorker* instance,
+    SubGhzFrequencyAnalyzerWorkerSpectrumCallback callback,
+    void* context);
+
 /** Start SubGhzFrequencyAnalyzerWorker
  * 
  * @param instance SubGhzFrequencyAnalyzerWorker instance
@@ -61,6 +61,17 @@ static void subghz_scene_receiver_update_statusbar(void* context) {
         subghz->subghz_receiver, subghz_txrx_radio_device_get(subghz->txrx));
 }
 
+static void subghz_scene_receiver_item_callback(
+    uint16_t idx,
+    FuriString* item_str,
+    uint8_t* type,
+    void* context) {
+    furi_assert(context);
+    SubGhz* subghz = context;
+    subghz_history_get_text_item_menu(subghz->history, item_str, idx);
+    *type = subghz_history_get_type_protocol(subghz->history, idx);
+}
+
 void subghz_scene_receiver_callback(SubGhzCustomEvent event, void* context) {
     furi_assert(context);
     SubGhz* subghz = context;
@@ -74,25 +85,17 @@ static void subghz_scene_add_to_history_callback(
     furi_assert(context);
     SubGhz* subghz = context;
     SubGhzHistory* history = subghz->history;
-    FuriString* str_buff = furi_string_alloc();
 
     SubGhzRadioPreset preset = subghz_txrx_get_preset(subghz->txrx);
 
-    if(subghz_history_add_to_history(history, decoder_base, &preset)) {
-        furi_string_reset(str_buff);
-
+    if(subghz_history_add_to_history(
+           history, decoder_base, &preset, subghz_txrx_radio_device_get_rssi(subghz->txrx))) {
         subghz->state_notifications = SubGhzNotificationStateRxDone;
-        uint16_t item_history = subghz_history_get_item(history);
-        subghz_history_get_text_item_menu(history, str_buff, item_history - 1);
-        subghz_view_receiver_add_item_to_menu(
-            subghz->subghz_receiver,
-            furi_string_get_cstr(str_buff),
-            subghz_history_get_type_protocol(history, item_history - 1));
-
-        subghz_scene_receiver_update_statusbar(subghz);
+        // Journal and list are updated from the GUI thread
+        view_dispatcher_send_custom_event(
+            subghz->view_dispatcher, SubGhzCustomEventSceneReceiverUpdate);
     }
     subghz_receiver_reset(receiver);
-    furi_string_free(str_buff);
     subghz_rx_key_state_set(subghz, SubGhzRxKeyStateAddKey);
 }
 
@@ -100,9 +103,6 @@ void subghz_scene_receiver_on_enter(void* context) {
     SubGhz* subghz = context;
     SubGhzHistory* history = subghz->history;
 
-    FuriString* str_buff;
-    str_buff = furi_string_alloc();
-
     if(subghz_rx_key_state_get(subghz) == SubGhzRxKeyStateIDLE) {
         subghz_set_default_preset(subghz);
         subghz_history_reset(history);
@@ -113,16 +113,12 @@ void subghz_scene_receiver_on_enter(void* context) {
 
     //Load history to receiver
     subghz_view_receiver_exit(subghz->subghz_receiver);
-    for(uint8_t i = 0; i < subghz_history_get_item(history); i++) {
-        furi_string_reset(str_buff);
-        subghz_history_get_text_item_menu(history, str_buff, i);
-        subghz_view_receiver_add_item_to_menu(
-            subghz->subghz_receiver,
-            furi_string_get_cstr(str_buff),
-            subghz_history_get_type_protocol(history, i));
+    subghz_view_receiver_set_item_callback(
+        subghz->subghz_receiver, subghz_scene_receiver_item_callback, subghz);
+    subghz_view_receiver_set_item_count(subghz->subghz_receiver, subghz_history_get_item(history));
+    if(subghz_history_get_item(history)) {
         subghz_rx_key_state_set(subghz, SubGhzRxKeyStateAddKey);
     }
-    furi_string_free(str_buff);
 
     subghz_view_receiver_set_callback(
         subghz->subghz_receiver, subghz_scene_receiver_callback, subghz);
@@ -185,6 +181,13 @@ bool subghz_scene_receiver_on_event(void* context, SceneManagerEvent event) {
             subghz_unlock(subghz);
             consumed = true;
             break;
+        case SubGhzCustomEventSceneReceiverUpdate:
+            subghz_history_flush(subghz->history);
+            subghz_view_receiver_set_item_count(
+                subghz->subghz_receiver, subghz_history_get_item(subghz->history));
+            subghz_scene_receiver_update_statusbar(subghz);
+            consumed = true;
+            break;
         default:
             break;
         }
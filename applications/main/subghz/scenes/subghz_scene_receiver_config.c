@@ -9,6 +9,7 @@ enum SubGhzSettingIndex {
     SubGhzSettingIndexSound,
     SubGhzSettingIndexLock,
     SubGhzSettingIndexRAWThesholdRSSI,
+    SubGhzSettingIndexRAWFormat,
 };
 
 #define RAW_THRESHOLD_RSSI_COUNT 11
@@ -40,6 +41,16 @@ const float raw_theshold_rssi_value[RAW_THRESHOLD_RSSI_COUNT] = {
     -40.0f,
 };
 
+#define RAW_FORMAT_COUNT 2
+const char* const raw_format_text[RAW_FORMAT_COUNT] = {
+    "Text",
+    "Binary",
+};
+const uint32_t raw_format_value[RAW_FORMAT_COUNT] = {
+    SubGhzRawEncodingText,
+    SubGhzRawEncodingVarint,
+};
+
 #define HOPPING_COUNT 2
 const char* const hopping_text[HOPPING_COUNT] = {
     "OFF",
@@ -231,6 +242,14 @@ static void subghz_scene_receiver_config_set_raw_threshold_rssi(VariableItem* it
     subghz_threshold_rssi_set(subghz->threshold_rssi, raw_theshold_rssi_value[index]);
 }
 
+static void subghz_scene_receiver_config_set_raw_format(VariableItem* item) {
+    SubGhz* subghz = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+
+    variable_item_set_current_value_text(item, raw_format_text[index]);
+    subghz->raw_encoding = raw_format_value[index];
+}
+
 static void subghz_scene_receiver_config_var_list_enter_callback(void* context, uint32_t index) {
     furi_assert(context);
     SubGhz* subghz = context;
@@ -339,6 +358,16 @@ void subghz_scene_receiver_config_on_enter(void* context) {
             RAW_THRESHOLD_RSSI_COUNT);
         variable_item_set_current_value_index(item, value_index);
         variable_item_set_current_value_text(item, raw_theshold_rssi_text[value_index]);
+
+        item = variable_item_list_add(
+            subghz->variable_item_list,
+            "RAW Format:",
+            RAW_FORMAT_COUNT,
+            subghz_scene_receiver_config_set_raw_format,
+            subghz);
+        value_index = value_index_uint32(subghz->raw_encoding, raw_format_value, RAW_FORMAT_COUNT);
+        variable_item_set_current_value_index(item, value_index);
+        variable_item_set_current_value_text(item, raw_format_text[value_index]);
     }
     view_dispatcher_switch_to_view(subghz->view_dispatcher, SubGhzViewIdVariableItemList);
 }
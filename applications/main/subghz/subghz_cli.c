@@ -9,6 +9,7 @@
 #include <lib/subghz/receiver.h>
 #include <lib/subghz/transmitter.h>
 #include <lib/subghz/subghz_file_encoder_worker.h>
+#include <lib/subghz/subghz_raw_codec.h>
 #include <lib/subghz/protocols/protocol_items.h>
 #include <lib/subghz/devices/cc1101_int/cc1101_int_interconnect.h>
 #include <lib/subghz/devices/devices.h>
@@ -831,6 +832,8 @@ static void subghz_cli_command_print_usage(void) {
     printf("\tdecode_raw <file_name: path_RAW_file>\t - Testing\r\n");
     printf(
         "\ttx_from_file <file_name: path_file> <repeat: count> <device: 0 - CC1101_INT, 1 - CC1101_EXT>\t - Transmitting from file\r\n");
+    printf(
+        "\traw_convert <path_RAW_file> <path_output_file> <encoding: text, varint, heatshrink>\t - Convert RAW file\r\n");
 
     if(furi_hal_rtc_is_flag_set(FuriHalRtcFlagDebug)) {
         printf("\r\n");
@@ -924,6 +927,57 @@ static void subghz_cli_command_encrypt_raw(Cli* cli, FuriString* args) {
     furi_string_free(source);
 }
 
+static void subghz_cli_command_raw_convert(Cli* cli, FuriString* args) {
+    UNUSED(cli);
+
+    FuriString* source;
+    FuriString* destination;
+    FuriString* encoding_name;
+    source = furi_string_alloc();
+    destination = furi_string_alloc();
+    encoding_name = furi_string_alloc();
+
+    do {
+        if(!args_read_string_and_trim(args, source) ||
+           !args_read_string_and_trim(args, destination) ||
+           !args_read_string_and_trim(args, encoding_name)) {
+            subghz_cli_command_print_usage();
+            break;
+        }
+
+        SubGhzRawEncoding encoding;
+        if(furi_string_cmp_str(encoding_name, "text") == 0) {
+            encoding = SubGhzRawEncodingText;
+        } else if(furi_string_cmp_str(encoding_name, "varint") == 0) {
+            encoding = SubGhzRawEncodingVarint;
+        } else if(furi_string_cmp_str(encoding_name, "heatshrink") == 0) {
+            encoding = SubGhzRawEncodingHeatshrink;
+        } else {
+            subghz_cli_command_print_usage();
+            break;
+        }
+
+        if(furi_string_cmp(source, destination) == 0) {
+            printf("Source and destination must differ\r\n");
+            break;
+        }
+
+        Storage* storage = furi_record_open(RECORD_STORAGE);
+        bool success = subghz_raw_convert(
+            storage,
+            furi_string_get_cstr(source),
+            furi_string_get_cstr(destination),
+            encoding);
+        furi_record_close(RECORD_STORAGE);
+
+        printf("%s\r\n", success ? "Done" : "Conversion failed");
+    } while(false);
+
+    furi_string_free(encoding_name);
+    furi_string_free(destination);
+    furi_string_free(source);
+}
+
 static void subghz_cli_command_chat(Cli* cli, FuriString* args) {
     uint32_t frequency = 433920000;
     uint32_t device_ind = 0; // 0 - CC1101_INT, 1 - CC1101_EXT
@@ -1160,6 +1214,11 @@ static void subghz_cli_command(Cli* cli, FuriString* args, void* context) {
             break;
         }
 
+        if(furi_string_cmp_str(cmd, "raw_convert") == 0) {
+            subghz_cli_command_raw_convert(cli, args);
+            break;
+        }
+
         if(furi_hal_rtc_is_flag_set(FuriHalRtcFlagDebug)) {
             if(furi_string_cmp_str(cmd, "encrypt_keeloq") == 0) {
                 subghz_cli_command_encrypt_keeloq(cli, args);
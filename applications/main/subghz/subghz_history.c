@@ -1,240 +1,580 @@
 #include "subghz_history.h"
 #include <lib/subghz/receiver.h>
-#include <lib/subghz/protocols/came.h>
+#include <lib/subghz/protocols/protocol_items.h>
+#include <flipper_format/flipper_format_i.h>
+#include <toolbox/stream/file_stream.h>
+#include <m-array.h>
 
 #include <furi.h>
 
-#define SUBGHZ_HISTORY_MAX       50
-#define SUBGHZ_HISTORY_FREE_HEAP 20480
+#define SUBGHZ_HISTORY_MAX           9999
+#define SUBGHZ_HISTORY_RAM_RECORDS   50
+#define SUBGHZ_HISTORY_FREE_HEAP     20480
+#define SUBGHZ_HISTORY_DEDUP_SIZE    16
+#define SUBGHZ_HISTORY_DEDUP_WINDOW  500
+#define SUBGHZ_HISTORY_ITEM_STR_SIZE 32
+#define SUBGHZ_HISTORY_INDEX_PATH    SUBGHZ_APP_FOLDER "/.history_index"
+#define SUBGHZ_HISTORY_DATA_PATH     SUBGHZ_APP_FOLDER "/.history_data"
 
 #define TAG "SubGhzHistory"
 
-typedef struct {
-    FuriString* item_str;
-    FlipperFormat* flipper_string;
-    uint8_t type;
-    SubGhzRadioPreset* preset;
-} SubGhzHistoryItem;
+typedef struct FURI_PACKED {
+    uint32_t timestamp;
+    uint32_t frequency;
+    uint64_t key;
+    uint32_t data_offset;
+    uint16_t data_size;
+    uint16_t bit_count;
+    uint8_t protocol_id;
+    uint8_t protocol_type;
+    uint8_t preset_id;
+    int8_t rssi;
+    char item_str[SUBGHZ_HISTORY_ITEM_STR_SIZE];
+} SubGhzHistoryRecord;
 
-ARRAY_DEF(SubGhzHistoryItemArray, SubGhzHistoryItem, M_POD_OPLIST)
+typedef struct {
+    uint16_t hash;
+    uint32_t timestamp;
+} SubGhzHistoryDedupEntry;
 
-#define M_OPL_SubGhzHistoryItemArray_t() ARRAY_OPLIST(SubGhzHistoryItemArray, M_POD_OPLIST)
+ARRAY_DEF(SubGhzHistoryPresetArray, SubGhzRadioPreset, M_POD_OPLIST)
 
-typedef struct {
-    SubGhzHistoryItemArray_t data;
-} SubGhzHistoryStruct;
+#define M_OPL_SubGhzHistoryPresetArray_t() ARRAY_OPLIST(SubGhzHistoryPresetArray, M_POD_OPLIST)
 
+// Items are added from the worker thread and only touch RAM there. Journal
+// files are written by subghz_history_flush and read only from the GUI thread.
 struct SubGhzHistory {
-    uint32_t last_update_timestamp;
-    uint16_t last_index_write;
-    uint8_t code_last_hash_data;
+    FuriMutex* mutex;
+    Storage* storage;
+    // Serialized items, one after another
+    Stream* data_stream;
+    // Records that do not fit into RAM ring
+    File* index_file;
+    // Without journal history is limited to RAM ring
+    bool journal_ok;
+
+    // Records [spilled_count, count) are in RAM
+    SubGhzHistoryRecord ring[SUBGHZ_HISTORY_RAM_RECORDS];
+    // Serialized data of records [flushed_count, count)
+    FlipperFormat* ring_data[SUBGHZ_HISTORY_RAM_RECORDS];
+    uint16_t count;
+    uint16_t flushed_count;
+    uint16_t spilled_count;
+
+    SubGhzHistoryDedupEntry dedup[SUBGHZ_HISTORY_DEDUP_SIZE];
+    SubGhzHistoryPresetArray_t presets;
+
+    FlipperFormat* item_data;
+    SubGhzRadioPreset item_preset;
     FuriString* tmp_string;
-    SubGhzHistoryStruct* history;
 };
 
+static void subghz_history_journal_close(SubGhzHistory* instance) {
+    if(instance->journal_ok) {
+        file_stream_close(instance->data_stream);
+        storage_file_close(instance->index_file);
+        storage_simply_remove(instance->storage, SUBGHZ_HISTORY_DATA_PATH);
+        storage_simply_remove(instance->storage, SUBGHZ_HISTORY_INDEX_PATH);
+        instance->journal_ok = false;
+    }
+}
+
+static void subghz_history_journal_open(SubGhzHistory* instance) {
+    subghz_history_journal_close(instance);
+
+    do {
+        if(!storage_simply_mkdir(instance->storage, SUBGHZ_APP_FOLDER)) break;
+        if(!file_stream_open(
+               instance->data_stream,
+               SUBGHZ_HISTORY_DATA_PATH,
+               FSAM_READ_WRITE,
+               FSOM_CREATE_ALWAYS)) {
+            file_stream_close(instance->data_stream);
+            break;
+        }
+        if(!storage_file_open(
+               instance->index_file,
+               SUBGHZ_HISTORY_INDEX_PATH,
+               FSAM_READ_WRITE,
+               FSOM_CREATE_ALWAYS)) {
+            storage_file_close(instance->index_file);
+            file_stream_close(instance->data_stream);
+            break;
+        }
+        instance->journal_ok = true;
+    } while(false);
+
+    if(!instance->journal_ok) {
+        FURI_LOG_E(TAG, "Unable to open journal, history is limited to RAM");
+    }
+}
+
+static void subghz_history_ring_data_reset(SubGhzHistory* instance) {
+    for(size_t i = 0; i < SUBGHZ_HISTORY_RAM_RECORDS; i++) {
+        if(instance->ring_data[i]) {
+            flipper_format_free(instance->ring_data[i]);
+            instance->ring_data[i] = NULL;
+        }
+    }
+}
+
+static void subghz_history_presets_reset(SubGhzHistory* instance) {
+    for
+        M_EACH(preset, instance->presets, SubGhzHistoryPresetArray_t) {
+            furi_string_free(preset->name);
+        }
+    SubGhzHistoryPresetArray_reset(instance->presets);
+}
+
 SubGhzHistory* subghz_history_alloc(void) {
     SubGhzHistory* instance = malloc(sizeof(SubGhzHistory));
+    instance->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    instance->storage = furi_record_open(RECORD_STORAGE);
+    instance->data_stream = file_stream_alloc(instance->storage);
+    instance->index_file = storage_file_alloc(instance->storage);
+    SubGhzHistoryPresetArray_init(instance->presets);
+    instance->item_data = flipper_format_string_alloc();
+    instance->item_preset.name = furi_string_alloc();
     instance->tmp_string = furi_string_alloc();
-    instance->history = malloc(sizeof(SubGhzHistoryStruct));
-    SubGhzHistoryItemArray_init(instance->history->data);
     return instance;
 }
 
 void subghz_history_free(SubGhzHistory* instance) {
     furi_assert(instance);
+    subghz_history_journal_close(instance);
+    subghz_history_ring_data_reset(instance);
+    subghz_history_presets_reset(instance);
+    SubGhzHistoryPresetArray_clear(instance->presets);
     furi_string_free(instance->tmp_string);
-    for
-        M_EACH(item, instance->history->data, SubGhzHistoryItemArray_t) {
-            furi_string_free(item->item_str);
-            furi_string_free(item->preset->name);
-            free(item->preset);
-            flipper_format_free(item->flipper_string);
-            item->type = 0;
-        }
-    SubGhzHistoryItemArray_clear(instance->history->data);
-    free(instance->history);
+    furi_string_free(instance->item_preset.name);
+    flipper_format_free(instance->item_data);
+    storage_file_free(instance->index_file);
+    stream_free(instance->data_stream);
+    furi_record_close(RECORD_STORAGE);
+    furi_mutex_free(instance->mutex);
     free(instance);
 }
 
-uint32_t subghz_history_get_frequency(SubGhzHistory* instance, uint16_t idx) {
+void subghz_history_reset(SubGhzHistory* instance) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return item->preset->frequency;
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+
+    subghz_history_journal_open(instance);
+    subghz_history_ring_data_reset(instance);
+    subghz_history_presets_reset(instance);
+    memset(instance->dedup, 0, sizeof(instance->dedup));
+    instance->count = 0;
+    instance->flushed_count = 0;
+    instance->spilled_count = 0;
+
+    furi_check(furi_mutex_release(instance->mutex) == FuriStatusOk);
 }
 
-SubGhzRadioPreset* subghz_history_get_radio_preset(SubGhzHistory* instance, uint16_t idx) {
+static bool subghz_history_get_record(
+    SubGhzHistory* instance,
+    uint16_t idx,
+    SubGhzHistoryRecord* record) {
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    furi_check(idx < instance->count);
+    bool in_ram = idx >= instance->spilled_count;
+    if(in_ram) {
+        *record = instance->ring[idx % SUBGHZ_HISTORY_RAM_RECORDS];
+    }
+    furi_check(furi_mutex_release(instance->mutex) == FuriStatusOk);
+
+    if(in_ram) return true;
+
+    // Spilled records never change, no need to hold the worker while reading them
+    if(storage_file_seek(instance->index_file, idx * sizeof(SubGhzHistoryRecord), true) &&
+       storage_file_read(instance->index_file, record, sizeof(SubGhzHistoryRecord)) ==
+           sizeof(SubGhzHistoryRecord)) {
+        return true;
+    }
+
+    FURI_LOG_E(TAG, "Unable to read record %u", idx);
+    memset(record, 0, sizeof(SubGhzHistoryRecord));
+    return false;
+}
+
+static bool subghz_history_flush_data(SubGhzHistory* instance) {
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    uint16_t idx = instance->flushed_count;
+    FlipperFormat* data = NULL;
+    if(idx < instance->count) {
+        data = instance->ring_data[idx % SUBGHZ_HISTORY_RAM_RECORDS];
+    }
+    furi_check(furi_mutex_release(instance->mutex) == FuriStatusOk);
+
+    if(!data) return false;
+
+    Stream* stream = flipper_format_get_raw_stream(data);
+    size_t data_size = stream_size(stream);
+    if(!stream_seek(instance->data_stream, 0, StreamOffsetFromEnd)) return false;
+    uint32_t data_offset = stream_tell(instance->data_stream);
+    stream_rewind(stream);
+    if(stream_copy(stream, instance->data_stream, data_size) != data_size) {
+        FURI_LOG_E(TAG, "Unable to write item data");
+        return false;
+    }
+
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    SubGhzHistoryRecord* record = &instance->ring[idx % SUBGHZ_HISTORY_RAM_RECORDS];
+    record->data_offset = data_offset;
+    record->data_size = data_size;
+    instance->ring_data[idx % SUBGHZ_HISTORY_RAM_RECORDS] = NULL;
+    instance->flushed_count++;
+    furi_check(furi_mutex_release(instance->mutex) == FuriStatusOk);
+
+    flipper_format_free(data);
+    return true;
+}
+
+static bool subghz_history_spill(SubGhzHistory* instance) {
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    uint16_t idx = instance->spilled_count;
+    // Keep half of the ring free for items received before the next flush
+    bool spill = idx < instance->flushed_count &&
+                 instance->count - idx > SUBGHZ_HISTORY_RAM_RECORDS / 2;
+    SubGhzHistoryRecord record = instance->ring[idx % SUBGHZ_HISTORY_RAM_RECORDS];
+    furi_check(furi_mutex_release(instance->mutex) == FuriStatusOk);
+
+    if(!spill) return false;
+
+    if(!storage_file_seek(instance->index_file, idx * sizeof(SubGhzHistoryRecord), true) ||
+       storage_file_write(instance->index_file, &record, sizeof(SubGhzHistoryRecord)) !=
+           sizeof(SubGhzHistoryRecord)) {
+        FURI_LOG_E(TAG, "Unable to spill record");
+        return false;
+    }
+
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    instance->spilled_count++;
+    furi_check(furi_mutex_release(instance->mutex) == FuriStatusOk);
+    return true;
+}
+
+void subghz_history_flush(SubGhzHistory* instance) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return item->preset;
+    if(!instance->journal_ok) return;
+
+    while(subghz_history_flush_data(instance))
+        ;
+    while(subghz_history_spill(instance))
+        ;
 }
 
-const char* subghz_history_get_preset(SubGhzHistory* instance, uint16_t idx) {
+static void
+    subghz_history_load_preset(SubGhzHistory* instance, const SubGhzHistoryRecord* record) {
+    instance->item_preset.frequency = record->frequency;
+    if(record->preset_id < SubGhzHistoryPresetArray_size(instance->presets)) {
+        SubGhzRadioPreset* preset =
+            SubGhzHistoryPresetArray_get(instance->presets, record->preset_id);
+        furi_string_set(instance->item_preset.name, preset->name);
+        instance->item_preset.data = preset->data;
+        instance->item_preset.data_size = preset->data_size;
+    }
+}
+
+uint32_t subghz_history_get_frequency(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return furi_string_get_cstr(item->preset->name);
+    SubGhzHistoryRecord record;
+    subghz_history_get_record(instance, idx, &record);
+    return record.frequency;
 }
 
-void subghz_history_reset(SubGhzHistory* instance) {
+SubGhzRadioPreset* subghz_history_get_radio_preset(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    furi_string_reset(instance->tmp_string);
-    for
-        M_EACH(item, instance->history->data, SubGhzHistoryItemArray_t) {
-            furi_string_free(item->item_str);
-            furi_string_free(item->preset->name);
-            free(item->preset);
-            flipper_format_free(item->flipper_string);
-            item->type = 0;
-        }
-    SubGhzHistoryItemArray_reset(instance->history->data);
-    instance->last_index_write = 0;
-    instance->code_last_hash_data = 0;
+    SubGhzHistoryRecord record;
+    subghz_history_get_record(instance, idx, &record);
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    subghz_history_load_preset(instance, &record);
+    furi_check(furi_mutex_release(instance->mutex) == FuriStatusOk);
+    return &instance->item_preset;
+}
+
+const char* subghz_history_get_preset(SubGhzHistory* instance, uint16_t idx) {
+    furi_assert(instance);
+    return furi_string_get_cstr(subghz_history_get_radio_preset(instance, idx)->name);
 }
 
 uint16_t subghz_history_get_item(SubGhzHistory* instance) {
     furi_assert(instance);
-    return instance->last_index_write;
+    return instance->count;
 }
 
 uint8_t subghz_history_get_type_protocol(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return item->type;
+    SubGhzHistoryRecord record;
+    subghz_history_get_record(instance, idx, &record);
+    return record.protocol_type;
 }
 
 const char* subghz_history_get_protocol_name(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    flipper_format_rewind(item->flipper_string);
-    if(!flipper_format_read_string(item->flipper_string, "Protocol", instance->tmp_string)) {
-        FURI_LOG_E(TAG, "Missing Protocol");
-        furi_string_reset(instance->tmp_string);
-    }
-    return furi_string_get_cstr(instance->tmp_string);
+    SubGhzHistoryRecord record;
+    subghz_history_get_record(instance, idx, &record);
+
+    const SubGhzProtocol* protocol =
+        subghz_protocol_registry_get_by_index(&subghz_protocol_registry, record.protocol_id);
+    return protocol ? protocol->name : "";
 }
 
 FlipperFormat* subghz_history_get_raw_data(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    if(item->flipper_string) {
-        return item->flipper_string;
+
+    FlipperFormat* result = NULL;
+    Stream* item_stream = flipper_format_get_raw_stream(instance->item_data);
+    stream_clean(item_stream);
+
+    SubGhzHistoryRecord record;
+    if(subghz_history_get_record(instance, idx, &record)) {
+        furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+        FlipperFormat* data = NULL;
+        if(idx >= instance->flushed_count) {
+            data = instance->ring_data[idx % SUBGHZ_HISTORY_RAM_RECORDS];
+        }
+        if(data) {
+            // Not flushed yet, data is still in RAM
+            Stream* data_stream = flipper_format_get_raw_stream(data);
+            if(stream_copy_full(data_stream, item_stream) == stream_size(data_stream)) {
+                result = instance->item_data;
+            }
+        }
+        furi_check(furi_mutex_release(instance->mutex) == FuriStatusOk);
+
+        if(!data &&
+           stream_seek(instance->data_stream, record.data_offset, StreamOffsetFromStart) &&
+           stream_copy(instance->data_stream, item_stream, record.data_size) ==
+               record.data_size) {
+            result = instance->item_data;
+        }
+    }
+
+    if(result) {
+        flipper_format_rewind(result);
     } else {
-        return NULL;
+        FURI_LOG_E(TAG, "Unable to load item %u", idx);
     }
+
+    return result;
 }
+
 bool subghz_history_get_text_space_left(SubGhzHistory* instance, FuriString* output) {
     furi_assert(instance);
-    if(memmgr_get_free_heap() < SUBGHZ_HISTORY_FREE_HEAP) {
-        if(output != NULL) furi_string_printf(output, "    Free heap LOW");
-        return true;
+    if(!instance->journal_ok) {
+        if(memmgr_get_free_heap() < SUBGHZ_HISTORY_FREE_HEAP) {
+            if(output != NULL) furi_string_printf(output, "    Free heap LOW");
+            return true;
+        }
+        if(instance->count == SUBGHZ_HISTORY_RAM_RECORDS) {
+            if(output != NULL) furi_string_printf(output, "   Memory is FULL");
+            return true;
+        }
+        if(output != NULL) {
+            furi_string_printf(output, "%02u/%02u", instance->count, SUBGHZ_HISTORY_RAM_RECORDS);
+        }
+        return false;
     }
-    if(instance->last_index_write == SUBGHZ_HISTORY_MAX) {
+    if(instance->count == SUBGHZ_HISTORY_MAX) {
         if(output != NULL) furi_string_printf(output, "   Memory is FULL");
         return true;
     }
-    if(output != NULL)
-        furi_string_printf(output, "%02u/%02u", instance->last_index_write, SUBGHZ_HISTORY_MAX);
+    if(output != NULL) furi_string_printf(output, "%02u", instance->count);
     return false;
 }
 
 void subghz_history_get_text_item_menu(SubGhzHistory* instance, FuriString* output, uint16_t idx) {
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    furi_string_set(output, item->item_str);
+    furi_assert(instance);
+    SubGhzHistoryRecord record;
+    subghz_history_get_record(instance, idx, &record);
+
+    furi_string_set_strn(
+        output, record.item_str, strnlen(record.item_str, sizeof(record.item_str)));
 }
 
-bool subghz_history_add_to_history(
-    SubGhzHistory* instance,
-    void* context,
-    SubGhzRadioPreset* preset) {
-    furi_assert(instance);
-    furi_assert(context);
+static bool subghz_history_is_duplicate(SubGhzHistory* instance, uint16_t hash) {
+    uint32_t now = furi_get_tick();
+    SubGhzHistoryDedupEntry* oldest = &instance->dedup[0];
 
-    if(memmgr_get_free_heap() < SUBGHZ_HISTORY_FREE_HEAP) return false;
-    if(instance->last_index_write >= SUBGHZ_HISTORY_MAX) return false;
+    for(size_t i = 0; i < SUBGHZ_HISTORY_DEDUP_SIZE; i++) {
+        SubGhzHistoryDedupEntry* entry = &instance->dedup[i];
+        if(entry->hash == hash && (now - entry->timestamp) < SUBGHZ_HISTORY_DEDUP_WINDOW) {
+            // Repeats of the same transmission keep it suppressed
+            entry->timestamp = now;
+            return true;
+        }
+        if(entry->timestamp < oldest->timestamp) {
+            oldest = entry;
+        }
+    }
 
-    SubGhzProtocolDecoderBase* decoder_base = context;
-    if((instance->code_last_hash_data ==
-        subghz_protocol_decoder_base_get_hash_data(decoder_base)) &&
-       ((furi_get_tick() - instance->last_update_timestamp) < 500)) {
-        instance->last_update_timestamp = furi_get_tick();
-        return false;
+    oldest->hash = hash;
+    oldest->timestamp = now;
+    return false;
+}
+
+static bool subghz_history_get_protocol_id(const SubGhzProtocol* protocol, uint8_t* protocol_id) {
+    size_t count = subghz_protocol_registry_count(&subghz_protocol_registry);
+    for(size_t i = 0; i < count && i <= UINT8_MAX; i++) {
+        if(subghz_protocol_registry_get_by_index(&subghz_protocol_registry, i) == protocol) {
+            *protocol_id = i;
+            return true;
+        }
     }
+    return false;
+}
 
-    instance->code_last_hash_data = subghz_protocol_decoder_base_get_hash_data(decoder_base);
-    instance->last_update_timestamp = furi_get_tick();
+static bool subghz_history_get_preset_id(
+    SubGhzHistory* instance,
+    const SubGhzRadioPreset* preset,
+    uint8_t* preset_id) {
+    size_t count = SubGhzHistoryPresetArray_size(instance->presets);
+    for(size_t i = 0; i < count; i++) {
+        SubGhzRadioPreset* item = SubGhzHistoryPresetArray_get(instance->presets, i);
+        if(item->data == preset->data && item->data_size == preset->data_size &&
+           furi_string_equal(item->name, preset->name)) {
+            *preset_id = i;
+            return true;
+        }
+    }
 
-    FuriString* text;
-    text = furi_string_alloc();
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_push_raw(instance->history->data);
-    item->preset = malloc(sizeof(SubGhzRadioPreset));
-    item->type = decoder_base->protocol->type;
-    item->preset->frequency = preset->frequency;
-    item->preset->name = furi_string_alloc();
-    furi_string_set(item->preset->name, preset->name);
-    item->preset->data = preset->data;
-    item->preset->data_size = preset->data_size;
+    if(count > UINT8_MAX) return false;
 
-    item->item_str = furi_string_alloc();
-    item->flipper_string = flipper_format_string_alloc();
-    subghz_protocol_decoder_base_serialize(decoder_base, item->flipper_string, preset);
+    SubGhzRadioPreset* item = SubGhzHistoryPresetArray_push_raw(instance->presets);
+    item->name = furi_string_alloc_set(preset->name);
+    item->data = preset->data;
+    item->data_size = preset->data_size;
+    *preset_id = count;
+    return true;
+}
+
+static void subghz_history_fill_item_str(
+    SubGhzHistory* instance,
+    FlipperFormat* flipper_format,
+    SubGhzHistoryRecord* record) {
+    FuriString* text = furi_string_alloc();
+    FuriString* item_str = furi_string_alloc();
 
     do {
-        if(!flipper_format_rewind(item->flipper_string)) {
+        if(!flipper_format_rewind(flipper_format)) {
             FURI_LOG_E(TAG, "Rewind error");
             break;
         }
-        if(!flipper_format_read_string(item->flipper_string, "Protocol", instance->tmp_string)) {
+        if(!flipper_format_read_string(flipper_format, "Protocol", instance->tmp_string)) {
             FURI_LOG_E(TAG, "Missing Protocol");
             break;
         }
         if(!strcmp(furi_string_get_cstr(instance->tmp_string), "KeeLoq")) {
             furi_string_set(instance->tmp_string, "KL ");
-            if(!flipper_format_read_string(item->flipper_string, "Manufacture", text)) {
+            if(!flipper_format_read_string(flipper_format, "Manufacture", text)) {
                 FURI_LOG_E(TAG, "Missing Protocol");
                 break;
             }
             furi_string_cat(instance->tmp_string, text);
         } else if(!strcmp(furi_string_get_cstr(instance->tmp_string), "Star Line")) {
             furi_string_set(instance->tmp_string, "SL ");
-            if(!flipper_format_read_string(item->flipper_string, "Manufacture", text)) {
+            if(!flipper_format_read_string(flipper_format, "Manufacture", text)) {
                 FURI_LOG_E(TAG, "Missing Protocol");
                 break;
             }
             furi_string_cat(instance->tmp_string, text);
         }
-        if(!flipper_format_rewind(item->flipper_string)) {
+        if(!flipper_format_rewind(flipper_format)) {
             FURI_LOG_E(TAG, "Rewind error");
             break;
         }
+        uint32_t bit_count = 0;
+        if(flipper_format_read_uint32(flipper_format, "Bit", &bit_count, 1)) {
+            record->bit_count = bit_count;
+        }
         uint8_t key_data[sizeof(uint64_t)] = {0};
-        if(!flipper_format_read_hex(item->flipper_string, "Key", key_data, sizeof(uint64_t))) {
+        if(!flipper_format_read_hex(flipper_format, "Key", key_data, sizeof(uint64_t))) {
             FURI_LOG_D(TAG, "No Key");
         }
         uint64_t data = 0;
         for(uint8_t i = 0; i < sizeof(uint64_t); i++) {
             data = (data << 8) | key_data[i];
         }
+        record->key = data;
         if(data != 0) {
             if(!(uint32_t)(data >> 32)) {
                 furi_string_printf(
-                    item->item_str,
+                    item_str,
                     "%s %lX",
                     furi_string_get_cstr(instance->tmp_string),
                     (uint32_t)(data & 0xFFFFFFFF));
             } else {
                 furi_string_printf(
-                    item->item_str,
+                    item_str,
                     "%s %lX%08lX",
                     furi_string_get_cstr(instance->tmp_string),
                     (uint32_t)(data >> 32),
                     (uint32_t)(data & 0xFFFFFFFF));
             }
         } else {
-            furi_string_printf(item->item_str, "%s", furi_string_get_cstr(instance->tmp_string));
+            furi_string_printf(item_str, "%s", furi_string_get_cstr(instance->tmp_string));
         }
-
     } while(false);
 
+    strlcpy(record->item_str, furi_string_get_cstr(item_str), sizeof(record->item_str));
+
+    furi_string_free(item_str);
     furi_string_free(text);
-    instance->last_index_write++;
-    return true;
+}
+
+bool subghz_history_add_to_history(
+    SubGhzHistory* instance,
+    void* context,
+    SubGhzRadioPreset* preset,
+    float rssi) {
+    furi_assert(instance);
+    furi_assert(context);
+
+    if(instance->count >= SUBGHZ_HISTORY_MAX) return false;
+
+    SubGhzProtocolDecoderBase* decoder_base = context;
+    SubGhzHistoryRecord record = {
+        .timestamp = furi_get_tick(),
+        .frequency = preset->frequency,
+        .protocol_type = decoder_base->protocol->type,
+        .rssi = CLAMP(rssi, INT8_MAX, INT8_MIN),
+    };
+    if(!subghz_history_get_protocol_id(decoder_base->protocol, &record.protocol_id)) {
+        FURI_LOG_E(TAG, "Unknown protocol %s", decoder_base->protocol->name);
+        return false;
+    }
+    uint16_t hash =
+        (record.protocol_id << 8) | subghz_protocol_decoder_base_get_hash_data(decoder_base);
+
+    // Called from the worker thread: data stays in RAM until subghz_history_flush
+    FlipperFormat* flipper_format = flipper_format_string_alloc();
+    subghz_protocol_decoder_base_serialize(decoder_base, flipper_format, preset);
+
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+
+    bool result = false;
+    do {
+        if(instance->count - instance->spilled_count == SUBGHZ_HISTORY_RAM_RECORDS) {
+            if(instance->journal_ok) FURI_LOG_W(TAG, "Flush is behind, item dropped");
+            break;
+        }
+        // Without journal every item stays in RAM
+        if(!instance->journal_ok && memmgr_get_free_heap() < SUBGHZ_HISTORY_FREE_HEAP) break;
+        if(subghz_history_is_duplicate(instance, hash)) break;
+        if(stream_size(flipper_format_get_raw_stream(flipper_format)) > UINT16_MAX) break;
+        if(!subghz_history_get_preset_id(instance, preset, &record.preset_id)) break;
+
+        subghz_history_fill_item_str(instance, flipper_format, &record);
+
+        instance->ring[instance->count % SUBGHZ_HISTORY_RAM_RECORDS] = record;
+        instance->ring_data[instance->count % SUBGHZ_HISTORY_RAM_RECORDS] = flipper_format;
+        flipper_format = NULL;
+        instance->count++;
+        result = true;
+    } while(false);
+
+    furi_check(furi_mutex_release(instance->mutex) == FuriStatusOk);
+    if(flipper_format) flipper_format_free(flipper_format);
+
+    return result;
 }
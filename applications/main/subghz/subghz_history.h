@@ -21,7 +21,7 @@ SubGhzHistory* subghz_history_alloc(void);
  */
 void subghz_history_free(SubGhzHistory* instance);
 
-/** Clear history
+/** Clear history, recreates SD card journal
  * 
  * @param instance - SubGhzHistory instance
  */
@@ -89,17 +89,28 @@ bool subghz_history_get_text_space_left(SubGhzHistory* instance, FuriString* out
  * @param instance  - SubGhzHistory instance
  * @param context    - SubGhzProtocolCommon context
  * @param preset    - SubGhzRadioPreset preset
+ * @param rssi      - RSSI at the moment of receiving, dBm
  * @return bool;
  */
 bool subghz_history_add_to_history(
     SubGhzHistory* instance,
     void* context,
-    SubGhzRadioPreset* preset);
+    SubGhzRadioPreset* preset,
+    float rssi);
 
-/** Get SubGhzProtocolCommonLoad to load into the protocol decoder bin data
+/** Write items added since the last call to SD card journal
+ * 
+ * Must be called from the thread that reads history, not from receiver callback.
+ * Without journal, history keeps items in RAM and this call does nothing.
+ * 
+ * @param instance  - SubGhzHistory instance
+ */
+void subghz_history_flush(SubGhzHistory* instance);
+
+/** Get serialized item data, loaded from RAM or SD card journal
  * 
  * @param instance  - SubGhzHistory instance
  * @param idx       - record index
- * @return SubGhzProtocolCommonLoad*
+ * @return FlipperFormat*, valid until the next call, NULL if item can't be read
  */
 FlipperFormat* subghz_history_get_raw_data(SubGhzHistory* instance, uint16_t idx);
@@ -64,6 +64,7 @@ struct SubGhz {
     FuriString* error_str;
     SubGhzLock lock;
     SubGhzThresholdRssi* threshold_rssi;
+    SubGhzRawEncoding raw_encoding;
     SubGhzRxKeyState rx_key_state;
     SubGhzHistory* history;
     uint16_t idx_menu_chosen;
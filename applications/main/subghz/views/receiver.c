@@ -4,7 +4,6 @@
 #include <input/input.h>
 #include <gui/elements.h>
 #include <assets_icons.h>
-#include <m-array.h>
 
 #define FRAME_HEIGHT 12
 #define MAX_LEN_PX   111
@@ -18,17 +17,6 @@ typedef struct {
     uint8_t type;
 } SubGhzReceiverMenuItem;
 
-ARRAY_DEF(SubGhzReceiverMenuItemArray, SubGhzReceiverMenuItem, M_POD_OPLIST)
-
-#define M_OPL_SubGhzReceiverMenuItemArray_t() \
-    ARRAY_OPLIST(SubGhzReceiverMenuItemArray, M_POD_OPLIST)
-
-struct SubGhzReceiverHistory {
-    SubGhzReceiverMenuItemArray_t data;
-};
-
-typedef struct SubGhzReceiverHistory SubGhzReceiverHistory;
-
 static const Icon* ReceiverItemIcons[] = {
     [SubGhzProtocolTypeUnknown] = &I_Quest_7x8,
     [SubGhzProtocolTypeStatic] = &I_Unlock_7x8,
@@ -49,13 +37,20 @@ struct SubGhzViewReceiver {
     View* view;
     SubGhzViewReceiverCallback callback;
     void* context;
+    SubGhzViewReceiverItemCallback item_callback;
+    void* item_context;
+    // Filled outside of the model lock, then swapped into the window
+    SubGhzReceiverMenuItem fetch[MENU_ITEMS];
 };
 
 typedef struct {
     FuriString* frequency_str;
     FuriString* preset_str;
     FuriString* history_stat_str;
-    SubGhzReceiverHistory* history;
+    // Only visible items are kept, the rest are requested on scroll
+    SubGhzReceiverMenuItem window[MENU_ITEMS];
+    uint16_t window_offset;
+    uint16_t window_size;
     uint16_t idx;
     uint16_t list_offset;
     uint16_t history_item;
@@ -110,6 +105,62 @@ void subghz_view_receiver_set_callback(
     subghz_receiver->context = context;
 }
 
+void subghz_view_receiver_set_item_callback(
+    SubGhzViewReceiver* subghz_receiver,
+    SubGhzViewReceiverItemCallback callback,
+    void* context) {
+    furi_assert(subghz_receiver);
+    subghz_receiver->item_callback = callback;
+    subghz_receiver->item_context = context;
+}
+
+static void subghz_view_receiver_update_window(SubGhzViewReceiver* subghz_receiver) {
+    uint16_t list_offset = 0;
+    uint16_t window_size = 0;
+    bool changed = false;
+
+    with_view_model(
+        subghz_receiver->view,
+        SubGhzViewReceiverModel * model,
+        {
+            list_offset = model->list_offset;
+            if(list_offset < model->history_item) {
+                window_size = MIN(model->history_item - list_offset, MENU_ITEMS);
+            }
+            changed = model->window_offset != list_offset || model->window_size != window_size;
+        },
+        false);
+
+    if(!changed) return;
+
+    // Items may come from SD card, fetch them without holding the model
+    for(uint16_t i = 0; i < window_size; i++) {
+        SubGhzReceiverMenuItem* item_menu = &subghz_receiver->fetch[i];
+        furi_string_reset(item_menu->item_str);
+        item_menu->type = 0;
+        if(subghz_receiver->item_callback) {
+            subghz_receiver->item_callback(
+                list_offset + i,
+                item_menu->item_str,
+                &item_menu->type,
+                subghz_receiver->item_context);
+        }
+    }
+
+    with_view_model(
+        subghz_receiver->view,
+        SubGhzViewReceiverModel * model,
+        {
+            for(uint16_t i = 0; i < window_size; i++) {
+                furi_string_swap(model->window[i].item_str, subghz_receiver->fetch[i].item_str);
+                model->window[i].type = subghz_receiver->fetch[i].type;
+            }
+            model->window_offset = list_offset;
+            model->window_size = window_size;
+        },
+        true);
+}
+
 static void subghz_view_receiver_update_offset(SubGhzViewReceiver* subghz_receiver) {
     furi_assert(subghz_receiver);
 
@@ -130,27 +181,20 @@ static void subghz_view_receiver_update_offset(SubGhzViewReceiver* subghz_receiv
             }
         },
         true);
+    subghz_view_receiver_update_window(subghz_receiver);
 }
 
-void subghz_view_receiver_add_item_to_menu(
-    SubGhzViewReceiver* subghz_receiver,
-    const char* name,
-    uint8_t type) {
+void subghz_view_receiver_set_item_count(SubGhzViewReceiver* subghz_receiver, uint16_t count) {
     furi_assert(subghz_receiver);
     with_view_model(
         subghz_receiver->view,
         SubGhzViewReceiverModel * model,
         {
-            SubGhzReceiverMenuItem* item_menu =
-                SubGhzReceiverMenuItemArray_push_raw(model->history->data);
-            item_menu->item_str = furi_string_alloc_set(name);
-            item_menu->type = type;
-            if(model->idx == model->history_item - 1) {
-                model->history_item++;
-                model->idx++;
-            } else {
-                model->history_item++;
+            // Keep following the newest item if it was selected
+            if(model->history_item && model->idx == model->history_item - 1) {
+                model->idx = count - 1;
             }
+            model->history_item = count;
         },
         true);
     subghz_view_receiver_update_offset(subghz_receiver);
@@ -223,7 +267,10 @@ void subghz_view_receiver_draw(Canvas* canvas, SubGhzViewReceiverModel* model) {
 
     for(size_t i = 0; i < MIN(model->history_item, MENU_ITEMS); ++i) {
         size_t idx = CLAMP((uint16_t)(i + model->list_offset), model->history_item, 0);
-        item_menu = SubGhzReceiverMenuItemArray_get(model->history->data, idx);
+        if(idx < model->window_offset || idx - model->window_offset >= model->window_size) {
+            continue;
+        }
+        item_menu = &model->window[idx - model->window_offset];
         furi_string_set(str_buff, item_menu->item_str);
         elements_string_fit_width(canvas, str_buff, scrollbar ? MAX_LEN_PX - 7 : MAX_LEN_PX);
         if(model->idx == idx) {
@@ -392,15 +439,11 @@ void subghz_view_receiver_exit(void* context) {
             furi_string_reset(model->frequency_str);
             furi_string_reset(model->preset_str);
             furi_string_reset(model->history_stat_str);
-                for
-                    M_EACH(item_menu, model->history->data, SubGhzReceiverMenuItemArray_t) {
-                        furi_string_free(item_menu->item_str);
-                        item_menu->type = 0;
-                    }
-                SubGhzReceiverMenuItemArray_reset(model->history->data);
-                model->idx = 0;
-                model->list_offset = 0;
-                model->history_item = 0;
+            model->idx = 0;
+            model->list_offset = 0;
+            model->history_item = 0;
+            model->window_offset = 0;
+            model->window_size = 0;
         },
         false);
     furi_timer_stop(subghz_receiver->timer);
@@ -414,6 +457,9 @@ SubGhzViewReceiver* subghz_view_receiver_alloc(void) {
 
     subghz_receiver->lock = false;
     subghz_receiver->lock_count = 0;
+    for(size_t i = 0; i < MENU_ITEMS; i++) {
+        subghz_receiver->fetch[i].item_str = furi_string_alloc();
+    }
     view_allocate_model(
         subghz_receiver->view, ViewModelTypeLocking, sizeof(SubGhzViewReceiverModel));
     view_set_context(subghz_receiver->view, subghz_receiver);
@@ -430,8 +476,9 @@ SubGhzViewReceiver* subghz_view_receiver_alloc(void) {
             model->preset_str = furi_string_alloc();
             model->history_stat_str = furi_string_alloc();
             model->bar_show = SubGhzViewReceiverBarShowDefault;
-            model->history = malloc(sizeof(SubGhzReceiverHistory));
-            SubGhzReceiverMenuItemArray_init(model->history->data);
+            for(size_t i = 0; i < MENU_ITEMS; i++) {
+                model->window[i].item_str = furi_string_alloc();
+            }
         },
         true);
     subghz_receiver->timer =
@@ -449,16 +496,15 @@ void subghz_view_receiver_free(SubGhzViewReceiver* subghz_receiver) {
             furi_string_free(model->frequency_str);
             furi_string_free(model->preset_str);
             furi_string_free(model->history_stat_str);
-                for
-                    M_EACH(item_menu, model->history->data, SubGhzReceiverMenuItemArray_t) {
-                        furi_string_free(item_menu->item_str);
-                        item_menu->type = 0;
-                    }
-                SubGhzReceiverMenuItemArray_clear(model->history->data);
-                free(model->history);
+            for(size_t i = 0; i < MENU_ITEMS; i++) {
+                furi_string_free(model->window[i].item_str);
+            }
         },
         false);
     furi_timer_free(subghz_receiver->timer);
+    for(size_t i = 0; i < MENU_ITEMS; i++) {
+        furi_string_free(subghz_receiver->fetch[i].item_str);
+    }
     view_free(subghz_receiver->view);
     free(subghz_receiver);
 }
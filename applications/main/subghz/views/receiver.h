@@ -8,6 +8,13 @@ typedef struct SubGhzViewReceiver SubGhzViewReceiver;
 
 typedef void (*SubGhzViewReceiverCallback)(SubGhzCustomEvent event, void* context);
 
+/** Fill menu item on request, called only for items that become visible */
+typedef void (*SubGhzViewReceiverItemCallback)(
+    uint16_t idx,
+    FuriString* item_str,
+    uint8_t* type,
+    void* context);
+
 void subghz_receiver_rssi(SubGhzViewReceiver* instance, float rssi);
 
 void subghz_view_receiver_set_lock(SubGhzViewReceiver* subghz_receiver, bool keyboard);
@@ -33,10 +40,12 @@ void subghz_view_receiver_set_radio_device_type(
     SubGhzViewReceiver* subghz_receiver,
     SubGhzRadioDeviceType device_type);
 
-void subghz_view_receiver_add_item_to_menu(
+void subghz_view_receiver_set_item_callback(
     SubGhzViewReceiver* subghz_receiver,
-    const char* name,
-    uint8_t type);
+    SubGhzViewReceiverItemCallback callback,
+    void* context);
+
+void subghz_view_receiver_set_item_count(SubGhzViewReceiver* subghz_receiver, uint16_t count);
 
 uint16_t subghz_view_receiver_get_idx_menu(SubGhzViewReceiver* subghz_receiver);
 
@@ -12,6 +12,8 @@
 #include <float_tools.h>
 
 #define LOG_FREQUENCY_MAX_ITEMS 60 // uint8_t (limited by 'seq' of SubGhzFrequencyAnalyzerLogItem)
+#define SPECTRUM_HEIGHT         26
+#define SPECTRUM_RANGE          60 // dB above SUBGHZ_FREQUENCY_ANALYZER_SPECTRUM_FLOOR
 
 #define SNPRINTF_FREQUENCY(buff, freq) \
     snprintf(buff, sizeof(buff), "%03ld.%03ld", freq / 1000000 % 1000, freq / 1000 % 1000);
@@ -23,6 +25,7 @@ typedef enum {
 typedef enum {
     SubGhzFrequencyAnalyzerFragmentBottomTypeMain,
     SubGhzFrequencyAnalyzerFragmentBottomTypeLog,
+    SubGhzFrequencyAnalyzerFragmentBottomTypeSpectrum,
 } SubGhzFrequencyAnalyzerFragmentBottomType;
 
 struct SubGhzFrequencyAnalyzer {
@@ -43,6 +46,7 @@ typedef struct {
     SubGhzFrequencyAnalyzerFragmentBottomType fragment_bottom_type;
     SubGhzFrequencyAnalyzerLogOrderBy log_frequency_order_by;
     uint8_t log_frequency_scroll_offset;
+    SubGhzFrequencyAnalyzerSpectrum spectrum;
 } SubGhzFrequencyAnalyzerModel;
 
 static inline uint8_t rssi_sanitize(float rssi) {
@@ -153,6 +157,43 @@ static void subghz_frequency_analyzer_history_frequency_draw(
     canvas_set_font(canvas, FontSecondary);
 }
 
+static void subghz_frequency_analyzer_spectrum_draw(
+    Canvas* canvas,
+    SubGhzFrequencyAnalyzerModel* model) {
+    const SubGhzFrequencyAnalyzerSpectrum* spectrum = &model->spectrum;
+    const uint8_t offset_y = 63;
+
+    if(!spectrum->channels_count) {
+        canvas_draw_str_aligned(canvas, 64, offset_y - 8, AlignCenter, AlignBottom, "Scanning...");
+        return;
+    }
+
+    const uint8_t bar_width = MAX(128 / spectrum->channels_count, 1);
+    const uint8_t offset_x = (128 - bar_width * spectrum->channels_count) / 2;
+
+    for(uint8_t i = 0; i < spectrum->channels_count; i++) {
+        uint8_t height =
+            MIN(spectrum->level[i], SPECTRUM_RANGE) * SPECTRUM_HEIGHT / SPECTRUM_RANGE;
+        if(height) {
+            canvas_draw_box(
+                canvas,
+                offset_x + i * bar_width,
+                offset_y - height + 1,
+                MAX(bar_width - 1, 1),
+                height);
+        }
+    }
+
+    // Signal threshold
+    const uint8_t threshold_y =
+        offset_y -
+        (uint8_t)(SUBGHZ_FREQUENCY_ANALYZER_THRESHOLD - SUBGHZ_FREQUENCY_ANALYZER_SPECTRUM_FLOOR) *
+            SPECTRUM_HEIGHT / SPECTRUM_RANGE;
+    for(uint8_t x = 0; x < 128; x += 4) {
+        canvas_draw_dot(canvas, x, threshold_y);
+    }
+}
+
 void subghz_frequency_analyzer_draw(Canvas* canvas, SubGhzFrequencyAnalyzerModel* model) {
     furi_assert(canvas);
     furi_assert(model);
@@ -173,6 +214,16 @@ void subghz_frequency_analyzer_draw(Canvas* canvas, SubGhzFrequencyAnalyzerModel
             canvas_draw_str(canvas, 2, 8, buffer);
         }
         subghz_frequency_analyzer_log_frequency_draw(canvas, model);
+    } else if(model->fragment_bottom_type == SubGhzFrequencyAnalyzerFragmentBottomTypeSpectrum) {
+        canvas_draw_str(canvas, 0, 8, "Spectrum");
+        snprintf(
+            buffer,
+            sizeof(buffer),
+            "%u ch/s %u hot",
+            model->spectrum.channels_per_second,
+            model->spectrum.hot_count);
+        canvas_draw_str_aligned(canvas, 127, 8, AlignRight, AlignBottom, buffer);
+        subghz_frequency_analyzer_spectrum_draw(canvas, model);
     } else {
         canvas_draw_str(canvas, 0, 8, "Frequency Analyzer");
         canvas_draw_icon(canvas, 109, 0, &I_Internal_ant_1_9x11);
@@ -216,13 +267,14 @@ bool subghz_frequency_analyzer_input(InputEvent* event, void* context) {
             {
                 if(event->key == InputKeyLeft) {
                     if(model->fragment_bottom_type == 0) {
-                        model->fragment_bottom_type = SubGhzFrequencyAnalyzerFragmentBottomTypeLog;
+                        model->fragment_bottom_type =
+                            SubGhzFrequencyAnalyzerFragmentBottomTypeSpectrum;
                     } else {
                         --model->fragment_bottom_type;
                     }
                 } else if(event->key == InputKeyRight) {
                     if(model->fragment_bottom_type ==
-                       SubGhzFrequencyAnalyzerFragmentBottomTypeLog) {
+                       SubGhzFrequencyAnalyzerFragmentBottomTypeSpectrum) {
                         model->fragment_bottom_type = 0;
                     } else {
                         ++model->fragment_bottom_type;
@@ -374,6 +426,22 @@ void subghz_frequency_analyzer_pair_callback(
         true);
 }
 
+static void subghz_frequency_analyzer_spectrum_callback(
+    void* context,
+    const SubGhzFrequencyAnalyzerSpectrum* spectrum) {
+    SubGhzFrequencyAnalyzer* instance = context;
+    bool is_visible = false;
+    with_view_model(
+        instance->view,
+        SubGhzFrequencyAnalyzerModel * model,
+        {
+            model->spectrum = *spectrum;
+            is_visible = model->fragment_bottom_type ==
+                         SubGhzFrequencyAnalyzerFragmentBottomTypeSpectrum;
+        },
+        is_visible);
+}
+
 void subghz_frequency_analyzer_enter(void* context) {
     furi_assert(context);
     SubGhzFrequencyAnalyzer* instance = context;
@@ -385,6 +453,8 @@ void subghz_frequency_analyzer_enter(void* context) {
         instance->worker,
         (SubGhzFrequencyAnalyzerWorkerPairCallback)subghz_frequency_analyzer_pair_callback,
         instance);
+    subghz_frequency_analyzer_worker_set_spectrum_callback(
+        instance->worker, subghz_frequency_analyzer_spectrum_callback, instance);
 
     subghz_frequency_analyzer_worker_start(instance->worker);
 
@@ -399,6 +469,7 @@ void subghz_frequency_analyzer_enter(void* context) {
             model->log_frequency_scroll_offset = 0;
             model->history_frequency[0] = model->history_frequency[1] =
                 model->history_frequency[2] = 0;
+            memset(&model->spectrum, 0, sizeof(SubGhzFrequencyAnalyzerSpectrum));
             SubGhzFrequencyAnalyzerLogItemArray_init(model->log_frequency);
         },
         true);
@@ -157,6 +157,8 @@ Bt* bt_alloc(void) {
     bt->keys_storage = bt_keys_storage_alloc(BT_KEYS_STORAGE_PATH);
     // Alloc queue
     bt->message_queue = furi_message_queue_alloc(8, sizeof(BtMessage));
+    // Status pubsub
+    bt->status_pubsub = furi_pubsub_alloc();
 
     // Setup statusbar view port
     bt->statusbar_view_port = bt_statusbar_view_port_alloc(bt);
@@ -553,6 +555,7 @@ int32_t bt_srv(void* p) {
             if(bt->status_changed_cb) {
                 bt->status_changed_cb(bt->status, bt->status_changed_ctx);
             }
+            furi_pubsub_publish(bt->status_pubsub, &bt->status);
         } else if(message.type == BtMessageTypeUpdateBatteryLevel) {
             // Update battery level
             furi_hal_bt_update_battery_level(message.data.battery_level);
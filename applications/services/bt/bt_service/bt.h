@@ -4,6 +4,7 @@
 #include <stdbool.h>
 #include <furi_ble/profile_interface.h>
 #include <core/common_defines.h>
+#include <core/pubsub.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -59,6 +60,16 @@ void bt_disconnect(Bt* bt);
  */
 void bt_set_status_changed_callback(Bt* bt, BtStatusChangedCallback callback, void* context);
 
+/** Get Bluetooth status pubsub
+ *
+ * Messages are BtStatus, published on every status change.
+ *
+ * @param bt        Bt instance
+ *
+ * @return          FuriPubSub instance
+ */
+FuriPubSub* bt_get_status_pubsub(Bt* bt);
+
 /** Forget bonded devices
  * @note Leads to wipe ble key storage and deleting bt.keys
  *
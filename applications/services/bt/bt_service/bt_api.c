@@ -49,6 +49,12 @@ void bt_set_status_changed_callback(Bt* bt, BtStatusChangedCallback callback, vo
     bt->status_changed_ctx = context;
 }
 
+FuriPubSub* bt_get_status_pubsub(Bt* bt) {
+    furi_check(bt);
+
+    return bt->status_pubsub;
+}
+
 void bt_forget_bonded_devices(Bt* bt) {
     furi_check(bt);
     BtMessage message = {.type = BtMessageTypeForgetBondedDevices};
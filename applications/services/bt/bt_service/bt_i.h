@@ -88,4 +88,5 @@ struct Bt {
     FuriEventFlag* api_event;
     BtStatusChangedCallback status_changed_cb;
     void* status_changed_ctx;
+    FuriPubSub* status_pubsub;
 };
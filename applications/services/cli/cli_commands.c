@@ -9,6 +9,12 @@
 #include <notification/notification_messages.h>
 #include <notification/notification_app.h>
 #include <loader/loader.h>
+#include <storage/storage.h>
+#include <input/input.h>
+#include <power/power_service/power.h>
+#include <desktop/desktop.h>
+#include <dolphin/dolphin.h>
+#include <bt/bt_service/bt.h>
 #include <lib/toolbox/args.h>
 #include <lib/toolbox/strint.h>
 
@@ -239,6 +245,206 @@ void cli_command_log(Cli* cli, FuriString* args, void* context) {
     furi_stream_buffer_free(ring);
 }
 
+#define CLI_COMMAND_TRACE_CAPACITY_DEFAULT 1024
+#define CLI_COMMAND_TRACE_PATH_DEFAULT     EXT_PATH("trace.bin")
+
+static bool cli_command_trace_dump_callback(const void* data, size_t size, void* context) {
+    return storage_file_write(context, data, size) == size;
+}
+
+void cli_command_trace_dump(FuriString* path) {
+    if(furi_string_empty(path)) {
+        furi_string_set(path, CLI_COMMAND_TRACE_PATH_DEFAULT);
+    }
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+
+    if(storage_file_open(file, furi_string_get_cstr(path), FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+        if(furi_trace_dump(cli_command_trace_dump_callback, file)) {
+            printf("Trace saved to %s\r\n", furi_string_get_cstr(path));
+        } else {
+            printf("Failed to write %s\r\n", furi_string_get_cstr(path));
+        }
+    } else {
+        printf("Failed to open %s\r\n", furi_string_get_cstr(path));
+    }
+
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+}
+
+void cli_command_trace_print_usage(void) {
+    printf("Usage:\r\n");
+    printf("trace <cmd> <args>\r\n");
+    printf("Cmd list:\r\n");
+
+    printf("\tstart [events]\t - Start recording, buffer size is a power of two\r\n");
+    printf("\tstop\t - Stop recording\r\n");
+    printf("\tinfo\t - Print buffer state\r\n");
+    printf("\tdump [path]\t - Stop recording and save events, " CLI_COMMAND_TRACE_PATH_DEFAULT
+           " by default\r\n");
+}
+
+void cli_command_trace(Cli* cli, FuriString* args, void* context) {
+    UNUSED(cli);
+    UNUSED(context);
+
+    FuriString* cmd = furi_string_alloc();
+    FuriTraceInfo info;
+    furi_trace_get_info(&info);
+
+    do {
+        if(!args_read_string_and_trim(args, cmd)) {
+            cli_command_trace_print_usage();
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "start") == 0) {
+            uint32_t capacity = CLI_COMMAND_TRACE_CAPACITY_DEFAULT;
+            if(!furi_string_empty(args) &&
+               (strint_to_uint32(furi_string_get_cstr(args), NULL, &capacity, 10) !=
+                    StrintParseNoError ||
+                capacity == 0 || (capacity & (capacity - 1)) != 0)) {
+                cli_print_usage("trace start", "[events]", furi_string_get_cstr(args));
+                break;
+            }
+            // Buffer of the same size is reused
+            size_t capacity_max = furi_trace_get_max_capacity();
+            if(capacity != info.capacity && capacity > capacity_max) {
+                printf(
+                    "Not enough memory for %lu events, %zu at most\r\n", capacity, capacity_max);
+                break;
+            }
+            furi_trace_start(capacity);
+            printf("Recording up to %lu events\r\n", capacity);
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "stop") == 0) {
+            furi_trace_stop();
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "info") == 0) {
+            printf(
+                "%s, %zu of %zu events, %lu lost\r\n",
+                info.running ? "Recording" : "Stopped",
+                info.count,
+                info.capacity,
+                info.lost);
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "dump") == 0) {
+            if(info.capacity == 0) {
+                printf("Nothing recorded, use <trace start> first\r\n");
+            } else {
+                cli_command_trace_dump(args);
+            }
+            break;
+        }
+
+        cli_command_trace_print_usage();
+    } while(false);
+
+    furi_string_free(cmd);
+}
+
+typedef FuriPubSub* (*CliCommandPubSubGetter)(void* record);
+
+static FuriPubSub* cli_command_pubsub_get_input(void* record) {
+    return record;
+}
+
+static FuriPubSub* cli_command_pubsub_get_power(void* record) {
+    return power_get_pubsub(record);
+}
+
+static FuriPubSub* cli_command_pubsub_get_storage(void* record) {
+    return storage_get_pubsub(record);
+}
+
+static FuriPubSub* cli_command_pubsub_get_loader(void* record) {
+    return loader_get_pubsub(record);
+}
+
+static FuriPubSub* cli_command_pubsub_get_desktop(void* record) {
+    return desktop_api_get_status_pubsub(record);
+}
+
+static FuriPubSub* cli_command_pubsub_get_dolphin(void* record) {
+    return dolphin_get_pubsub(record);
+}
+
+static FuriPubSub* cli_command_pubsub_get_bt(void* record) {
+    return bt_get_status_pubsub(record);
+}
+
+static const struct {
+    const char* record;
+    CliCommandPubSubGetter get;
+} cli_command_pubsubs[] = {
+    {RECORD_INPUT_EVENTS, cli_command_pubsub_get_input},
+    {RECORD_POWER, cli_command_pubsub_get_power},
+    {RECORD_STORAGE, cli_command_pubsub_get_storage},
+    {RECORD_LOADER, cli_command_pubsub_get_loader},
+    {RECORD_DESKTOP, cli_command_pubsub_get_desktop},
+    {RECORD_DOLPHIN, cli_command_pubsub_get_dolphin},
+    {RECORD_BT, cli_command_pubsub_get_bt},
+};
+
+void cli_command_pubsub(Cli* cli, FuriString* args, void* context) {
+    UNUSED(cli);
+    UNUSED(context);
+
+    const bool reset = furi_string_cmp_str(args, "reset") == 0;
+    if(!reset && !furi_string_empty(args)) {
+        cli_print_usage("pubsub", "[reset]", furi_string_get_cstr(args));
+        return;
+    }
+
+    if(!reset) {
+        printf(
+            "%-14s %5s %5s %10s %8s %9s %8s %8s\r\n",
+            "Record",
+            "Subs",
+            "Async",
+            "Published",
+            "Dropped",
+            "Overflows",
+            "Avg, us",
+            "Max, us");
+    }
+
+    for(size_t i = 0; i < COUNT_OF(cli_command_pubsubs); i++) {
+        const char* name = cli_command_pubsubs[i].record;
+        // Opening a record waits until it is created
+        if(!furi_record_exists(name)) continue;
+
+        FuriPubSub* pubsub = cli_command_pubsubs[i].get(furi_record_open(name));
+
+        if(reset) {
+            furi_pubsub_reset_stats(pubsub);
+        } else {
+            FuriPubSubStats stats;
+            furi_pubsub_get_stats(pubsub, &stats);
+            printf(
+                "%-14s %5zu %5zu %10lu %8lu %9lu %8lu %8lu\r\n",
+                name,
+                stats.subscribers,
+                stats.async_subscribers,
+                stats.published,
+                stats.dropped,
+                stats.overflows,
+                stats.latency_avg_us,
+                stats.latency_max_us);
+        }
+
+        furi_record_close(name);
+    }
+}
+
 void cli_command_sysctl_debug(Cli* cli, FuriString* args, void* context) {
     UNUSED(cli);
     UNUSED(context);
@@ -484,6 +690,114 @@ void cli_command_free_blocks(Cli* cli, FuriString* args, void* context) {
     memmgr_heap_printf_free_blocks();
 }
 
+#define CLI_COMMAND_HEAP_PROFILE_CAPACITY_DEFAULT 2048
+#define CLI_COMMAND_HEAP_PROFILE_PATH_DEFAULT     EXT_PATH("heap_profile.bin")
+
+static bool cli_command_heap_profile_dump_callback(const void* data, size_t size, void* context) {
+    return storage_file_write(context, data, size) == size;
+}
+
+void cli_command_heap_profile_dump(FuriString* path) {
+    if(furi_string_empty(path)) {
+        furi_string_set(path, CLI_COMMAND_HEAP_PROFILE_PATH_DEFAULT);
+    }
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+
+    if(storage_file_open(file, furi_string_get_cstr(path), FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+        if(memmgr_heap_profile_dump(cli_command_heap_profile_dump_callback, file)) {
+            printf("Heap profile saved to %s\r\n", furi_string_get_cstr(path));
+        } else {
+            printf("Failed to write %s\r\n", furi_string_get_cstr(path));
+        }
+    } else {
+        printf("Failed to open %s\r\n", furi_string_get_cstr(path));
+    }
+
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+}
+
+void cli_command_heap_profile_print_usage(void) {
+    printf("Usage:\r\n");
+    printf("heap_profile <cmd> <args>\r\n");
+    printf("Cmd list:\r\n");
+
+    printf(
+        "\tstart [events]\t - Start recording allocations, %u bytes of heap per event\r\n",
+        MEMMGR_HEAP_PROFILE_RECORD_SIZE);
+    printf("\tstop\t - Stop recording\r\n");
+    printf("\tinfo\t - Print buffer state\r\n");
+    printf(
+        "\tdump [path]\t - Stop recording and save events, " CLI_COMMAND_HEAP_PROFILE_PATH_DEFAULT
+        " by default\r\n");
+}
+
+void cli_command_heap_profile(Cli* cli, FuriString* args, void* context) {
+    UNUSED(cli);
+    UNUSED(context);
+
+    FuriString* cmd = furi_string_alloc();
+    MemmgrHeapProfileInfo info;
+    memmgr_heap_profile_get_info(&info);
+
+    do {
+        if(!args_read_string_and_trim(args, cmd)) {
+            cli_command_heap_profile_print_usage();
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "start") == 0) {
+            uint32_t capacity = CLI_COMMAND_HEAP_PROFILE_CAPACITY_DEFAULT;
+            if(!furi_string_empty(args) &&
+               (strint_to_uint32(furi_string_get_cstr(args), NULL, &capacity, 10) !=
+                    StrintParseNoError ||
+                capacity == 0)) {
+                cli_print_usage("heap_profile start", "[events]", furi_string_get_cstr(args));
+                break;
+            }
+            size_t capacity_max = memmgr_heap_profile_get_max_capacity();
+            if(capacity > capacity_max) {
+                printf(
+                    "Not enough memory for %lu events, %zu at most\r\n", capacity, capacity_max);
+                break;
+            }
+            memmgr_heap_profile_start(capacity);
+            printf("Recording up to %lu allocation events\r\n", capacity);
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "stop") == 0) {
+            memmgr_heap_profile_stop();
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "info") == 0) {
+            printf(
+                "%s, %zu of %zu events, %lu lost\r\n",
+                info.running ? "Recording" : "Stopped",
+                info.count,
+                info.capacity,
+                info.lost);
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "dump") == 0) {
+            if(info.capacity == 0) {
+                printf("Nothing recorded, use <heap_profile start> first\r\n");
+            } else {
+                cli_command_heap_profile_dump(args);
+            }
+            break;
+        }
+
+        cli_command_heap_profile_print_usage();
+    } while(false);
+
+    furi_string_free(cmd);
+}
+
 void cli_command_i2c(Cli* cli, FuriString* args, void* context) {
     UNUSED(cli);
     UNUSED(args);
@@ -519,9 +833,13 @@ void cli_commands_init(Cli* cli) {
     cli_add_command(cli, "date", CliCommandFlagParallelSafe, cli_command_date, NULL);
     cli_add_command(cli, "log", CliCommandFlagParallelSafe, cli_command_log, NULL);
     cli_add_command(cli, "sysctl", CliCommandFlagDefault, cli_command_sysctl, NULL);
+    cli_add_command(cli, "trace", CliCommandFlagParallelSafe, cli_command_trace, NULL);
+    cli_add_command(cli, "pubsub", CliCommandFlagParallelSafe, cli_command_pubsub, NULL);
     cli_add_command(cli, "top", CliCommandFlagParallelSafe, cli_command_top, NULL);
     cli_add_command(cli, "free", CliCommandFlagParallelSafe, cli_command_free, NULL);
     cli_add_command(cli, "free_blocks", CliCommandFlagParallelSafe, cli_command_free_blocks, NULL);
+    cli_add_command(
+        cli, "heap_profile", CliCommandFlagParallelSafe, cli_command_heap_profile, NULL);
 
     cli_add_command(cli, "vibro", CliCommandFlagDefault, cli_command_vibro, NULL);
     cli_add_command(cli, "led", CliCommandFlagDefault, cli_command_led, NULL);
@@ -4,9 +4,11 @@
 #include <storage/storage.h>
 
 #include <toolbox/path.h>
+#include <toolbox/stream/buffered_file_stream.h>
 #include <core/check.h>
 #include <core/common_defines.h>
 #include <furi.h>
+#include <furi_hal_rtc.h>
 
 #include <m-array.h>
 #include <stdbool.h>
@@ -19,6 +21,17 @@
 #define FILE_NAME_LEN_MAX   256
 #define LONG_LOAD_THRESHOLD 100
 
+// Folder index: filtered entries are stored as [is_dir][name_len][name] records
+#define BROWSER_INDEX_RAM_MAX         (4 * 1024)
+#define BROWSER_INDEX_RAM_STEP        256
+#define BROWSER_INDEX_CHECKPOINT_STEP 32
+#define BROWSER_INDEX_TMP_DIR         EXT_PATH(".tmp")
+#define BROWSER_INDEX_SPILL_DIR       BROWSER_INDEX_TMP_DIR "/browser_index"
+#define BROWSER_INDEX_RECORD_HEADER   2
+
+// Seconds, resolution of FAT timestamps
+#define BROWSER_INDEX_TIMESTAMP_RESOLUTION 2
+
 typedef enum {
     WorkerEvtStop = (1 << 0),
     WorkerEvtLoad = (1 << 1),
@@ -26,14 +39,35 @@ typedef enum {
     WorkerEvtFolderExit = (1 << 3),
     WorkerEvtFolderRefresh = (1 << 4),
     WorkerEvtConfigChange = (1 << 5),
+    WorkerEvtStorageChange = (1 << 6),
 } WorkerEvtFlags;
 
 #define WORKER_FLAGS_ALL                                                          \
     (WorkerEvtStop | WorkerEvtLoad | WorkerEvtFolderEnter | WorkerEvtFolderExit | \
-     WorkerEvtFolderRefresh | WorkerEvtConfigChange)
+     WorkerEvtFolderRefresh | WorkerEvtConfigChange | WorkerEvtStorageChange)
 
 ARRAY_DEF(IdxLastArray, int32_t)
 ARRAY_DEF(ExtFilterArray, FuriString*, FURI_STRING_OPLIST)
+ARRAY_DEF(IndexCheckpointArray, uint32_t, M_POD_OPLIST)
+
+typedef struct {
+    bool valid;
+    FuriString* path;
+    // RTC time when the folder was last known to match the index
+    uint32_t checked_at;
+    // All folder entries, before filtering, and hash of their names
+    uint32_t entries;
+    uint32_t names_hash;
+    uint32_t count;
+    uint32_t size;
+    // Records are kept in RAM until BROWSER_INDEX_RAM_MAX, then moved to spill file
+    uint8_t* ram;
+    uint32_t ram_capacity;
+    Stream* spill;
+    FuriString* spill_path;
+    // Record offset of every BROWSER_INDEX_CHECKPOINT_STEP entry
+    IndexCheckpointArray_t checkpoints;
+} BrowserIndex;
 
 struct BrowserWorker {
     FuriThread* thread;
@@ -48,6 +82,8 @@ struct BrowserWorker {
     bool hide_dot_files;
     IdxLastArray_t idx_last;
     ExtFilterArray_t ext_filter;
+    BrowserIndex index;
+    FuriPubSubSubscription* storage_subscription;
 
     void* cb_ctx;
     BrowserWorkerFolderOpenCallback folder_cb;
@@ -142,6 +178,273 @@ static bool browser_filter_by_name(BrowserWorker* browser, FuriString* name, boo
     return false;
 }
 
+static uint32_t browser_worker_count = 0;
+
+static void browser_index_init(BrowserIndex* index, BrowserWorker* browser) {
+    index->valid = false;
+    index->path = furi_string_alloc();
+    index->spill_path =
+        furi_string_alloc_printf("%s/%08lX", BROWSER_INDEX_SPILL_DIR, (uint32_t)browser);
+    IndexCheckpointArray_init(index->checkpoints);
+
+    FURI_CRITICAL_ENTER();
+    const bool is_first = (browser_worker_count++ == 0);
+    FURI_CRITICAL_EXIT();
+
+    // Spill files of the previous session are left behind if it did not end cleanly
+    if(is_first) {
+        Storage* storage = furi_record_open(RECORD_STORAGE);
+        storage_simply_remove_recursive(storage, BROWSER_INDEX_SPILL_DIR);
+        furi_record_close(RECORD_STORAGE);
+    }
+}
+
+static void browser_index_reset(BrowserIndex* index) {
+    index->valid = false;
+    index->count = 0;
+    index->size = 0;
+    IndexCheckpointArray_reset(index->checkpoints);
+
+    free(index->ram);
+    index->ram = NULL;
+    index->ram_capacity = 0;
+
+    if(index->spill) {
+        buffered_file_stream_close(index->spill);
+        stream_free(index->spill);
+        index->spill = NULL;
+
+        Storage* storage = furi_record_open(RECORD_STORAGE);
+        storage_simply_remove(storage, furi_string_get_cstr(index->spill_path));
+        furi_record_close(RECORD_STORAGE);
+    }
+}
+
+static void browser_index_deinit(BrowserIndex* index) {
+    browser_index_reset(index);
+
+    FURI_CRITICAL_ENTER();
+    browser_worker_count--;
+    FURI_CRITICAL_EXIT();
+
+    IndexCheckpointArray_clear(index->checkpoints);
+    furi_string_free(index->spill_path);
+    furi_string_free(index->path);
+}
+
+static bool browser_index_spill(BrowserIndex* index) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    index->spill = buffered_file_stream_alloc(storage);
+
+    bool success = false;
+    do {
+        if(!storage_simply_mkdir(storage, BROWSER_INDEX_TMP_DIR) ||
+           !storage_simply_mkdir(storage, BROWSER_INDEX_SPILL_DIR)) {
+            break;
+        }
+        if(!buffered_file_stream_open(
+               index->spill,
+               furi_string_get_cstr(index->spill_path),
+               FSAM_READ_WRITE,
+               FSOM_CREATE_ALWAYS)) {
+            break;
+        }
+        if(stream_write(index->spill, index->ram, index->size) != index->size) {
+            break;
+        }
+        success = true;
+    } while(0);
+    furi_record_close(RECORD_STORAGE);
+
+    free(index->ram);
+    index->ram = NULL;
+    index->ram_capacity = 0;
+
+    return success;
+}
+
+static bool browser_index_append(BrowserIndex* index, const char* name, bool is_folder) {
+    size_t name_len = strlen(name);
+    if(name_len > UINT8_MAX) return false;
+
+    uint8_t header[BROWSER_INDEX_RECORD_HEADER] = {is_folder, (uint8_t)name_len};
+    uint32_t record_size = BROWSER_INDEX_RECORD_HEADER + name_len;
+
+    if(!index->spill && (index->size + record_size > BROWSER_INDEX_RAM_MAX)) {
+        if(!browser_index_spill(index)) return false;
+    }
+
+    if(index->spill) {
+        if(stream_write(index->spill, header, sizeof(header)) != sizeof(header)) return false;
+        if(stream_write(index->spill, (const uint8_t*)name, name_len) != name_len) return false;
+    } else {
+        if(index->size + record_size > index->ram_capacity) {
+            index->ram_capacity =
+                MIN(index->ram_capacity + BROWSER_INDEX_RAM_STEP + record_size,
+                    (uint32_t)BROWSER_INDEX_RAM_MAX);
+            index->ram = realloc(index->ram, index->ram_capacity); //-V701
+        }
+        memcpy(&index->ram[index->size], header, sizeof(header));
+        memcpy(&index->ram[index->size + sizeof(header)], name, name_len);
+    }
+
+    if((index->count % BROWSER_INDEX_CHECKPOINT_STEP) == 0) {
+        IndexCheckpointArray_push_back(index->checkpoints, index->size);
+    }
+    index->size += record_size;
+    index->count++;
+
+    return true;
+}
+
+static bool browser_index_seek(BrowserIndex* index, uint32_t entry, uint32_t* position) {
+    if(entry > index->count) return false;
+
+    size_t checkpoint = entry / BROWSER_INDEX_CHECKPOINT_STEP;
+    if(checkpoint >= IndexCheckpointArray_size(index->checkpoints)) {
+        // Offset right after the last entry
+        *position = index->size;
+        return entry == index->count;
+    }
+
+    *position = *IndexCheckpointArray_get(index->checkpoints, checkpoint);
+    if(index->spill && !stream_seek(index->spill, *position, StreamOffsetFromStart)) {
+        return false;
+    }
+
+    // Skip to the requested entry inside checkpoint block
+    for(uint32_t i = checkpoint * BROWSER_INDEX_CHECKPOINT_STEP; i < entry; i++) {
+        uint8_t header[BROWSER_INDEX_RECORD_HEADER];
+        if(index->spill) {
+            if(stream_read(index->spill, header, sizeof(header)) != sizeof(header)) return false;
+            if(!stream_seek(index->spill, header[1], StreamOffsetFromCurrent)) return false;
+        } else {
+            memcpy(header, &index->ram[*position], sizeof(header));
+        }
+        *position += BROWSER_INDEX_RECORD_HEADER + header[1];
+    }
+
+    return true;
+}
+
+static bool browser_index_read_next(
+    BrowserIndex* index,
+    uint32_t* position,
+    char* name,
+    bool* is_folder) {
+    if(*position >= index->size) return false;
+
+    uint8_t header[BROWSER_INDEX_RECORD_HEADER];
+    if(index->spill) {
+        if(stream_read(index->spill, header, sizeof(header)) != sizeof(header)) return false;
+        if(stream_read(index->spill, (uint8_t*)name, header[1]) != header[1]) return false;
+    } else {
+        memcpy(header, &index->ram[*position], sizeof(header));
+        memcpy(name, &index->ram[*position + sizeof(header)], header[1]);
+    }
+    name[header[1]] = '\0';
+    *is_folder = header[0];
+    *position += BROWSER_INDEX_RECORD_HEADER + header[1];
+
+    return true;
+}
+
+// FNV-1a over entry names, to detect renames that keep the entry count
+static uint32_t browser_names_hash_add(uint32_t hash, const char* name) {
+    while(*name) {
+        hash = (hash ^ (uint8_t)*name++) * 16777619UL;
+    }
+    return (hash ^ '/') * 16777619UL;
+}
+
+#define BROWSER_NAMES_HASH_INIT (2166136261UL)
+
+static bool browser_folder_signature(FuriString* path, uint32_t* entries, uint32_t* names_hash) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* directory = storage_file_alloc(storage);
+    char name_temp[FILE_NAME_LEN_MAX];
+    bool success = false;
+
+    *entries = 0;
+    *names_hash = BROWSER_NAMES_HASH_INIT;
+    if(storage_dir_open(directory, furi_string_get_cstr(path))) {
+        while(storage_dir_read(directory, NULL, name_temp, FILE_NAME_LEN_MAX)) {
+            if((storage_file_get_error(directory) == FSE_OK) && (name_temp[0] != '\0')) {
+                (*entries)++;
+                *names_hash = browser_names_hash_add(*names_hash, name_temp);
+            }
+        }
+        success = true;
+    }
+
+    storage_dir_close(directory);
+    storage_file_free(directory);
+    furi_record_close(RECORD_STORAGE);
+    return success;
+}
+
+// Time of the last change of folder entries. Root folder has no timestamp of its own, time of
+// the last write to the storage is used instead.
+static bool browser_folder_timestamp(FuriString* path, uint32_t* timestamp) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FileInfo file_info;
+    FS_Error error = storage_common_stat(storage, furi_string_get_cstr(path), &file_info);
+    if((error == FSE_OK) && (file_info.mtime != 0)) {
+        *timestamp = file_info.mtime;
+    } else {
+        error = storage_common_timestamp(storage, furi_string_get_cstr(path), timestamp);
+    }
+    furi_record_close(RECORD_STORAGE);
+
+    return error == FSE_OK;
+}
+
+static bool browser_index_is_actual(BrowserIndex* index, FuriString* path) {
+    if(!index->valid) return false;
+    if(furi_string_cmp(index->path, path) != 0) return false;
+
+    uint32_t timestamp = 0;
+    if(!browser_folder_timestamp(path, &timestamp)) return false;
+
+    // Folder was not changed since the last check. FAT timestamps have a resolution of two
+    // seconds, so changes made around the time of the check are not trusted.
+    if(timestamp + BROWSER_INDEX_TIMESTAMP_RESOLUTION < index->checked_at) return true;
+
+    // Folder was changed, not necessarily its entries: compare folder contents
+    const uint32_t checked_at = furi_hal_rtc_get_timestamp();
+    uint32_t entries = 0, names_hash = 0;
+    if(!browser_folder_signature(path, &entries, &names_hash) || (entries != index->entries) ||
+       (names_hash != index->names_hash)) {
+        return false;
+    }
+
+    index->checked_at = checked_at;
+    return true;
+}
+
+static void browser_index_finalize(BrowserIndex* index, FuriString* path, bool success) {
+    if(success && index->spill) {
+        success = buffered_file_stream_sync(index->spill);
+    }
+
+    if(success) {
+        furi_string_set(index->path, path);
+        index->valid = true;
+    } else {
+        browser_index_reset(index);
+    }
+}
+
+static void browser_storage_callback(const void* message, void* context) {
+    const StorageEvent* event = message;
+    BrowserWorker* browser = context;
+
+    if((event->type == StorageEventTypeCardMount) ||
+       (event->type == StorageEventTypeCardUnmount)) {
+        furi_thread_flags_set(furi_thread_get_id(browser->thread), WorkerEvtStorageChange);
+    }
+}
+
 static bool browser_folder_check_and_switch(FuriString* path) {
     FileInfo file_info;
     Storage* storage = furi_record_open(RECORD_STORAGE);
@@ -187,6 +490,14 @@ static bool browser_folder_init(
     *item_cnt = 0;
     *file_idx = -1;
 
+    uint32_t start_tick = furi_get_tick();
+    bool index_ok = true;
+    browser_index_reset(&browser->index);
+    // Taken before the scan, so writes during the scan are not trusted later
+    browser->index.checked_at = furi_hal_rtc_get_timestamp();
+    browser->index.entries = 0;
+    browser->index.names_hash = BROWSER_NAMES_HASH_INIT;
+
     if(storage_dir_open(directory, furi_string_get_cstr(path))) {
         state = true;
         while(1) {
@@ -195,6 +506,9 @@ static bool browser_folder_init(
             }
             if((storage_file_get_error(directory) == FSE_OK) && (name_temp[0] != '\0')) {
                 total_files_cnt++;
+                browser->index.entries++;
+                browser->index.names_hash =
+                    browser_names_hash_add(browser->index.names_hash, name_temp);
                 furi_string_set(name_str, name_temp);
                 if(browser_filter_by_name(browser, name_str, file_info_is_dir(&file_info))) {
                     if(!furi_string_empty(filename)) {
@@ -202,6 +516,10 @@ static bool browser_folder_init(
                             *file_idx = *item_cnt;
                         }
                     }
+                    if(index_ok) {
+                        index_ok = browser_index_append(
+                            &browser->index, name_temp, file_info_is_dir(&file_info));
+                    }
                     (*item_cnt)++;
                 }
                 if(total_files_cnt == LONG_LOAD_THRESHOLD) {
@@ -221,11 +539,62 @@ static bool browser_folder_init(
 
     furi_record_close(RECORD_STORAGE);
 
+    browser_index_finalize(&browser->index, path, state && index_ok);
+    FURI_LOG_D(
+        TAG,
+        "Index: %lu items, %lu bytes, %s, %lums",
+        browser->index.count,
+        browser->index.size,
+        browser->index.spill ? "file" : "ram",
+        furi_get_tick() - start_tick);
+
     return state;
 }
 
+static bool browser_folder_load_from_index(
+    BrowserWorker* browser,
+    FuriString* path,
+    uint32_t offset,
+    uint32_t count) {
+    BrowserIndex* index = &browser->index;
+
+    char name_temp[FILE_NAME_LEN_MAX];
+    FuriString* name_str = furi_string_alloc();
+    uint32_t items_cnt = 0;
+    uint32_t position = 0;
+    bool is_folder = false;
+
+    if(browser_index_seek(index, offset, &position)) {
+        if(browser->list_load_cb) {
+            browser->list_load_cb(browser->cb_ctx, offset);
+        }
+
+        while(items_cnt < count) {
+            if(!browser_index_read_next(index, &position, name_temp, &is_folder)) {
+                break;
+            }
+            furi_string_printf(name_str, "%s/%s", furi_string_get_cstr(path), name_temp);
+            if(browser->list_item_cb) {
+                browser->list_item_cb(browser->cb_ctx, name_str, is_folder, false);
+            }
+            items_cnt++;
+        }
+        if(browser->list_item_cb) {
+            browser->list_item_cb(browser->cb_ctx, NULL, false, true);
+        }
+    }
+
+    furi_string_free(name_str);
+
+    return items_cnt == count;
+}
+
 static bool
     browser_folder_load(BrowserWorker* browser, FuriString* path, uint32_t offset, uint32_t count) {
+    if(browser_index_is_actual(&browser->index, path)) {
+        return browser_folder_load_from_index(browser, path, offset, count);
+    }
+
     FileInfo file_info;
 
     Storage* storage = furi_record_open(RECORD_STORAGE);
@@ -389,6 +758,10 @@ static int32_t browser_worker(void* context) {
             }
         }
 
+        if(flags & WorkerEvtStorageChange) {
+            browser_index_reset(&browser->index);
+        }
+
         if(flags & WorkerEvtLoad) {
             FURI_LOG_D(
                 TAG, "Load offset: %lu cnt: %lu", browser->load_offset, browser->load_count);
@@ -400,6 +773,8 @@ static int32_t browser_worker(void* context) {
         }
     }
 
+    browser_index_reset(&browser->index);
+
     furi_string_free(filename);
     furi_string_free(path);
 
@@ -430,19 +805,32 @@ BrowserWorker* file_browser_worker_alloc(
         furi_string_set_str(browser->path_start, base_path);
     }
 
+    browser_index_init(&browser->index, browser);
+
     browser->thread = furi_thread_alloc_ex("BrowserWorker", 2048, browser_worker, browser);
     furi_thread_start(browser->thread);
 
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    browser->storage_subscription =
+        furi_pubsub_subscribe(storage_get_pubsub(storage), browser_storage_callback, browser);
+    furi_record_close(RECORD_STORAGE);
+
     return browser;
 } //-V773
 
 void file_browser_worker_free(BrowserWorker* browser) {
     furi_check(browser);
 
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    furi_pubsub_unsubscribe(storage_get_pubsub(storage), browser->storage_subscription);
+    furi_record_close(RECORD_STORAGE);
+
     furi_thread_flags_set(furi_thread_get_id(browser->thread), WorkerEvtStop);
     furi_thread_join(browser->thread);
     furi_thread_free(browser->thread);
 
+    browser_index_deinit(&browser->index);
+
     furi_string_free(browser->path_next);
     furi_string_free(browser->path_current);
     furi_string_free(browser->path_start);
@@ -47,6 +47,7 @@ typedef struct File File;
 /** Structure that hold file info */
 typedef struct {
     uint8_t flags; /**< flags from FS_Flags enum */
+    uint32_t mtime; /**< last modification time, UNIX timestamp, 0 if unknown */
     uint64_t size; /**< file size */
 } FileInfo;
 
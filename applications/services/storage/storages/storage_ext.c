@@ -24,6 +24,7 @@ typedef struct {
 } SDData;
 
 static FS_Error storage_ext_parse_error(SDError error);
+static uint32_t storage_ext_parse_timestamp(WORD fdate, WORD ftime);
 
 /******************* Core Functions *******************/
 
@@ -350,6 +351,22 @@ static void storage_ext_tick(StorageData* storage) {
 
 /****************** Common Functions ******************/
 
+/* FAT keeps local date and time with 2 second resolution */
+static uint32_t storage_ext_parse_timestamp(WORD fdate, WORD ftime) {
+    if(fdate == 0) return 0;
+
+    DateTime datetime = {
+        .year = 1980 + (fdate >> 9),
+        .month = (fdate >> 5) & 0x0F,
+        .day = fdate & 0x1F,
+        .hour = ftime >> 11,
+        .minute = (ftime >> 5) & 0x3F,
+        .second = (ftime & 0x1F) * 2,
+    };
+
+    return datetime_datetime_to_timestamp(&datetime);
+}
+
 static FS_Error storage_ext_parse_error(SDError error) {
     FS_Error result;
     switch(error) {
@@ -385,6 +402,28 @@ static FS_Error storage_ext_parse_error(SDError error) {
     return result;
 }
 
+#ifndef FURI_RAM_EXEC
+/* FAT does not update directory timestamp when its entries change, do it here. This way folder
+ * modification time tells whether its listing could have changed. Root has no timestamp. */
+static void storage_ext_touch_parent(const char* path) {
+    FuriString* parent = furi_string_alloc_set(path);
+    size_t last_slash = furi_string_search_rchar(parent, '/');
+
+    if(last_slash != FURI_STRING_FAILURE && last_slash > 0) {
+        furi_string_left(parent, last_slash);
+
+        const DWORD fattime = get_fattime();
+        SDFileInfo _fileinfo = {
+            .fdate = (WORD)(fattime >> 16),
+            .ftime = (WORD)fattime,
+        };
+        f_utime(furi_string_get_cstr(parent), &_fileinfo);
+    }
+
+    furi_string_free(parent);
+}
+#endif
+
 /******************* File Functions *******************/
 
 static bool storage_ext_file_open(
@@ -404,11 +443,28 @@ static bool storage_ext_file_open(
     if(open_mode & FSOM_CREATE_NEW) _mode |= FA_CREATE_NEW;
     if(open_mode & FSOM_CREATE_ALWAYS) _mode |= FA_CREATE_ALWAYS;
 
+#ifndef FURI_RAM_EXEC
+    // Only a new file changes folder contents
+    bool is_created = false;
+    if(open_mode & FSOM_CREATE_NEW) {
+        is_created = true;
+    } else if(open_mode & (FSOM_OPEN_ALWAYS | FSOM_OPEN_APPEND | FSOM_CREATE_ALWAYS)) {
+        is_created = (f_stat(path, NULL) == FR_NO_FILE);
+    }
+#endif
+
     SDFile* file_data = malloc(sizeof(SDFile));
     storage_set_storage_file_data(file, file_data, storage);
 
     file->internal_error_id = f_open(file_data, path, _mode);
     file->error_id = storage_ext_parse_error(file->internal_error_id);
+
+#ifndef FURI_RAM_EXEC
+    if(is_created && file->error_id == FSE_OK) {
+        storage_ext_touch_parent(path);
+    }
+#endif
+
     return file->error_id == FSE_OK;
 }
 
@@ -564,6 +620,7 @@ static bool storage_ext_dir_read(
 
     if(fileinfo != NULL) {
         fileinfo->size = _fileinfo.fsize;
+        fileinfo->mtime = storage_ext_parse_timestamp(_fileinfo.fdate, _fileinfo.ftime);
         fileinfo->flags = 0;
 
         if(_fileinfo.fattrib & AM_DIR) fileinfo->flags |= FSF_DIRECTORY;
@@ -597,6 +654,7 @@ static FS_Error storage_ext_common_stat(void* ctx, const char* path, FileInfo* f
 
     if(fileinfo != NULL) {
         fileinfo->size = _fileinfo.fsize;
+        fileinfo->mtime = storage_ext_parse_timestamp(_fileinfo.fdate, _fileinfo.ftime);
         fileinfo->flags = 0;
 
         if(_fileinfo.fattrib & AM_DIR) fileinfo->flags |= FSF_DIRECTORY;
@@ -612,6 +670,7 @@ static FS_Error storage_ext_common_remove(void* ctx, const char* path) {
     return FSE_NOT_READY;
 #else
     SDError result = f_unlink(path);
+    if(result == FR_OK) storage_ext_touch_parent(path);
     return storage_ext_parse_error(result);
 #endif
 }
@@ -623,6 +682,7 @@ static FS_Error storage_ext_common_mkdir(void* ctx, const char* path) {
     return FSE_NOT_READY;
 #else
     SDError result = f_mkdir(path);
+    if(result == FR_OK) storage_ext_touch_parent(path);
     return storage_ext_parse_error(result);
 #endif
 }
@@ -24,9 +24,11 @@ static const char* update_task_stage_descr[] = {
     [UpdateTaskStageOBValidation] = "Validating opt. bytes",
     [UpdateTaskStageIntBackup] = "Backing up configuration",
     [UpdateTaskStageIntRestore] = "Restoring configuration",
+    [UpdateTaskStageResourcesCompare] = "Comparing resources",
     [UpdateTaskStageResourcesFileCleanup] = "Cleaning up files",
     [UpdateTaskStageResourcesDirCleanup] = "Cleaning up directories",
     [UpdateTaskStageResourcesFileUnpack] = "Extracting resources",
+    [UpdateTaskStageResourcesVerify] = "Verifying resources",
     [UpdateTaskStageSplashscreenInstall] = "Installing splashscreen",
     [UpdateTaskStageCompleted] = "Restarting...",
     [UpdateTaskStageError] = "Error",
@@ -198,6 +200,12 @@ static const struct {
         .percent_max = 100,
         .descr = "SD card I/O error",
     },
+    {
+        .stage = UpdateTaskStageResourcesCompare,
+        .percent_min = 0,
+        .percent_max = 100,
+        .descr = "SD card I/O error",
+    },
     {
         .stage = UpdateTaskStageResourcesFileCleanup,
         .percent_min = 0,
@@ -216,6 +224,12 @@ static const struct {
         .percent_max = 100,
         .descr = "SD card I/O error",
     },
+    {
+        .stage = UpdateTaskStageResourcesVerify,
+        .percent_min = 0,
+        .percent_max = 100,
+        .descr = "Resource file corrupted",
+    },
 #endif
 };
 
@@ -261,9 +275,11 @@ static const UpdateTaskStageGroupMap update_task_stage_progress[] = {
 
     [UpdateTaskStageIntRestore] = STAGE_DEF(UpdateTaskStageGroupPostUpdate, 5),
 
+    [UpdateTaskStageResourcesCompare] = STAGE_DEF(UpdateTaskStageGroupResources, 50),
     [UpdateTaskStageResourcesFileCleanup] = STAGE_DEF(UpdateTaskStageGroupResources, 100),
     [UpdateTaskStageResourcesDirCleanup] = STAGE_DEF(UpdateTaskStageGroupResources, 50),
     [UpdateTaskStageResourcesFileUnpack] = STAGE_DEF(UpdateTaskStageGroupResources, 255),
+    [UpdateTaskStageResourcesVerify] = STAGE_DEF(UpdateTaskStageGroupResources, 50),
     [UpdateTaskStageSplashscreenInstall] = STAGE_DEF(UpdateTaskStageGroupSplashscreen, 5),
 
     [UpdateTaskStageCompleted] = STAGE_DEF(UpdateTaskStageGroupMisc, 1),
@@ -31,9 +31,11 @@ typedef enum {
     UpdateTaskStageFlashValidate,
 
     UpdateTaskStageIntRestore,
+    UpdateTaskStageResourcesCompare,
     UpdateTaskStageResourcesFileCleanup,
     UpdateTaskStageResourcesDirCleanup,
     UpdateTaskStageResourcesFileUnpack,
+    UpdateTaskStageResourcesVerify,
     UpdateTaskStageSplashscreenInstall,
 
     UpdateTaskStageCompleted,
@@ -12,9 +12,13 @@
 #include <update_util/resources/manifest.h>
 #include <toolbox/tar/tar_archive.h>
 #include <toolbox/crc32_calc.h>
+#include <toolbox/md5_calc.h>
 
 #define TAG "UpdWorkerBackup"
 
+#define UPDATE_TASK_RESOURCES_MANIFEST_NAME "Manifest"
+#define UPDATE_TASK_RESOURCES_MANIFEST_PATH EXT_PATH(UPDATE_TASK_RESOURCES_MANIFEST_NAME)
+
 static bool update_task_pre_update(UpdateTask* update_task) {
     bool success = false;
     FuriString* backup_file_path;
@@ -35,27 +39,274 @@ static bool update_task_pre_update(UpdateTask* update_task) {
     furi_string_free(backup_file_path);
     return success;
 }
+
+/* Resources already on the SD card are compared with the new bundle by manifest entries.
+ * Entries are reduced to 64-bit FNV-1a hashes kept in sorted arrays: a few thousand
+ * resource files fit in tens of kilobytes. */
+#define UPDATE_TASK_HASH_INIT  (0xCBF29CE484222325ULL)
+#define UPDATE_TASK_HASH_PRIME (0x100000001B3ULL)
+
+typedef struct {
+    uint64_t* items;
+    size_t count;
+} UpdateTaskHashSet;
+
+typedef struct {
+    UpdateTaskHashSet names; // Files and directories of the new bundle
+    UpdateTaskHashSet unchanged; // Files of the new bundle already on the SD card
+    uint32_t removed;
+    uint32_t written;
+    uint32_t skipped;
+} UpdateTaskResourceDelta;
+
+static uint64_t update_task_hash(uint64_t hash, const void* data, size_t size) {
+    const uint8_t* bytes = data;
+    for(size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * UPDATE_TASK_HASH_PRIME;
+    }
+    return hash;
+}
+
+static uint64_t update_task_hash_name(const char* name) {
+    return update_task_hash(UPDATE_TASK_HASH_INIT, name, strlen(name));
+}
+
+static uint64_t update_task_hash_file(const ResourceManifestEntry* entry) {
+    uint64_t hash = update_task_hash_name(furi_string_get_cstr(entry->name));
+    hash = update_task_hash(hash, &entry->size, sizeof(entry->size));
+    return update_task_hash(hash, entry->hash, sizeof(entry->hash));
+}
+
+static int update_task_hash_compare(const void* a, const void* b) {
+    const uint64_t left = *(const uint64_t*)a;
+    const uint64_t right = *(const uint64_t*)b;
+    return (left > right) - (left < right);
+}
+
+static void update_task_hash_set_alloc(UpdateTaskHashSet* set, size_t capacity) {
+    set->items = malloc(MAX(capacity, 1U) * sizeof(uint64_t));
+    set->count = 0;
+}
+
+static void update_task_hash_set_free(UpdateTaskHashSet* set) {
+    free(set->items);
+    set->items = NULL;
+    set->count = 0;
+}
+
+static void update_task_hash_set_sort(UpdateTaskHashSet* set) {
+    qsort(set->items, set->count, sizeof(uint64_t), update_task_hash_compare);
+}
+
+static bool update_task_hash_set_contains(const UpdateTaskHashSet* set, uint64_t hash) {
+    return set->items &&
+           bsearch(&hash, set->items, set->count, sizeof(uint64_t), update_task_hash_compare);
+}
+
+static size_t update_task_manifest_count(ResourceManifestReader* manifest_reader) {
+    size_t count = 0;
+    ResourceManifestEntry* entry_ptr = NULL;
+    while((entry_ptr = resource_manifest_reader_next(manifest_reader))) {
+        if(entry_ptr->type == ResourceManifestEntryTypeFile ||
+           entry_ptr->type == ResourceManifestEntryTypeDirectory) {
+            count++;
+        }
+    }
+    resource_manifest_rewind(manifest_reader);
+    return count;
+}
+
+/* Files listed in the manifest of installed resources, by name, size and MD5 */
+static void update_task_load_installed_files(UpdateTask* update_task, UpdateTaskHashSet* files) {
+    ResourceManifestReader* manifest_reader = resource_manifest_reader_alloc(update_task->storage);
+    do {
+        if(!resource_manifest_reader_open(manifest_reader, UPDATE_TASK_RESOURCES_MANIFEST_PATH)) {
+            FURI_LOG_W(TAG, "No existing manifest");
+            break;
+        }
+
+        update_task_hash_set_alloc(files, update_task_manifest_count(manifest_reader));
+        ResourceManifestEntry* entry_ptr = NULL;
+        while((entry_ptr = resource_manifest_reader_next(manifest_reader))) {
+            if(entry_ptr->type == ResourceManifestEntryTypeFile) {
+                files->items[files->count++] = update_task_hash_file(entry_ptr);
+            }
+        }
+        update_task_hash_set_sort(files);
+    } while(false);
+    resource_manifest_reader_free(manifest_reader);
+}
+
+static bool update_task_resource_delta_load(
+    UpdateTask* update_task,
+    const char* manifest_path,
+    UpdateTaskResourceDelta* delta) {
+    update_task_set_progress(update_task, UpdateTaskStageResourcesCompare, 0);
+
+    UpdateTaskHashSet installed = {0};
+    update_task_load_installed_files(update_task, &installed);
+
+    ResourceManifestReader* manifest_reader = resource_manifest_reader_alloc(update_task->storage);
+    FuriString* file_path = furi_string_alloc();
+    bool success = false;
+
+    do {
+        if(!resource_manifest_reader_open(manifest_reader, manifest_path)) break;
+
+        const size_t n_entries = update_task_manifest_count(manifest_reader);
+        update_task_hash_set_alloc(&delta->names, n_entries);
+        update_task_hash_set_alloc(&delta->unchanged, n_entries);
+
+        ResourceManifestEntry* entry_ptr = NULL;
+        while((entry_ptr = resource_manifest_reader_next(manifest_reader))) {
+            if(entry_ptr->type == ResourceManifestEntryTypeDirectory) {
+                delta->names.items[delta->names.count++] =
+                    update_task_hash_name(furi_string_get_cstr(entry_ptr->name));
+            } else if(entry_ptr->type == ResourceManifestEntryTypeFile) {
+                const uint64_t name_hash =
+                    update_task_hash_name(furi_string_get_cstr(entry_ptr->name));
+                delta->names.items[delta->names.count++] = name_hash;
+
+                update_task_set_progress(
+                    update_task,
+                    UpdateTaskStageProgress,
+                    (delta->names.count * 100) / (n_entries + 1));
+
+                // Same file was installed before and is still in place
+                if(!update_task_hash_set_contains(&installed, update_task_hash_file(entry_ptr)))
+                    continue;
+
+                path_concat(
+                    STORAGE_EXT_PATH_PREFIX, furi_string_get_cstr(entry_ptr->name), file_path);
+                FileInfo file_info;
+                if(storage_common_stat(
+                       update_task->storage, furi_string_get_cstr(file_path), &file_info) ==
+                       FSE_OK &&
+                   file_info.size == entry_ptr->size) {
+                    delta->unchanged.items[delta->unchanged.count++] = name_hash;
+                }
+            }
+        }
+
+        update_task_hash_set_sort(&delta->names);
+        update_task_hash_set_sort(&delta->unchanged);
+        FURI_LOG_I(
+            TAG,
+            "%zu of %zu resource entries unchanged",
+            delta->unchanged.count,
+            delta->names.count);
+        success = true;
+    } while(false);
+
+    furi_string_free(file_path);
+    resource_manifest_reader_free(manifest_reader);
+    update_task_hash_set_free(&installed);
+    return success;
+}
+
+static void update_task_resource_delta_free(UpdateTaskResourceDelta* delta) {
+    update_task_hash_set_free(&delta->names);
+    update_task_hash_set_free(&delta->unchanged);
+}
+
 typedef struct {
     UpdateTask* update_task;
-    TarArchive* archive;
+    UpdateTaskResourceDelta* delta;
+    uint8_t progress;
 } TarUnpackProgress;
 
+/* Called for every written block, so large files move the progress bar too */
+static void update_task_resource_progress_cb(int32_t processed, int32_t total, void* context) {
+    TarUnpackProgress* unpack_progress = context;
+    const uint8_t progress = ((int64_t)processed * 100) / (total + 1);
+    if(progress != unpack_progress->progress) {
+        unpack_progress->progress = progress;
+        update_task_set_progress(unpack_progress->update_task, UpdateTaskStageProgress, progress);
+    }
+}
+
 static bool update_task_resource_unpack_cb(const char* name, bool is_directory, void* context) {
-    UNUSED(name);
-    UNUSED(is_directory);
     TarUnpackProgress* unpack_progress = context;
-    int32_t progress = 0, total = 0;
-    tar_archive_get_read_progress(unpack_progress->archive, &progress, &total);
-    update_task_set_progress(
-        unpack_progress->update_task, UpdateTaskStageProgress, (progress * 100) / (total + 1));
+    UpdateTaskResourceDelta* delta = unpack_progress->delta;
+    if(is_directory) {
+        return true;
+    }
+    /* Installed manifest is replaced only after verification: an interrupted update must not
+     * leave a manifest describing files that were never written */
+    if(strcmp(name, UPDATE_TASK_RESOURCES_MANIFEST_NAME) == 0) {
+        return false;
+    }
+    if(update_task_hash_set_contains(&delta->unchanged, update_task_hash_name(name))) {
+        delta->skipped++;
+        return false;
+    }
+    delta->written++;
     return true;
 }
 
-static void update_task_cleanup_resources(UpdateTask* update_task) {
+/* Check files written from the bundle against the new manifest */
+static bool update_task_verify_resources(
+    UpdateTask* update_task,
+    const char* manifest_path,
+    const UpdateTaskResourceDelta* delta) {
+    update_task_set_progress(update_task, UpdateTaskStageResourcesVerify, 0);
+
+    ResourceManifestReader* manifest_reader = resource_manifest_reader_alloc(update_task->storage);
+    File* file = storage_file_alloc(update_task->storage);
+    FuriString* file_path = furi_string_alloc();
+    bool success = false;
+
+    do {
+        if(!resource_manifest_reader_open(manifest_reader, manifest_path)) break;
+
+        const size_t n_entries = update_task_manifest_count(manifest_reader);
+        size_t n_processed_entries = 0;
+        success = true;
+
+        ResourceManifestEntry* entry_ptr = NULL;
+        while(success && (entry_ptr = resource_manifest_reader_next(manifest_reader))) {
+            update_task_set_progress(
+                update_task,
+                UpdateTaskStageProgress,
+                (n_processed_entries++ * 100) / (n_entries + 1));
+
+            if(entry_ptr->type != ResourceManifestEntryTypeFile ||
+               update_task_hash_set_contains(
+                   &delta->unchanged,
+                   update_task_hash_name(furi_string_get_cstr(entry_ptr->name)))) {
+                continue;
+            }
+
+            path_concat(
+                STORAGE_EXT_PATH_PREFIX, furi_string_get_cstr(entry_ptr->name), file_path);
+            uint8_t hash[sizeof(entry_ptr->hash)];
+            FS_Error error;
+            if(!md5_calc_file(file, furi_string_get_cstr(file_path), hash, &error) ||
+               memcmp(hash, entry_ptr->hash, sizeof(hash)) != 0) {
+                FURI_LOG_E(TAG, "%s is corrupted", furi_string_get_cstr(file_path));
+                success = false;
+            }
+        }
+    } while(false);
+
+    furi_string_free(file_path);
+    storage_file_free(file);
+    resource_manifest_reader_free(manifest_reader);
+    return success;
+}
+
+/* Entries present in the new bundle are overwritten or kept as is */
+static bool update_task_is_resource_kept(const UpdateTaskResourceDelta* delta, FuriString* name) {
+    return update_task_hash_set_contains(
+        &delta->names, update_task_hash_name(furi_string_get_cstr(name)));
+}
+
+static void
+    update_task_cleanup_resources(UpdateTask* update_task, UpdateTaskResourceDelta* delta) {
     ResourceManifestReader* manifest_reader = resource_manifest_reader_alloc(update_task->storage);
     do {
         FURI_LOG_D(TAG, "Cleaning up old manifest");
-        if(!resource_manifest_reader_open(manifest_reader, EXT_PATH("Manifest"))) {
+        if(!resource_manifest_reader_open(manifest_reader, UPDATE_TASK_RESOURCES_MANIFEST_PATH)) {
             FURI_LOG_W(TAG, "No existing manifest");
             break;
         }
@@ -81,6 +332,9 @@ static void update_task_cleanup_resources(UpdateTask* update_task) {
                     UpdateTaskStageProgress,
                     (n_processed_file_entries++ * 100) / n_file_entries);
 
+                if(update_task_is_resource_kept(delta, entry_ptr->name)) continue;
+                delta->removed++;
+
                 FuriString* file_path = furi_string_alloc();
                 path_concat(
                     STORAGE_EXT_PATH_PREFIX, furi_string_get_cstr(entry_ptr->name), file_path);
@@ -108,6 +362,8 @@ static void update_task_cleanup_resources(UpdateTask* update_task) {
                     UpdateTaskStageProgress,
                     (n_processed_dir_entries++ * 100) / n_dir_entries);
 
+                if(update_task_is_resource_kept(delta, entry_ptr->name)) continue;
+
                 FuriString* folder_path = furi_string_alloc();
 
                 do {
@@ -135,6 +391,82 @@ static void update_task_cleanup_resources(UpdateTask* update_task) {
     resource_manifest_reader_free(manifest_reader);
 }
 
+static bool update_task_install_resources(UpdateTask* update_task, TarArchive* archive) {
+    const uint32_t start_tick = furi_get_tick();
+    UpdateTaskResourceDelta delta = {0};
+    TarUnpackProgress progress = {
+        .update_task = update_task,
+        .delta = &delta,
+    };
+
+    FuriString* bundle_path = furi_string_alloc();
+    FuriString* manifest_path = furi_string_alloc();
+    path_concat(
+        furi_string_get_cstr(update_task->update_path),
+        furi_string_get_cstr(update_task->manifest->resource_bundle),
+        bundle_path);
+    path_concat(
+        furi_string_get_cstr(update_task->update_path),
+        UPDATE_TASK_RESOURCES_MANIFEST_NAME,
+        manifest_path);
+
+    bool success = false;
+    do {
+        if(!tar_archive_open(
+               archive, furi_string_get_cstr(bundle_path), TarOpenModeReadHeatshrink)) {
+            break;
+        }
+
+        /* Manifest of the new bundle tells which installed files can be kept. Without it,
+         * all old resources are removed and the whole bundle is unpacked */
+        const bool has_manifest = tar_archive_unpack_file(
+            archive, UPDATE_TASK_RESOURCES_MANIFEST_NAME, furi_string_get_cstr(manifest_path));
+        if(!has_manifest ||
+           !update_task_resource_delta_load(
+               update_task, furi_string_get_cstr(manifest_path), &delta)) {
+            FURI_LOG_W(TAG, "No manifest in bundle, full install");
+            update_task_resource_delta_free(&delta);
+        }
+
+        update_task_cleanup_resources(update_task, &delta);
+
+        update_task_set_progress(update_task, UpdateTaskStageResourcesFileUnpack, 0);
+        tar_archive_set_file_callback(archive, update_task_resource_unpack_cb, &progress);
+        tar_archive_set_progress_callback(archive, update_task_resource_progress_cb, &progress);
+        if(!tar_archive_unpack_to(archive, STORAGE_EXT_PATH_PREFIX, NULL)) break;
+
+        if(has_manifest &&
+           !update_task_verify_resources(
+               update_task, furi_string_get_cstr(manifest_path), &delta)) {
+            break;
+        }
+
+        if(has_manifest &&
+           storage_common_rename(
+               update_task->storage,
+               furi_string_get_cstr(manifest_path),
+               UPDATE_TASK_RESOURCES_MANIFEST_PATH) != FSE_OK) {
+            FURI_LOG_E(TAG, "Failed to install manifest");
+            break;
+        }
+
+        FURI_LOG_I(
+            TAG,
+            "Resources: %lu written, %lu unchanged, %lu removed in %lums",
+            delta.written,
+            delta.skipped,
+            delta.removed,
+            furi_get_tick() - start_tick);
+        success = true;
+    } while(false);
+
+    storage_common_remove(update_task->storage, furi_string_get_cstr(manifest_path));
+    update_task_resource_delta_free(&delta);
+    furi_string_free(manifest_path);
+    furi_string_free(bundle_path);
+    return success;
+}
+
 static bool update_task_post_update(UpdateTask* update_task) {
     bool success = false;
 
@@ -153,24 +485,7 @@ static bool update_task_post_update(UpdateTask* update_task) {
         CHECK_RESULT(int_backup_unpack(update_task->storage, furi_string_get_cstr(file_path)));
 
         if(update_task->state.groups & UpdateTaskStageGroupResources) {
-            TarUnpackProgress progress = {
-                .update_task = update_task,
-                .archive = archive,
-            };
-
-            path_concat(
-                furi_string_get_cstr(update_task->update_path),
-                furi_string_get_cstr(update_task->manifest->resource_bundle),
-                file_path);
-
-            CHECK_RESULT(tar_archive_open(
-                archive, furi_string_get_cstr(file_path), TarOpenModeReadHeatshrink));
-
-            update_task_cleanup_resources(update_task);
-
-            update_task_set_progress(update_task, UpdateTaskStageResourcesFileUnpack, 0);
-            tar_archive_set_file_callback(archive, update_task_resource_unpack_cb, &progress);
-            CHECK_RESULT(tar_archive_unpack_to(archive, STORAGE_EXT_PATH_PREFIX, NULL));
+            CHECK_RESULT(update_task_install_resources(update_task, archive));
         }
 
         if(update_task->state.groups & UpdateTaskStageGroupSplashscreen) {
@@ -86,8 +86,8 @@ struct FuriEventLoop {
     FuriEventLoopTree_t tree;
     WaitingList_t waiting_list;
 
-    // Active timer list
-    TimerList_t timer_list;
+    // Active timers, allocated with the first timer
+    FuriEventLoopTimerWheel* timer_wheel;
     // Timer request queue
     TimerQueue_t timer_queue;
     // Pending callback queue
@@ -5,6 +5,10 @@
 
 #include <furi.h>
 
+#define FURI_EVENT_LOOP_TIMER_WHEEL_SLOT_MASK (FURI_EVENT_LOOP_TIMER_WHEEL_SLOTS - 1U)
+#define FURI_EVENT_LOOP_TIMER_WHEEL_DELTA_MAX \
+    ((1UL << (FURI_EVENT_LOOP_TIMER_WHEEL_SLOT_BITS * FURI_EVENT_LOOP_TIMER_WHEEL_LEVELS)) - 1U)
+
 /*
  * Private functions
  */
@@ -19,35 +23,137 @@ static inline uint32_t
     return elapsed_time < timer->interval ? timer->interval - elapsed_time : 0;
 }
 
-static inline bool furi_event_loop_timer_is_expired(const FuriEventLoopTimer* timer) {
-    return furi_event_loop_timer_get_elapsed_time(timer) >= timer->interval;
+static inline uint32_t furi_event_loop_timer_wheel_shift(size_t level) {
+    return level * FURI_EVENT_LOOP_TIMER_WHEEL_SLOT_BITS;
 }
 
-static void furi_event_loop_schedule_timer(FuriEventLoop* instance, FuriEventLoopTimer* timer) {
-    FuriEventLoopTimer* timer_pos = NULL;
+static FuriEventLoopTimerWheel* furi_event_loop_timer_wheel_alloc(void) {
+    FuriEventLoopTimerWheel* wheel = malloc(sizeof(FuriEventLoopTimerWheel));
+
+    wheel->time = xTaskGetTickCount();
+    TimerList_init(wheel->expired);
+
+    for(size_t level = 0; level < FURI_EVENT_LOOP_TIMER_WHEEL_LEVELS; level++) {
+        for(size_t index = 0; index < FURI_EVENT_LOOP_TIMER_WHEEL_SLOTS; index++) {
+            TimerList_init(wheel->slots[level][index]);
+        }
+    }
+
+    return wheel;
+}
+
+static bool furi_event_loop_timer_wheel_is_empty(const FuriEventLoopTimerWheel* wheel) {
+    for(size_t level = 0; level < FURI_EVENT_LOOP_TIMER_WHEEL_LEVELS; level++) {
+        if(wheel->occupied[level]) return false;
+    }
+    return TimerList_empty_p(wheel->expired);
+}
+
+// Wheel time must be the current tick, see furi_event_loop_timer_wheel_advance()
+static void
+    furi_event_loop_timer_wheel_insert(FuriEventLoopTimerWheel* wheel, FuriEventLoopTimer* timer) {
+    const uint32_t elapsed_time = wheel->time - timer->start_time;
+
+    if(elapsed_time >= timer->interval) {
+        timer->slot = FURI_EVENT_LOOP_TIMER_SLOT_EXPIRED;
+        TimerList_push_back(wheel->expired, timer);
+        return;
+    }
+
+    // Timers beyond the wheel are placed at its edge and moved again from there
+    const uint32_t delta =
+        MIN(timer->interval - elapsed_time, FURI_EVENT_LOOP_TIMER_WHEEL_DELTA_MAX);
+
+    // The lowest level the delta fits in
+    size_t level = 0;
+    while(delta >> furi_event_loop_timer_wheel_shift(level + 1)) {
+        level++;
+    }
+
+    const uint32_t shift = furi_event_loop_timer_wheel_shift(level);
+    const size_t index = ((wheel->time + delta) >> shift) & FURI_EVENT_LOOP_TIMER_WHEEL_SLOT_MASK;
 
-    FURI_CRITICAL_ENTER();
+    timer->slot = level * FURI_EVENT_LOOP_TIMER_WHEEL_SLOTS + index;
+    TimerList_push_back(wheel->slots[level][index], timer);
+    wheel->occupied[level] |= 1U << index;
+}
+
+static void
+    furi_event_loop_timer_wheel_remove(FuriEventLoopTimerWheel* wheel, FuriEventLoopTimer* timer) {
+    TimerList_unlink(timer);
 
-    const uint32_t remaining_time = furi_event_loop_timer_get_remaining_time_private(timer);
+    if(timer->slot != FURI_EVENT_LOOP_TIMER_SLOT_EXPIRED) {
+        const size_t level = timer->slot / FURI_EVENT_LOOP_TIMER_WHEEL_SLOTS;
+        const size_t index = timer->slot % FURI_EVENT_LOOP_TIMER_WHEEL_SLOTS;
 
-    TimerList_it_t it;
-    for(TimerList_it_last(it, instance->timer_list); !TimerList_end_p(it);
-        TimerList_previous(it)) {
-        FuriEventLoopTimer* tmp = TimerList_ref(it);
-        if(remaining_time >= furi_event_loop_timer_get_remaining_time_private(tmp)) {
-            timer_pos = tmp;
-            break;
+        if(TimerList_empty_p(wheel->slots[level][index])) {
+            wheel->occupied[level] &= ~(1U << index);
         }
     }
 
-    FURI_CRITICAL_EXIT();
+    timer->slot = FURI_EVENT_LOOP_TIMER_SLOT_NONE;
+}
 
-    if(timer_pos) {
-        TimerList_push_after(timer_pos, timer);
-    } else {
-        TimerList_push_front(instance->timer_list, timer);
+// Ticks from the wheel time to the next slot to process, FuriWaitForever if there is none
+static uint32_t furi_event_loop_timer_wheel_get_next(const FuriEventLoopTimerWheel* wheel) {
+    uint32_t next = FuriWaitForever;
+
+    for(size_t level = 0; level < FURI_EVENT_LOOP_TIMER_WHEEL_LEVELS; level++) {
+        const uint32_t occupied = wheel->occupied[level];
+        if(!occupied) continue;
+
+        const uint32_t shift = furi_event_loop_timer_wheel_shift(level);
+        const uint32_t block = wheel->time >> shift;
+
+        // Rotate so bit 0 is the slot after the current one, the current slot comes last
+        const uint32_t rotation = (block + 1U) & FURI_EVENT_LOOP_TIMER_WHEEL_SLOT_MASK;
+        const uint32_t rotated = (occupied >> rotation) |
+                                 (occupied << (FURI_EVENT_LOOP_TIMER_WHEEL_SLOTS - rotation));
+        const uint32_t blocks = __builtin_ctz(rotated) + 1U;
+
+        next = MIN(next, ((block + blocks) << shift) - wheel->time);
     }
-    // At this point, TimerList_front() points to the first timer to expire
+
+    return next;
+}
+
+static void furi_event_loop_timer_wheel_move_slot(
+    FuriEventLoopTimerWheel* wheel,
+    size_t level,
+    size_t index) {
+    const uint16_t mask = 1U << index;
+    if(!(wheel->occupied[level] & mask)) return;
+
+    wheel->occupied[level] &= ~mask;
+
+    TimerList_t* slot = &wheel->slots[level][index];
+    while(!TimerList_empty_p(*slot)) {
+        furi_event_loop_timer_wheel_insert(wheel, TimerList_pop_front(*slot));
+    }
+}
+
+// Move all timers due by the given tick to the expired list
+static void furi_event_loop_timer_wheel_advance(FuriEventLoopTimerWheel* wheel, uint32_t now) {
+    while(true) {
+        const uint32_t next = furi_event_loop_timer_wheel_get_next(wheel);
+        // Only empty slots are skipped
+        if(next > now - wheel->time) break;
+
+        wheel->time += next;
+
+        // Higher levels first, so timers moved down can expire on this tick
+        for(size_t level = FURI_EVENT_LOOP_TIMER_WHEEL_LEVELS - 1; level > 0; level--) {
+            const uint32_t shift = furi_event_loop_timer_wheel_shift(level);
+            if(wheel->time & ((1UL << shift) - 1U)) continue;
+            furi_event_loop_timer_wheel_move_slot(
+                wheel, level, (wheel->time >> shift) & FURI_EVENT_LOOP_TIMER_WHEEL_SLOT_MASK);
+        }
+
+        furi_event_loop_timer_wheel_move_slot(
+            wheel, 0, wheel->time & FURI_EVENT_LOOP_TIMER_WHEEL_SLOT_MASK);
+    }
+
+    wheel->time = now;
 }
 
 static void furi_event_loop_timer_enqueue_request(
@@ -76,22 +182,27 @@ static void furi_event_loop_timer_enqueue_request(
  */
 
 uint32_t furi_event_loop_get_timer_wait_time(const FuriEventLoop* instance) {
-    uint32_t wait_time = FuriWaitForever;
+    const FuriEventLoopTimerWheel* wheel = instance->timer_wheel;
+    if(!wheel) return FuriWaitForever;
 
-    if(!TimerList_empty_p(instance->timer_list)) {
-        FuriEventLoopTimer* timer = TimerList_front(instance->timer_list);
-        wait_time = furi_event_loop_timer_get_remaining_time_private(timer);
-    }
+    if(!TimerList_empty_p(wheel->expired)) return 0;
 
-    return wait_time;
+    const uint32_t next = furi_event_loop_timer_wheel_get_next(wheel);
+    if(next == FuriWaitForever) return FuriWaitForever;
+
+    // Waking up for a higher level slot only moves its timers down
+    const uint32_t elapsed_time = xTaskGetTickCount() - wheel->time;
+    return elapsed_time < next ? next - elapsed_time : 0;
 }
 
 void furi_event_loop_process_timer_queue(FuriEventLoop* instance) {
+    FuriEventLoopTimerWheel* wheel = instance->timer_wheel;
+
     while(!TimerQueue_empty_p(instance->timer_queue)) {
         FuriEventLoopTimer* timer = TimerQueue_pop_front(instance->timer_queue);
 
         if(timer->active) {
-            TimerList_unlink(timer);
+            furi_event_loop_timer_wheel_remove(wheel, timer);
         }
 
         if(timer->request == FuriEventLoopTimerRequestStart) {
@@ -100,7 +211,8 @@ void furi_event_loop_process_timer_queue(FuriEventLoop* instance) {
             timer->start_time = xTaskGetTickCount();
             timer->request = FuriEventLoopTimerRequestNone;
 
-            furi_event_loop_schedule_timer(instance, timer);
+            furi_event_loop_timer_wheel_advance(wheel, timer->start_time);
+            furi_event_loop_timer_wheel_insert(wheel, timer);
 
         } else if(timer->request == FuriEventLoopTimerRequestStop) {
             timer->active = false;
@@ -116,24 +228,24 @@ void furi_event_loop_process_timer_queue(FuriEventLoop* instance) {
 }
 
 bool furi_event_loop_process_expired_timers(FuriEventLoop* instance) {
-    if(TimerList_empty_p(instance->timer_list)) {
-        return false;
-    }
-    // The front() element contains the earliest-expiring timer
-    FuriEventLoopTimer* timer = TimerList_front(instance->timer_list);
+    FuriEventLoopTimerWheel* wheel = instance->timer_wheel;
+    if(!wheel) return false;
+
+    // All timers due by now are collected at once and called one per loop iteration
+    furi_event_loop_timer_wheel_advance(wheel, xTaskGetTickCount());
 
-    if(!furi_event_loop_timer_is_expired(timer)) {
+    if(TimerList_empty_p(wheel->expired)) {
         return false;
     }
 
-    TimerList_unlink(timer);
+    FuriEventLoopTimer* timer = TimerList_front(wheel->expired);
+    furi_event_loop_timer_wheel_remove(wheel, timer);
 
     if(timer->periodic) {
-        const uint32_t num_events =
-            furi_event_loop_timer_get_elapsed_time(timer) / timer->interval;
+        const uint32_t num_events = (wheel->time - timer->start_time) / timer->interval;
 
         timer->start_time += timer->interval * num_events;
-        furi_event_loop_schedule_timer(instance, timer);
+        furi_event_loop_timer_wheel_insert(wheel, timer);
 
     } else {
         timer->active = false;
@@ -143,6 +255,16 @@ bool furi_event_loop_process_expired_timers(FuriEventLoop* instance) {
     return true;
 }
 
+void furi_event_loop_deinit_timers(FuriEventLoop* instance) {
+    FuriEventLoopTimerWheel* wheel = instance->timer_wheel;
+    if(!wheel) return;
+
+    furi_check(furi_event_loop_timer_wheel_is_empty(wheel));
+
+    free(wheel);
+    instance->timer_wheel = NULL;
+}
+
 /*
  * Public timer API
  */
@@ -157,12 +279,17 @@ FuriEventLoopTimer* furi_event_loop_timer_alloc(
     furi_check(callback);
     furi_check(type <= FuriEventLoopTimerTypePeriodic);
 
+    if(!instance->timer_wheel) {
+        instance->timer_wheel = furi_event_loop_timer_wheel_alloc();
+    }
+
     FuriEventLoopTimer* timer = malloc(sizeof(FuriEventLoopTimer));
 
     timer->owner = instance;
     timer->callback = callback;
     timer->context = context;
     timer->periodic = (type == FuriEventLoopTimerTypePeriodic);
+    timer->slot = FURI_EVENT_LOOP_TIMER_SLOT_NONE;
 
     TimerList_init_field(timer);
     TimerQueue_init_field(timer);
@@ -4,6 +4,14 @@
 
 #include <m-i-list.h>
 
+// Hierarchical timer wheel: 6 levels of 16 slots cover 2^24 ticks
+#define FURI_EVENT_LOOP_TIMER_WHEEL_LEVELS    (6U)
+#define FURI_EVENT_LOOP_TIMER_WHEEL_SLOT_BITS (4U)
+#define FURI_EVENT_LOOP_TIMER_WHEEL_SLOTS     (1U << FURI_EVENT_LOOP_TIMER_WHEEL_SLOT_BITS)
+
+#define FURI_EVENT_LOOP_TIMER_SLOT_EXPIRED (0xFEU)
+#define FURI_EVENT_LOOP_TIMER_SLOT_NONE    (0xFFU)
+
 typedef enum {
     FuriEventLoopTimerRequestNone,
     FuriEventLoopTimerRequestStart,
@@ -21,8 +29,10 @@ struct FuriEventLoopTimer {
     uint32_t start_time;
     uint32_t next_interval;
 
-    // Interface for the active timer list
+    // Interface for the timer wheel slot lists
     ILIST_INTERFACE(TimerList, FuriEventLoopTimer);
+    // Index of the slot the timer is linked to: level * slots + index
+    uint8_t slot;
 
     // Interface for the timer request queue
     ILIST_INTERFACE(TimerQueue, FuriEventLoopTimer);
@@ -36,6 +46,18 @@ struct FuriEventLoopTimer {
 ILIST_DEF(TimerList, FuriEventLoopTimer, M_POD_OPLIST)
 ILIST_DEF(TimerQueue, FuriEventLoopTimer, M_POD_OPLIST)
 
+typedef struct {
+    // Last processed tick, timers are placed relative to it
+    uint32_t time;
+    // Bitmaps of non-empty slots
+    uint16_t occupied[FURI_EVENT_LOOP_TIMER_WHEEL_LEVELS];
+    // Timers due to be called, in expiration order
+    TimerList_t expired;
+    TimerList_t slots[FURI_EVENT_LOOP_TIMER_WHEEL_LEVELS][FURI_EVENT_LOOP_TIMER_WHEEL_SLOTS];
+} FuriEventLoopTimerWheel;
+
+void furi_event_loop_deinit_timers(FuriEventLoop* instance);
+
 uint32_t furi_event_loop_get_timer_wait_time(const FuriEventLoop* instance);
 
 void furi_event_loop_process_timer_queue(FuriEventLoop* instance);
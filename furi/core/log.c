@@ -1,4 +1,4 @@
-#include "log.h"
+#include "log_i.h"
 #include "check.h"
 #include "mutex.h"
 #include <furi_hal.h>
@@ -107,12 +107,60 @@ void furi_log_puts(const char* data) {
     furi_log_tx((const uint8_t*)data, strlen(data));
 }
 
+static void furi_log_print_prefix(
+    FuriString* string,
+    FuriLogLevel level,
+    const char* tag,
+    uint32_t tick) {
+    const char* color = _FURI_LOG_CLR_RESET;
+    const char* log_letter = " ";
+    switch(level) {
+    case FuriLogLevelError:
+        color = _FURI_LOG_CLR_E;
+        log_letter = "E";
+        break;
+    case FuriLogLevelWarn:
+        color = _FURI_LOG_CLR_W;
+        log_letter = "W";
+        break;
+    case FuriLogLevelInfo:
+        color = _FURI_LOG_CLR_I;
+        log_letter = "I";
+        break;
+    case FuriLogLevelDebug:
+        color = _FURI_LOG_CLR_D;
+        log_letter = "D";
+        break;
+    case FuriLogLevelTrace:
+        color = _FURI_LOG_CLR_T;
+        log_letter = "T";
+        break;
+    default:
+        break;
+    }
+
+    // Timestamp
+    furi_string_printf(
+        string, "%lu %s[%s][%s] " _FURI_LOG_CLR_RESET, tick, color, log_letter, tag);
+    furi_log_puts(furi_string_get_cstr(string));
+    furi_string_reset(string);
+}
+
 void furi_log_print_format(FuriLogLevel level, const char* tag, const char* format, ...) {
     do {
         if(level > furi_log.log_level) {
             break;
         }
 
+        va_list args;
+        va_start(args, format);
+        bool deferred = furi_log_deferred_put(level, tag, format, args);
+        va_end(args);
+
+        if(deferred) {
+            break;
+        }
+
         if(furi_mutex_acquire(furi_log.mutex, furi_kernel_is_running() ? FuriWaitForever : 0) !=
            FuriStatusOk) {
             break;
@@ -120,40 +168,8 @@ void furi_log_print_format(FuriLogLevel level, const char* tag, const char* form
 
         FuriString* string = furi_string_alloc();
 
-        const char* color = _FURI_LOG_CLR_RESET;
-        const char* log_letter = " ";
-        switch(level) {
-        case FuriLogLevelError:
-            color = _FURI_LOG_CLR_E;
-            log_letter = "E";
-            break;
-        case FuriLogLevelWarn:
-            color = _FURI_LOG_CLR_W;
-            log_letter = "W";
-            break;
-        case FuriLogLevelInfo:
-            color = _FURI_LOG_CLR_I;
-            log_letter = "I";
-            break;
-        case FuriLogLevelDebug:
-            color = _FURI_LOG_CLR_D;
-            log_letter = "D";
-            break;
-        case FuriLogLevelTrace:
-            color = _FURI_LOG_CLR_T;
-            log_letter = "T";
-            break;
-        default:
-            break;
-        }
+        furi_log_print_prefix(string, level, tag, furi_get_tick());
 
-        // Timestamp
-        furi_string_printf(
-            string, "%lu %s[%s][%s] " _FURI_LOG_CLR_RESET, furi_get_tick(), color, log_letter, tag);
-        furi_log_puts(furi_string_get_cstr(string));
-        furi_string_reset(string);
-
-        va_list args;
         va_start(args, format);
         furi_string_vprintf(string, format, args);
         va_end(args);
@@ -167,6 +183,26 @@ void furi_log_print_format(FuriLogLevel level, const char* tag, const char* form
     } while(0);
 }
 
+void furi_log_print_record(
+    FuriLogLevel level,
+    const char* tag,
+    uint32_t tick,
+    const char* message) {
+    furi_check(tag);
+    furi_check(message);
+
+    furi_check(furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk);
+
+    FuriString* string = furi_string_alloc();
+    furi_log_print_prefix(string, level, tag, tick);
+    furi_string_free(string);
+
+    furi_log_puts(message);
+    furi_log_puts("\r\n");
+
+    furi_mutex_release(furi_log.mutex);
+}
+
 void furi_log_print_raw_format(FuriLogLevel level, const char* format, ...) {
     if(level <= furi_log.log_level &&
        furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk) {
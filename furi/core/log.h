@@ -39,6 +39,21 @@ typedef enum {
 #define _FURI_LOG_CLR_D _FURI_LOG_CLR(_FURI_LOG_CLR_BLUE)
 #define _FURI_LOG_CLR_T _FURI_LOG_CLR(_FURI_LOG_CLR_PURPLE)
 
+typedef enum {
+    FuriLogDeferredModeOff, /**< Records are formatted and sent by the caller */
+    FuriLogDeferredModeText, /**< Records are queued, formatted and sent by the log thread */
+    FuriLogDeferredModeBinary, /**< Records are queued and sent unformatted by the log thread */
+} FuriLogDeferredMode;
+
+typedef struct {
+    uint32_t queued; /**< Records queued for deferred output */
+    uint32_t dropped; /**< Records dropped because the queue was full */
+    uint32_t immediate; /**< Records printed by the caller because they could not be queued */
+} FuriLogDeferredStats;
+
+/** Magic preceding each record in FuriLogDeferredModeBinary output */
+#define FURI_LOG_DEFERRED_BINARY_MAGIC (0x474C4246UL) // "FBLG"
+
 typedef void (*FuriLogHandlerCallback)(const uint8_t* data, size_t size, void* context);
 
 typedef struct {
@@ -109,6 +124,36 @@ void furi_log_set_level(FuriLogLevel level);
  */
 FuriLogLevel furi_log_get_level(void);
 
+/** Set deferred logging mode
+ *
+ * In deferred modes log calls only copy the tag and format addresses, tick, level and
+ * arguments to a lock-free queue, which makes them cheap enough for time critical code and
+ * interrupts. A low priority thread then formats queued records or sends them in binary form,
+ * to be decoded on the host with scripts/log_decode.py and the firmware ELF.
+ *
+ * Tag and format strings outside of the firmware image (e.g. from applications) are copied
+ * to the queue, string arguments are copied and truncated to 32 characters. Records with
+ * %n, wide strings, too long formats or too many arguments are printed immediately.
+ *
+ * @param[in]  mode  The mode
+ */
+void furi_log_set_deferred_mode(FuriLogDeferredMode mode);
+
+/** Get deferred logging mode
+ *
+ * @return     The deferred logging mode
+ */
+FuriLogDeferredMode furi_log_get_deferred_mode(void);
+
+/** Wait until all queued log records are sent */
+void furi_log_flush(void);
+
+/** Get deferred logging statistics
+ *
+ * @param[out] stats  The statistics
+ */
+void furi_log_get_deferred_stats(FuriLogDeferredStats* stats);
+
 /** Log level to string
  *
  * @param[in]  level  The level
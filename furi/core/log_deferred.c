@@ -0,0 +1,568 @@
+#include "log_i.h"
+#include "check.h"
+#include "common_defines.h"
+#include "kernel.h"
+#include "thread.h"
+
+#include <stm32wbxx.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Single core: one queue shared by all threads and interrupts
+#define FURI_LOG_DEFERRED_BUFFER_WORDS   (1024U)
+#define FURI_LOG_DEFERRED_RECORD_WORDS   (64U)
+#define FURI_LOG_DEFERRED_STRING_MAX     (32U)
+#define FURI_LOG_DEFERRED_STRING_WORDS   (FURI_LOG_DEFERRED_STRING_MAX / sizeof(uint32_t) + 1U)
+#define FURI_LOG_DEFERRED_INLINE_MAX     (64U)
+#define FURI_LOG_DEFERRED_SPEC_SIZE_MAX  (16U)
+// Also fits the biggest binary record with magic
+#define FURI_LOG_DEFERRED_MESSAGE_SIZE   (320U)
+#define FURI_LOG_DEFERRED_STACK_SIZE     (2048U)
+#define FURI_LOG_DEFERRED_POLL_MS        (10U)
+
+#define FURI_LOG_DEFERRED_WAKE_FLAG (1UL << 0)
+
+// Record: header, tick, tag, format, arguments
+// Header: size in words | level << 16 | flags << 24
+// Tag and format: address in flash or, with the inline flag, length word and characters
+#define FURI_LOG_DEFERRED_FLAG_COMMITTED     (1UL << 0)
+#define FURI_LOG_DEFERRED_FLAG_PADDING       (1UL << 1)
+#define FURI_LOG_DEFERRED_FLAG_TAG_INLINE    (1UL << 2)
+#define FURI_LOG_DEFERRED_FLAG_FORMAT_INLINE (1UL << 3)
+
+#define FURI_LOG_DEFERRED_HEADER(words, level, flags) \
+    ((uint32_t)(words) | ((uint32_t)(level) << 16) | ((uint32_t)(flags) << 24))
+#define FURI_LOG_DEFERRED_HEADER_WORDS_GET(header) ((header) & 0xFFFFU)
+#define FURI_LOG_DEFERRED_HEADER_LEVEL_GET(header) (((header) >> 16) & 0xFFU)
+#define FURI_LOG_DEFERRED_HEADER_FLAGS_GET(header) ((header) >> 24)
+
+typedef enum {
+    FuriLogDeferredArgNone,
+    FuriLogDeferredArgInt,
+    FuriLogDeferredArgLongLong,
+    FuriLogDeferredArgDouble,
+    FuriLogDeferredArgPointer,
+    FuriLogDeferredArgString,
+    FuriLogDeferredArgUnsupported,
+} FuriLogDeferredArg;
+
+typedef struct {
+    size_t length;
+    size_t stars;
+    bool precision_star;
+    int precision;
+    bool long_double;
+    FuriLogDeferredArg arg;
+} FuriLogDeferredSpec;
+
+typedef struct {
+    FuriLogDeferredMode mode;
+    FuriThread* thread;
+    uint32_t* buffer;
+    uint32_t head;
+    uint32_t tail;
+    uint32_t dropped_reported;
+    FuriLogDeferredStats stats;
+} FuriLogDeferred;
+
+static FuriLogDeferred furi_log_deferred = {0};
+
+static bool furi_log_deferred_is_static(const char* str) {
+    return (uintptr_t)str >= FLASH_BASE && (uintptr_t)str < FLASH_BASE + FLASH_SIZE;
+}
+
+// Length word followed by null-terminated characters, returns number of words
+static size_t furi_log_deferred_put_string(uint32_t* words, const char* str, size_t length) {
+    words[0] = length;
+    char* chars = (char*)&words[1];
+    memcpy(chars, str, length);
+    chars[length] = '\0';
+    return 1 + length / sizeof(uint32_t) + 1;
+}
+
+static const char* furi_log_deferred_get_string(const uint32_t** words) {
+    const char* str = (const char*)&(*words)[1];
+    *words += 1 + (*words)[0] / sizeof(uint32_t) + 1;
+    return str;
+}
+
+// Strings in flash outlive the record, others are copied as they may be gone when it is printed
+static size_t furi_log_deferred_put_field(
+    uint32_t* words,
+    const char* str,
+    uint32_t* flags,
+    uint32_t inline_flag) {
+    if(furi_log_deferred_is_static(str)) {
+        words[0] = (uintptr_t)str;
+        return 1;
+    }
+
+    const size_t length = strnlen(str, FURI_LOG_DEFERRED_INLINE_MAX + 1);
+    if(length > FURI_LOG_DEFERRED_INLINE_MAX) return SIZE_MAX;
+
+    *flags |= inline_flag;
+    return furi_log_deferred_put_string(words, str, length);
+}
+
+static const char* furi_log_deferred_get_field(const uint32_t** words, bool is_inline) {
+    if(is_inline) return furi_log_deferred_get_string(words);
+
+    const char* str = (const char*)(*words)[0];
+    *words += 1;
+    return str;
+}
+
+static const char* furi_log_deferred_parse_spec(const char* start, FuriLogDeferredSpec* spec) {
+    const char* p = start + 1;
+
+    spec->stars = 0;
+    spec->precision_star = false;
+    spec->precision = -1;
+    spec->long_double = false;
+
+    // Flags and width
+    while(*p && strchr("-+ #0", *p)) p++;
+    if(*p == '*') {
+        spec->stars++;
+        p++;
+    } else {
+        while(*p >= '0' && *p <= '9') p++;
+    }
+
+    // Precision
+    if(*p == '.') {
+        p++;
+        if(*p == '*') {
+            spec->stars++;
+            spec->precision_star = true;
+            p++;
+        } else {
+            spec->precision = 0;
+            while(*p >= '0' && *p <= '9') {
+                spec->precision = spec->precision * 10 + (*p - '0');
+                p++;
+            }
+        }
+    }
+
+    // Length, everything except ll and j fits a word on this target
+    bool is_long = false;
+    bool is_long_long = false;
+    if(*p == 'h') {
+        p++;
+        if(*p == 'h') p++;
+    } else if(*p == 'l') {
+        p++;
+        is_long = true;
+        if(*p == 'l') {
+            p++;
+            is_long_long = true;
+        }
+    } else if(*p == 'j') {
+        p++;
+        is_long_long = true;
+    } else if(*p == 'z' || *p == 't') {
+        p++;
+    } else if(*p == 'L') {
+        p++;
+        spec->long_double = true;
+    }
+
+    switch(*p) {
+    case '%':
+        spec->arg = FuriLogDeferredArgNone;
+        break;
+    case 'd':
+    case 'i':
+    case 'u':
+    case 'o':
+    case 'x':
+    case 'X':
+    case 'c':
+        spec->arg = is_long_long ? FuriLogDeferredArgLongLong : FuriLogDeferredArgInt;
+        break;
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A':
+        spec->arg = FuriLogDeferredArgDouble;
+        break;
+    case 'p':
+        spec->arg = FuriLogDeferredArgPointer;
+        break;
+    case 's':
+        spec->arg = is_long ? FuriLogDeferredArgUnsupported : FuriLogDeferredArgString;
+        break;
+    default:
+        // %n, wide characters and broken specifications
+        spec->arg = FuriLogDeferredArgUnsupported;
+        break;
+    }
+
+    if(*p) p++;
+    spec->length = p - start;
+    if(spec->length >= FURI_LOG_DEFERRED_SPEC_SIZE_MAX) {
+        spec->arg = FuriLogDeferredArgUnsupported;
+    }
+
+    return p;
+}
+
+// Returns number of packed words or SIZE_MAX if arguments can't be packed
+static size_t
+    furi_log_deferred_pack(uint32_t* words, size_t size, const char* format, va_list args) {
+    size_t count = 0;
+    const char* p = format;
+
+    while(*p) {
+        if(*p != '%') {
+            p++;
+            continue;
+        }
+
+        FuriLogDeferredSpec spec;
+        p = furi_log_deferred_parse_spec(p, &spec);
+        if(spec.arg == FuriLogDeferredArgUnsupported) return SIZE_MAX;
+        if(count + spec.stars + 1 + FURI_LOG_DEFERRED_STRING_WORDS > size) return SIZE_MAX;
+
+        for(size_t i = 0; i < spec.stars; i++) {
+            int star = va_arg(args, int);
+            words[count++] = star;
+            if(spec.precision_star) spec.precision = star;
+        }
+
+        switch(spec.arg) {
+        case FuriLogDeferredArgInt:
+            words[count++] = va_arg(args, unsigned int);
+            break;
+        case FuriLogDeferredArgLongLong: {
+            unsigned long long value = va_arg(args, unsigned long long);
+            memcpy(&words[count], &value, sizeof(value));
+            count += 2;
+            break;
+        }
+        case FuriLogDeferredArgDouble: {
+            double value = spec.long_double ? (double)va_arg(args, long double) :
+                                              va_arg(args, double);
+            memcpy(&words[count], &value, sizeof(value));
+            count += 2;
+            break;
+        }
+        case FuriLogDeferredArgPointer:
+            words[count++] = (uintptr_t)va_arg(args, void*);
+            break;
+        case FuriLogDeferredArgString: {
+            const char* str = va_arg(args, const char*);
+            if(!str) str = "(null)";
+            size_t length_max = FURI_LOG_DEFERRED_STRING_MAX;
+            if(spec.precision >= 0 && (size_t)spec.precision < length_max) {
+                length_max = spec.precision;
+            }
+            count += furi_log_deferred_put_string(&words[count], str, strnlen(str, length_max));
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    return count;
+}
+
+static void furi_log_deferred_format(
+    char* message,
+    size_t size,
+    const char* format,
+    const uint32_t* words,
+    size_t count) {
+    size_t length = 0;
+    size_t w = 0;
+    const char* p = format;
+
+    while(*p && length < size - 1) {
+        if(*p != '%') {
+            message[length++] = *p++;
+            continue;
+        }
+
+        FuriLogDeferredSpec spec;
+        const char* next = furi_log_deferred_parse_spec(p, &spec);
+        char spec_str[FURI_LOG_DEFERRED_SPEC_SIZE_MAX];
+        memcpy(spec_str, p, spec.length);
+        spec_str[spec.length] = '\0';
+        p = next;
+
+        int stars[2] = {0};
+        for(size_t i = 0; i < spec.stars; i++) {
+            stars[i] = words[w++];
+        }
+
+        char* out = message + length;
+        const size_t out_size = size - length;
+        int written = 0;
+
+#define FURI_LOG_DEFERRED_PRINT(value)                                                 \
+    (spec.stars == 0 ? snprintf(out, out_size, spec_str, value) :                      \
+     spec.stars == 1 ? snprintf(out, out_size, spec_str, stars[0], value) :            \
+                       snprintf(out, out_size, spec_str, stars[0], stars[1], value))
+
+        switch(spec.arg) {
+        case FuriLogDeferredArgNone:
+            written = snprintf(out, out_size, "%%");
+            break;
+        case FuriLogDeferredArgInt:
+            written = FURI_LOG_DEFERRED_PRINT(words[w]);
+            w++;
+            break;
+        case FuriLogDeferredArgLongLong: {
+            unsigned long long value;
+            memcpy(&value, &words[w], sizeof(value));
+            written = FURI_LOG_DEFERRED_PRINT(value);
+            w += 2;
+            break;
+        }
+        case FuriLogDeferredArgDouble: {
+            double value;
+            memcpy(&value, &words[w], sizeof(value));
+            if(spec.long_double) {
+                written = FURI_LOG_DEFERRED_PRINT((long double)value);
+            } else {
+                written = FURI_LOG_DEFERRED_PRINT(value);
+            }
+            w += 2;
+            break;
+        }
+        case FuriLogDeferredArgPointer:
+            written = FURI_LOG_DEFERRED_PRINT((void*)words[w]);
+            w++;
+            break;
+        case FuriLogDeferredArgString: {
+            const uint32_t* str_words = &words[w];
+            written = FURI_LOG_DEFERRED_PRINT(furi_log_deferred_get_string(&str_words));
+            w = str_words - words;
+            break;
+        }
+        default:
+            break;
+        }
+
+#undef FURI_LOG_DEFERRED_PRINT
+
+        furi_check(w <= count);
+        if(written > 0) {
+            length = MIN(length + written, size - 1);
+        }
+    }
+
+    message[length] = '\0';
+}
+
+static void furi_log_deferred_output(const uint32_t* record, size_t words, char* message) {
+    const uint32_t header = record[0];
+
+    if(furi_log_deferred.mode == FuriLogDeferredModeBinary) {
+        // Magic and record in one piece, so other output can't get in between
+        const uint32_t magic = FURI_LOG_DEFERRED_BINARY_MAGIC;
+        memcpy(message, &magic, sizeof(magic));
+        memcpy(message + sizeof(magic), record, words * sizeof(uint32_t));
+        furi_log_tx((const uint8_t*)message, sizeof(magic) + words * sizeof(uint32_t));
+    } else {
+        const uint32_t flags = FURI_LOG_DEFERRED_HEADER_FLAGS_GET(header);
+        const uint32_t* args = &record[2];
+        const char* tag =
+            furi_log_deferred_get_field(&args, flags & FURI_LOG_DEFERRED_FLAG_TAG_INLINE);
+        const char* format =
+            furi_log_deferred_get_field(&args, flags & FURI_LOG_DEFERRED_FLAG_FORMAT_INLINE);
+        furi_log_deferred_format(
+            message, FURI_LOG_DEFERRED_MESSAGE_SIZE, format, args, &record[words] - args);
+        furi_log_print_record(FURI_LOG_DEFERRED_HEADER_LEVEL_GET(header), tag, record[1], message);
+    }
+}
+
+static void furi_log_deferred_process(char* message) {
+    FuriLogDeferred* deferred = &furi_log_deferred;
+
+    uint32_t tail = deferred->tail;
+    while(tail != __atomic_load_n(&deferred->head, __ATOMIC_ACQUIRE)) {
+        uint32_t* record = &deferred->buffer[tail % FURI_LOG_DEFERRED_BUFFER_WORDS];
+        const uint32_t header = __atomic_load_n(record, __ATOMIC_ACQUIRE);
+        const uint32_t flags = FURI_LOG_DEFERRED_HEADER_FLAGS_GET(header);
+        // Reserved, but still being written by a producer
+        if(!(flags & FURI_LOG_DEFERRED_FLAG_COMMITTED)) break;
+
+        const size_t words = FURI_LOG_DEFERRED_HEADER_WORDS_GET(header);
+        if(!(flags & FURI_LOG_DEFERRED_FLAG_PADDING)) {
+            furi_log_deferred_output(record, words, message);
+        }
+
+        memset(record, 0, words * sizeof(uint32_t));
+        tail += words;
+        __atomic_store_n(&deferred->tail, tail, __ATOMIC_RELEASE);
+    }
+
+    const uint32_t dropped = __atomic_load_n(&deferred->stats.dropped, __ATOMIC_RELAXED);
+    if(dropped != deferred->dropped_reported) {
+        snprintf(
+            message,
+            FURI_LOG_DEFERRED_MESSAGE_SIZE,
+            "%lu records dropped",
+            dropped - deferred->dropped_reported);
+        furi_log_print_record(FuriLogLevelWarn, "FuriLog", furi_get_tick(), message);
+        deferred->dropped_reported = dropped;
+    }
+}
+
+static int32_t furi_log_deferred_worker(void* context) {
+    UNUSED(context);
+
+    char* message = malloc(FURI_LOG_DEFERRED_MESSAGE_SIZE);
+
+    while(true) {
+        furi_thread_flags_wait(
+            FURI_LOG_DEFERRED_WAKE_FLAG, FuriFlagWaitAny, FURI_LOG_DEFERRED_POLL_MS);
+        furi_log_deferred_process(message);
+    }
+
+    free(message);
+
+    return 0;
+}
+
+static uint32_t* furi_log_deferred_reserve(FuriLogDeferred* deferred, size_t words) {
+    uint32_t head = __atomic_load_n(&deferred->head, __ATOMIC_RELAXED);
+    uint32_t new_head;
+    size_t padding;
+
+    do {
+        // Records are never split at the end of the buffer
+        const size_t offset = head % FURI_LOG_DEFERRED_BUFFER_WORDS;
+        padding = (offset + words > FURI_LOG_DEFERRED_BUFFER_WORDS) ?
+                      FURI_LOG_DEFERRED_BUFFER_WORDS - offset :
+                      0;
+        new_head = head + padding + words;
+
+        const uint32_t tail = __atomic_load_n(&deferred->tail, __ATOMIC_ACQUIRE);
+        if(new_head - tail > FURI_LOG_DEFERRED_BUFFER_WORDS) return NULL;
+    } while(!__atomic_compare_exchange_n(
+        &deferred->head, &head, new_head, true, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED));
+
+    if(padding) {
+        uint32_t* pad = &deferred->buffer[head % FURI_LOG_DEFERRED_BUFFER_WORDS];
+        __atomic_store_n(
+            pad,
+            FURI_LOG_DEFERRED_HEADER(
+                padding, 0, FURI_LOG_DEFERRED_FLAG_COMMITTED | FURI_LOG_DEFERRED_FLAG_PADDING),
+            __ATOMIC_RELEASE);
+    }
+
+    return &deferred->buffer[(head + padding) % FURI_LOG_DEFERRED_BUFFER_WORDS];
+}
+
+bool furi_log_deferred_put(FuriLogLevel level, const char* tag, const char* format, va_list args) {
+    FuriLogDeferred* deferred = &furi_log_deferred;
+
+    if(deferred->mode == FuriLogDeferredModeOff) return false;
+
+    bool queued = false;
+
+    do {
+        // Record is assembled on the stack, so the queue is only held for a copy
+        uint32_t words[FURI_LOG_DEFERRED_RECORD_WORDS];
+        uint32_t flags = FURI_LOG_DEFERRED_FLAG_COMMITTED;
+        size_t count = 2;
+
+        size_t field = furi_log_deferred_put_field(
+            &words[count], tag, &flags, FURI_LOG_DEFERRED_FLAG_TAG_INLINE);
+        if(field == SIZE_MAX) break;
+        count += field;
+
+        field = furi_log_deferred_put_field(
+            &words[count], format, &flags, FURI_LOG_DEFERRED_FLAG_FORMAT_INLINE);
+        if(field == SIZE_MAX) break;
+        count += field;
+
+        field = furi_log_deferred_pack(
+            &words[count], FURI_LOG_DEFERRED_RECORD_WORDS - count, format, args);
+        if(field == SIZE_MAX) break;
+        count += field;
+
+        // From here on the record is either queued or lost
+        queued = true;
+
+        uint32_t* record = furi_log_deferred_reserve(deferred, count);
+        if(!record) {
+            __atomic_fetch_add(&deferred->stats.dropped, 1, __ATOMIC_RELAXED);
+            break;
+        }
+
+        words[1] = furi_get_tick();
+        memcpy(&record[1], &words[1], (count - 1) * sizeof(uint32_t));
+        // Header goes last: consumer stops at the first record which is not committed
+        __atomic_store_n(
+            &record[0], FURI_LOG_DEFERRED_HEADER(count, level, flags), __ATOMIC_RELEASE);
+        __atomic_fetch_add(&deferred->stats.queued, 1, __ATOMIC_RELAXED);
+
+        const uint32_t used = __atomic_load_n(&deferred->head, __ATOMIC_RELAXED) -
+                              __atomic_load_n(&deferred->tail, __ATOMIC_RELAXED);
+        if(used >= FURI_LOG_DEFERRED_BUFFER_WORDS / 2) {
+            furi_thread_flags_set(
+                furi_thread_get_id(deferred->thread), FURI_LOG_DEFERRED_WAKE_FLAG);
+        }
+    } while(false);
+
+    if(!queued) {
+        __atomic_fetch_add(&deferred->stats.immediate, 1, __ATOMIC_RELAXED);
+    }
+
+    return queued;
+}
+
+void furi_log_set_deferred_mode(FuriLogDeferredMode mode) {
+    furi_check(mode <= FuriLogDeferredModeBinary);
+    furi_check(!FURI_IS_ISR());
+
+    FuriLogDeferred* deferred = &furi_log_deferred;
+
+    if(mode != FuriLogDeferredModeOff && !deferred->thread) {
+        // Allocated on first use and kept afterwards, queued records may refer to the buffer
+        deferred->buffer = malloc(FURI_LOG_DEFERRED_BUFFER_WORDS * sizeof(uint32_t));
+        deferred->thread = furi_thread_alloc_ex(
+            "LogWorker", FURI_LOG_DEFERRED_STACK_SIZE, furi_log_deferred_worker, NULL);
+        furi_thread_set_priority(deferred->thread, FuriThreadPriorityLow);
+        furi_thread_start(deferred->thread);
+    }
+
+    // Queued records are sent in the mode they were queued in
+    furi_log_flush();
+    deferred->mode = mode;
+}
+
+FuriLogDeferredMode furi_log_get_deferred_mode(void) {
+    return furi_log_deferred.mode;
+}
+
+void furi_log_flush(void) {
+    FuriLogDeferred* deferred = &furi_log_deferred;
+
+    if(!deferred->thread || FURI_IS_ISR()) return;
+    if(furi_thread_get_current_id() == furi_thread_get_id(deferred->thread)) return;
+
+    furi_thread_flags_set(furi_thread_get_id(deferred->thread), FURI_LOG_DEFERRED_WAKE_FLAG);
+    while(__atomic_load_n(&deferred->tail, __ATOMIC_ACQUIRE) !=
+          __atomic_load_n(&deferred->head, __ATOMIC_ACQUIRE)) {
+        furi_delay_tick(1);
+    }
+}
+
+void furi_log_get_deferred_stats(FuriLogDeferredStats* stats) {
+    furi_check(stats);
+
+    stats->queued = __atomic_load_n(&furi_log_deferred.stats.queued, __ATOMIC_RELAXED);
+    stats->dropped = __atomic_load_n(&furi_log_deferred.stats.dropped, __ATOMIC_RELAXED);
+    stats->immediate = __atomic_load_n(&furi_log_deferred.stats.immediate, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,39 @@
+/**
+ * @file log_i.h
+ * Furi Logging system, private definitions
+ */
+#pragma once
+
+#include "log.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Print formatted log record through log IO callbacks
+ *
+ * @param[in]  level    The level
+ * @param[in]  tag      The tag
+ * @param[in]  tick     The tick when record was created
+ * @param[in]  message  The formatted message, null-terminated C-string
+ */
+void furi_log_print_record(
+    FuriLogLevel level,
+    const char* tag,
+    uint32_t tick,
+    const char* message);
+
+/** Queue log record for deferred output
+ *
+ * @param[in]  level   The level
+ * @param[in]  tag     The tag
+ * @param[in]  format  The format
+ * @param[in]  args    The format arguments
+ *
+ * @return     true if record was queued or dropped, false if it must be printed immediately
+ */
+bool furi_log_deferred_put(FuriLogLevel level, const char* tag, const char* format, va_list args);
+
+#ifdef __cplusplus
+}
+#endif
@@ -2,37 +2,40 @@
 #include <string.h>
 #include <furi_hal_memory.h>
 
-extern void* pvPortMalloc(size_t xSize);
-extern void vPortFree(void* pv);
+extern void* memmgr_heap_malloc(size_t size, uint32_t caller);
+extern void memmgr_heap_free(void* pointer, uint32_t caller);
 extern size_t xPortGetFreeHeapSize(void);
 extern size_t xPortGetTotalHeapSize(void);
 extern size_t xPortGetMinimumEverFreeHeapSize(void);
 
+// Return addresses are passed down for the allocation profile
+#define MEMMGR_CALLER() ((uint32_t)__builtin_return_address(0))
+
 void* malloc(size_t size) {
-    return pvPortMalloc(size);
+    return memmgr_heap_malloc(size, MEMMGR_CALLER());
 }
 
 void free(void* ptr) {
-    vPortFree(ptr);
+    memmgr_heap_free(ptr, MEMMGR_CALLER());
 }
 
 void* realloc(void* ptr, size_t size) {
     if(size == 0) {
-        vPortFree(ptr);
+        memmgr_heap_free(ptr, MEMMGR_CALLER());
         return NULL;
     }
 
-    void* p = pvPortMalloc(size);
+    void* p = memmgr_heap_malloc(size, MEMMGR_CALLER());
     if(ptr != NULL) {
         memcpy(p, ptr, size);
-        vPortFree(ptr);
+        memmgr_heap_free(ptr, MEMMGR_CALLER());
     }
 
     return p;
 }
 
 void* calloc(size_t count, size_t size) {
-    return pvPortMalloc(count * size);
+    return memmgr_heap_malloc(count * size, MEMMGR_CALLER());
 }
 
 char* strdup(const char* s) {
@@ -40,7 +43,7 @@ char* strdup(const char* s) {
     furi_check(((uint32_t)s << 2) != 0);
 
     size_t siz = strlen(s) + 1;
-    char* y = pvPortMalloc(siz);
+    char* y = memmgr_heap_malloc(siz, MEMMGR_CALLER());
     memcpy(y, s, siz);
 
     return y;
@@ -60,17 +63,17 @@ size_t memmgr_get_minimum_free_heap(void) {
 
 void* __wrap__malloc_r(struct _reent* r, size_t size) {
     UNUSED(r);
-    return pvPortMalloc(size);
+    return memmgr_heap_malloc(size, MEMMGR_CALLER());
 }
 
 void __wrap__free_r(struct _reent* r, void* ptr) {
     UNUSED(r);
-    vPortFree(ptr);
+    memmgr_heap_free(ptr, MEMMGR_CALLER());
 }
 
 void* __wrap__calloc_r(struct _reent* r, size_t count, size_t size) {
     UNUSED(r);
-    return calloc(count, size);
+    return memmgr_heap_malloc(count * size, MEMMGR_CALLER());
 }
 
 void* __wrap__realloc_r(struct _reent* r, void* ptr, size_t size) {
@@ -38,6 +38,7 @@
 #include "check.h"
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <stm32wbxx.h>
 #include <stm32wb55_linker.h>
 #include <core/log.h>
@@ -83,6 +84,12 @@ typedef struct A_BLOCK_LINK {
  */
 static void prvInsertBlockIntoFreeList(BlockLink_t* pxBlockToInsert);
 
+/*
+ * Takes the first block of adequate size out of the list of free blocks,
+ * splitting it if it is larger than required. Returns NULL if there is none.
+ */
+static BlockLink_t* prvTakeBlockFromFreeList(size_t xWantedSize);
+
 /*
  * Called automatically to setup the required heap structures the first time
  * pvPortMalloc() is called.
@@ -219,11 +226,375 @@ static inline void traceFREE(void* pointer, size_t size) {
     }
 }
 
+/* Allocation profile, must match scripts/heap_profile.py */
+#define MEMMGR_HEAP_PROFILE_NAME_SIZE      (24U)
+#define MEMMGR_HEAP_PROFILE_THREAD_COUNT   (63U)
+#define MEMMGR_HEAP_PROFILE_THREAD_UNKNOWN (MEMMGR_HEAP_PROFILE_THREAD_COUNT)
+#define MEMMGR_HEAP_PROFILE_IMAGE_COUNT    (16U)
+#define MEMMGR_HEAP_PROFILE_HEADROOM       (4096U) // Left for the rest of the system
+
+#define MEMMGR_HEAP_PROFILE_SIZE_MASK    (0x00FFFFFFUL)
+#define MEMMGR_HEAP_PROFILE_THREAD_SHIFT (24U)
+#define MEMMGR_HEAP_PROFILE_TYPE_SHIFT   (30U)
+
+typedef enum {
+    MemmgrHeapProfileEventMalloc, /* address: block, caller: return address */
+    MemmgrHeapProfileEventFree, /* address: block, caller: return address */
+    MemmgrHeapProfileEventImage, /* address: image .text, caller: image index */
+} MemmgrHeapProfileEvent;
+
+typedef struct {
+    uint32_t timestamp; // System tick
+    uint32_t address;
+    uint32_t caller;
+    uint32_t info; // Size: 24 bits, thread index: 6 bits, event: 2 bits
+} MemmgrHeapProfileRecord;
+
+static_assert(sizeof(MemmgrHeapProfileRecord) == MEMMGR_HEAP_PROFILE_RECORD_SIZE);
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t record_size;
+    uint32_t tick_rate;
+    uint32_t record_count;
+    uint32_t lost;
+} MemmgrHeapProfileDumpHeader;
+
+// Followed by the name characters, the list ends with an empty name
+typedef struct {
+    uint32_t index;
+    uint8_t type;
+    uint8_t size;
+} FURI_PACKED MemmgrHeapProfileDumpName;
+
+typedef enum {
+    MemmgrHeapProfileDumpNameTypeThread,
+    MemmgrHeapProfileDumpNameTypeImage,
+} MemmgrHeapProfileDumpNameType;
+
+typedef struct {
+    FuriThreadId id;
+    char name[MEMMGR_HEAP_PROFILE_NAME_SIZE];
+} MemmgrHeapProfileThread;
+
+typedef struct {
+    MemmgrHeapProfileRecord* records;
+    size_t capacity;
+    size_t count;
+    uint32_t lost;
+    bool running;
+    // Names are copied, threads and applications may be gone by the time of the dump
+    MemmgrHeapProfileThread* threads;
+    size_t thread_count;
+    size_t thread_last;
+    char (*images)[MEMMGR_HEAP_PROFILE_NAME_SIZE];
+    size_t image_count;
+} MemmgrHeapProfile;
+
+static MemmgrHeapProfile memmgr_heap_profile = {0};
+
+static uint32_t memmgr_heap_profile_thread_index(void) {
+    MemmgrHeapProfile* profile = &memmgr_heap_profile;
+    const FuriThreadId thread_id = furi_thread_get_current_id();
+    const char* name = furi_thread_get_name(thread_id);
+    if(!name) return MEMMGR_HEAP_PROFILE_THREAD_UNKNOWN;
+
+    // Handles of finished threads are reused, so names are compared too
+    MemmgrHeapProfileThread* thread = &profile->threads[profile->thread_last];
+    if(profile->thread_count && thread->id == thread_id &&
+       strncmp(thread->name, name, MEMMGR_HEAP_PROFILE_NAME_SIZE - 1) == 0) {
+        return profile->thread_last;
+    }
+
+    for(size_t i = 0; i < profile->thread_count; i++) {
+        thread = &profile->threads[i];
+        if(thread->id == thread_id &&
+           strncmp(thread->name, name, MEMMGR_HEAP_PROFILE_NAME_SIZE - 1) == 0) {
+            profile->thread_last = i;
+            return i;
+        }
+    }
+
+    if(profile->thread_count == MEMMGR_HEAP_PROFILE_THREAD_COUNT) {
+        return MEMMGR_HEAP_PROFILE_THREAD_UNKNOWN;
+    }
+
+    thread = &profile->threads[profile->thread_count];
+    thread->id = thread_id;
+    strncpy(thread->name, name, MEMMGR_HEAP_PROFILE_NAME_SIZE - 1);
+    profile->thread_last = profile->thread_count++;
+    return profile->thread_last;
+}
+
+/* Must be called with the scheduler suspended */
+static void memmgr_heap_profile_record(
+    MemmgrHeapProfileEvent event,
+    const void* address,
+    size_t size,
+    uint32_t caller) {
+    MemmgrHeapProfile* profile = &memmgr_heap_profile;
+    if(!profile->running || !address) return;
+
+    // Oldest events are kept: live memory can't be restored without them
+    if(profile->count == profile->capacity) {
+        profile->lost++;
+        return;
+    }
+
+    MemmgrHeapProfileRecord* record = &profile->records[profile->count++];
+    record->timestamp = xTaskGetTickCount();
+    record->address = (uint32_t)address;
+    record->caller = caller;
+    record->info = MIN(size, MEMMGR_HEAP_PROFILE_SIZE_MASK) |
+                   (memmgr_heap_profile_thread_index() << MEMMGR_HEAP_PROFILE_THREAD_SHIFT) |
+                   ((uint32_t)event << MEMMGR_HEAP_PROFILE_TYPE_SHIFT);
+}
+
+void memmgr_heap_profile_start(size_t capacity) {
+    furi_check(capacity);
+    furi_check(capacity <= SIZE_MAX / sizeof(MemmgrHeapProfileRecord));
+
+    memmgr_heap_profile_stop();
+
+    MemmgrHeapProfile* profile = &memmgr_heap_profile;
+    free(profile->records);
+    free(profile->threads);
+    free(profile->images);
+
+    MemmgrHeapProfileRecord* records = malloc(capacity * sizeof(MemmgrHeapProfileRecord));
+    MemmgrHeapProfileThread* threads =
+        malloc(MEMMGR_HEAP_PROFILE_THREAD_COUNT * sizeof(MemmgrHeapProfileThread));
+    void* images = malloc(MEMMGR_HEAP_PROFILE_IMAGE_COUNT * MEMMGR_HEAP_PROFILE_NAME_SIZE);
+
+    vTaskSuspendAll();
+    {
+        profile->records = records;
+        profile->capacity = capacity;
+        profile->count = 0;
+        profile->lost = 0;
+        profile->threads = threads;
+        profile->thread_count = 0;
+        profile->thread_last = 0;
+        profile->images = images;
+        profile->image_count = 0;
+        profile->running = true;
+    }
+    (void)xTaskResumeAll();
+}
+
+size_t memmgr_heap_profile_get_max_capacity(void) {
+    // Buffer of the previous start is not counted: it may not be next to the largest block
+    const size_t reserved = xHeapStructSize * 3 +
+                            MEMMGR_HEAP_PROFILE_THREAD_COUNT * sizeof(MemmgrHeapProfileThread) +
+                            MEMMGR_HEAP_PROFILE_IMAGE_COUNT * MEMMGR_HEAP_PROFILE_NAME_SIZE +
+                            MEMMGR_HEAP_PROFILE_HEADROOM;
+    const size_t max_free_block = memmgr_heap_get_max_free_block();
+    if(max_free_block <= reserved) return 0;
+    return (max_free_block - reserved) / sizeof(MemmgrHeapProfileRecord);
+}
+
+void memmgr_heap_profile_stop(void) {
+    vTaskSuspendAll();
+    memmgr_heap_profile.running = false;
+    (void)xTaskResumeAll();
+}
+
+void memmgr_heap_profile_get_info(MemmgrHeapProfileInfo* info) {
+    furi_check(info);
+
+    vTaskSuspendAll();
+    {
+        info->capacity = memmgr_heap_profile.capacity;
+        info->count = memmgr_heap_profile.count;
+        info->lost = memmgr_heap_profile.lost;
+        info->running = memmgr_heap_profile.running;
+    }
+    (void)xTaskResumeAll();
+}
+
+void memmgr_heap_profile_add_image(const char* name, const void* address) {
+    furi_check(name);
+
+    MemmgrHeapProfile* profile = &memmgr_heap_profile;
+    vTaskSuspendAll();
+    if(profile->running && profile->image_count < MEMMGR_HEAP_PROFILE_IMAGE_COUNT) {
+        strncpy(profile->images[profile->image_count], name, MEMMGR_HEAP_PROFILE_NAME_SIZE - 1);
+        memmgr_heap_profile_record(
+            MemmgrHeapProfileEventImage, address, 0, profile->image_count++);
+    }
+    (void)xTaskResumeAll();
+}
+
+static bool memmgr_heap_profile_dump_name(
+    MemmgrHeapProfileDumpCallback callback,
+    void* context,
+    MemmgrHeapProfileDumpNameType type,
+    uint32_t index,
+    const char* name) {
+    MemmgrHeapProfileDumpName entry = {
+        .index = index,
+        .type = type,
+        .size = strnlen(name, MEMMGR_HEAP_PROFILE_NAME_SIZE),
+    };
+
+    return callback(&entry, sizeof(entry), context) && callback(name, entry.size, context);
+}
+
+bool memmgr_heap_profile_dump(MemmgrHeapProfileDumpCallback callback, void* context) {
+    furi_check(callback);
+
+    MemmgrHeapProfile* profile = &memmgr_heap_profile;
+    furi_check(profile->records);
+
+    memmgr_heap_profile_stop();
+
+    const MemmgrHeapProfileDumpHeader header = {
+        .magic = MEMMGR_HEAP_PROFILE_DUMP_MAGIC,
+        .version = MEMMGR_HEAP_PROFILE_DUMP_VERSION,
+        .record_size = sizeof(MemmgrHeapProfileRecord),
+        .tick_rate = configTICK_RATE_HZ,
+        .record_count = profile->count,
+        .lost = profile->lost,
+    };
+
+    bool success = false;
+
+    do {
+        if(!callback(&header, sizeof(header), context)) break;
+        if(!callback(
+               profile->records, profile->count * sizeof(MemmgrHeapProfileRecord), context))
+            break;
+
+        bool names_success = true;
+        for(size_t i = 0; i < profile->thread_count && names_success; i++) {
+            names_success = memmgr_heap_profile_dump_name(
+                callback,
+                context,
+                MemmgrHeapProfileDumpNameTypeThread,
+                i,
+                profile->threads[i].name);
+        }
+        for(size_t i = 0; i < profile->image_count && names_success; i++) {
+            names_success = memmgr_heap_profile_dump_name(
+                callback, context, MemmgrHeapProfileDumpNameTypeImage, i, profile->images[i]);
+        }
+        if(!names_success) break;
+
+        // Terminating empty name
+        const MemmgrHeapProfileDumpName end = {0};
+        if(!callback(&end, sizeof(end), context)) break;
+
+        success = true;
+    } while(false);
+
+    return success;
+}
+
+/* Small block size classes: freed blocks up to MEMMGR_HEAP_CLASS_BLOCK_SIZE_MAX are kept
+in per class lists instead of the address ordered free list, so allocating them again takes
+no search. Cached blocks are free: they are counted in xFreeBytesRemaining and have the
+allocated bit clear. */
+#define MEMMGR_HEAP_CLASS_BLOCK_SIZE_MIN (heapMINIMUM_BLOCK_SIZE)
+#define MEMMGR_HEAP_CLASS_BLOCK_SIZE_MAX \
+    (MEMMGR_HEAP_CLASS_BLOCK_SIZE_MIN + (MEMMGR_HEAP_CLASS_COUNT - 1) * portBYTE_ALIGNMENT)
+
+/* Blocks kept per class: cached blocks can't merge with neighbours, so only a few are held */
+#define MEMMGR_HEAP_CLASS_DEPTH (4U)
+
+typedef struct {
+    BlockLink_t* head;
+    size_t cached;
+    uint32_t hits;
+    uint32_t misses;
+} MemmgrHeapClass;
+
+static MemmgrHeapClass memmgr_heap_classes[MEMMGR_HEAP_CLASS_COUNT] = {0};
+static size_t memmgr_heap_class_cache_size = 0;
+
+static inline MemmgrHeapClass* memmgr_heap_class_get(size_t block_size) {
+    if(block_size < MEMMGR_HEAP_CLASS_BLOCK_SIZE_MIN ||
+       block_size > MEMMGR_HEAP_CLASS_BLOCK_SIZE_MAX) {
+        return NULL;
+    }
+    const size_t index = (block_size - MEMMGR_HEAP_CLASS_BLOCK_SIZE_MIN) / portBYTE_ALIGNMENT;
+    return &memmgr_heap_classes[index];
+}
+
+/* Must be called with the scheduler suspended */
+static BlockLink_t* memmgr_heap_class_pop(size_t block_size) {
+    MemmgrHeapClass* heap_class = memmgr_heap_class_get(block_size);
+    if(!heap_class) return NULL;
+
+    BlockLink_t* block = heap_class->head;
+    if(block) {
+        heap_class->head = block->pxNextFreeBlock;
+        heap_class->cached--;
+        heap_class->hits++;
+        memmgr_heap_class_cache_size -= block_size;
+    } else {
+        heap_class->misses++;
+    }
+
+    return block;
+}
+
+/* Must be called with the scheduler suspended */
+static bool memmgr_heap_class_push(BlockLink_t* block) {
+    MemmgrHeapClass* heap_class = memmgr_heap_class_get(block->xBlockSize);
+    if(!heap_class || heap_class->cached >= MEMMGR_HEAP_CLASS_DEPTH) {
+        return false;
+    }
+
+    block->pxNextFreeBlock = heap_class->head;
+    heap_class->head = block;
+    heap_class->cached++;
+    memmgr_heap_class_cache_size += block->xBlockSize;
+
+    return true;
+}
+
+/* Return cached blocks to the free list, must be called with the scheduler suspended */
+static bool memmgr_heap_class_flush(void) {
+    if(!memmgr_heap_class_cache_size) return false;
+
+    for(size_t i = 0; i < MEMMGR_HEAP_CLASS_COUNT; i++) {
+        MemmgrHeapClass* heap_class = &memmgr_heap_classes[i];
+        while(heap_class->head) {
+            BlockLink_t* block = heap_class->head;
+            heap_class->head = block->pxNextFreeBlock;
+            prvInsertBlockIntoFreeList(block);
+        }
+        heap_class->cached = 0;
+    }
+    memmgr_heap_class_cache_size = 0;
+
+    return true;
+}
+
+void memmgr_heap_get_class_stats(size_t index, MemmgrHeapClassStats* stats) {
+    furi_check(index < MEMMGR_HEAP_CLASS_COUNT);
+    furi_check(stats);
+
+    vTaskSuspendAll();
+    {
+        const MemmgrHeapClass* heap_class = &memmgr_heap_classes[index];
+        stats->block_size = MEMMGR_HEAP_CLASS_BLOCK_SIZE_MIN + index * portBYTE_ALIGNMENT;
+        stats->cached = heap_class->cached;
+        stats->hits = heap_class->hits;
+        stats->misses = heap_class->misses;
+    }
+    (void)xTaskResumeAll();
+}
+
 size_t memmgr_heap_get_max_free_block(void) {
     size_t max_free_size = 0;
     BlockLink_t* pxBlock;
     vTaskSuspendAll();
 
+    // Cached blocks are merged back by malloc before it fails, report what it can get
+    memmgr_heap_class_flush();
+
     pxBlock = xStart.pxNextFreeBlock;
     while(pxBlock->pxNextFreeBlock != NULL) {
         if(pxBlock->xBlockSize > max_free_size) {
@@ -238,16 +609,44 @@ size_t memmgr_heap_get_max_free_block(void) {
 
 void memmgr_heap_printf_free_blocks(void) {
     BlockLink_t* pxBlock;
+    size_t block_count = 0;
+    size_t free_size = 0;
+    size_t max_free_size = 0;
     //can be enabled once we can do printf with a locked scheduler
     //vTaskSuspendAll();
 
     pxBlock = xStart.pxNextFreeBlock;
     while(pxBlock->pxNextFreeBlock != NULL) {
         printf("A %p S %lu\r\n", (void*)pxBlock, (uint32_t)pxBlock->xBlockSize);
+        block_count++;
+        free_size += pxBlock->xBlockSize;
+        max_free_size = MAX(max_free_size, pxBlock->xBlockSize);
         pxBlock = pxBlock->pxNextFreeBlock;
     }
 
     //xTaskResumeAll();
+
+    // Share of free memory not usable for an allocation of the largest free block size
+    const size_t fragmentation = free_size ? 100U - max_free_size * 100U / free_size : 0;
+    printf(
+        "Free blocks: %zu, free: %zu, largest: %zu, fragmentation: %zu%%\r\n",
+        block_count,
+        free_size,
+        max_free_size,
+        fragmentation);
+
+    printf("Size class cache: %zu bytes\r\n", memmgr_heap_class_cache_size);
+    printf("%-6s %6s %10s %10s\r\n", "Block", "Cached", "Hits", "Misses");
+    for(size_t i = 0; i < MEMMGR_HEAP_CLASS_COUNT; i++) {
+        MemmgrHeapClassStats stats;
+        memmgr_heap_get_class_stats(i, &stats);
+        printf(
+            "%-6zu %6zu %10lu %10lu\r\n",
+            stats.block_size,
+            stats.cached,
+            stats.hits,
+            stats.misses);
+    }
 }
 
 #ifdef HEAP_PRINT_DEBUG
@@ -336,8 +735,8 @@ static void print_heap_free(void* ptr) {
 #endif
 /*-----------------------------------------------------------*/
 
-void* pvPortMalloc(size_t xWantedSize) {
-    BlockLink_t *pxBlock, *pxPreviousBlock, *pxNewBlockLink;
+void* memmgr_heap_malloc(size_t xWantedSize, uint32_t caller) {
+    BlockLink_t* pxBlock;
     void* pvReturn = NULL;
     size_t to_wipe = xWantedSize;
 
@@ -392,47 +791,22 @@ void* pvPortMalloc(size_t xWantedSize) {
             }
 
             if((xWantedSize > 0) && (xWantedSize <= xFreeBytesRemaining)) {
-                /* Traverse the list from the start (lowest address) block until
-                one of adequate size is found. */
-                pxPreviousBlock = &xStart;
-                pxBlock = xStart.pxNextFreeBlock;
-                while((pxBlock->xBlockSize < xWantedSize) && (pxBlock->pxNextFreeBlock != NULL)) {
-                    pxPreviousBlock = pxBlock;
-                    pxBlock = pxBlock->pxNextFreeBlock;
+                /* Small blocks of the same size are reused without a search. */
+                pxBlock = memmgr_heap_class_pop(xWantedSize);
+
+                if(pxBlock == NULL) {
+                    pxBlock = prvTakeBlockFromFreeList(xWantedSize);
+                }
+
+                /* Cached small blocks may merge into a large enough one. */
+                if(pxBlock == NULL && memmgr_heap_class_flush()) {
+                    pxBlock = prvTakeBlockFromFreeList(xWantedSize);
                 }
 
-                /* If the end marker was reached then a block of adequate size
-                was not found. */
-                if(pxBlock != pxEnd) {
+                if(pxBlock != NULL) {
                     /* Return the memory space pointed to - jumping over the
                     BlockLink_t structure at its start. */
-                    pvReturn =
-                        (void*)(((uint8_t*)pxPreviousBlock->pxNextFreeBlock) + xHeapStructSize);
-
-                    /* This block is being returned for use so must be taken out
-                    of the list of free blocks. */
-                    pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
-
-                    /* If the block is larger than required it can be split into
-                    two. */
-                    if((pxBlock->xBlockSize - xWantedSize) > heapMINIMUM_BLOCK_SIZE) {
-                        /* This block is to be split into two.  Create a new
-                        block following the number of bytes requested. The void
-                        cast is used to prevent byte alignment warnings from the
-                        compiler. */
-                        pxNewBlockLink = (void*)(((uint8_t*)pxBlock) + xWantedSize);
-                        configASSERT((((size_t)pxNewBlockLink) & portBYTE_ALIGNMENT_MASK) == 0);
-
-                        /* Calculate the sizes of two blocks split from the
-                        single block. */
-                        pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
-                        pxBlock->xBlockSize = xWantedSize;
-
-                        /* Insert the new block into the list of free blocks. */
-                        prvInsertBlockIntoFreeList(pxNewBlockLink);
-                    } else {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+                    pvReturn = (void*)(((uint8_t*)pxBlock) + xHeapStructSize);
 
                     xFreeBytesRemaining -= pxBlock->xBlockSize;
 
@@ -461,6 +835,7 @@ void* pvPortMalloc(size_t xWantedSize) {
         }
 
         traceMALLOC(pvReturn, xWantedSize);
+        memmgr_heap_profile_record(MemmgrHeapProfileEventMalloc, pvReturn, to_wipe, caller);
     }
     (void)xTaskResumeAll();
 
@@ -487,7 +862,12 @@ void* pvPortMalloc(size_t xWantedSize) {
 }
 /*-----------------------------------------------------------*/
 
-void vPortFree(void* pv) {
+void* pvPortMalloc(size_t xWantedSize) {
+    return memmgr_heap_malloc(xWantedSize, (uint32_t)__builtin_return_address(0));
+}
+/*-----------------------------------------------------------*/
+
+void memmgr_heap_free(void* pv, uint32_t caller) {
     uint8_t* puc = (uint8_t*)pv;
     BlockLink_t* pxLink;
 
@@ -527,8 +907,15 @@ void vPortFree(void* pv) {
                     /* Add this block to the list of free blocks. */
                     xFreeBytesRemaining += pxLink->xBlockSize;
                     traceFREE(pv, pxLink->xBlockSize);
+                    memmgr_heap_profile_record(
+                        MemmgrHeapProfileEventFree,
+                        pv,
+                        pxLink->xBlockSize - xHeapStructSize,
+                        caller);
                     memset(pv, 0, pxLink->xBlockSize - xHeapStructSize);
-                    prvInsertBlockIntoFreeList((BlockLink_t*)pxLink);
+                    if(!memmgr_heap_class_push(pxLink)) {
+                        prvInsertBlockIntoFreeList((BlockLink_t*)pxLink);
+                    }
                 }
                 (void)xTaskResumeAll();
             } else {
@@ -545,6 +932,11 @@ void vPortFree(void* pv) {
 }
 /*-----------------------------------------------------------*/
 
+void vPortFree(void* pv) {
+    memmgr_heap_free(pv, (uint32_t)__builtin_return_address(0));
+}
+/*-----------------------------------------------------------*/
+
 size_t xPortGetTotalHeapSize(void) {
     return (size_t)&__heap_end__ - (size_t)&__heap_start__;
 }
@@ -611,6 +1003,53 @@ static void prvHeapInit(void) {
 }
 /*-----------------------------------------------------------*/
 
+static BlockLink_t* prvTakeBlockFromFreeList(size_t xWantedSize) {
+    BlockLink_t *pxBlock, *pxPreviousBlock, *pxNewBlockLink;
+
+    /* Traverse the list from the start (lowest address) block until
+    one of adequate size is found. */
+    pxPreviousBlock = &xStart;
+    pxBlock = xStart.pxNextFreeBlock;
+    while((pxBlock->xBlockSize < xWantedSize) && (pxBlock->pxNextFreeBlock != NULL)) {
+        pxPreviousBlock = pxBlock;
+        pxBlock = pxBlock->pxNextFreeBlock;
+    }
+
+    /* If the end marker was reached then a block of adequate size
+    was not found. */
+    if(pxBlock == pxEnd) {
+        return NULL;
+    }
+
+    /* This block is being returned for use so must be taken out
+    of the list of free blocks. */
+    pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+
+    /* If the block is larger than required it can be split into
+    two. */
+    if((pxBlock->xBlockSize - xWantedSize) > heapMINIMUM_BLOCK_SIZE) {
+        /* This block is to be split into two.  Create a new
+        block following the number of bytes requested. The void
+        cast is used to prevent byte alignment warnings from the
+        compiler. */
+        pxNewBlockLink = (void*)(((uint8_t*)pxBlock) + xWantedSize);
+        configASSERT((((size_t)pxNewBlockLink) & portBYTE_ALIGNMENT_MASK) == 0);
+
+        /* Calculate the sizes of two blocks split from the
+        single block. */
+        pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+        pxBlock->xBlockSize = xWantedSize;
+
+        /* Insert the new block into the list of free blocks. */
+        prvInsertBlockIntoFreeList(pxNewBlockLink);
+    } else {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return pxBlock;
+}
+/*-----------------------------------------------------------*/
+
 static void prvInsertBlockIntoFreeList(BlockLink_t* pxBlockToInsert) {
     BlockLink_t* pxIterator;
     uint8_t* puc;
@@ -14,6 +14,42 @@ extern "C" {
 
 #define MEMMGR_HEAP_UNKNOWN 0xFFFFFFFF
 
+/** Number of small block size classes, 8 bytes apart, for blocks up to 128 bytes of data */
+#define MEMMGR_HEAP_CLASS_COUNT (16U)
+
+/** Allocation profile event size in bytes */
+#define MEMMGR_HEAP_PROFILE_RECORD_SIZE (16U)
+
+/** Small block size class statistics */
+typedef struct {
+    size_t block_size; /**< Block size, including the block header */
+    size_t cached; /**< Free blocks kept in the class list */
+    uint32_t hits; /**< Allocations served from the class list */
+    uint32_t misses; /**< Allocations of the class size served from the heap */
+} MemmgrHeapClassStats;
+
+/** Allocation profile state */
+typedef struct {
+    size_t capacity; /**< Buffer size in events, 0 if profiling was never started */
+    size_t count; /**< Events in the buffer */
+    uint32_t lost; /**< Events dropped after the buffer was full */
+    bool running; /**< Events are being recorded */
+} MemmgrHeapProfileInfo;
+
+/** Allocation profile dump output callback
+ *
+ * @param[in]  data     The data
+ * @param[in]  size     The data size
+ * @param      context  The context
+ *
+ * @return     true to continue, false to abort the dump
+ */
+typedef bool (*MemmgrHeapProfileDumpCallback)(const void* data, size_t size, void* context);
+
+/** Magic at the start of the allocation profile dump */
+#define MEMMGR_HEAP_PROFILE_DUMP_MAGIC   (0x50484D46UL) // "FMHP"
+#define MEMMGR_HEAP_PROFILE_DUMP_VERSION (1)
+
 /** Memmgr heap enable thread allocation tracking
  *
  * @param      thread_id  - thread id to track
@@ -35,15 +71,79 @@ void memmgr_heap_disable_thread_trace(FuriThreadId thread_id);
 size_t memmgr_heap_get_thread_memory(FuriThreadId thread_id);
 
 /** Memmgr heap get the max contiguous block size on the heap
+ *
+ * Small blocks held by the size class cache are returned to the heap first,
+ * so the result is the largest block malloc can provide.
  *
  * @return     size_t max contiguous block size
  */
 size_t memmgr_heap_get_max_free_block(void);
 
-/** Print the address and size of all free blocks to stdout
+/** Print the address and size of all free blocks, fragmentation and size class statistics
+ * to stdout
  */
 void memmgr_heap_printf_free_blocks(void);
 
+/** Get small block size class statistics
+ *
+ * Freed small blocks are kept in per size class lists and reused without searching the heap.
+ *
+ * @param      index  The class index, less than MEMMGR_HEAP_CLASS_COUNT
+ * @param[out] stats  The statistics
+ */
+void memmgr_heap_get_class_stats(size_t index, MemmgrHeapClassStats* stats);
+
+/** Allocate the event buffer and start recording allocations
+ *
+ * Every malloc and free is recorded with its return address, size, thread and system tick.
+ * When the buffer is full, new events are dropped: live memory can only be restored from the
+ * start of the recording. Previous events are discarded. Dump is converted on the host with
+ * scripts/heap_profile.py.
+ *
+ * @param[in]  capacity  The buffer size in events, MEMMGR_HEAP_PROFILE_RECORD_SIZE bytes each
+ */
+void memmgr_heap_profile_start(size_t capacity);
+
+/** Get the largest buffer size memmgr_heap_profile_start can allocate right now
+ *
+ * Accounts for block headers and name tables allocated with the buffer and leaves some heap
+ * for the rest of the system.
+ *
+ * @return     The buffer size in events, 0 if there is not enough memory
+ */
+size_t memmgr_heap_profile_get_max_capacity(void);
+
+/** Stop recording allocations, recorded events are kept until the next start */
+void memmgr_heap_profile_stop(void);
+
+/** Get allocation profile state
+ *
+ * @param[out] info  The information
+ */
+void memmgr_heap_profile_get_info(MemmgrHeapProfileInfo* info);
+
+/** Record the code location of a loaded application
+ *
+ * Lets return addresses of application code be resolved on the host. Only applications
+ * loaded while recording are known to the profile.
+ *
+ * @param[in]  name     The image name, debug ELF name of the application
+ * @param[in]  address  The address of the .text section
+ */
+void memmgr_heap_profile_add_image(const char* name, const void* address);
+
+/** Stop recording and serialize recorded events
+ *
+ * Dump contains a header, events from the oldest to the newest and names of threads and
+ * application images.
+ *
+ * @param[in]  callback  The output callback
+ * @param      context   The callback context
+ *
+ * @return     true if the whole dump was written
+ */
+bool memmgr_heap_profile_dump(MemmgrHeapProfileDumpCallback callback, void* context);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,12 +1,21 @@
 #include "pubsub.h"
 #include "check.h"
 #include "mutex.h"
+#include "message_queue.h"
 
+#include <furi_hal.h>
 #include <m-list.h>
 
 struct FuriPubSubSubscription {
     FuriPubSubCallback callback;
     void* callback_context;
+    // Asynchronous subscription only
+    FuriEventLoop* event_loop;
+    FuriMessageQueue* queue;
+    void* message;
+    uint32_t delivered; // Updated by the event loop without the mutex, atomic access only
+    uint32_t dropped;
+    size_t queue_peak;
 };
 
 LIST_DEF(FuriPubSubSubscriptionList, FuriPubSubSubscription, M_POD_OPLIST);
@@ -14,6 +23,12 @@ LIST_DEF(FuriPubSubSubscriptionList, FuriPubSubSubscription, M_POD_OPLIST);
 struct FuriPubSub {
     FuriPubSubSubscriptionList_t items;
     FuriMutex* mutex;
+    // Statistics
+    uint32_t published;
+    uint32_t dropped;
+    uint32_t overflows;
+    uint64_t latency_total; // DWT cycles
+    uint32_t latency_max; // DWT cycles
 };
 
 FuriPubSub* furi_pubsub_alloc(void) {
@@ -48,8 +63,52 @@ FuriPubSubSubscription*
     FuriPubSubSubscription* item = FuriPubSubSubscriptionList_push_raw(pubsub->items);
 
     // initialize item
-    item->callback = callback;
-    item->callback_context = callback_context;
+    *item = (FuriPubSubSubscription){
+        .callback = callback,
+        .callback_context = callback_context,
+    };
+
+    furi_check(furi_mutex_release(pubsub->mutex) == FuriStatusOk);
+
+    return item;
+}
+
+static void furi_pubsub_queue_callback(FuriEventLoopObject* object, void* context) {
+    FuriPubSubSubscription* item = context;
+    furi_assert(object == item->queue);
+
+    furi_check(furi_message_queue_get(item->queue, item->message, 0) == FuriStatusOk);
+    __atomic_fetch_add(&item->delivered, 1, __ATOMIC_RELAXED);
+    item->callback(item->message, item->callback_context);
+}
+
+FuriPubSubSubscription* furi_pubsub_subscribe_async(
+    FuriPubSub* pubsub,
+    FuriEventLoop* event_loop,
+    size_t message_size,
+    size_t queue_length,
+    FuriPubSubCallback callback,
+    void* callback_context) {
+    furi_check(pubsub);
+    furi_check(event_loop);
+    furi_check(callback);
+
+    FuriMessageQueue* queue = furi_message_queue_alloc(queue_length, message_size);
+
+    furi_check(furi_mutex_acquire(pubsub->mutex, FuriWaitForever) == FuriStatusOk);
+    FuriPubSubSubscription* item = FuriPubSubSubscriptionList_push_raw(pubsub->items);
+
+    *item = (FuriPubSubSubscription){
+        .callback = callback,
+        .callback_context = callback_context,
+        .event_loop = event_loop,
+        .queue = queue,
+        .message = malloc(message_size),
+    };
+
+    // Queue is empty, so the event loop can't call back before the item is initialized
+    furi_event_loop_subscribe_message_queue(
+        event_loop, queue, FuriEventLoopEventIn, furi_pubsub_queue_callback, item);
 
     furi_check(furi_mutex_release(pubsub->mutex) == FuriStatusOk);
 
@@ -62,6 +121,7 @@ void furi_pubsub_unsubscribe(FuriPubSub* pubsub, FuriPubSubSubscription* pubsub_
 
     furi_check(furi_mutex_acquire(pubsub->mutex, FuriWaitForever) == FuriStatusOk);
     bool result = false;
+    FuriPubSubSubscription removed = {0};
 
     // iterate over items
     FuriPubSubSubscriptionList_it_t it;
@@ -71,6 +131,7 @@ void furi_pubsub_unsubscribe(FuriPubSub* pubsub, FuriPubSubSubscription* pubsub_
 
         // if the iterator is equal to our element
         if(item == pubsub_subscription) {
+            removed = *item;
             FuriPubSubSubscriptionList_remove(pubsub->items, it);
             result = true;
             break;
@@ -79,19 +140,119 @@ void furi_pubsub_unsubscribe(FuriPubSub* pubsub, FuriPubSubSubscription* pubsub_
 
     furi_check(furi_mutex_release(pubsub->mutex) == FuriStatusOk);
     furi_check(result);
+
+    // Publishers can't reach the queue anymore
+    if(removed.queue) {
+        furi_event_loop_unsubscribe(removed.event_loop, removed.queue);
+        furi_message_queue_free(removed.queue);
+        free(removed.message);
+    }
 }
 
 void furi_pubsub_publish(FuriPubSub* pubsub, void* message) {
     furi_check(pubsub);
 
+    const uint32_t start = DWT->CYCCNT;
     furi_check(furi_mutex_acquire(pubsub->mutex, FuriWaitForever) == FuriStatusOk);
 
+    bool overflow = false;
+
     // iterate over subscribers
     FuriPubSubSubscriptionList_it_t it;
     for(FuriPubSubSubscriptionList_it(it, pubsub->items); !FuriPubSubSubscriptionList_end_p(it);
         FuriPubSubSubscriptionList_next(it)) {
-        const FuriPubSubSubscription* item = FuriPubSubSubscriptionList_cref(it);
-        item->callback(message, item->callback_context);
+        FuriPubSubSubscription* item = FuriPubSubSubscriptionList_ref(it);
+        if(item->queue) {
+            if(furi_message_queue_put(item->queue, message, 0) == FuriStatusOk) {
+                const size_t count = furi_message_queue_get_count(item->queue);
+                if(count > item->queue_peak) item->queue_peak = count;
+            } else {
+                item->dropped++;
+                pubsub->dropped++;
+                overflow = true;
+            }
+        } else {
+            item->callback(message, item->callback_context);
+        }
+    }
+
+    const uint32_t latency = DWT->CYCCNT - start;
+    pubsub->published++;
+    pubsub->latency_total += latency;
+    if(latency > pubsub->latency_max) pubsub->latency_max = latency;
+    if(overflow) pubsub->overflows++;
+
+    furi_check(furi_mutex_release(pubsub->mutex) == FuriStatusOk);
+}
+
+void furi_pubsub_get_stats(FuriPubSub* pubsub, FuriPubSubStats* stats) {
+    furi_check(pubsub);
+    furi_check(stats);
+
+    const uint32_t cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+
+    furi_check(furi_mutex_acquire(pubsub->mutex, FuriWaitForever) == FuriStatusOk);
+
+    *stats = (FuriPubSubStats){
+        .published = pubsub->published,
+        .subscribers = FuriPubSubSubscriptionList_size(pubsub->items),
+        .dropped = pubsub->dropped,
+        .overflows = pubsub->overflows,
+        .latency_max_us = pubsub->latency_max / cycles_per_us,
+    };
+
+    if(pubsub->published) {
+        stats->latency_avg_us = pubsub->latency_total / pubsub->published / cycles_per_us;
+    }
+
+    FuriPubSubSubscriptionList_it_t it;
+    for(FuriPubSubSubscriptionList_it(it, pubsub->items); !FuriPubSubSubscriptionList_end_p(it);
+        FuriPubSubSubscriptionList_next(it)) {
+        if(FuriPubSubSubscriptionList_cref(it)->queue) stats->async_subscribers++;
+    }
+
+    furi_check(furi_mutex_release(pubsub->mutex) == FuriStatusOk);
+}
+
+void furi_pubsub_subscription_get_stats(
+    FuriPubSub* pubsub,
+    FuriPubSubSubscription* pubsub_subscription,
+    FuriPubSubSubscriptionStats* stats) {
+    furi_check(pubsub);
+    furi_check(pubsub_subscription);
+    furi_check(pubsub_subscription->queue);
+    furi_check(stats);
+
+    furi_check(furi_mutex_acquire(pubsub->mutex, FuriWaitForever) == FuriStatusOk);
+
+    *stats = (FuriPubSubSubscriptionStats){
+        .delivered = __atomic_load_n(&pubsub_subscription->delivered, __ATOMIC_RELAXED),
+        .dropped = pubsub_subscription->dropped,
+        .queue_length = furi_message_queue_get_capacity(pubsub_subscription->queue),
+        .queue_peak = pubsub_subscription->queue_peak,
+    };
+
+    furi_check(furi_mutex_release(pubsub->mutex) == FuriStatusOk);
+}
+
+void furi_pubsub_reset_stats(FuriPubSub* pubsub) {
+    furi_check(pubsub);
+
+    furi_check(furi_mutex_acquire(pubsub->mutex, FuriWaitForever) == FuriStatusOk);
+
+    pubsub->published = 0;
+    pubsub->dropped = 0;
+    pubsub->overflows = 0;
+    pubsub->latency_total = 0;
+    pubsub->latency_max = 0;
+
+    FuriPubSubSubscriptionList_it_t it;
+    for(FuriPubSubSubscriptionList_it(it, pubsub->items); !FuriPubSubSubscriptionList_end_p(it);
+        FuriPubSubSubscriptionList_next(it)) {
+        FuriPubSubSubscription* item = FuriPubSubSubscriptionList_ref(it);
+        __atomic_store_n(&item->delivered, 0, __ATOMIC_RELAXED);
+        item->dropped = 0;
+        item->queue_peak = 0;
     }
 
     furi_check(furi_mutex_release(pubsub->mutex) == FuriStatusOk);
@@ -4,6 +4,9 @@
  */
 #pragma once
 
+#include "base.h"
+#include "event_loop.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -17,6 +20,25 @@ typedef struct FuriPubSub FuriPubSub;
 /** FuriPubSubSubscription type */
 typedef struct FuriPubSubSubscription FuriPubSubSubscription;
 
+/** FuriPubSub statistics */
+typedef struct {
+    uint32_t published; /**< Messages published */
+    size_t subscribers; /**< Active subscriptions of both kinds */
+    size_t async_subscribers; /**< Active asynchronous subscriptions */
+    uint32_t dropped; /**< Message copies dropped because of full subscriber queues */
+    uint32_t overflows; /**< Publications that overflowed at least one subscriber queue */
+    uint32_t latency_avg_us; /**< Average time spent in furi_pubsub_publish */
+    uint32_t latency_max_us; /**< Maximum time spent in furi_pubsub_publish */
+} FuriPubSubStats;
+
+/** Asynchronous FuriPubSubSubscription statistics */
+typedef struct {
+    uint32_t delivered; /**< Messages passed to the callback */
+    uint32_t dropped; /**< Messages dropped because the queue was full */
+    size_t queue_length; /**< Queue capacity in messages */
+    size_t queue_peak; /**< Maximum number of messages waiting in the queue */
+} FuriPubSubSubscriptionStats;
+
 /** Allocate FuriPubSub
  *
  * Reentrable, Not threadsafe, one owner
@@ -34,6 +56,8 @@ void furi_pubsub_free(FuriPubSub* pubsub);
 /** Subscribe to FuriPubSub
  * 
  * Threadsafe, Reentrable
+ *
+ * Callback is called in the publisher context while the publisher waits for it.
  * 
  * @param      pubsub            pointer to FuriPubSub instance
  * @param[in]  callback          The callback
@@ -44,10 +68,37 @@ void furi_pubsub_free(FuriPubSub* pubsub);
 FuriPubSubSubscription*
     furi_pubsub_subscribe(FuriPubSub* pubsub, FuriPubSubCallback callback, void* callback_context);
 
+/** Subscribe to FuriPubSub asynchronously
+ *
+ * Threadsafe, must be called from the event loop thread.
+ *
+ * Published messages are copied into a queue of the subscription and the callback is
+ * called later by the event loop, so a slow subscriber doesn't stall the publisher.
+ * Messages published while the queue is full are dropped and counted.
+ *
+ * @param      pubsub            pointer to FuriPubSub instance
+ * @param      event_loop        The Event Loop to call the callback from
+ * @param[in]  message_size      The size of messages published to this FuriPubSub
+ * @param[in]  queue_length      The maximum number of messages waiting for the callback
+ * @param[in]  callback          The callback
+ * @param      callback_context  The callback context
+ *
+ * @return     pointer to FuriPubSubSubscription instance
+ */
+FuriPubSubSubscription* furi_pubsub_subscribe_async(
+    FuriPubSub* pubsub,
+    FuriEventLoop* event_loop,
+    size_t message_size,
+    size_t queue_length,
+    FuriPubSubCallback callback,
+    void* callback_context);
+
 /** Unsubscribe from FuriPubSub
  * 
  * No use of `pubsub_subscription` allowed after call of this method
  * Threadsafe, Reentrable.
+ * Asynchronous subscriptions must be removed from the event loop thread, messages
+ * still waiting in the queue are discarded.
  *
  * @param      pubsub               pointer to FuriPubSub instance
  * @param      pubsub_subscription  pointer to FuriPubSubSubscription instance
@@ -63,6 +114,36 @@ void furi_pubsub_unsubscribe(FuriPubSub* pubsub, FuriPubSubSubscription* pubsub_
  */
 void furi_pubsub_publish(FuriPubSub* pubsub, void* message);
 
+/** Get FuriPubSub statistics
+ *
+ * Threadsafe
+ *
+ * @param      pubsub  pointer to FuriPubSub instance
+ * @param[out] stats   The statistics
+ */
+void furi_pubsub_get_stats(FuriPubSub* pubsub, FuriPubSubStats* stats);
+
+/** Get asynchronous subscription statistics
+ *
+ * Threadsafe
+ *
+ * @param      pubsub               pointer to FuriPubSub instance
+ * @param      pubsub_subscription  pointer to asynchronous FuriPubSubSubscription instance
+ * @param[out] stats                The statistics
+ */
+void furi_pubsub_subscription_get_stats(
+    FuriPubSub* pubsub,
+    FuriPubSubSubscription* pubsub_subscription,
+    FuriPubSubSubscriptionStats* stats);
+
+/** Reset FuriPubSub and subscription statistics
+ *
+ * Threadsafe
+ *
+ * @param      pubsub  pointer to FuriPubSub instance
+ */
+void furi_pubsub_reset_stats(FuriPubSub* pubsub);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,221 @@
+#include "trace.h"
+#include "check.h"
+#include "common_defines.h"
+#include "memmgr_heap.h"
+
+#include <furi_hal.h>
+#include <m-dict.h>
+#include <FreeRTOS.h>
+#include <task.h>
+
+#define FURI_TRACE_NAME_SIZE_MAX (64U)
+#define FURI_TRACE_HEADROOM      (4096U) // Block header and heap left for the rest of the system
+
+typedef struct {
+    uint32_t timestamp; // DWT cycle counter
+    uint32_t id;
+    uint32_t value;
+    uint32_t type;
+} FuriTraceRecord;
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t record_size;
+    uint32_t cpu_frequency;
+    uint32_t record_count;
+    uint32_t lost;
+} FuriTraceDumpHeader;
+
+// Followed by the name characters, the list ends with an empty name
+typedef struct {
+    uint32_t id;
+    uint8_t type;
+    uint8_t size;
+} FURI_PACKED FuriTraceDumpName;
+
+typedef enum {
+    FuriTraceDumpNameTypeThread,
+    FuriTraceDumpNameTypePoint,
+} FuriTraceDumpNameType;
+
+DICT_SET_DEF(FuriTraceIdSet, uint32_t, M_DEFAULT_OPLIST) // NOLINT
+
+typedef struct {
+    FuriTraceRecord* records;
+    uint32_t mask;
+    uint32_t head;
+    bool running;
+} FuriTrace;
+
+static FuriTrace furi_trace = {0};
+
+void furi_trace_start(size_t capacity) {
+    furi_check(capacity && (capacity & (capacity - 1)) == 0);
+    furi_check(capacity <= SIZE_MAX / sizeof(FuriTraceRecord));
+    furi_check(!FURI_IS_ISR());
+
+    furi_trace.running = false;
+
+    if(furi_trace.mask + 1 != capacity || !furi_trace.records) {
+        free(furi_trace.records);
+        furi_trace.records = malloc(capacity * sizeof(FuriTraceRecord));
+        furi_trace.mask = capacity - 1;
+    }
+    furi_trace.head = 0;
+
+    __atomic_store_n(&furi_trace.running, true, __ATOMIC_RELEASE);
+}
+
+size_t furi_trace_get_max_capacity(void) {
+    const size_t max_free_block = memmgr_heap_get_max_free_block();
+    if(max_free_block <= FURI_TRACE_HEADROOM) return 0;
+
+    const size_t max_records = (max_free_block - FURI_TRACE_HEADROOM) / sizeof(FuriTraceRecord);
+    size_t capacity = 1;
+    while(capacity <= max_records / 2) {
+        capacity <<= 1;
+    }
+    return max_records ? capacity : 0;
+}
+
+void furi_trace_stop(void) {
+    __atomic_store_n(&furi_trace.running, false, __ATOMIC_RELEASE);
+}
+
+void furi_trace_get_info(FuriTraceInfo* info) {
+    furi_check(info);
+
+    const size_t capacity = furi_trace.records ? furi_trace.mask + 1 : 0;
+    info->capacity = capacity;
+    info->count = MIN(furi_trace.head, capacity);
+    info->lost = furi_trace.head > capacity ? furi_trace.head - capacity : 0;
+    info->running = furi_trace.running;
+}
+
+void furi_trace_event(FuriTraceEventType type, uint32_t id, uint32_t value) {
+    if(!furi_trace.running) return;
+
+    // Slot and timestamp are taken together, so records stay in time order
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    if(furi_trace.running) {
+        FuriTraceRecord* record = &furi_trace.records[furi_trace.head & furi_trace.mask];
+        record->timestamp = DWT->CYCCNT;
+        record->id = id;
+        record->value = value;
+        record->type = type;
+        furi_trace.head++;
+    }
+
+    __set_PRIMASK(primask);
+}
+
+// Called by the scheduler, see traceTASK_SWITCHED_IN in FreeRTOSConfig.h
+void furi_trace_thread_switch(void* task) {
+    furi_trace_event(FuriTraceEventTypeThreadSwitch, (uint32_t)task, 0);
+}
+
+static bool furi_trace_dump_name(
+    FuriTraceDumpCallback callback,
+    void* context,
+    FuriTraceDumpNameType type,
+    uint32_t id,
+    const char* name) {
+    FuriTraceDumpName entry = {
+        .id = id,
+        .type = type,
+        .size = strnlen(name, FURI_TRACE_NAME_SIZE_MAX),
+    };
+
+    return callback(&entry, sizeof(entry), context) && callback(name, entry.size, context);
+}
+
+static bool furi_trace_dump_thread_names(FuriTraceDumpCallback callback, void* context) {
+    // Only threads alive at the time of the dump have names
+    UBaseType_t count = uxTaskGetNumberOfTasks();
+    TaskStatus_t* tasks = malloc(count * sizeof(TaskStatus_t));
+    count = uxTaskGetSystemState(tasks, count, NULL);
+
+    bool success = true;
+    for(UBaseType_t i = 0; i < count && success; i++) {
+        success = furi_trace_dump_name(
+            callback,
+            context,
+            FuriTraceDumpNameTypeThread,
+            (uint32_t)tasks[i].xHandle,
+            tasks[i].pcTaskName);
+    }
+
+    free(tasks);
+    return success;
+}
+
+bool furi_trace_dump(FuriTraceDumpCallback callback, void* context) {
+    furi_check(callback);
+    furi_check(furi_trace.records);
+
+    furi_trace_stop();
+
+    FuriTraceInfo info;
+    furi_trace_get_info(&info);
+
+    const FuriTraceDumpHeader header = {
+        .magic = FURI_TRACE_DUMP_MAGIC,
+        .version = FURI_TRACE_DUMP_VERSION,
+        .record_size = sizeof(FuriTraceRecord),
+        .cpu_frequency = furi_hal_cortex_instructions_per_microsecond() * 1000000UL,
+        .record_count = info.count,
+        .lost = info.lost,
+    };
+
+    FuriTraceIdSet_t points;
+    FuriTraceIdSet_init(points);
+
+    bool success = false;
+
+    do {
+        if(!callback(&header, sizeof(header), context)) break;
+
+        // Oldest record is at the head once the buffer has wrapped
+        const uint32_t first = furi_trace.head - info.count;
+        const size_t first_index = first & furi_trace.mask;
+        const size_t first_part = MIN(info.count, info.capacity - first_index);
+        if(!callback(
+               &furi_trace.records[first_index], first_part * sizeof(FuriTraceRecord), context))
+            break;
+        if(!callback(
+               furi_trace.records, (info.count - first_part) * sizeof(FuriTraceRecord), context))
+            break;
+
+        for(size_t i = 0; i < info.count; i++) {
+            const FuriTraceRecord* record = &furi_trace.records[(first + i) & furi_trace.mask];
+            if(record->type >= FuriTraceEventTypeBegin) {
+                FuriTraceIdSet_push(points, record->id);
+            }
+        }
+
+        bool names_success = true;
+        FuriTraceIdSet_it_t it;
+        for(FuriTraceIdSet_it(it, points); !FuriTraceIdSet_end_p(it) && names_success;
+            FuriTraceIdSet_next(it)) {
+            const uint32_t id = *FuriTraceIdSet_cref(it);
+            names_success = furi_trace_dump_name(
+                callback, context, FuriTraceDumpNameTypePoint, id, (const char*)id);
+        }
+        if(!names_success) break;
+
+        if(!furi_trace_dump_thread_names(callback, context)) break;
+
+        // Terminating empty name
+        const FuriTraceDumpName end = {0};
+        if(!callback(&end, sizeof(end), context)) break;
+
+        success = true;
+    } while(false);
+
+    FuriTraceIdSet_clear(points);
+
+    return success;
+}
@@ -0,0 +1,112 @@
+/**
+ * @file trace.h
+ * Furi Trace: timeline of trace points, thread switches and interrupts
+ *
+ * Events are stored with DWT cycle counter timestamps in a RAM ring buffer, which keeps
+ * the latest events when it overflows. The dump is converted to Chrome trace JSON on the
+ * host with scripts/trace_convert.py.
+ */
+#pragma once
+
+#include "base.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    FuriTraceEventTypeThreadSwitch, /**< id: FreeRTOS task handle of the new thread */
+    FuriTraceEventTypeIsrEnter, /**< id: FuriHalInterruptId */
+    FuriTraceEventTypeIsrExit, /**< id: FuriHalInterruptId */
+    FuriTraceEventTypeBegin, /**< id: trace point name, begins a span on the current context */
+    FuriTraceEventTypeEnd, /**< id: trace point name, ends the span */
+    FuriTraceEventTypeInstant, /**< id: trace point name */
+    FuriTraceEventTypeCounter, /**< id: trace point name, value: counter value */
+} FuriTraceEventType;
+
+typedef struct {
+    size_t capacity; /**< Buffer size in events, 0 if tracing was never started */
+    size_t count; /**< Events in the buffer */
+    uint32_t lost; /**< Events overwritten after the buffer was full */
+    bool running; /**< Events are being recorded */
+} FuriTraceInfo;
+
+/** Trace dump output callback
+ *
+ * @param[in]  data     The data
+ * @param[in]  size     The data size
+ * @param      context  The context
+ *
+ * @return     true to continue, false to abort the dump
+ */
+typedef bool (*FuriTraceDumpCallback)(const void* data, size_t size, void* context);
+
+/** Magic at the start of the trace dump */
+#define FURI_TRACE_DUMP_MAGIC   (0x43525446UL) // "FTRC"
+#define FURI_TRACE_DUMP_VERSION (1)
+
+/** Begin a span, name must be a string literal: its address is the trace point id */
+#define FURI_TRACE_BEGIN(name) \
+    furi_trace_event(FuriTraceEventTypeBegin, (uint32_t)(name ""), 0)
+
+/** End a span started with FURI_TRACE_BEGIN() with the same name */
+#define FURI_TRACE_END(name) furi_trace_event(FuriTraceEventTypeEnd, (uint32_t)(name ""), 0)
+
+/** Mark a moment */
+#define FURI_TRACE_INSTANT(name) \
+    furi_trace_event(FuriTraceEventTypeInstant, (uint32_t)(name ""), 0)
+
+/** Record counter value */
+#define FURI_TRACE_COUNTER(name, value) \
+    furi_trace_event(FuriTraceEventTypeCounter, (uint32_t)(name ""), (value))
+
+/** Allocate the event buffer and start recording
+ *
+ * Previous events are discarded.
+ *
+ * @param[in]  capacity  The buffer size in events, power of two
+ */
+void furi_trace_start(size_t capacity);
+
+/** Get the largest buffer size furi_trace_start can allocate right now
+ *
+ * Leaves some heap for the rest of the system. Buffer of the previous start is not counted.
+ *
+ * @return     The buffer size in events, power of two, 0 if there is not enough memory
+ */
+size_t furi_trace_get_max_capacity(void);
+
+/** Stop recording, recorded events are kept until the next start */
+void furi_trace_stop(void);
+
+/** Get trace state
+ *
+ * @param[out] info  The information
+ */
+void furi_trace_get_info(FuriTraceInfo* info);
+
+/** Record an event, use FURI_TRACE_* macros instead
+ *
+ * Safe to call from interrupts. Does nothing unless recording.
+ *
+ * @param[in]  type   The event type
+ * @param[in]  id     The event id
+ * @param[in]  value  The event value
+ */
+void furi_trace_event(FuriTraceEventType type, uint32_t id, uint32_t value);
+
+/** Stop recording and serialize recorded events
+ *
+ * Dump contains a header, events from the oldest to the newest and names of threads and
+ * trace points. Names of trace points from applications are only valid while they are loaded.
+ *
+ * @param[in]  callback  The output callback
+ * @param      context   The callback context
+ *
+ * @return     true if the whole dump was written
+ */
+bool furi_trace_dump(FuriTraceDumpCallback callback, void* context);
+
+#ifdef __cplusplus
+}
+#endif
@@ -19,6 +19,7 @@
 #include "core/thread.h"
 #include "core/thread_list.h"
 #include "core/timer.h"
+#include "core/trace.h"
 #include "core/string.h"
 #include "core/stream_buffer.h"
 
@@ -226,6 +226,33 @@ bool ble_profile_hid_kb_release(FuriHalBleProfileBase* profile, uint16_t button)
         sizeof(FuriHalBtHidKbReport));
 }
 
+bool ble_profile_hid_kb_set_pressed(
+    FuriHalBleProfileBase* profile,
+    const uint16_t* buttons,
+    size_t count) {
+    furi_check(profile);
+    furi_check(profile->config == ble_profile_hid);
+    furi_check(buttons || (count == 0));
+    furi_check(count <= BLE_PROFILE_HID_KB_MAX_KEYS);
+
+    BleProfileHid* hid_profile = (BleProfileHid*)profile;
+    FuriHalBtHidKbReport* kb_report = hid_profile->kb_report;
+    kb_report->mods = 0;
+    for(uint8_t i = 0; i < BLE_PROFILE_HID_KB_MAX_KEYS; i++) {
+        if(i < count) {
+            kb_report->key[i] = buttons[i] & 0xFF;
+            kb_report->mods |= (buttons[i] >> 8);
+        } else {
+            kb_report->key[i] = 0;
+        }
+    }
+    return ble_svc_hid_update_input_report(
+        hid_profile->hid_svc,
+        ReportNumberKeyboard,
+        (uint8_t*)kb_report,
+        sizeof(FuriHalBtHidKbReport));
+}
+
 bool ble_profile_hid_kb_release_all(FuriHalBleProfileBase* profile) {
     furi_check(profile);
     furi_check(profile->config == ble_profile_hid);
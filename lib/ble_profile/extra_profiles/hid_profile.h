@@ -36,6 +36,19 @@ bool ble_profile_hid_kb_press(FuriHalBleProfileBase* profile, uint16_t button);
  */
 bool ble_profile_hid_kb_release(FuriHalBleProfileBase* profile, uint16_t button);
 
+/** Replace the whole set of pressed keyboard buttons with a single report
+ *
+ * @param profile   profile instance
+ * @param buttons   button codes from HID specification, modifiers in high byte
+ * @param count     number of buttons, not more than 6
+ *
+ * @return          true on success
+ */
+bool ble_profile_hid_kb_set_pressed(
+    FuriHalBleProfileBase* profile,
+    const uint16_t* buttons,
+    size_t count);
+
 /** Release all keyboard buttons
  *
  * @param profile   profile instance
@@ -47,8 +47,15 @@ typedef struct {
     uint32_t data[DIGITAL_SEQUENCE_RING_BUFFER_SIZE];
     uint32_t write_pos;
     uint32_t read_pos;
+    uint32_t size_free; /* Free space as of the last read position update. */
 } DigitalSequenceRingBuffer;
 
+typedef enum {
+    DigitalSequenceEventNone = 0,
+    DigitalSequenceEventUnderrun = (1 << 0),
+    DigitalSequenceEventTimeout = (1 << 1),
+} DigitalSequenceEvent;
+
 typedef uint32_t DigitalSequenceGpioBuffer[DIGITAL_SEQUENCE_GPIO_BUFFER_SIZE];
 
 typedef const DigitalSignal* DigitalSequenceSignalBank[DIGITAL_SEQUENCE_BANK_SIZE];
@@ -66,6 +73,9 @@ struct DigitalSequence {
     DigitalSequenceRingBuffer timer_buf;
     DigitalSequenceSignalBank signals;
     DigitalSequenceState state;
+    DigitalSequenceStats stats;
+    DigitalSequenceStats stats_logged;
+    uint32_t events;
 
     uint8_t data[];
 };
@@ -78,6 +88,7 @@ DigitalSequence* digital_sequence_alloc(uint32_t size, const GpioPin* gpio) {
 
     sequence->gpio = gpio;
     sequence->max_size = size;
+    sequence->stats.queued_min = DIGITAL_SEQUENCE_RING_BUFFER_SIZE;
 
     sequence->dma_config_gpio.PeriphOrM2MSrcAddress = (uint32_t)&gpio->port->BSRR;
     sequence->dma_config_gpio.MemoryOrM2MDstAddress = (uint32_t)sequence->gpio_buf;
@@ -131,6 +142,25 @@ void digital_sequence_add_signal(DigitalSequence* sequence, uint8_t signal_index
     sequence->data[sequence->size++] = signal_index;
 }
 
+void digital_sequence_add_signals(
+    DigitalSequence* sequence,
+    const uint8_t* signal_indices,
+    size_t count) {
+    furi_check(sequence);
+    furi_check(signal_indices);
+    furi_check(count <= sequence->max_size - sequence->size);
+
+    // All indices are below the power of two bank size if their bitwise OR is
+    uint8_t indices_or = 0;
+    for(size_t i = 0; i < count; i++) {
+        indices_or |= signal_indices[i];
+    }
+    furi_check(indices_or < DIGITAL_SEQUENCE_BANK_SIZE);
+
+    memcpy(&sequence->data[sequence->size], signal_indices, count);
+    sequence->size += count;
+}
+
 static inline void digital_sequence_start_dma(DigitalSequence* sequence) {
     furi_assert(sequence);
 
@@ -206,16 +236,7 @@ static inline void digital_sequence_finish(DigitalSequence* sequence) {
             }
 
             if(DWT->CYCCNT - prev_timer > DIGITAL_SEQUENCE_LOCK_WAIT_TICKS) {
-                DigitalSequenceRingBuffer* dma_buffer = &sequence->timer_buf;
-                dma_buffer->read_pos = DIGITAL_SEQUENCE_RING_BUFFER_SIZE -
-                                       LL_DMA_GetDataLength(DMA1, LL_DMA_CHANNEL_2);
-                FURI_LOG_D(
-                    TAG,
-                    "[SEQ] hung %lu ms in finish (ARR 0x%08lx, read %lu, write %lu)",
-                    DIGITAL_SEQUENCE_LOCK_WAIT_MS,
-                    TIM2->ARR,
-                    dma_buffer->read_pos,
-                    dma_buffer->write_pos);
+                sequence->events |= DigitalSequenceEventTimeout;
                 break;
             }
         } while(true);
@@ -225,51 +246,56 @@ static inline void digital_sequence_finish(DigitalSequence* sequence) {
     digital_sequence_stop_dma();
 }
 
-static inline void digital_sequence_enqueue_period(DigitalSequence* sequence, uint32_t length) {
+/* Wait for free space in the ring buffer. Only called once the space known to be free is used up,
+ * so that the DMA counter is not read for every period. */
+static void digital_sequence_wait_for_space(DigitalSequence* sequence) {
     DigitalSequenceRingBuffer* dma_buffer = &sequence->timer_buf;
+    const uint32_t prev_timer = DWT->CYCCNT;
 
-    if(sequence->state == DigitalSequenceStateActive) {
-        const uint32_t prev_timer = DWT->CYCCNT;
+    do {
+        dma_buffer->read_pos =
+            DIGITAL_SEQUENCE_RING_BUFFER_SIZE - LL_DMA_GetDataLength(DMA1, LL_DMA_CHANNEL_2);
 
-        do {
-            dma_buffer->read_pos =
-                DIGITAL_SEQUENCE_RING_BUFFER_SIZE - LL_DMA_GetDataLength(DMA1, LL_DMA_CHANNEL_2);
+        dma_buffer->size_free = (DIGITAL_SEQUENCE_RING_BUFFER_SIZE + dma_buffer->read_pos -
+                                 dma_buffer->write_pos) %
+                                DIGITAL_SEQUENCE_RING_BUFFER_SIZE;
 
-            const uint32_t size_free = (DIGITAL_SEQUENCE_RING_BUFFER_SIZE + dma_buffer->read_pos -
-                                        dma_buffer->write_pos) %
-                                       DIGITAL_SEQUENCE_RING_BUFFER_SIZE;
+        /* Periods queued ahead of the DMA, the fewer there are the closer it is to an underrun. */
+        const uint32_t size_queued = (DIGITAL_SEQUENCE_RING_BUFFER_SIZE + dma_buffer->write_pos -
+                                      dma_buffer->read_pos) %
+                                     DIGITAL_SEQUENCE_RING_BUFFER_SIZE;
+        sequence->stats.queued_min = MIN(sequence->stats.queued_min, size_queued);
 
-            if(size_free > DIGITAL_SEQUENCE_RING_BUFFER_MIN_FREE_SIZE) {
-                break;
-            }
+        if(dma_buffer->size_free > DIGITAL_SEQUENCE_RING_BUFFER_MIN_FREE_SIZE) {
+            break;
+        }
 
-            if(DWT->CYCCNT - prev_timer > DIGITAL_SEQUENCE_LOCK_WAIT_TICKS) {
-                FURI_LOG_D(
-                    TAG,
-                    "[SEQ] hung %lu ms in queue (ARR 0x%08lx, read %lu, write %lu)",
-                    DIGITAL_SEQUENCE_LOCK_WAIT_MS,
-                    TIM2->ARR,
-                    dma_buffer->read_pos,
-                    dma_buffer->write_pos);
-                break;
-            }
+        if(DWT->CYCCNT - prev_timer > DIGITAL_SEQUENCE_LOCK_WAIT_TICKS) {
+            sequence->events |= DigitalSequenceEventTimeout;
+            break;
+        }
 
-            if(TIM2->ARR == DIGITAL_SEQUENCE_TIMER_MAX) {
-                FURI_LOG_D(
-                    TAG,
-                    "[SEQ] buffer underrun in queue (ARR 0x%08lx, read %lu, write %lu)",
-                    TIM2->ARR,
-                    dma_buffer->read_pos,
-                    dma_buffer->write_pos);
-                break;
-            }
-        } while(true);
+        /* The end marker has been loaded into the timer before the rest of the data was queued. */
+        if(TIM2->ARR == DIGITAL_SEQUENCE_TIMER_MAX) {
+            sequence->events |= DigitalSequenceEventUnderrun;
+            break;
+        }
+    } while(true);
+}
+
+static inline void digital_sequence_enqueue_period(DigitalSequence* sequence, uint32_t length) {
+    DigitalSequenceRingBuffer* dma_buffer = &sequence->timer_buf;
+
+    if(sequence->state == DigitalSequenceStateActive &&
+       dma_buffer->size_free <= DIGITAL_SEQUENCE_RING_BUFFER_MIN_FREE_SIZE) {
+        digital_sequence_wait_for_space(sequence);
     }
 
     dma_buffer->data[dma_buffer->write_pos] = length;
 
     dma_buffer->write_pos += 1;
     dma_buffer->write_pos %= DIGITAL_SEQUENCE_RING_BUFFER_SIZE;
+    if(dma_buffer->size_free) dma_buffer->size_free -= 1;
 
     dma_buffer->data[dma_buffer->write_pos] = DIGITAL_SEQUENCE_TIMER_MAX;
 }
@@ -278,6 +304,23 @@ static inline void digital_sequence_timer_buffer_reset(DigitalSequence* sequence
     sequence->timer_buf.data[0] = DIGITAL_SEQUENCE_TIMER_MAX;
     sequence->timer_buf.read_pos = 0;
     sequence->timer_buf.write_pos = 0;
+    sequence->timer_buf.size_free = 0;
+}
+
+static void digital_sequence_update_stats(DigitalSequence* sequence) {
+    DigitalSequenceStats* stats = &sequence->stats;
+
+    stats->transmissions++;
+
+    // Only count here, callers usually transmit with interrupts masked
+    if(sequence->events & DigitalSequenceEventUnderrun) {
+        stats->underruns++;
+    }
+    if(sequence->events & DigitalSequenceEventTimeout) {
+        stats->timeouts++;
+    }
+
+    sequence->events = DigitalSequenceEventNone;
 }
 
 void digital_sequence_transmit(DigitalSequence* sequence) {
@@ -373,6 +416,7 @@ void digital_sequence_transmit(DigitalSequence* sequence) {
     FURI_CRITICAL_EXIT();
 
     sequence->state = DigitalSequenceStateIdle;
+    digital_sequence_update_stats(sequence);
 }
 
 void digital_sequence_clear(DigitalSequence* sequence) {
@@ -380,3 +424,43 @@ void digital_sequence_clear(DigitalSequence* sequence) {
 
     sequence->size = 0;
 }
+
+void digital_sequence_get_stats(DigitalSequence* sequence, DigitalSequenceStats* stats) {
+    furi_check(sequence);
+    furi_check(stats);
+
+    *stats = sequence->stats;
+}
+
+void digital_sequence_reset_stats(DigitalSequence* sequence) {
+    furi_check(sequence);
+
+    memset(&sequence->stats, 0, sizeof(DigitalSequenceStats));
+    memset(&sequence->stats_logged, 0, sizeof(DigitalSequenceStats));
+    sequence->stats.queued_min = DIGITAL_SEQUENCE_RING_BUFFER_SIZE;
+}
+
+void digital_sequence_log_stats(DigitalSequence* sequence) {
+    furi_check(sequence);
+
+    DigitalSequenceStats* stats = &sequence->stats;
+    DigitalSequenceStats* logged = &sequence->stats_logged;
+
+    if(stats->underruns != logged->underruns) {
+        FURI_LOG_D(
+            TAG,
+            "Buffer underrun in %lu transmissions, %lu in total",
+            stats->underruns - logged->underruns,
+            stats->underruns);
+    }
+    if(stats->timeouts != logged->timeouts) {
+        FURI_LOG_D(
+            TAG,
+            "Hung %lu ms in %lu transmissions, %lu in total",
+            DIGITAL_SEQUENCE_LOCK_WAIT_MS,
+            stats->timeouts - logged->timeouts,
+            stats->timeouts);
+    }
+
+    *logged = *stats;
+}
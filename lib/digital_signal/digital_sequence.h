@@ -40,6 +40,16 @@ extern "C" {
 
 typedef struct DigitalSequence DigitalSequence;
 
+/**
+ * @brief DigitalSequence transmission statistics.
+ */
+typedef struct {
+    uint32_t transmissions; /**< Number of transmitted sequences. */
+    uint32_t underruns; /**< Number of transmissions during which DMA ran out of queued data. */
+    uint32_t timeouts; /**< Number of transmissions which got stuck waiting for DMA. */
+    uint32_t queued_min; /**< Lowest number of periods queued ahead of DMA during refill. */
+} DigitalSequenceStats;
+
 /**
  * @brief Allocate a DigitalSequence instance of a given size which will operate on a set GPIO pin.
  *
@@ -84,6 +94,21 @@ void digital_sequence_register_signal(
  */
 void digital_sequence_add_signal(DigitalSequence* sequence, uint8_t signal_index);
 
+/**
+ * @brief Append several signal indices to a DigitalSequence instance.
+ *
+ * Equivalent to calling digital_sequence_add_signal() for each index, but checks the whole
+ * array at once. Useful for appending sequences encoded in advance.
+ *
+ * @param[in,out] sequence pointer to the instance to be modified.
+ * @param[in] signal_indices pointer to the array of signal indices (each must be less than 32).
+ * @param[in] count number of signal indices in the array.
+ */
+void digital_sequence_add_signals(
+    DigitalSequence* sequence,
+    const uint8_t* signal_indices,
+    size_t count);
+
 /**
  * @brief Transmit the sequence contained in the DigitalSequence instance.
  *
@@ -107,6 +132,35 @@ void digital_sequence_transmit(DigitalSequence* sequence);
  */
 void digital_sequence_clear(DigitalSequence* sequence);
 
+/**
+ * @brief Get transmission statistics of a DigitalSequence instance.
+ *
+ * Periods are queued to DMA through a ring buffer which is refilled during transmission.
+ * A low DigitalSequenceStats::queued_min means that the refill barely keeps up with the
+ * output, for example because of long signals with short periods or interrupts.
+ *
+ * @param[in] sequence pointer to the instance.
+ * @param[out] stats pointer to the statistics to be filled.
+ */
+void digital_sequence_get_stats(DigitalSequence* sequence, DigitalSequenceStats* stats);
+
+/**
+ * @brief Reset transmission statistics of a DigitalSequence instance.
+ *
+ * @param[in,out] sequence pointer to the instance.
+ */
+void digital_sequence_reset_stats(DigitalSequence* sequence);
+
+/**
+ * @brief Log transmission problems counted since the previous call.
+ *
+ * digital_sequence_transmit() only counts underruns and timeouts, as it is usually called
+ * inside a critical section. Call this function after leaving it.
+ *
+ * @param[in,out] sequence pointer to the instance.
+ */
+void digital_sequence_log_stats(DigitalSequence* sequence);
+
 #ifdef __cplusplus
 }
 #endif
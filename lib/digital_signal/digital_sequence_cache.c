@@ -0,0 +1,140 @@
+#include "digital_sequence_cache.h"
+
+#include <furi.h>
+
+typedef struct {
+    uint32_t last_used;
+    uint16_t key_size;
+    uint16_t count;
+    uint8_t* key;
+    uint8_t* signals;
+} DigitalSequenceCacheEntry;
+
+struct DigitalSequenceCache {
+    size_t entry_count;
+    size_t key_size_max;
+    size_t signals_max;
+    uint32_t use_counter;
+    DigitalSequenceCacheEntry* reserved;
+    DigitalSequenceCacheStats stats;
+    DigitalSequenceCacheEntry entries[];
+};
+
+DigitalSequenceCache*
+    digital_sequence_cache_alloc(size_t entry_count, size_t key_size_max, size_t signals_max) {
+    furi_check(entry_count);
+    furi_check(key_size_max && key_size_max <= UINT16_MAX);
+    furi_check(signals_max && signals_max <= UINT16_MAX);
+
+    DigitalSequenceCache* instance =
+        malloc(sizeof(DigitalSequenceCache) + entry_count * sizeof(DigitalSequenceCacheEntry));
+    instance->entry_count = entry_count;
+    instance->key_size_max = key_size_max;
+    instance->signals_max = signals_max;
+
+    // Keys and signals of all entries share one allocation
+    uint8_t* storage = malloc(entry_count * (key_size_max + signals_max));
+    for(size_t i = 0; i < entry_count; i++) {
+        instance->entries[i].key = storage;
+        storage += key_size_max;
+        instance->entries[i].signals = storage;
+        storage += signals_max;
+    }
+
+    return instance;
+}
+
+void digital_sequence_cache_free(DigitalSequenceCache* instance) {
+    furi_check(instance);
+
+    free(instance->entries[0].key);
+    free(instance);
+}
+
+const uint8_t* digital_sequence_cache_get(
+    DigitalSequenceCache* instance,
+    const uint8_t* key,
+    size_t key_size,
+    size_t* count) {
+    furi_check(instance);
+    furi_check(key);
+    furi_check(count);
+
+    const uint8_t* signals = NULL;
+
+    for(size_t i = 0; i < instance->entry_count; i++) {
+        DigitalSequenceCacheEntry* entry = &instance->entries[i];
+        // Empty entries have zero count and never match
+        if(entry->count == 0 || entry->key_size != key_size) continue;
+        if(memcmp(entry->key, key, key_size) != 0) continue;
+
+        entry->last_used = ++instance->use_counter;
+        *count = entry->count;
+        signals = entry->signals;
+        break;
+    }
+
+    return signals;
+}
+
+uint8_t* digital_sequence_cache_reserve(
+    DigitalSequenceCache* instance,
+    const uint8_t* key,
+    size_t key_size) {
+    furi_check(instance);
+    furi_check(key);
+    furi_check(key_size <= instance->key_size_max);
+
+    DigitalSequenceCacheEntry* entry = &instance->entries[0];
+    for(size_t i = 1; i < instance->entry_count; i++) {
+        if(instance->entries[i].last_used < entry->last_used) {
+            entry = &instance->entries[i];
+        }
+    }
+
+    memcpy(entry->key, key, key_size);
+    entry->key_size = key_size;
+    entry->count = 0;
+    instance->reserved = entry;
+
+    return entry->signals;
+}
+
+void digital_sequence_cache_commit(DigitalSequenceCache* instance, size_t count) {
+    furi_check(instance);
+    furi_check(instance->reserved);
+    furi_check(count <= instance->signals_max);
+
+    instance->reserved->count = count;
+    instance->reserved->last_used = ++instance->use_counter;
+    instance->reserved = NULL;
+}
+
+void digital_sequence_cache_record_frame(
+    DigitalSequenceCache* instance,
+    bool hit,
+    uint32_t cycles) {
+    furi_check(instance);
+
+    DigitalSequenceCacheStats* stats = &instance->stats;
+    stats->frames++;
+    if(hit) stats->hits++;
+    stats->encode_cycles_last = cycles;
+    stats->encode_cycles_max = MAX(stats->encode_cycles_max, cycles);
+    stats->encode_cycles_total += cycles;
+}
+
+void digital_sequence_cache_get_stats(
+    DigitalSequenceCache* instance,
+    DigitalSequenceCacheStats* stats) {
+    furi_check(instance);
+    furi_check(stats);
+
+    *stats = instance->stats;
+}
+
+void digital_sequence_cache_reset_stats(DigitalSequenceCache* instance) {
+    furi_check(instance);
+
+    memset(&instance->stats, 0, sizeof(DigitalSequenceCacheStats));
+}
@@ -0,0 +1,124 @@
+/**
+ * @file digital_sequence_cache.h
+ * @brief Cache of encoded DigitalSequence signal index lists.
+ *
+ * Protocol presets encode frames into lists of signal indices before transmission. Frames
+ * which are sent repeatedly can be encoded once, stored in the cache under a key describing
+ * the frame and appended to the sequence with digital_sequence_add_signals() afterwards.
+ *
+ * Least recently used entry is replaced when the cache is full.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct DigitalSequenceCache DigitalSequenceCache;
+
+/**
+ * @brief Cache statistics.
+ */
+typedef struct {
+    uint32_t frames; /**< Number of frames produced. */
+    uint32_t hits; /**< Number of frames found in the cache. */
+    uint32_t encode_cycles_last; /**< CPU cycles spent producing the last frame. */
+    uint32_t encode_cycles_max; /**< Maximum CPU cycles spent producing a frame. */
+    uint64_t encode_cycles_total; /**< Total CPU cycles spent producing frames. */
+} DigitalSequenceCacheStats;
+
+/**
+ * @brief Allocate a DigitalSequenceCache instance.
+ *
+ * @param[in] entry_count number of cache entries.
+ * @param[in] key_size_max maximum key size in bytes.
+ * @param[in] signals_max maximum number of signal indices in an entry.
+ * @returns pointer to the allocated instance.
+ */
+DigitalSequenceCache*
+    digital_sequence_cache_alloc(size_t entry_count, size_t key_size_max, size_t signals_max);
+
+/**
+ * @brief Delete a DigitalSequenceCache instance.
+ *
+ * @param[in,out] instance pointer to the instance to be deleted.
+ */
+void digital_sequence_cache_free(DigitalSequenceCache* instance);
+
+/**
+ * @brief Find an encoded entry by its key.
+ *
+ * Found entry is marked as the most recently used one.
+ *
+ * @param[in,out] instance pointer to the instance.
+ * @param[in] key pointer to the key.
+ * @param[in] key_size key size in bytes.
+ * @param[out] count pointer to the number of signal indices in the entry.
+ * @returns pointer to the signal indices if the entry was found, NULL otherwise.
+ */
+const uint8_t* digital_sequence_cache_get(
+    DigitalSequenceCache* instance,
+    const uint8_t* key,
+    size_t key_size,
+    size_t* count);
+
+/**
+ * @brief Reserve an entry for the key, replacing the least recently used one.
+ *
+ * Caller must write the signal indices into the returned buffer and then call
+ * digital_sequence_cache_commit(). The key must not be in the cache already.
+ *
+ * @param[in,out] instance pointer to the instance.
+ * @param[in] key pointer to the key.
+ * @param[in] key_size key size in bytes.
+ * @returns pointer to the buffer for signal indices.
+ */
+uint8_t* digital_sequence_cache_reserve(
+    DigitalSequenceCache* instance,
+    const uint8_t* key,
+    size_t key_size);
+
+/**
+ * @brief Make the reserved entry available for lookups.
+ *
+ * @param[in,out] instance pointer to the instance.
+ * @param[in] count number of signal indices written to the reserved entry.
+ */
+void digital_sequence_cache_commit(DigitalSequenceCache* instance, size_t count);
+
+/**
+ * @brief Record a frame produced for transmission in the statistics.
+ *
+ * @param[in,out] instance pointer to the instance.
+ * @param[in] hit true if the frame was found in the cache, false if it was encoded.
+ * @param[in] cycles CPU cycles spent on lookup and encoding.
+ */
+void digital_sequence_cache_record_frame(
+    DigitalSequenceCache* instance,
+    bool hit,
+    uint32_t cycles);
+
+/**
+ * @brief Get cache statistics.
+ *
+ * @param[in] instance pointer to the instance.
+ * @param[out] stats pointer to the statistics to be filled.
+ */
+void digital_sequence_cache_get_stats(
+    DigitalSequenceCache* instance,
+    DigitalSequenceCacheStats* stats);
+
+/**
+ * @brief Reset cache statistics. Cached entries are kept.
+ *
+ * @param[in,out] instance pointer to the instance.
+ */
+void digital_sequence_cache_reset_stats(DigitalSequenceCache* instance);
+
+#ifdef __cplusplus
+}
+#endif
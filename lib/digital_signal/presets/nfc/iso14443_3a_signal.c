@@ -10,6 +10,9 @@
 #define ISO14443_3A_SIGNAL_SEQUENCE_SIZE \
     (ISO14443_3A_SIGNAL_MAX_EDGES / (ISO14443_3A_SIGNAL_BIT_MAX_EDGES - 2))
 
+// Start of frame and 9 bits per byte
+#define ISO14443_3A_SIGNAL_DATA_SIZE_MAX ((ISO14443_3A_SIGNAL_SEQUENCE_SIZE - 1) / 9)
+
 #define ISO14443_3A_SIGNAL_F_SIG       (13560000.0)
 #define ISO14443_3A_SIGNAL_T_SIG       7374 //73.746ns*100
 #define ISO14443_3A_SIGNAL_T_SIG_X8    58992 //T_SIG*8
@@ -26,43 +29,48 @@ typedef DigitalSignal* Iso14443_3aSignalBank[Iso14443_3aSignalIndexCount];
 
 struct Iso14443_3aSignal {
     DigitalSequence* tx_sequence;
+    // Frames are mostly unique encrypted replies, so they are encoded every time, not cached
+    uint8_t* encoded;
+    DigitalSequenceCacheStats stats;
     Iso14443_3aSignalBank signals;
 };
 
-static void iso14443_3a_signal_add_byte(Iso14443_3aSignal* instance, uint8_t byte, bool parity) {
+static inline uint8_t* iso14443_3a_signal_add_byte(uint8_t* signals, uint8_t byte, bool parity) {
     for(size_t i = 0; i < BITS_IN_BYTE; i++) {
-        digital_sequence_add_signal(
-            instance->tx_sequence,
-            FURI_BIT(byte, i) ? Iso14443_3aSignalIndexOne : Iso14443_3aSignalIndexZero);
+        *signals++ = FURI_BIT(byte, i) ? Iso14443_3aSignalIndexOne : Iso14443_3aSignalIndexZero;
     }
-    digital_sequence_add_signal(
-        instance->tx_sequence, parity ? Iso14443_3aSignalIndexOne : Iso14443_3aSignalIndexZero);
+    *signals++ = parity ? Iso14443_3aSignalIndexOne : Iso14443_3aSignalIndexZero;
+
+    return signals;
 }
 
-static void iso14443_3a_signal_encode(
-    Iso14443_3aSignal* instance,
+static size_t iso14443_3a_signal_encode(
+    uint8_t* signals,
     const uint8_t* tx_data,
     const uint8_t* tx_parity,
     size_t tx_bits) {
-    furi_assert(instance);
+    furi_assert(signals);
     furi_assert(tx_data);
     furi_assert(tx_parity);
 
+    uint8_t* signal = signals;
+
     // Start of frame
-    digital_sequence_add_signal(instance->tx_sequence, Iso14443_3aSignalIndexOne);
+    *signal++ = Iso14443_3aSignalIndexOne;
 
     if(tx_bits < BITS_IN_BYTE) {
         for(size_t i = 0; i < tx_bits; i++) {
-            digital_sequence_add_signal(
-                instance->tx_sequence,
-                FURI_BIT(tx_data[0], i) ? Iso14443_3aSignalIndexOne : Iso14443_3aSignalIndexZero);
+            *signal++ = FURI_BIT(tx_data[0], i) ? Iso14443_3aSignalIndexOne :
+                                                  Iso14443_3aSignalIndexZero;
         }
     } else {
         for(size_t i = 0; i < tx_bits / BITS_IN_BYTE; i++) {
             bool parity = FURI_BIT(tx_parity[i / BITS_IN_BYTE], i % BITS_IN_BYTE);
-            iso14443_3a_signal_add_byte(instance, tx_data[i], parity);
+            signal = iso14443_3a_signal_add_byte(signal, tx_data[i], parity);
         }
     }
+
+    return signal - signals;
 }
 
 static inline void iso14443_3a_signal_set_bit(DigitalSignal* signal, bool bit) {
@@ -106,6 +114,7 @@ Iso14443_3aSignal* iso14443_3a_signal_alloc(const GpioPin* pin) {
 
     Iso14443_3aSignal* instance = malloc(sizeof(Iso14443_3aSignal));
     instance->tx_sequence = digital_sequence_alloc(ISO14443_3A_SIGNAL_SEQUENCE_SIZE, pin);
+    instance->encoded = malloc(ISO14443_3A_SIGNAL_SEQUENCE_SIZE);
 
     iso14443_3a_signal_bank_fill(instance->signals);
     iso14443_3a_signal_bank_register(instance->signals, instance->tx_sequence);
@@ -118,6 +127,7 @@ void iso14443_3a_signal_free(Iso14443_3aSignal* instance) {
     furi_assert(instance->tx_sequence);
 
     iso14443_3a_signal_bank_clear(instance->signals);
+    free(instance->encoded);
     digital_sequence_free(instance->tx_sequence);
     free(instance);
 }
@@ -131,9 +141,36 @@ void iso14443_3a_signal_tx(
     furi_assert(tx_data);
     furi_assert(tx_parity);
 
+    furi_check(tx_bits / BITS_IN_BYTE <= ISO14443_3A_SIGNAL_DATA_SIZE_MAX);
+
     FURI_CRITICAL_ENTER();
+    const uint32_t start = DWT->CYCCNT;
+
+    const size_t count = iso14443_3a_signal_encode(instance->encoded, tx_data, tx_parity, tx_bits);
     digital_sequence_clear(instance->tx_sequence);
-    iso14443_3a_signal_encode(instance, tx_data, tx_parity, tx_bits);
+    digital_sequence_add_signals(instance->tx_sequence, instance->encoded, count);
+
+    const uint32_t cycles = DWT->CYCCNT - start;
+    instance->stats.frames++;
+    instance->stats.encode_cycles_last = cycles;
+    instance->stats.encode_cycles_max = MAX(instance->stats.encode_cycles_max, cycles);
+    instance->stats.encode_cycles_total += cycles;
+
     digital_sequence_transmit(instance->tx_sequence);
     FURI_CRITICAL_EXIT();
+
+    digital_sequence_log_stats(instance->tx_sequence);
+}
+
+void iso14443_3a_signal_get_stats(Iso14443_3aSignal* instance, DigitalSequenceCacheStats* stats) {
+    furi_assert(instance);
+    furi_assert(stats);
+
+    *stats = instance->stats;
+}
+
+void iso14443_3a_signal_reset_stats(Iso14443_3aSignal* instance) {
+    furi_assert(instance);
+
+    instance->stats = (DigitalSequenceCacheStats){0};
 }
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <furi_hal_resources.h>
+#include <digital_signal/digital_sequence_cache.h>
 
 #include <stdint.h>
 #include <stddef.h>
@@ -33,6 +34,8 @@ void iso14443_3a_signal_free(Iso14443_3aSignal* instance);
 /**
  * @brief Transmit arbitrary bytes using an Iso14443_3aSignal instance.
  *
+ * Frames are encoded every time: listener replies are mostly unique, so a cache would
+ * only add a lookup to the reply path.
  * This function will block until the transmisson has been completed.
  *
  * @param[in] instance pointer to the instance used in transmission.
@@ -46,6 +49,23 @@ void iso14443_3a_signal_tx(
     const uint8_t* tx_parity,
     size_t tx_bits);
 
+/**
+ * @brief Get frame encoding statistics of an Iso14443_3aSignal instance.
+ *
+ * Frames are not cached, so the hit count is always zero.
+ *
+ * @param[in] instance pointer to the instance.
+ * @param[out] stats pointer to the statistics to be filled.
+ */
+void iso14443_3a_signal_get_stats(Iso14443_3aSignal* instance, DigitalSequenceCacheStats* stats);
+
+/**
+ * @brief Reset frame encoding statistics of an Iso14443_3aSignal instance.
+ *
+ * @param[in,out] instance pointer to the instance.
+ */
+void iso14443_3a_signal_reset_stats(Iso14443_3aSignal* instance);
+
 #ifdef __cplusplus
 }
 #endif
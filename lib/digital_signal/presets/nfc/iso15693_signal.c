@@ -1,6 +1,7 @@
 #include "iso15693_signal.h"
 
 #include <digital_signal/digital_sequence.h>
+#include <digital_signal/digital_sequence_cache.h>
 
 #define BITS_IN_BYTE (8U)
 
@@ -13,6 +14,14 @@
 #define ISO15693_SIGNAL_SOF_EDGES  (ISO15693_SIGNAL_EOF_EDGES + 1U)
 #define ISO15693_SIGNAL_EDGES      (1350U)
 
+#define ISO15693_SIGNAL_SEQUENCE_SIZE (BITS_IN_BYTE * 255U + 2U)
+
+// Longer frames, such as multiple block reads, are encoded on every transmission
+#define ISO15693_SIGNAL_CACHE_ENTRIES     (8U)
+#define ISO15693_SIGNAL_CACHE_DATA_SIZE   (32U)
+#define ISO15693_SIGNAL_CACHE_KEY_SIZE    (ISO15693_SIGNAL_CACHE_DATA_SIZE + 1U)
+#define ISO15693_SIGNAL_CACHE_SIGNALS_MAX (ISO15693_SIGNAL_CACHE_DATA_SIZE * BITS_IN_BYTE + 2U)
+
 #define ISO15693_SIGNAL_FC     (13.56e6)
 #define ISO15693_SIGNAL_FC_16  (16.0e11 / ISO15693_SIGNAL_FC)
 #define ISO15693_SIGNAL_FC_256 (256.0e11 / ISO15693_SIGNAL_FC)
@@ -30,6 +39,7 @@ typedef DigitalSignal* Iso15693SignalBank[Iso15693SignalIndexNum];
 
 struct Iso15693Signal {
     DigitalSequence* tx_sequence;
+    DigitalSequenceCache* cache;
     Iso15693SignalBank banks[Iso15693SignalDataRateNum];
 };
 
@@ -84,18 +94,38 @@ static inline uint32_t
     return index + data_rate * Iso15693SignalIndexNum;
 }
 
-static inline void
-    iso15693_add_byte(Iso15693Signal* instance, Iso15693SignalDataRate data_rate, uint8_t byte) {
+static inline uint8_t*
+    iso15693_encode_byte(uint8_t* signals, Iso15693SignalDataRate data_rate, uint8_t byte) {
+    const uint8_t one = iso15693_get_sequence_index(Iso15693SignalIndexOne, data_rate);
+    const uint8_t zero = iso15693_get_sequence_index(Iso15693SignalIndexZero, data_rate);
+
     for(size_t i = 0; i < BITS_IN_BYTE; i++) {
-        const uint8_t bit = byte & (1U << i);
-        digital_sequence_add_signal(
-            instance->tx_sequence,
-            iso15693_get_sequence_index(
-                bit ? Iso15693SignalIndexOne : Iso15693SignalIndexZero, data_rate));
+        *signals++ = (byte & (1U << i)) ? one : zero;
     }
+
+    return signals;
 }
 
-static inline void iso15693_signal_encode(
+static size_t iso15693_signal_encode(
+    uint8_t* signals,
+    Iso15693SignalDataRate data_rate,
+    const uint8_t* tx_data,
+    size_t tx_data_size) {
+    uint8_t* signal = signals;
+
+    *signal++ = iso15693_get_sequence_index(Iso15693SignalIndexSof, data_rate);
+
+    for(size_t i = 0; i < tx_data_size; i++) {
+        signal = iso15693_encode_byte(signal, data_rate, tx_data[i]);
+    }
+
+    *signal++ = iso15693_get_sequence_index(Iso15693SignalIndexEof, data_rate);
+
+    return signal - signals;
+}
+
+// Frames too long for the cache are encoded into the sequence byte by byte
+static void iso15693_signal_encode_to_sequence(
     Iso15693Signal* instance,
     Iso15693SignalDataRate data_rate,
     const uint8_t* tx_data,
@@ -103,14 +133,27 @@ static inline void iso15693_signal_encode(
     digital_sequence_add_signal(
         instance->tx_sequence, iso15693_get_sequence_index(Iso15693SignalIndexSof, data_rate));
 
+    uint8_t byte_signals[BITS_IN_BYTE];
     for(size_t i = 0; i < tx_data_size; i++) {
-        iso15693_add_byte(instance, data_rate, tx_data[i]);
+        iso15693_encode_byte(byte_signals, data_rate, tx_data[i]);
+        digital_sequence_add_signals(instance->tx_sequence, byte_signals, BITS_IN_BYTE);
     }
 
     digital_sequence_add_signal(
         instance->tx_sequence, iso15693_get_sequence_index(Iso15693SignalIndexEof, data_rate));
 }
 
+static inline size_t iso15693_signal_make_key(
+    uint8_t* key,
+    Iso15693SignalDataRate data_rate,
+    const uint8_t* tx_data,
+    size_t tx_data_size) {
+    key[0] = data_rate;
+    memcpy(&key[1], tx_data, tx_data_size);
+
+    return tx_data_size + 1;
+}
+
 static void iso15693_signal_bank_fill(Iso15693Signal* instance, Iso15693SignalDataRate data_rate) {
     const uint32_t k = data_rate == Iso15693SignalDataRateHi ? ISO15693_SIGNAL_COEFF_HI :
                                                                ISO15693_SIGNAL_COEFF_LO;
@@ -151,7 +194,11 @@ Iso15693Signal* iso15693_signal_alloc(const GpioPin* pin) {
 
     Iso15693Signal* instance = malloc(sizeof(Iso15693Signal));
 
-    instance->tx_sequence = digital_sequence_alloc(BITS_IN_BYTE * 255 + 2, pin);
+    instance->tx_sequence = digital_sequence_alloc(ISO15693_SIGNAL_SEQUENCE_SIZE, pin);
+    instance->cache = digital_sequence_cache_alloc(
+        ISO15693_SIGNAL_CACHE_ENTRIES,
+        ISO15693_SIGNAL_CACHE_KEY_SIZE,
+        ISO15693_SIGNAL_CACHE_SIGNALS_MAX);
 
     for(uint32_t i = 0; i < Iso15693SignalDataRateNum; ++i) {
         iso15693_signal_bank_fill(instance, i);
@@ -164,6 +211,7 @@ Iso15693Signal* iso15693_signal_alloc(const GpioPin* pin) {
 void iso15693_signal_free(Iso15693Signal* instance) {
     furi_assert(instance);
 
+    digital_sequence_cache_free(instance->cache);
     digital_sequence_free(instance->tx_sequence);
 
     for(uint32_t i = 0; i < Iso15693SignalDataRateNum; ++i) {
@@ -183,11 +231,73 @@ void iso15693_signal_tx(
     furi_assert(tx_data);
 
     FURI_CRITICAL_ENTER();
+    const uint32_t start = DWT->CYCCNT;
+    bool hit = false;
+
     digital_sequence_clear(instance->tx_sequence);
-    iso15693_signal_encode(instance, data_rate, tx_data, tx_data_size);
+
+    if(tx_data_size <= ISO15693_SIGNAL_CACHE_DATA_SIZE) {
+        uint8_t key[ISO15693_SIGNAL_CACHE_KEY_SIZE];
+        size_t key_size = iso15693_signal_make_key(key, data_rate, tx_data, tx_data_size);
+
+        size_t count = 0;
+        const uint8_t* signals =
+            digital_sequence_cache_get(instance->cache, key, key_size, &count);
+        hit = signals != NULL;
+
+        if(!hit) {
+            uint8_t* entry = digital_sequence_cache_reserve(instance->cache, key, key_size);
+            count = iso15693_signal_encode(entry, data_rate, tx_data, tx_data_size);
+            digital_sequence_cache_commit(instance->cache, count);
+            signals = entry;
+        }
+
+        digital_sequence_add_signals(instance->tx_sequence, signals, count);
+    } else {
+        iso15693_signal_encode_to_sequence(instance, data_rate, tx_data, tx_data_size);
+    }
+
+    digital_sequence_cache_record_frame(instance->cache, hit, DWT->CYCCNT - start);
     digital_sequence_transmit(instance->tx_sequence);
 
     FURI_CRITICAL_EXIT();
+
+    digital_sequence_log_stats(instance->tx_sequence);
+}
+
+void iso15693_signal_prepare(
+    Iso15693Signal* instance,
+    Iso15693SignalDataRate data_rate,
+    const uint8_t* tx_data,
+    size_t tx_data_size) {
+    furi_assert(instance);
+    furi_assert(data_rate < Iso15693SignalDataRateNum);
+    furi_assert(tx_data);
+
+    if(tx_data_size > ISO15693_SIGNAL_CACHE_DATA_SIZE) return;
+
+    uint8_t key[ISO15693_SIGNAL_CACHE_KEY_SIZE];
+    size_t key_size = iso15693_signal_make_key(key, data_rate, tx_data, tx_data_size);
+
+    size_t count = 0;
+    if(digital_sequence_cache_get(instance->cache, key, key_size, &count)) return;
+
+    uint8_t* entry = digital_sequence_cache_reserve(instance->cache, key, key_size);
+    count = iso15693_signal_encode(entry, data_rate, tx_data, tx_data_size);
+    digital_sequence_cache_commit(instance->cache, count);
+}
+
+void iso15693_signal_get_stats(Iso15693Signal* instance, DigitalSequenceCacheStats* stats) {
+    furi_assert(instance);
+    furi_assert(stats);
+
+    digital_sequence_cache_get_stats(instance->cache, stats);
+}
+
+void iso15693_signal_reset_stats(Iso15693Signal* instance) {
+    furi_assert(instance);
+
+    digital_sequence_cache_reset_stats(instance->cache);
 }
 
 void iso15693_signal_tx_sof(Iso15693Signal* instance, Iso15693SignalDataRate data_rate) {
@@ -201,4 +311,6 @@ void iso15693_signal_tx_sof(Iso15693Signal* instance, Iso15693SignalDataRate dat
     digital_sequence_transmit(instance->tx_sequence);
 
     FURI_CRITICAL_EXIT();
+
+    digital_sequence_log_stats(instance->tx_sequence);
 }
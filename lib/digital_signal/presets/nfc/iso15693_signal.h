@@ -6,6 +6,7 @@
 #pragma once
 
 #include <furi_hal_resources.h>
+#include <digital_signal/digital_sequence_cache.h>
 
 #include <stdint.h>
 #include <stddef.h>
@@ -44,6 +45,7 @@ void iso15693_signal_free(Iso15693Signal* instance);
  * @brief Transmit arbitrary bytes using an Iso15693Signal instance.
  * @see Iso15693SignalDataRate
  *
+ * Encoded short frames are cached, so that repeated frames are not encoded again.
  * This function will block until the transmisson has been completed.
  *
  * @param[in] instance pointer to the instance used in transmission.
@@ -68,6 +70,38 @@ void iso15693_signal_tx(
  */
 void iso15693_signal_tx_sof(Iso15693Signal* instance, Iso15693SignalDataRate data_rate);
 
+/**
+ * @brief Encode a frame which is likely to be transmitted next and put it in the cache.
+ *
+ * Moves frame encoding out of the time between the reader request and the response.
+ * Frames which are too long to be cached are ignored.
+ *
+ * @param[in] instance pointer to the instance.
+ * @param[in] data_rate data rate the frame will be transmitted at.
+ * @param[in] tx_data pointer to the data to be transmitted.
+ * @param[in] tx_data_size size of the data to be transmitted in bytes.
+ */
+void iso15693_signal_prepare(
+    Iso15693Signal* instance,
+    Iso15693SignalDataRate data_rate,
+    const uint8_t* tx_data,
+    size_t tx_data_size);
+
+/**
+ * @brief Get frame encoding statistics of an Iso15693Signal instance.
+ *
+ * @param[in] instance pointer to the instance.
+ * @param[out] stats pointer to the statistics to be filled.
+ */
+void iso15693_signal_get_stats(Iso15693Signal* instance, DigitalSequenceCacheStats* stats);
+
+/**
+ * @brief Reset frame encoding statistics of an Iso15693Signal instance.
+ *
+ * @param[in,out] instance pointer to the instance.
+ */
+void iso15693_signal_reset_stats(Iso15693Signal* instance);
+
 #ifdef __cplusplus
 }
 #endif
@@ -39,6 +39,25 @@ CC1101Status cc1101_write_reg(FuriHalSpiBusHandle* handle, uint8_t reg, uint8_t
     return rx[1];
 }
 
+CC1101Status cc1101_write_burst(
+    FuriHalSpiBusHandle* handle,
+    uint8_t reg,
+    const uint8_t* data,
+    uint8_t size) {
+    assert(size < 64);
+    uint8_t tx[64] = {reg | CC1101_BURST};
+    CC1101Status rx[64] = {0};
+    rx[0].CHIP_RDYn = 1;
+    rx[size].CHIP_RDYn = 1;
+
+    memcpy(&tx[1], data, size);
+
+    cc1101_spi_trx(handle, tx, (uint8_t*)rx, size + 1);
+
+    assert((rx[0].CHIP_RDYn | rx[size].CHIP_RDYn) == 0);
+    return rx[size];
+}
+
 CC1101Status cc1101_read_reg(FuriHalSpiBusHandle* handle, uint8_t reg, uint8_t* data) {
     assert(sizeof(CC1101Status) == 1);
     uint8_t tx[2] = {reg | CC1101_READ, 0};
@@ -126,9 +145,13 @@ uint32_t cc1101_set_frequency(FuriHalSpiBusHandle* handle, uint32_t value) {
     // Sanity check
     assert((real_value & CC1101_FMASK) == real_value);
 
-    cc1101_write_reg(handle, CC1101_FREQ2, (real_value >> 16) & 0xFF);
-    cc1101_write_reg(handle, CC1101_FREQ1, (real_value >> 8) & 0xFF);
-    cc1101_write_reg(handle, CC1101_FREQ0, (real_value >> 0) & 0xFF);
+    // FREQ2, FREQ1 and FREQ0 are consecutive, write them in one transaction
+    uint8_t freq[3] = {
+        (real_value >> 16) & 0xFF,
+        (real_value >> 8) & 0xFF,
+        (real_value >> 0) & 0xFF,
+    };
+    cc1101_write_burst(handle, CC1101_FREQ2, freq, sizeof(freq));
 
     uint64_t real_frequency = real_value * CC1101_QUARTZ / CC1101_FDIV;
 
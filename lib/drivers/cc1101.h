@@ -31,6 +31,21 @@ CC1101Status cc1101_strobe(FuriHalSpiBusHandle* handle, uint8_t strobe);
  */
 CC1101Status cc1101_write_reg(FuriHalSpiBusHandle* handle, uint8_t reg, uint8_t data);
 
+/** Write consecutive device registers in one transaction
+ *
+ * @param      handle  - pointer to FuriHalSpiHandle
+ * @param      reg     - first register
+ * @param      data    - data to write
+ * @param      size    - registers count, less than 64
+ *
+ * @return     device status
+ */
+CC1101Status cc1101_write_burst(
+    FuriHalSpiBusHandle* handle,
+    uint8_t reg,
+    const uint8_t* data,
+    uint8_t size);
+
 /** Read device register
  *
  * @param      handle  - pointer to FuriHalSpiHandle
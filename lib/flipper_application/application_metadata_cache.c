@@ -0,0 +1,266 @@
+#include "application_metadata_cache.h"
+#include <toolbox/crc32_calc.h>
+#include <furi.h>
+#include <m-dict.h>
+
+#define TAG "FapMetaCache"
+
+#define FLIPPER_APPLICATION_METADATA_CACHE_PATH        EXT_PATH("apps/.metadata_cache")
+#define FLIPPER_APPLICATION_METADATA_CACHE_MAGIC       0x4D504146
+#define FLIPPER_APPLICATION_METADATA_CACHE_VERSION     3
+#define FLIPPER_APPLICATION_METADATA_CACHE_RECORDS_MAX 1024
+
+typedef struct FURI_PACKED {
+    uint32_t magic;
+    uint32_t version;
+} FlipperApplicationMetadataCacheHeader;
+
+typedef struct FURI_PACKED {
+    uint32_t path_hash;
+    uint32_t file_size;
+    uint32_t mtime;
+    uint32_t api_version;
+    uint16_t hardware_target_id;
+    uint8_t has_icon;
+    char name[FAP_MANIFEST_MAX_APP_NAME_LENGTH];
+    uint8_t icon[FAP_MANIFEST_MAX_ICON_SIZE];
+} FlipperApplicationMetadataCacheRecord;
+
+DICT_DEF2(
+    FlipperApplicationMetadataCacheIndex,
+    uint32_t,
+    M_DEFAULT_OPLIST,
+    uint32_t,
+    M_DEFAULT_OPLIST)
+
+typedef struct {
+    FuriMutex* mutex;
+    bool loaded;
+    uint32_t records_count;
+    // path hash -> record number in cache file
+    FlipperApplicationMetadataCacheIndex_t index;
+} FlipperApplicationMetadataCache;
+
+static FlipperApplicationMetadataCache* metadata_cache = NULL;
+
+static FlipperApplicationMetadataCache* flipper_application_metadata_cache_acquire(void) {
+    if(!metadata_cache) {
+        FlipperApplicationMetadataCache* cache = malloc(sizeof(FlipperApplicationMetadataCache));
+        cache->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+        FlipperApplicationMetadataCacheIndex_init(cache->index);
+
+        bool is_set = false;
+        FURI_CRITICAL_ENTER();
+        if(!metadata_cache) {
+            metadata_cache = cache;
+            is_set = true;
+        }
+        FURI_CRITICAL_EXIT();
+
+        if(!is_set) {
+            FlipperApplicationMetadataCacheIndex_clear(cache->index);
+            furi_mutex_free(cache->mutex);
+            free(cache);
+        }
+    }
+
+    furi_check(furi_mutex_acquire(metadata_cache->mutex, FuriWaitForever) == FuriStatusOk);
+    return metadata_cache;
+}
+
+static void flipper_application_metadata_cache_release(FlipperApplicationMetadataCache* cache) {
+    furi_check(furi_mutex_release(cache->mutex) == FuriStatusOk);
+}
+
+static size_t flipper_application_metadata_cache_record_offset(uint32_t record_number) {
+    return sizeof(FlipperApplicationMetadataCacheHeader) +
+           record_number * sizeof(FlipperApplicationMetadataCacheRecord);
+}
+
+static void
+    flipper_application_metadata_cache_load(FlipperApplicationMetadataCache* cache, File* file) {
+    cache->loaded = true;
+    cache->records_count = 0;
+    FlipperApplicationMetadataCacheIndex_reset(cache->index);
+
+    if(!storage_file_open(
+           file, FLIPPER_APPLICATION_METADATA_CACHE_PATH, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        return;
+    }
+
+    do {
+        FlipperApplicationMetadataCacheHeader header;
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) break;
+        if(header.magic != FLIPPER_APPLICATION_METADATA_CACHE_MAGIC ||
+           header.version != FLIPPER_APPLICATION_METADATA_CACHE_VERSION) {
+            FURI_LOG_W(TAG, "Unsupported cache file, will be recreated");
+            break;
+        }
+
+        FlipperApplicationMetadataCacheRecord record;
+        while(storage_file_read(file, &record, sizeof(record)) == sizeof(record)) {
+            FlipperApplicationMetadataCacheIndex_set_at(
+                cache->index, record.path_hash, cache->records_count);
+            cache->records_count++;
+        }
+    } while(false);
+
+    storage_file_close(file);
+    FURI_LOG_D(TAG, "Loaded %lu records", cache->records_count);
+}
+
+bool flipper_application_metadata_cache_get_key(
+    Storage* storage,
+    const char* path,
+    FlipperApplicationMetadataKey* key) {
+    furi_check(storage);
+    furi_check(path);
+    furi_check(key);
+
+    FileInfo file_info;
+    if(storage_common_stat(storage, path, &file_info) != FSE_OK) return false;
+    if(file_info_is_dir(&file_info) || file_info.size > UINT32_MAX) return false;
+
+    key->path_hash = crc32_calc_buffer(0, path, strlen(path));
+    key->file_size = file_info.size;
+    key->mtime = file_info.mtime;
+
+    return true;
+}
+
+bool flipper_application_metadata_cache_lookup(
+    Storage* storage,
+    const FlipperApplicationMetadataKey* key,
+    FlipperApplicationMetadata* metadata) {
+    furi_check(storage);
+    furi_check(key);
+    furi_check(metadata);
+
+    FlipperApplicationMetadataCache* cache = flipper_application_metadata_cache_acquire();
+    File* file = storage_file_alloc(storage);
+    bool found = false;
+
+    if(!cache->loaded) {
+        flipper_application_metadata_cache_load(cache, file);
+    }
+
+    do {
+        uint32_t* record_number =
+            FlipperApplicationMetadataCacheIndex_get(cache->index, key->path_hash);
+        if(!record_number) break;
+
+        if(!storage_file_open(
+               file, FLIPPER_APPLICATION_METADATA_CACHE_PATH, FSAM_READ, FSOM_OPEN_EXISTING)) {
+            break;
+        }
+        if(!storage_file_seek(
+               file, flipper_application_metadata_cache_record_offset(*record_number), true)) {
+            break;
+        }
+
+        FlipperApplicationMetadataCacheRecord record;
+        if(storage_file_read(file, &record, sizeof(record)) != sizeof(record)) break;
+
+        if(record.path_hash != key->path_hash || record.file_size != key->file_size ||
+           record.mtime != key->mtime) {
+            break;
+        }
+
+        metadata->api_version = record.api_version;
+        metadata->hardware_target_id = record.hardware_target_id;
+        metadata->has_icon = record.has_icon;
+        memcpy(metadata->name, record.name, sizeof(metadata->name));
+        memcpy(metadata->icon, record.icon, sizeof(metadata->icon));
+        found = true;
+    } while(false);
+
+    storage_file_free(file);
+    flipper_application_metadata_cache_release(cache);
+
+    return found;
+}
+
+void flipper_application_metadata_cache_update(
+    Storage* storage,
+    const FlipperApplicationMetadataKey* key,
+    const FlipperApplicationMetadata* metadata) {
+    furi_check(storage);
+    furi_check(key);
+    furi_check(metadata);
+
+    FlipperApplicationMetadataCache* cache = flipper_application_metadata_cache_acquire();
+    File* file = storage_file_alloc(storage);
+
+    if(!cache->loaded) {
+        flipper_application_metadata_cache_load(cache, file);
+    }
+
+    uint32_t* existing = FlipperApplicationMetadataCacheIndex_get(cache->index, key->path_hash);
+    if(!existing && cache->records_count >= FLIPPER_APPLICATION_METADATA_CACHE_RECORDS_MAX) {
+        // Mostly records of removed applications, start from scratch
+        cache->records_count = 0;
+        FlipperApplicationMetadataCacheIndex_reset(cache->index);
+    }
+
+    do {
+        bool is_new = (cache->records_count == 0);
+        if(!is_new) {
+            is_new = !storage_file_open(
+                file,
+                FLIPPER_APPLICATION_METADATA_CACHE_PATH,
+                FSAM_READ_WRITE,
+                FSOM_OPEN_EXISTING);
+            if(is_new) {
+                // Cache file was removed since it was loaded, index no longer matches it
+                FURI_LOG_W(TAG, "Cache file is gone, recreating");
+                storage_file_close(file);
+                cache->records_count = 0;
+                FlipperApplicationMetadataCacheIndex_reset(cache->index);
+                existing = NULL;
+            }
+        }
+
+        if(is_new) {
+            if(!storage_file_open(
+                   file,
+                   FLIPPER_APPLICATION_METADATA_CACHE_PATH,
+                   FSAM_READ_WRITE,
+                   FSOM_CREATE_ALWAYS)) {
+                break;
+            }
+
+            FlipperApplicationMetadataCacheHeader header = {
+                .magic = FLIPPER_APPLICATION_METADATA_CACHE_MAGIC,
+                .version = FLIPPER_APPLICATION_METADATA_CACHE_VERSION,
+            };
+            if(storage_file_write(file, &header, sizeof(header)) != sizeof(header)) break;
+        }
+
+        const uint32_t record_number = existing ? *existing : cache->records_count;
+        FlipperApplicationMetadataCacheRecord record = {
+            .path_hash = key->path_hash,
+            .file_size = key->file_size,
+            .mtime = key->mtime,
+            .api_version = metadata->api_version,
+            .hardware_target_id = metadata->hardware_target_id,
+            .has_icon = metadata->has_icon,
+        };
+        memcpy(record.name, metadata->name, sizeof(record.name));
+        memcpy(record.icon, metadata->icon, sizeof(record.icon));
+
+        if(!storage_file_seek(
+               file, flipper_application_metadata_cache_record_offset(record_number), true)) {
+            break;
+        }
+        if(storage_file_write(file, &record, sizeof(record)) != sizeof(record)) break;
+
+        if(!existing) {
+            FlipperApplicationMetadataCacheIndex_set_at(
+                cache->index, key->path_hash, record_number);
+            cache->records_count++;
+        }
+    } while(false);
+
+    storage_file_free(file);
+    flipper_application_metadata_cache_release(cache);
+}
@@ -0,0 +1,70 @@
+/**
+ * @file application_metadata_cache.h
+ * Persistent cache of FAP name, icon and manifest info
+ */
+#pragma once
+
+#include <storage/storage.h>
+#include "application_manifest.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Cached subset of application manifest */
+typedef struct {
+    uint32_t api_version;
+    uint16_t hardware_target_id;
+    bool has_icon;
+    char name[FAP_MANIFEST_MAX_APP_NAME_LENGTH];
+    uint8_t icon[FAP_MANIFEST_MAX_ICON_SIZE];
+} FlipperApplicationMetadata;
+
+/** Cache key, identifies particular build of FAP file */
+typedef struct {
+    uint32_t path_hash;
+    uint32_t file_size;
+    uint32_t mtime;
+} FlipperApplicationMetadataKey;
+
+/** Calculate cache key for FAP file
+ *
+ * Key is based on path, file size and modification time, all taken from
+ * a single stat call, so the file itself is not opened.
+ *
+ * @param storage Storage instance
+ * @param path Path to FAP file
+ * @param key Pointer to key to fill
+ * @return true if key was calculated
+ */
+bool flipper_application_metadata_cache_get_key(
+    Storage* storage,
+    const char* path,
+    FlipperApplicationMetadataKey* key);
+
+/** Find cached metadata
+ *
+ * @param storage Storage instance
+ * @param key Cache key
+ * @param metadata Pointer to metadata to fill
+ * @return true if cache has actual metadata for this key
+ */
+bool flipper_application_metadata_cache_lookup(
+    Storage* storage,
+    const FlipperApplicationMetadataKey* key,
+    FlipperApplicationMetadata* metadata);
+
+/** Store metadata in cache, replacing outdated record for the same path
+ *
+ * @param storage Storage instance
+ * @param key Cache key
+ * @param metadata Metadata to store
+ */
+void flipper_application_metadata_cache_update(
+    Storage* storage,
+    const FlipperApplicationMetadataKey* key,
+    const FlipperApplicationMetadata* metadata);
+
+#ifdef __cplusplus
+}
+#endif
@@ -166,12 +166,10 @@ static bool elf_read_symbol(ELFFile* elf, int n, Elf32_Sym* sym, FuriString* nam
 }
 
 static ELFSection* elf_section_of(ELFFile* elf, int index) {
-    ELFSectionDict_it_t it;
-    for(ELFSectionDict_it(it, elf->sections); !ELFSectionDict_end_p(it); ELFSectionDict_next(it)) {
-        ELFSectionDict_itref_t* itref = ELFSectionDict_ref(it);
-        if(itref->value.sec_idx == index) {
-            return &itref->value;
-        }
+    furi_check(elf->sections_by_index);
+
+    if(index > 0 && (size_t)index < elf->sections_count) {
+        return elf->sections_by_index[index];
     }
 
     return NULL;
@@ -811,6 +809,7 @@ ELFFile* elf_file_alloc(Storage* storage, const ElfApiInterface* api_interface)
     ELFFile* elf = malloc(sizeof(ELFFile));
     elf->fd = storage_file_alloc(storage);
     elf->api_interface = api_interface;
+    elf->sections_by_index = NULL;
     ELFSectionDict_init(elf->sections);
     AddressCache_init(elf->trampoline_cache);
     elf->init_array_called = false;
@@ -975,6 +974,18 @@ ELFFileLoadStatus elf_file_load_sections(ELFFile* elf) {
 
     AddressCache_init(elf->relocation_cache);
 
+    // Dict is not modified during relocation, so pointers to its values stay valid
+    const size_t sections_by_index_size = elf->sections_count * sizeof(ELFSection*);
+    elf->sections_by_index = malloc(sections_by_index_size);
+    // Sections that were not loaded must resolve to NULL
+    memset(elf->sections_by_index, 0, sections_by_index_size);
+    for(ELFSectionDict_it(it, elf->sections); !ELFSectionDict_end_p(it); ELFSectionDict_next(it)) {
+        ELFSectionDict_itref_t* itref = ELFSectionDict_ref(it);
+        if(itref->value.sec_idx < elf->sections_count) {
+            elf->sections_by_index[itref->value.sec_idx] = &itref->value;
+        }
+    }
+
     for(ELFSectionDict_it(it, elf->sections); !ELFSectionDict_end_p(it); ELFSectionDict_next(it)) {
         ELFSectionDict_itref_t* itref = ELFSectionDict_ref(it);
         FURI_LOG_D(TAG, "Relocating section '%s'", itref->key);
@@ -1000,6 +1011,9 @@ ELFFileLoadStatus elf_file_load_sections(ELFFile* elf) {
     FURI_LOG_D(TAG, "Trampoline cache size: %u", AddressCache_size(elf->trampoline_cache));
     AddressCache_clear(elf->relocation_cache);
 
+    free(elf->sections_by_index);
+    elf->sections_by_index = NULL;
+
     {
         size_t total_size = 0;
         for(ELFSectionDict_it(it, elf->sections); !ELFSectionDict_end_p(it);
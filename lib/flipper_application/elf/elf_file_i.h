@@ -38,6 +38,8 @@ struct ELFFile {
     off_t symbol_table_strings;
     off_t entry;
     ELFSectionDict_t sections;
+    // Section index -> loaded section, valid only while relocating
+    ELFSection** sections_by_index;
 
     AddressCache_t relocation_cache;
     AddressCache_t trampoline_cache;
@@ -2,6 +2,7 @@
 #include "elf/elf_file.h"
 #include <notification/notification_messages.h>
 #include "application_assets.h"
+#include "application_metadata_cache.h"
 #include <loader/firmware_api/firmware_api.h>
 
 #include <m-list.h>
@@ -50,6 +51,21 @@ static void flipper_application_list_remove_app(const FlipperApplication* app) {
 
 /*****************************************************************************/
 
+static void flipper_application_add_profile_image(const FlipperApplication* app) {
+    // Debug link is a file name followed by CRC32
+    const char* name = app->state.debug_link_info.debug_link_size ?
+                           (const char*)app->state.debug_link_info.debug_link :
+                           app->manifest.name;
+
+    for(size_t i = 0; i < app->state.mmap_entry_count; i++) {
+        const ELFMemoryMapEntry* entry = &app->state.mmap_entries[i];
+        if(strcmp(entry->name, ".text") == 0) {
+            memmgr_heap_profile_add_image(name, (const void*)entry->address);
+            break;
+        }
+    }
+}
+
 FlipperApplication*
     flipper_application_alloc(Storage* storage, const ElfApiInterface* api_interface) {
     furi_check(storage);
@@ -221,6 +237,7 @@ FlipperApplicationLoadStatus flipper_application_map_to_memory(FlipperApplicatio
     case ELFFileLoadStatusSuccess:
         elf_file_init_debug_info(app->elf, &app->state);
         flipper_application_list_add_app(app);
+        flipper_application_add_profile_image(app);
         return FlipperApplicationLoadStatusSuccess;
     case ELFFileLoadStatusMissingImports:
         return FlipperApplicationLoadStatusMissingImports;
@@ -341,25 +358,49 @@ bool flipper_application_load_name_and_icon(
     furi_check(icon_ptr);
     furi_check(item_name);
 
-    FlipperApplication* app = flipper_application_alloc(storage, firmware_api_interface);
-
-    FlipperApplicationPreloadStatus preload_res =
-        flipper_application_preload_manifest(app, furi_string_get_cstr(path));
+    FlipperApplicationMetadata* metadata = malloc(sizeof(FlipperApplicationMetadata));
+    FlipperApplicationMetadataKey key;
+    bool has_key =
+        flipper_application_metadata_cache_get_key(storage, furi_string_get_cstr(path), &key);
 
     bool load_success = false;
 
-    if(preload_res == FlipperApplicationPreloadStatusSuccess) {
-        const FlipperApplicationManifest* manifest = flipper_application_get_manifest(app);
-        if(manifest->has_icon) {
-            memcpy(*icon_ptr, manifest->icon, FAP_MANIFEST_MAX_ICON_SIZE);
-        }
-        furi_string_set(item_name, manifest->name);
+    if(has_key && flipper_application_metadata_cache_lookup(storage, &key, metadata)) {
         load_success = true;
     } else {
-        FURI_LOG_E(TAG, "Failed to preload %s", furi_string_get_cstr(path));
-        load_success = false;
+        FlipperApplication* app = flipper_application_alloc(storage, firmware_api_interface);
+
+        FlipperApplicationPreloadStatus preload_res =
+            flipper_application_preload_manifest(app, furi_string_get_cstr(path));
+
+        if(preload_res == FlipperApplicationPreloadStatusSuccess) {
+            const FlipperApplicationManifest* manifest = flipper_application_get_manifest(app);
+            metadata->api_version = manifest->base.api_version.version;
+            metadata->hardware_target_id = manifest->base.hardware_target_id;
+            metadata->has_icon = manifest->has_icon;
+            memcpy(metadata->name, manifest->name, sizeof(metadata->name));
+            memcpy(metadata->icon, manifest->icon, sizeof(metadata->icon));
+            // Manifest name is not guaranteed to be null-terminated
+            metadata->name[sizeof(metadata->name) - 1] = '\0';
+            if(has_key) {
+                flipper_application_metadata_cache_update(storage, &key, metadata);
+            }
+            load_success = true;
+        } else {
+            FURI_LOG_E(TAG, "Failed to preload %s", furi_string_get_cstr(path));
+            load_success = false;
+        }
+
+        flipper_application_free(app);
     }
 
-    flipper_application_free(app);
+    if(load_success) {
+        if(metadata->has_icon) {
+            memcpy(*icon_ptr, metadata->icon, FAP_MANIFEST_MAX_ICON_SIZE);
+        }
+        furi_string_set(item_name, metadata->name);
+    }
+
+    free(metadata);
     return load_success;
-}
\ No newline at end of file
+}
@@ -139,12 +139,14 @@ static int32_t nfc_worker_listener(void* context) {
         }
         if(event & FuriHalNfcEventRxEnd) {
             furi_hal_nfc_timer_block_tx_start(instance->fdt_listen_fc);
+            FURI_TRACE_BEGIN("NfcListenerRx");
 
             nfc_event.type = NfcEventTypeRxEnd;
             furi_hal_nfc_listener_rx(
                 instance->rx_buffer, sizeof(instance->rx_buffer), &instance->rx_bits);
             bit_buffer_copy_bits(event_data.buffer, instance->rx_buffer, instance->rx_bits);
             command = instance->callback(nfc_event, instance->context);
+            FURI_TRACE_END("NfcListenerRx");
             if(command == NfcCommandStop) {
                 break;
             } else if(command == NfcCommandReset) {
@@ -179,7 +181,9 @@ bool nfc_worker_poller_ready_handler(Nfc* instance) {
     NfcCommand command = NfcCommandContinue;
 
     NfcEvent event = {.type = NfcEventTypePollerReady};
+    FURI_TRACE_BEGIN("NfcPollerReady");
     command = instance->callback(event, instance->context);
+    FURI_TRACE_END("NfcPollerReady");
     if(command == NfcCommandReset) {
         instance->poller_state = NfcPollerStateReset;
     } else if(command == NfcCommandStop) {
@@ -646,6 +650,17 @@ NfcError nfc_iso15693_listener_tx_sof(Nfc* instance) {
     return ret;
 }
 
+NfcError nfc_iso15693_listener_tx_prepare(Nfc* instance, const BitBuffer* tx_buffer) {
+    furi_check(instance);
+    furi_check(tx_buffer);
+
+    FuriHalNfcError error = furi_hal_nfc_iso15693_listener_tx_prepare(
+        bit_buffer_get_data(tx_buffer), bit_buffer_get_size(tx_buffer));
+    NfcError ret = nfc_process_hal_error(error);
+
+    return ret;
+}
+
 NfcError nfc_felica_listener_set_sensf_res_data(
     Nfc* instance,
     const uint8_t* idm,
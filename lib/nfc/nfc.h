@@ -380,6 +380,18 @@ NfcError nfc_felica_listener_set_sensf_res_data(
  */
 NfcError nfc_iso15693_listener_tx_sof(Nfc* instance);
 
+/**
+ * @brief Prepare ISO15693 frame which is likely to be transmitted next in listener mode.
+ *
+ * Encodes the frame in advance, so that a subsequent nfc_listener_tx() call with the
+ * same data replies to the reader sooner. Must be called when no transmission is pending.
+ *
+ * @param[in,out] instance pointer to the instance to be configured.
+ * @param[in] tx_buffer pointer to the buffer containing the frame to be prepared.
+ * @returns NfcErrorNone on success, any other error code on failure.
+ */
+NfcError nfc_iso15693_listener_tx_prepare(Nfc* instance, const BitBuffer* tx_buffer);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,6 +1,7 @@
 #ifdef FW_CFG_unit_tests
 
 #include <lib/nfc/nfc.h>
+#include <lib/nfc/nfc_mock.h>
 #include <lib/nfc/helpers/iso14443_crc.h>
 #include <lib/nfc/protocols/iso14443_3a/iso14443_3a.h>
 #include <lib/nfc/protocols/felica/felica.h>
@@ -8,6 +9,7 @@
 #include <lib/nfc/protocols/felica/felica_poller_sync.h>
 
 #include <furi/furi.h>
+#include <furi_hal.h>
 
 #define NFC_MAX_BUFFER_SIZE (256)
 
@@ -19,6 +21,12 @@ typedef enum {
 FuriMessageQueue* poller_queue = NULL;
 FuriMessageQueue* listener_queue = NULL;
 
+static NfcMockStats nfc_mock_stats = {.heap_free_min = SIZE_MAX};
+// Cycle counter value at the end of the last poller transaction
+static uint32_t nfc_mock_poller_mark = 0;
+static bool nfc_mock_poller_mark_valid = false;
+static bool nfc_mock_frame_log = true;
+
 typedef enum {
     NfcMessageTypeTx,
     NfcMessageTypeTimeout,
@@ -93,6 +101,8 @@ static void nfc_test_print(
     const char* message,
     uint8_t* buffer,
     uint16_t bits) {
+    if(!nfc_mock_frame_log) return;
+
     FuriString* str = furi_string_alloc();
     size_t bytes = (bits + 7) / 8;
 
@@ -139,6 +149,22 @@ static void nfc_prepare_col_res_data(
     }
 }
 
+void nfc_mock_stats_reset(void) {
+    memset(&nfc_mock_stats, 0, sizeof(nfc_mock_stats));
+    nfc_mock_stats.heap_free_min = SIZE_MAX;
+    nfc_mock_poller_mark_valid = false;
+}
+
+void nfc_mock_stats_get(NfcMockStats* stats) {
+    furi_check(stats);
+
+    *stats = nfc_mock_stats;
+}
+
+void nfc_mock_set_frame_log(bool enable) {
+    nfc_mock_frame_log = enable;
+}
+
 Nfc* nfc_alloc(void) {
     Nfc* instance = malloc(sizeof(Nfc));
 
@@ -316,6 +342,7 @@ static int32_t nfc_worker_listener(void* context) {
         } else if(message.type == NfcMessageTypeTx) {
             nfc_test_print(
                 NfcTransportLogLevelInfo, "RDR", message.data.data, message.data.data_bits);
+            uint32_t cycles = DWT->CYCCNT;
             if(instance->software_col_res_required &&
                (instance->col_res_status != Iso14443_3aColResStatusDone)) {
                 nfc_worker_listener_pass_col_res(
@@ -325,6 +352,7 @@ static int32_t nfc_worker_listener(void* context) {
                 nfc_event.type = NfcEventTypeRxEnd;
                 instance->callback(nfc_event, instance->context);
             }
+            nfc_mock_stats.listener_cycles += DWT->CYCCNT - cycles;
         }
     }
 
@@ -357,6 +385,7 @@ void nfc_start(Nfc* instance, NfcEventCallback callback, void* context) {
         listener_queue = furi_message_queue_alloc(4, sizeof(NfcMessage));
     } else {
         poller_queue = furi_message_queue_alloc(4, sizeof(NfcMessage));
+        nfc_mock_poller_mark_valid = false;
     }
 
     instance->worker_thread = furi_thread_alloc();
@@ -431,12 +460,18 @@ NfcError
     furi_check(listener_queue);
     UNUSED(fwt);
 
+    if(nfc_mock_poller_mark_valid) {
+        nfc_mock_stats.poller_cycles += DWT->CYCCNT - nfc_mock_poller_mark;
+    }
+
     NfcError error = NfcErrorNone;
 
     NfcMessage message = {};
     message.type = NfcMessageTypeTx;
     message.data.data_bits = bit_buffer_get_size(tx_buffer);
     bit_buffer_write_bytes(tx_buffer, message.data.data, bit_buffer_get_size_bytes(tx_buffer));
+    nfc_mock_stats.transactions++;
+    nfc_mock_stats.tx_bytes += bit_buffer_get_size_bytes(tx_buffer);
     // Tx
     furi_check(furi_message_queue_put(listener_queue, &message, FuriWaitForever) == FuriStatusOk);
     // Rx
@@ -446,12 +481,20 @@ NfcError
         error = NfcErrorTimeout;
     } else if(message.type == NfcMessageTypeTx) {
         bit_buffer_copy_bits(rx_buffer, message.data.data, message.data.data_bits);
+        nfc_mock_stats.rx_bytes += bit_buffer_get_size_bytes(rx_buffer);
         nfc_test_print(
             NfcTransportLogLevelWarning, "TAG", message.data.data, message.data.data_bits);
     } else if(message.type == NfcMessageTypeTimeout) {
         error = NfcErrorTimeout;
     }
 
+    if(error == NfcErrorTimeout) {
+        nfc_mock_stats.timeouts++;
+    }
+    nfc_mock_stats.heap_free_min = MIN(nfc_mock_stats.heap_free_min, memmgr_get_free_heap());
+    nfc_mock_poller_mark = DWT->CYCCNT;
+    nfc_mock_poller_mark_valid = true;
+
     return error;
 }
 
@@ -497,6 +540,13 @@ NfcError nfc_iso15693_listener_tx_sof(Nfc* instance) {
     return NfcErrorNone;
 }
 
+NfcError nfc_iso15693_listener_tx_prepare(Nfc* instance, const BitBuffer* tx_buffer) {
+    UNUSED(instance);
+    UNUSED(tx_buffer);
+
+    return NfcErrorNone;
+}
+
 NfcError nfc_felica_listener_set_sensf_res_data(
     Nfc* instance,
     const uint8_t* idm,
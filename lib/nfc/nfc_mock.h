@@ -0,0 +1,56 @@
+/**
+ * @file nfc_mock.h
+ * @brief Instrumentation of the Nfc transport mock.
+ *
+ * Available in unit tests builds only, where the Nfc transport links poller and listener
+ * through message queues instead of the radio. Counters are updated by the poller side
+ * of each transaction and are meant to be read once the poller is stopped.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Transport statistics collected since the last reset.
+ */
+typedef struct {
+    uint32_t transactions; /**< Number of poller frames sent. */
+    uint32_t timeouts; /**< Number of frames left without response. */
+    uint32_t tx_bytes; /**< Bytes sent by the poller. */
+    uint32_t rx_bytes; /**< Bytes received by the poller. */
+    uint64_t poller_cycles; /**< CPU cycles spent by the poller between frames. */
+    uint64_t listener_cycles; /**< CPU cycles spent by the listener handling frames. */
+    size_t heap_free_min; /**< Lowest free heap observed during transactions. */
+} NfcMockStats;
+
+/**
+ * @brief Reset transport statistics.
+ */
+void nfc_mock_stats_reset(void);
+
+/**
+ * @brief Get transport statistics.
+ *
+ * @param[out] stats pointer to the structure to be filled.
+ */
+void nfc_mock_stats_get(NfcMockStats* stats);
+
+/**
+ * @brief Enable or disable logging of every transferred frame.
+ *
+ * Logging is enabled by default. It dominates the transaction time,
+ * so it should be turned off when measuring performance.
+ *
+ * @param[in] enable true to log frames, false otherwise.
+ */
+void nfc_mock_set_frame_log(bool enable);
+
+#ifdef __cplusplus
+}
+#endif
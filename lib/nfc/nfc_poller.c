@@ -29,6 +29,10 @@ struct NfcPoller {
     NfcPollerSessionState session_state;
     bool protocol_detected;
 
+    const NfcProtocol* children;
+    bool* children_detected;
+    size_t children_num;
+
     NfcGenericCallbackEx callback;
     void* context;
 };
@@ -271,6 +275,76 @@ bool nfc_poller_detect(NfcPoller* instance) {
     return instance->protocol_detected;
 }
 
+static NfcCommand nfc_poller_detect_children_callback(NfcGenericEvent event, void* context) {
+    furi_assert(context);
+
+    NfcPoller* instance = context;
+    NfcPollerListElement* tail_poller = instance->list.tail;
+
+    for(size_t i = 0; i < instance->children_num; i++) {
+        const NfcPollerBase* child_api = nfc_pollers_api[instance->children[i]];
+        NfcGenericInstance* child_poller = child_api->alloc(tail_poller->poller);
+        instance->children_detected[i] = child_api->detect(event, child_poller);
+        child_api->free(child_poller);
+    }
+
+    return NfcCommandStop;
+}
+
+static NfcCommand nfc_poller_detect_children_head_callback(NfcEvent event, void* context) {
+    furi_assert(context);
+
+    NfcPoller* instance = context;
+    NfcPollerListElement* head_poller = instance->list.head;
+
+    NfcCommand command = NfcCommandContinue;
+    NfcGenericEvent poller_event = {
+        .protocol = NfcProtocolInvalid,
+        .instance = instance->nfc,
+        .event_data = &event,
+    };
+
+    if(event.type == NfcEventTypePollerReady) {
+        command = head_poller->poller_api->run(poller_event, head_poller->poller);
+    }
+
+    return command;
+}
+
+void nfc_poller_detect_children(
+    NfcPoller* instance,
+    const NfcProtocol* children,
+    bool* detected,
+    size_t children_num) {
+    furi_check(instance);
+    furi_check(children);
+    furi_check(detected);
+    furi_check(instance->session_state == NfcPollerSessionStateIdle);
+
+    for(size_t i = 0; i < children_num; i++) {
+        furi_check(children[i] < NfcProtocolNum);
+        furi_check(nfc_protocol_get_parent(children[i]) == instance->protocol);
+        detected[i] = false;
+    }
+
+    instance->children = children;
+    instance->children_detected = detected;
+    instance->children_num = children_num;
+
+    NfcPollerListElement* tail_poller = instance->list.tail;
+    tail_poller->poller_api->set_callback(
+        tail_poller->poller, nfc_poller_detect_children_callback, instance);
+
+    instance->session_state = NfcPollerSessionStateActive;
+    nfc_start(instance->nfc, nfc_poller_detect_children_head_callback, instance);
+    nfc_stop(instance->nfc);
+    instance->session_state = NfcPollerSessionStateIdle;
+
+    instance->children = NULL;
+    instance->children_detected = NULL;
+    instance->children_num = 0;
+}
+
 NfcProtocol nfc_poller_get_protocol(const NfcPoller* instance) {
     furi_check(instance);
 
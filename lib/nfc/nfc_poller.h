@@ -120,6 +120,27 @@ void nfc_poller_stop(NfcPoller* instance);
  */
 bool nfc_poller_detect(NfcPoller* instance);
 
+/**
+ * @brief Detect several child protocols within a single poller session.
+ *
+ * The card is activated once up to the protocol of the current instance, after that
+ * the detection of each child protocol is performed on the already activated card.
+ * This is only suitable for child protocols whose detection does not change the card state.
+ *
+ * It is used automatically inside NfcScanner, so there is usually no need
+ * to call it explicitly.
+ *
+ * @param[in,out] instance pointer to the instance to perform the detection with.
+ * @param[in] children pointer to the array of child protocols of the current one.
+ * @param[out] detected pointer to the array of results, one per child protocol.
+ * @param[in] children_num number of child protocols.
+ */
+void nfc_poller_detect_children(
+    NfcPoller* instance,
+    const NfcProtocol* children,
+    bool* detected,
+    size_t children_num);
+
 /**
  * @brief Get the protocol identifier an NfcPoller instance was created with.
  *
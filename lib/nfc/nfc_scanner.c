@@ -2,6 +2,9 @@
 #include "nfc_poller.h"
 
 #include <nfc/protocols/nfc_poller_defs.h>
+#include <nfc/protocols/nfc_device_defs.h>
+#include <nfc/protocols/iso14443_3a/iso14443_3a.h>
+#include <nfc/protocols/iso14443_3b/iso14443_3b.h>
 
 #include <furi/furi.h>
 
@@ -23,6 +26,82 @@ typedef enum {
     NfcScannerSessionStateStopRequest,
 } NfcScannerSessionState;
 
+typedef bool (*NfcScannerFingerprintMatch)(const NfcDeviceData* base_data);
+
+/**
+ * @brief Static knowledge about a child protocol.
+ *
+ * match() rejects cards which can not support the protocol judging by the data
+ * already obtained from the base protocol activation (ATQA/SAK, ATQB, etc).
+ *
+ * shared_session is set when detection does not alter the card state, so that
+ * the protocol can be probed together with its siblings on a single activation.
+ */
+typedef struct {
+    NfcScannerFingerprintMatch match;
+    bool shared_session;
+} NfcScannerFingerprint;
+
+static bool nfc_scanner_fingerprint_iso14443_4a(const NfcDeviceData* base_data) {
+    return iso14443_3a_supports_iso14443_4(base_data);
+}
+
+static bool nfc_scanner_fingerprint_iso14443_4b(const NfcDeviceData* base_data) {
+    return iso14443_3b_supports_iso14443_4(base_data);
+}
+
+static bool nfc_scanner_fingerprint_mf_ultralight(const NfcDeviceData* base_data) {
+    const Iso14443_3aData* iso14443_3a_data = base_data;
+    // Neither MIFARE Classic nor ISO14443-4 compliant
+    return (iso14443_3a_data->sak & 0x28) == 0;
+}
+
+static bool nfc_scanner_fingerprint_mf_classic(const NfcDeviceData* base_data) {
+    const Iso14443_3aData* iso14443_3a_data = base_data;
+    // MIFARE Classic (bit 3), MIFARE Plus SL2 (bit 4) or TNP3xxx (bit 0)
+    return (iso14443_3a_data->sak & 0x19) != 0;
+}
+
+static const NfcScannerFingerprint nfc_scanner_fingerprints[NfcProtocolNum] = {
+    [NfcProtocolIso14443_4a] =
+        {
+            .match = nfc_scanner_fingerprint_iso14443_4a,
+            .shared_session = true,
+        },
+    [NfcProtocolIso14443_4b] =
+        {
+            .match = nfc_scanner_fingerprint_iso14443_4b,
+            .shared_session = true,
+        },
+    [NfcProtocolMfUltralight] =
+        {
+            // Halts the card after probe read
+            .match = nfc_scanner_fingerprint_mf_ultralight,
+            .shared_session = false,
+        },
+    [NfcProtocolMfClassic] =
+        {
+            // Failed authentication halts the card
+            .match = nfc_scanner_fingerprint_mf_classic,
+            .shared_session = false,
+        },
+    [NfcProtocolMfPlus] =
+        {
+            .match = NULL,
+            .shared_session = true,
+        },
+    [NfcProtocolMfDesfire] =
+        {
+            .match = NULL,
+            .shared_session = true,
+        },
+    [NfcProtocolSlix] =
+        {
+            .match = NULL,
+            .shared_session = true,
+        },
+};
+
 struct NfcScanner {
     Nfc* nfc;
     NfcScannerState state;
@@ -39,9 +118,6 @@ struct NfcScanner {
     size_t base_protocols_idx;
     NfcProtocol base_protocols[NfcProtocolNum];
 
-    size_t detected_base_protocols_num;
-    NfcProtocol detected_base_protocols[NfcProtocolNum];
-
     size_t children_protocols_num;
     size_t children_protocols_idx;
     NfcProtocol children_protocols[NfcProtocolNum];
@@ -49,8 +125,17 @@ struct NfcScanner {
     size_t detected_protocols_num;
     NfcProtocol detected_protocols[NfcProtocolNum];
 
+    // Data obtained during base protocol activation, used for children pruning
+    NfcDeviceData* base_data[NfcProtocolNum];
+    // Detected protocols starting from this index were not checked for children yet
+    size_t parents_idx;
+
     NfcProtocol current_protocol;
 
+    uint32_t detect_start_tick;
+    uint32_t detect_time_ms;
+    size_t sessions_num;
+
     FuriThread* scan_worker;
 };
 
@@ -62,9 +147,31 @@ static void nfc_scanner_reset(NfcScanner* instance) {
     instance->children_protocols_num = 0;
 
     instance->detected_protocols_num = 0;
-    instance->detected_base_protocols_num = 0;
 
     instance->current_protocol = 0;
+
+    instance->parents_idx = 0;
+    instance->sessions_num = 0;
+
+    for(size_t i = 0; i < NfcProtocolNum; i++) {
+        if(instance->base_data[i]) {
+            nfc_devices[i]->free(instance->base_data[i]);
+            instance->base_data[i] = NULL;
+        }
+    }
+}
+
+static NfcProtocol nfc_scanner_get_base_protocol(NfcProtocol protocol) {
+    NfcProtocol parent_protocol = nfc_protocol_get_parent(protocol);
+    while(parent_protocol != NfcProtocolInvalid) {
+        protocol = parent_protocol;
+        parent_protocol = nfc_protocol_get_parent(protocol);
+    }
+    return protocol;
+}
+
+static bool nfc_scanner_is_shared_session(NfcProtocol protocol) {
+    return nfc_scanner_fingerprints[protocol].shared_session;
 }
 
 typedef void (*NfcScannerStateHandler)(NfcScanner* instance);
@@ -92,8 +199,25 @@ void nfc_scanner_state_handler_try_base_pollers(NfcScanner* instance) {
             break;
         }
 
+        uint32_t poll_start_tick = furi_get_tick();
         NfcPoller* poller = nfc_poller_alloc(instance->nfc, instance->current_protocol);
         bool protocol_detected = nfc_poller_detect(poller);
+
+        // Time detection from the poll that found the card, not from empty polls before it
+        if(protocol_detected && instance->first_detected_protocol == NfcProtocolInvalid) {
+            instance->detect_start_tick = poll_start_tick;
+            instance->sessions_num = 0;
+        }
+        instance->sessions_num++;
+
+        if(protocol_detected) {
+            NfcProtocol protocol = instance->current_protocol;
+            if(!instance->base_data[protocol]) {
+                instance->base_data[protocol] = nfc_devices[protocol]->alloc();
+            }
+            nfc_devices[protocol]->copy(
+                instance->base_data[protocol], nfc_poller_get_data(poller));
+        }
         nfc_poller_free(poller);
 
         if(protocol_detected) {
@@ -101,10 +225,6 @@ void nfc_scanner_state_handler_try_base_pollers(NfcScanner* instance) {
                 instance->current_protocol;
             instance->detected_protocols_num++;
 
-            instance->detected_base_protocols[instance->detected_base_protocols_num] =
-                instance->current_protocol;
-            instance->detected_base_protocols_num++;
-
             if(instance->first_detected_protocol == NfcProtocolInvalid) {
                 instance->first_detected_protocol = instance->current_protocol;
                 instance->current_protocol = NfcProtocolInvalid;
@@ -116,12 +236,32 @@ void nfc_scanner_state_handler_try_base_pollers(NfcScanner* instance) {
     } while(false);
 }
 
+static bool nfc_scanner_fingerprint_match(NfcScanner* instance, NfcProtocol protocol) {
+    NfcScannerFingerprintMatch match = nfc_scanner_fingerprints[protocol].match;
+    const NfcDeviceData* base_data = instance->base_data[nfc_scanner_get_base_protocol(protocol)];
+
+    return (match == NULL) || (base_data == NULL) || match(base_data);
+}
+
 void nfc_scanner_state_handler_find_children_protocols(NfcScanner* instance) {
-    for(size_t i = 0; i < NfcProtocolNum; i++) {
-        for(size_t j = 0; j < instance->detected_base_protocols_num; j++) {
-            if(nfc_protocol_has_parent(i, instance->detected_base_protocols[j])) {
-                instance->children_protocols[instance->children_protocols_num] = i;
-                instance->children_protocols_num++;
+    instance->children_protocols_num = 0;
+    instance->children_protocols_idx = 0;
+
+    // Only direct children of newly detected protocols: grandchildren can't be present
+    // unless their parent is. Children sharing a session are kept adjacent.
+    for(; instance->parents_idx < instance->detected_protocols_num; instance->parents_idx++) {
+        NfcProtocol parent_protocol = instance->detected_protocols[instance->parents_idx];
+        for(size_t shared = 0; shared < 2; shared++) {
+            for(size_t i = 0; i < NfcProtocolNum; i++) {
+                if(nfc_protocol_get_parent(i) != parent_protocol) continue;
+                if(nfc_scanner_is_shared_session(i) != (shared == 0)) continue;
+
+                if(nfc_scanner_fingerprint_match(instance, i)) {
+                    instance->children_protocols[instance->children_protocols_num] = i;
+                    instance->children_protocols_num++;
+                } else {
+                    FURI_LOG_D(TAG, "Pruned %s", nfc_devices[i]->protocol_name);
+                }
             }
         }
     }
@@ -129,29 +269,57 @@ void nfc_scanner_state_handler_find_children_protocols(NfcScanner* instance) {
     if(instance->children_protocols_num > 0) {
         instance->state = NfcScannerStateDetectChildrenProtocols;
     } else {
+        instance->detect_time_ms = furi_get_tick() - instance->detect_start_tick;
         instance->state = NfcScannerStateComplete;
     }
     FURI_LOG_D(TAG, "Found %zu children", instance->children_protocols_num);
 }
 
+static void nfc_scanner_add_detected_protocol(NfcScanner* instance, NfcProtocol protocol) {
+    instance->detected_protocols[instance->detected_protocols_num] = protocol;
+    instance->detected_protocols_num++;
+}
+
 void nfc_scanner_state_handler_detect_children_protocols(NfcScanner* instance) {
     furi_assert(instance->children_protocols_num);
 
-    instance->current_protocol = instance->children_protocols[instance->children_protocols_idx];
+    const NfcProtocol* children = &instance->children_protocols[instance->children_protocols_idx];
+    instance->current_protocol = children[0];
+    NfcProtocol parent_protocol = nfc_protocol_get_parent(instance->current_protocol);
+
+    // Group of siblings which can be probed on one activation
+    size_t group_num = 1;
+    if(nfc_scanner_is_shared_session(instance->current_protocol)) {
+        while(instance->children_protocols_idx + group_num < instance->children_protocols_num) {
+            NfcProtocol sibling = children[group_num];
+            if(nfc_protocol_get_parent(sibling) != parent_protocol) break;
+            if(!nfc_scanner_is_shared_session(sibling)) break;
+            group_num++;
+        }
+    }
+
+    if(group_num > 1) {
+        bool detected[NfcProtocolNum] = {};
+        NfcPoller* poller = nfc_poller_alloc(instance->nfc, parent_protocol);
+        nfc_poller_detect_children(poller, children, detected, group_num);
+        nfc_poller_free(poller);
 
-    NfcPoller* poller = nfc_poller_alloc(instance->nfc, instance->current_protocol);
-    bool protocol_detected = nfc_poller_detect(poller);
-    nfc_poller_free(poller);
+        for(size_t i = 0; i < group_num; i++) {
+            if(detected[i]) nfc_scanner_add_detected_protocol(instance, children[i]);
+        }
+    } else {
+        NfcPoller* poller = nfc_poller_alloc(instance->nfc, instance->current_protocol);
+        bool protocol_detected = nfc_poller_detect(poller);
+        nfc_poller_free(poller);
 
-    if(protocol_detected) {
-        instance->detected_protocols[instance->detected_protocols_num] =
-            instance->current_protocol;
-        instance->detected_protocols_num++;
+        if(protocol_detected) nfc_scanner_add_detected_protocol(instance, children[0]);
     }
+    instance->sessions_num++;
 
-    instance->children_protocols_idx++;
+    instance->children_protocols_idx += group_num;
     if(instance->children_protocols_idx == instance->children_protocols_num) {
-        instance->state = NfcScannerStateComplete;
+        // Look for children of just detected protocols
+        instance->state = NfcScannerStateFindChildrenProtocols;
     }
 }
 
@@ -173,14 +341,22 @@ static void nfc_scanner_filter_detected_protocols(NfcScanner* instance) {
     }
 
     instance->detected_protocols_num = filtered_protocols_num;
-    memcpy(instance->detected_protocols, filtered_protocols, filtered_protocols_num);
+    memcpy(
+        instance->detected_protocols,
+        filtered_protocols,
+        filtered_protocols_num * sizeof(NfcProtocol));
 }
 
 void nfc_scanner_state_handler_complete(NfcScanner* instance) {
     if(instance->detected_protocols_num > 1) {
         nfc_scanner_filter_detected_protocols(instance);
     }
-    FURI_LOG_I(TAG, "Detected %zu protocols", instance->detected_protocols_num);
+    FURI_LOG_I(
+        TAG,
+        "Detected %zu protocols in %lu ms, %zu sessions",
+        instance->detected_protocols_num,
+        instance->detect_time_ms,
+        instance->sessions_num);
 
     NfcScannerEvent event = {
         .type = NfcScannerEventTypeDetected,
@@ -18,6 +18,7 @@ Iso15693_3Listener* iso15693_3_listener_alloc(Nfc* nfc, Iso15693_3Data* data) {
     instance->data = data;
 
     instance->tx_buffer = bit_buffer_alloc(ISO15693_3_LISTENER_BUFFER_SIZE);
+    instance->prepare_buffer = bit_buffer_alloc(ISO15693_3_LISTENER_BUFFER_SIZE);
 
     instance->iso15693_3_event.data = &instance->iso15693_3_event_data;
     instance->generic_event.protocol = NfcProtocolIso15693_3;
@@ -34,6 +35,7 @@ void iso15693_3_listener_free(Iso15693_3Listener* instance) {
     furi_assert(instance);
 
     bit_buffer_free(instance->tx_buffer);
+    bit_buffer_free(instance->prepare_buffer);
 
     free(instance);
 }
@@ -616,6 +616,27 @@ const Iso15693_3ListenerHandlerTable iso15693_3_handler_table = {
         },
 };
 
+// Readers tend to read blocks in order, encode the next block response while waiting for request
+static void iso15693_3_listener_prepare_next_block(
+    Iso15693_3Listener* instance,
+    const uint8_t* data,
+    uint8_t flags) {
+    const uint32_t block_index = data[0] + 1;
+    if(block_index >= instance->data->system_info.block_count) return;
+
+    bit_buffer_reset(instance->prepare_buffer);
+    bit_buffer_append_byte(instance->prepare_buffer, ISO15693_3_RESP_FLAG_NONE);
+
+    if(flags & ISO15693_3_REQ_FLAG_T4_OPTION) {
+        iso15693_3_append_block_security(instance->data, block_index, instance->prepare_buffer);
+    }
+
+    iso15693_3_append_block(instance->data, block_index, instance->prepare_buffer);
+    iso13239_crc_append(Iso13239CrcTypeDefault, instance->prepare_buffer);
+
+    nfc_iso15693_listener_tx_prepare(instance->nfc, instance->prepare_buffer);
+}
+
 static Iso15693_3Error iso15693_3_listener_handle_standard_request(
     Iso15693_3Listener* instance,
     const uint8_t* data,
@@ -661,6 +682,10 @@ static Iso15693_3Error iso15693_3_listener_handle_standard_request(
 
         if(!session_state->wait_for_eof) {
             error = iso15693_3_listener_send_frame(instance, instance->tx_buffer);
+
+            if(command == ISO15693_3_CMD_READ_BLOCK && error == Iso15693_3ErrorNone) {
+                iso15693_3_listener_prepare_next_block(instance, data, flags);
+            }
         }
 
     } while(false);
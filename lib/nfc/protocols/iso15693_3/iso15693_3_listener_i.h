@@ -35,6 +35,7 @@ struct Iso15693_3Listener {
     Iso15693_3ListenerState state;
     Iso15693_3ListenerSessionState session_state;
     BitBuffer* tx_buffer;
+    BitBuffer* prepare_buffer;
 
     NfcGenericEvent generic_event;
     Iso15693_3ListenerEvent iso15693_3_event;
@@ -0,0 +1,223 @@
+#include "mf_classic_nonce_log.h"
+
+#include <furi.h>
+#include <storage/storage.h>
+#include <stream/stream.h>
+#include <stream/buffered_file_stream.h>
+
+#define TAG "MfClassicNonceLog"
+
+// 64 records fit in 1.6K and cover a quarter of Hardnested nonces for one key
+#define MF_CLASSIC_NONCE_LOG_BUFFER_RECORDS (64)
+// Slowly collected records are written out anyway, so a crash loses little
+#define MF_CLASSIC_NONCE_LOG_FLUSH_INTERVAL_MS (5000)
+#define MF_CLASSIC_NONCE_LOG_EXPORT_RECORDS    (16)
+#define MF_CLASSIC_NONCE_LOG_LINE_SIZE         (128)
+
+struct MfClassicNonceLog {
+    FuriString* path;
+    bool started;
+    uint32_t flush_tick;
+    MfClassicNonceLogRecord buffer[MF_CLASSIC_NONCE_LOG_BUFFER_RECORDS];
+    size_t buffered;
+    size_t count;
+};
+
+MfClassicNonceLog* mf_classic_nonce_log_alloc(const char* path) {
+    furi_check(path);
+
+    MfClassicNonceLog* instance = malloc(sizeof(MfClassicNonceLog));
+    instance->path = furi_string_alloc_set(path);
+    instance->flush_tick = furi_get_tick();
+
+    return instance;
+}
+
+void mf_classic_nonce_log_free(MfClassicNonceLog* instance) {
+    furi_check(instance);
+
+    if(!mf_classic_nonce_log_flush(instance)) {
+        FURI_LOG_E(TAG, "Failed to flush %zu records", instance->buffered);
+    }
+
+    furi_string_free(instance->path);
+    free(instance);
+}
+
+static size_t
+    mf_classic_nonce_log_format_record(const MfClassicNonceLogRecord* record, char* line) {
+    size_t nonce_count = (record->flags & MfClassicNonceLogFlagPair) ? 2 : 1;
+
+    size_t len = snprintf(
+        line,
+        MF_CLASSIC_NONCE_LOG_LINE_SIZE,
+        "Sec %u key %c cuid %08lx",
+        record->sector,
+        (record->flags & MfClassicNonceLogFlagKeyB) ? 'B' : 'A',
+        record->cuid);
+
+    for(size_t i = 0; i < nonce_count; i++) {
+        const MfClassicNonceLogNonce* nonce = &record->nonces[i];
+        len += snprintf(
+            line + len,
+            MF_CLASSIC_NONCE_LOG_LINE_SIZE - len,
+            " nt%u %08lx ks%u %08lx par%u %u%u%u%u",
+            i,
+            nonce->nt,
+            i,
+            nonce->ks,
+            i,
+            (nonce->par >> 3) & 1,
+            (nonce->par >> 2) & 1,
+            (nonce->par >> 1) & 1,
+            nonce->par & 1);
+    }
+
+    if(record->flags & MfClassicNonceLogFlagDist) {
+        len += snprintf(
+            line + len, MF_CLASSIC_NONCE_LOG_LINE_SIZE - len, " dist %u\n", record->dist);
+    } else {
+        len += snprintf(line + len, MF_CLASSIC_NONCE_LOG_LINE_SIZE - len, "\n");
+    }
+
+    return len;
+}
+
+static bool mf_classic_nonce_log_write_text(
+    Stream* stream,
+    const MfClassicNonceLogRecord* records,
+    size_t record_count,
+    char* line) {
+    for(size_t i = 0; i < record_count; i++) {
+        size_t len = mf_classic_nonce_log_format_record(&records[i], line);
+        if(stream_write(stream, (const uint8_t*)line, len) != len) return false;
+    }
+
+    return true;
+}
+
+bool mf_classic_nonce_log_add(MfClassicNonceLog* instance, const MfClassicNonceLogRecord* record) {
+    furi_check(instance);
+    furi_check(record);
+
+    bool success = true;
+    if(instance->buffered == MF_CLASSIC_NONCE_LOG_BUFFER_RECORDS) {
+        success = mf_classic_nonce_log_flush(instance);
+    }
+
+    instance->buffer[instance->buffered++] = *record;
+    instance->count++;
+
+    if(furi_get_tick() - instance->flush_tick >= MF_CLASSIC_NONCE_LOG_FLUSH_INTERVAL_MS) {
+        success = mf_classic_nonce_log_flush(instance) && success;
+    }
+
+    return success;
+}
+
+bool mf_classic_nonce_log_flush(MfClassicNonceLog* instance) {
+    furi_check(instance);
+
+    instance->flush_tick = furi_get_tick();
+    if(instance->buffered == 0) return true;
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    bool success = false;
+
+    do {
+        // Start over on the first flush, so the log only holds records of this instance
+        FS_OpenMode open_mode = instance->started ? FSOM_OPEN_APPEND : FSOM_CREATE_ALWAYS;
+        if(!storage_file_open(file, furi_string_get_cstr(instance->path), FSAM_WRITE, open_mode))
+            break;
+        instance->started = true;
+
+        if(storage_file_size(file) == 0) {
+            const MfClassicNonceLogHeader header = {
+                .magic = MF_CLASSIC_NONCE_LOG_MAGIC,
+                .version = MF_CLASSIC_NONCE_LOG_VERSION,
+            };
+            if(storage_file_write(file, &header, sizeof(header)) != sizeof(header)) break;
+        }
+
+        size_t size = instance->buffered * sizeof(MfClassicNonceLogRecord);
+        if(storage_file_write(file, instance->buffer, size) != size) break;
+
+        success = true;
+    } while(false);
+
+    if(!success) {
+        FURI_LOG_E(TAG, "Failed to write %s", furi_string_get_cstr(instance->path));
+    }
+
+    // Records are dropped on failure, there is nothing better to do with them
+    instance->buffered = 0;
+
+    storage_file_close(file);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    return success;
+}
+
+size_t mf_classic_nonce_log_get_count(MfClassicNonceLog* instance) {
+    furi_check(instance);
+
+    return instance->count;
+}
+
+bool mf_classic_nonce_log_export(const char* log_path, const char* text_path) {
+    furi_check(log_path);
+    furi_check(text_path);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    Stream* stream = buffered_file_stream_alloc(storage);
+    const size_t records_size =
+        MF_CLASSIC_NONCE_LOG_EXPORT_RECORDS * sizeof(MfClassicNonceLogRecord);
+    MfClassicNonceLogRecord* records = malloc(records_size);
+    char* line = malloc(MF_CLASSIC_NONCE_LOG_LINE_SIZE);
+    bool success = false;
+
+    do {
+        if(!storage_file_open(file, log_path, FSAM_READ, FSOM_OPEN_EXISTING)) break;
+
+        MfClassicNonceLogHeader header = {};
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) break;
+        if(header.magic != MF_CLASSIC_NONCE_LOG_MAGIC) {
+            FURI_LOG_E(TAG, "Invalid magic %08lx", header.magic);
+            break;
+        }
+        if(header.version != MF_CLASSIC_NONCE_LOG_VERSION) {
+            FURI_LOG_E(TAG, "Unsupported version %u", header.version);
+            break;
+        }
+
+        if(!buffered_file_stream_open(stream, text_path, FSAM_WRITE, FSOM_OPEN_APPEND)) break;
+
+        bool write_success = true;
+        size_t exported = 0;
+        while(write_success) {
+            size_t record_count =
+                storage_file_read(file, records, records_size) / sizeof(MfClassicNonceLogRecord);
+            if(record_count == 0) break;
+
+            write_success = mf_classic_nonce_log_write_text(stream, records, record_count, line);
+            exported += record_count;
+        }
+        if(!write_success) break;
+
+        FURI_LOG_D(TAG, "Exported %zu records", exported);
+        success = true;
+    } while(false);
+
+    free(line);
+    free(records);
+    buffered_file_stream_close(stream);
+    stream_free(stream);
+    storage_file_close(file);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    return success;
+}
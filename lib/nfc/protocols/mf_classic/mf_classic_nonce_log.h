@@ -0,0 +1,117 @@
+/**
+ * @file mf_classic_nonce_log.h
+ * @brief Buffered binary log of nonces collected by nested attacks.
+ *
+ * Records are kept in RAM and written to the log file in chunks. The file starts with
+ * a header followed by fixed size records, so collecting thousands of Hardnested nonces
+ * costs one file write per chunk instead of text formatting and writing per nonce.
+ * Buffered records are also written out a few seconds after the previous write, so a crash
+ * loses little. A binary log is converted to the text format understood by external solvers
+ * with mf_classic_nonce_log_export().
+ */
+#pragma once
+
+#include "mf_classic.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MF_CLASSIC_NONCE_LOG_MAGIC   (0x4C4E4346) // "FCNL"
+#define MF_CLASSIC_NONCE_LOG_VERSION (1)
+
+typedef struct MfClassicNonceLog MfClassicNonceLog;
+
+/**
+ * @brief Record flags.
+ */
+typedef enum {
+    MfClassicNonceLogFlagKeyB = (1 << 0), /**< Nonces were collected for key B. */
+    MfClassicNonceLogFlagPair = (1 << 1), /**< Record holds two nonces. */
+    MfClassicNonceLogFlagDist = (1 << 2), /**< Record holds nonce distance. */
+} MfClassicNonceLogFlag;
+
+/**
+ * @brief Log file header.
+ */
+typedef struct FURI_PACKED {
+    uint32_t magic; /**< Must be MF_CLASSIC_NONCE_LOG_MAGIC. */
+    uint8_t version; /**< Must be MF_CLASSIC_NONCE_LOG_VERSION. */
+    uint8_t reserved[3]; /**< Reserved, set to 0. */
+} MfClassicNonceLogHeader;
+
+/**
+ * @brief Nonce as stored in the log.
+ */
+typedef struct FURI_PACKED {
+    uint32_t nt; /**< Plain tag nonce. */
+    uint32_t ks; /**< Keystream, encrypted nonce XOR plain nonce. */
+    uint8_t par; /**< Parity bits, MSB first in the low nibble. */
+} MfClassicNonceLogNonce;
+
+/**
+ * @brief Log record, one line of the text log.
+ */
+typedef struct FURI_PACKED {
+    uint32_t cuid; /**< Card UID used in authentication. */
+    uint8_t sector; /**< Target sector. */
+    uint8_t flags; /**< Combination of MfClassicNonceLogFlag. */
+    uint16_t dist; /**< Nonce distance, valid with MfClassicNonceLogFlagDist. */
+    MfClassicNonceLogNonce nonces[2]; /**< Second nonce valid with MfClassicNonceLogFlagPair. */
+} MfClassicNonceLogRecord;
+
+/**
+ * @brief Allocate log writing to the given file.
+ *
+ * File is not touched until the first flush. The first flush starts a new log, so it only
+ * holds records of this instance.
+ *
+ * @param[in] path path to the binary log file.
+ * @return pointer to the allocated instance.
+ */
+MfClassicNonceLog* mf_classic_nonce_log_alloc(const char* path);
+
+/**
+ * @brief Flush buffered records and free the instance.
+ *
+ * @param[in] instance pointer to the instance to be freed.
+ */
+void mf_classic_nonce_log_free(MfClassicNonceLog* instance);
+
+/**
+ * @brief Add record to the log, flushing the buffer once it is full or after a while.
+ *
+ * @param[in] instance pointer to the instance.
+ * @param[in] record pointer to the record to be added.
+ * @return true if record was buffered and any flush succeeded, false otherwise.
+ */
+bool mf_classic_nonce_log_add(MfClassicNonceLog* instance, const MfClassicNonceLogRecord* record);
+
+/**
+ * @brief Write buffered records to the log file.
+ *
+ * @param[in] instance pointer to the instance.
+ * @return true on success, false otherwise.
+ */
+bool mf_classic_nonce_log_flush(MfClassicNonceLog* instance);
+
+/**
+ * @brief Get number of records added since allocation.
+ *
+ * @param[in] instance pointer to the instance.
+ * @return number of records.
+ */
+size_t mf_classic_nonce_log_get_count(MfClassicNonceLog* instance);
+
+/**
+ * @brief Append records of a binary log to a text log, one line per record.
+ *
+ * @param[in] log_path path to the binary log file.
+ * @param[in] text_path path to the text log file.
+ * @return true on success, false if binary log is missing, invalid or write failed.
+ */
+bool mf_classic_nonce_log_export(const char* log_path, const char* text_path);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,294 @@
+#include "mf_classic_nonce_solver.h"
+
+#include <nfc/helpers/crypto1.h>
+#include <toolbox/keys_dict.h>
+#include <furi.h>
+
+#define TAG "MfClassicNonceSolver"
+
+#define MF_CLASSIC_NONCE_SOLVER_STACK_SIZE    (2 * 1024)
+#define MF_CLASSIC_NONCE_SOLVER_JOBS_MAX      (MF_CLASSIC_TOTAL_SECTORS_MAX * 2)
+#define MF_CLASSIC_NONCE_SOLVER_RESULTS_MAX   (8)
+#define MF_CLASSIC_NONCE_SOLVER_PROGRESS_STEP (256)
+#define MF_CLASSIC_NONCE_SOLVER_PUT_TIMEOUT   (100)
+
+typedef enum {
+    MfClassicNonceSolverDictUser,
+    MfClassicNonceSolverDictSystem,
+
+    MfClassicNonceSolverDictNum,
+} MfClassicNonceSolverDict;
+
+struct MfClassicNonceSolver {
+    FuriThread* thread;
+    FuriMessageQueue* jobs;
+    FuriMessageQueue* results;
+    FuriMutex* mutex;
+    const char* dict_paths[MfClassicNonceSolverDictNum];
+    volatile bool stop;
+    // One bit per sector key, 2 keys per sector
+    volatile uint8_t keys_found[MF_CLASSIC_TOTAL_SECTORS_MAX * 2 / 8];
+
+    // Protected by mutex
+    size_t jobs_pending;
+    size_t keys_total;
+    size_t keys_checked;
+    uint64_t keys_checked_overall;
+    uint32_t search_time_ms;
+};
+
+static size_t mf_classic_nonce_solver_key_idx(uint8_t sector, MfClassicKeyType key_type) {
+    return sector * 2 + key_type;
+}
+
+static bool mf_classic_nonce_solver_is_key_found(
+    MfClassicNonceSolver* instance,
+    uint8_t sector,
+    MfClassicKeyType key_type) {
+    size_t key_idx = mf_classic_nonce_solver_key_idx(sector, key_type);
+    return (instance->keys_found[key_idx / 8] & (1 << (key_idx % 8))) != 0;
+}
+
+static bool
+    mf_classic_nonce_solver_check_key(const MfClassicNonceSolverJob* job, MfClassicKey key) {
+    bool match = true;
+
+    for(size_t i = 0; i < job->nonce_count; i++) {
+        const MfClassicNonceSolverNonce* nonce = &job->nonces[i];
+        uint32_t nt = crypto1_decrypt_nt_enc(nonce->cuid, nonce->nt_enc, key);
+        if(job->is_weak && !crypto1_is_weak_prng_nonce(nt)) {
+            match = false;
+            break;
+        }
+        if(!crypto1_nonce_matches_encrypted_parity_bits(nt, nt ^ nonce->nt_enc, nonce->par)) {
+            match = false;
+            break;
+        }
+    }
+
+    return match;
+}
+
+static void mf_classic_nonce_solver_update_progress(
+    MfClassicNonceSolver* instance,
+    size_t keys_checked,
+    uint32_t elapsed_ms) {
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    instance->keys_checked_overall += keys_checked - instance->keys_checked;
+    instance->keys_checked = keys_checked;
+    instance->search_time_ms += elapsed_ms;
+    furi_check(furi_mutex_release(instance->mutex) == FuriStatusOk);
+}
+
+static void mf_classic_nonce_solver_process(
+    MfClassicNonceSolver* instance,
+    KeysDict** dicts,
+    const MfClassicNonceSolverJob* job) {
+    size_t keys_checked = 0;
+    uint32_t tick = furi_get_tick();
+    bool aborted = false;
+    MfClassicKey key = {};
+
+    FURI_LOG_D(
+        TAG,
+        "Searching sector %u key %c, %zu nonces",
+        job->sector,
+        job->key_type == MfClassicKeyTypeA ? 'A' : 'B',
+        job->nonce_count);
+
+    for(size_t i = 0; (i < MfClassicNonceSolverDictNum) && !aborted; i++) {
+        if(!dicts[i]) continue;
+
+        keys_dict_rewind(dicts[i]);
+        while(keys_dict_get_next_key(dicts[i], key.data, sizeof(MfClassicKey))) {
+            keys_checked++;
+            if(keys_checked % MF_CLASSIC_NONCE_SOLVER_PROGRESS_STEP == 0) {
+                uint32_t now = furi_get_tick();
+                mf_classic_nonce_solver_update_progress(instance, keys_checked, now - tick);
+                tick = now;
+                if(instance->stop ||
+                   mf_classic_nonce_solver_is_key_found(instance, job->sector, job->key_type)) {
+                    aborted = true;
+                    break;
+                }
+            }
+
+            if(!mf_classic_nonce_solver_check_key(job, key)) continue;
+
+            MfClassicNonceSolverResult result = {
+                .sector = job->sector,
+                .key_type = job->key_type,
+                .key = key,
+            };
+            // Results are consumed by the poller, don't get stuck if it is gone
+            while(furi_message_queue_put(
+                      instance->results, &result, MF_CLASSIC_NONCE_SOLVER_PUT_TIMEOUT) !=
+                  FuriStatusOk) {
+                if(instance->stop) break;
+            }
+        }
+    }
+
+    mf_classic_nonce_solver_update_progress(instance, keys_checked, furi_get_tick() - tick);
+}
+
+static int32_t mf_classic_nonce_solver_worker(void* context) {
+    MfClassicNonceSolver* instance = context;
+
+    KeysDict* dicts[MfClassicNonceSolverDictNum] = {};
+    size_t keys_total = 0;
+    for(size_t i = 0; i < MfClassicNonceSolverDictNum; i++) {
+        if(!keys_dict_check_presence(instance->dict_paths[i])) continue;
+        dicts[i] = keys_dict_alloc(
+            instance->dict_paths[i], KeysDictModeOpenExisting, sizeof(MfClassicKey));
+        keys_total += keys_dict_get_total_keys(dicts[i]);
+    }
+
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    instance->keys_total = keys_total;
+    furi_check(furi_mutex_release(instance->mutex) == FuriStatusOk);
+
+    while(true) {
+        MfClassicNonceSolverJob* job = NULL;
+        furi_check(
+            furi_message_queue_get(instance->jobs, &job, FuriWaitForever) == FuriStatusOk);
+        // NULL job is sent on stop
+        if(!job) break;
+
+        if(!instance->stop &&
+           !mf_classic_nonce_solver_is_key_found(instance, job->sector, job->key_type)) {
+            mf_classic_nonce_solver_process(instance, dicts, job);
+        }
+        free(job);
+
+        furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+        instance->jobs_pending--;
+        instance->keys_checked = 0;
+        furi_check(furi_mutex_release(instance->mutex) == FuriStatusOk);
+    }
+
+    for(size_t i = 0; i < MfClassicNonceSolverDictNum; i++) {
+        if(dicts[i]) keys_dict_free(dicts[i]);
+    }
+
+    return 0;
+}
+
+MfClassicNonceSolver*
+    mf_classic_nonce_solver_alloc(const char* system_dict_path, const char* user_dict_path) {
+    furi_check(system_dict_path);
+    furi_check(user_dict_path);
+
+    MfClassicNonceSolver* instance = malloc(sizeof(MfClassicNonceSolver));
+    instance->dict_paths[MfClassicNonceSolverDictUser] = user_dict_path;
+    instance->dict_paths[MfClassicNonceSolverDictSystem] = system_dict_path;
+    // Extra slot for stop message
+    instance->jobs = furi_message_queue_alloc(
+        MF_CLASSIC_NONCE_SOLVER_JOBS_MAX + 1, sizeof(MfClassicNonceSolverJob*));
+    instance->results = furi_message_queue_alloc(
+        MF_CLASSIC_NONCE_SOLVER_RESULTS_MAX, sizeof(MfClassicNonceSolverResult));
+    instance->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+
+    instance->thread = furi_thread_alloc_ex(
+        "MfcNonceSolver",
+        MF_CLASSIC_NONCE_SOLVER_STACK_SIZE,
+        mf_classic_nonce_solver_worker,
+        instance);
+    furi_thread_set_priority(instance->thread, FuriThreadPriorityLow);
+    furi_thread_start(instance->thread);
+
+    return instance;
+}
+
+void mf_classic_nonce_solver_free(MfClassicNonceSolver* instance) {
+    furi_check(instance);
+
+    instance->stop = true;
+    MfClassicNonceSolverJob* job = NULL;
+    furi_check(furi_message_queue_put(instance->jobs, &job, FuriWaitForever) == FuriStatusOk);
+    furi_thread_join(instance->thread);
+    furi_thread_free(instance->thread);
+
+    while(furi_message_queue_get(instance->jobs, &job, 0) == FuriStatusOk) {
+        free(job);
+    }
+
+    furi_message_queue_free(instance->jobs);
+    furi_message_queue_free(instance->results);
+    furi_mutex_free(instance->mutex);
+    free(instance);
+}
+
+void mf_classic_nonce_solver_submit(
+    MfClassicNonceSolver* instance,
+    const MfClassicNonceSolverJob* job) {
+    furi_check(instance);
+    furi_check(job);
+    furi_check(job->nonce_count > 0);
+    furi_check(job->nonce_count <= MF_CLASSIC_NONCE_SOLVER_NONCES_MAX);
+
+    MfClassicNonceSolverJob* job_copy = malloc(sizeof(MfClassicNonceSolverJob));
+    *job_copy = *job;
+
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    instance->jobs_pending++;
+    furi_check(furi_mutex_release(instance->mutex) == FuriStatusOk);
+
+    furi_check(
+        furi_message_queue_put(instance->jobs, &job_copy, FuriWaitForever) == FuriStatusOk);
+}
+
+bool mf_classic_nonce_solver_get_result(
+    MfClassicNonceSolver* instance,
+    MfClassicNonceSolverResult* result,
+    uint32_t timeout) {
+    furi_check(instance);
+    furi_check(result);
+
+    return furi_message_queue_get(instance->results, result, timeout) == FuriStatusOk;
+}
+
+void mf_classic_nonce_solver_set_key_found(
+    MfClassicNonceSolver* instance,
+    uint8_t sector,
+    MfClassicKeyType key_type) {
+    furi_check(instance);
+    furi_check(sector < MF_CLASSIC_TOTAL_SECTORS_MAX);
+
+    // Written from the caller thread only, worker just reads
+    size_t key_idx = mf_classic_nonce_solver_key_idx(sector, key_type);
+    instance->keys_found[key_idx / 8] |= 1 << (key_idx % 8);
+}
+
+bool mf_classic_nonce_solver_is_busy(MfClassicNonceSolver* instance) {
+    furi_check(instance);
+
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    bool is_busy = instance->jobs_pending > 0;
+    furi_check(furi_mutex_release(instance->mutex) == FuriStatusOk);
+
+    return is_busy || (furi_message_queue_get_count(instance->results) > 0);
+}
+
+void mf_classic_nonce_solver_get_progress(
+    MfClassicNonceSolver* instance,
+    MfClassicNonceSolverProgress* progress) {
+    furi_check(instance);
+    furi_check(progress);
+
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    progress->jobs_pending = instance->jobs_pending;
+    progress->keys_total = instance->keys_total;
+    progress->keys_checked = instance->keys_checked;
+    progress->keys_per_second =
+        instance->search_time_ms ?
+            (instance->keys_checked_overall * 1000 / instance->search_time_ms) :
+            0;
+    furi_check(furi_mutex_release(instance->mutex) == FuriStatusOk);
+
+    progress->eta_s = 0;
+    if(progress->keys_per_second && progress->jobs_pending) {
+        size_t keys_left = progress->jobs_pending * progress->keys_total - progress->keys_checked;
+        progress->eta_s = keys_left / progress->keys_per_second;
+    }
+}
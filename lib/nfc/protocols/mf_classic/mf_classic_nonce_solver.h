@@ -0,0 +1,136 @@
+/**
+ * @file mf_classic_nonce_solver.h
+ * @brief Background dictionary search of keys for collected nested nonces.
+ *
+ * Solver runs in its own thread and processes jobs in order of submission.
+ * Each job is a set of nested nonces collected for one sector key. Every
+ * dictionary key consistent with all nonces of the job is reported as a result,
+ * search continues until dictionaries are exhausted or the key is marked as found.
+ */
+#pragma once
+
+#include "mf_classic.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MF_CLASSIC_NONCE_SOLVER_NONCES_MAX (8)
+
+typedef struct MfClassicNonceSolver MfClassicNonceSolver;
+
+/**
+ * @brief Encrypted nested nonce, as seen by the reader.
+ */
+typedef struct {
+    uint32_t cuid; /**< Card UID used in authentication. */
+    uint32_t nt_enc; /**< Encrypted tag nonce. */
+    uint8_t par; /**< Decrypted parity bits of the nonce, MSB first. */
+} MfClassicNonceSolverNonce;
+
+/**
+ * @brief Key search job.
+ */
+typedef struct {
+    uint8_t sector; /**< Sector the nonces were collected for. */
+    MfClassicKeyType key_type; /**< Key type the nonces were collected for. */
+    bool is_weak; /**< Tag has weak PRNG, plain nonces must be PRNG outputs. */
+    size_t nonce_count; /**< Number of nonces in the job. */
+    MfClassicNonceSolverNonce nonces[MF_CLASSIC_NONCE_SOLVER_NONCES_MAX]; /**< Nonces. */
+} MfClassicNonceSolverJob;
+
+/**
+ * @brief Key candidate.
+ */
+typedef struct {
+    uint8_t sector; /**< Sector of the job which produced the candidate. */
+    MfClassicKeyType key_type; /**< Key type of the job which produced the candidate. */
+    MfClassicKey key; /**< Key consistent with all nonces of the job. */
+} MfClassicNonceSolverResult;
+
+/**
+ * @brief Solver progress.
+ */
+typedef struct {
+    size_t jobs_pending; /**< Jobs queued or in progress. */
+    size_t keys_total; /**< Number of keys in dictionaries, checked per job. */
+    size_t keys_checked; /**< Keys checked for the job in progress. */
+    uint32_t keys_per_second; /**< Average search speed. */
+    uint32_t eta_s; /**< Estimated time to finish all pending jobs. */
+} MfClassicNonceSolverProgress;
+
+/**
+ * @brief Allocate solver and start its thread.
+ *
+ * Missing dictionaries are skipped. User dictionary is searched first.
+ *
+ * @param[in] system_dict_path path to system dictionary.
+ * @param[in] user_dict_path path to user dictionary.
+ * @return pointer to the allocated instance.
+ */
+MfClassicNonceSolver*
+    mf_classic_nonce_solver_alloc(const char* system_dict_path, const char* user_dict_path);
+
+/**
+ * @brief Stop solver thread and free the instance, pending jobs are dropped.
+ *
+ * @param[in] instance pointer to the instance to be freed.
+ */
+void mf_classic_nonce_solver_free(MfClassicNonceSolver* instance);
+
+/**
+ * @brief Queue a job.
+ *
+ * @param[in] instance pointer to the instance.
+ * @param[in] job pointer to the job, copied by the solver.
+ */
+void mf_classic_nonce_solver_submit(
+    MfClassicNonceSolver* instance,
+    const MfClassicNonceSolverJob* job);
+
+/**
+ * @brief Get next key candidate.
+ *
+ * @param[in] instance pointer to the instance.
+ * @param[out] result pointer to the result to be filled.
+ * @param[in] timeout time to wait for a candidate in milliseconds.
+ * @return true if result was filled, false otherwise.
+ */
+bool mf_classic_nonce_solver_get_result(
+    MfClassicNonceSolver* instance,
+    MfClassicNonceSolverResult* result,
+    uint32_t timeout);
+
+/**
+ * @brief Mark key as found, so that remaining search for it is skipped.
+ *
+ * @param[in] instance pointer to the instance.
+ * @param[in] sector sector number.
+ * @param[in] key_type key type.
+ */
+void mf_classic_nonce_solver_set_key_found(
+    MfClassicNonceSolver* instance,
+    uint8_t sector,
+    MfClassicKeyType key_type);
+
+/**
+ * @brief Check if there are pending jobs or unread results.
+ *
+ * @param[in] instance pointer to the instance.
+ * @return true if solver is busy, false otherwise.
+ */
+bool mf_classic_nonce_solver_is_busy(MfClassicNonceSolver* instance);
+
+/**
+ * @brief Get solver progress.
+ *
+ * @param[in] instance pointer to the instance.
+ * @param[out] progress pointer to the progress to be filled.
+ */
+void mf_classic_nonce_solver_get_progress(
+    MfClassicNonceSolver* instance,
+    MfClassicNonceSolverProgress* progress);
+
+#ifdef __cplusplus
+}
+#endif
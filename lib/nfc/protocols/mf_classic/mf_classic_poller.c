@@ -6,7 +6,7 @@
 
 #define TAG "MfClassicPoller"
 
-// TODO FL-3926: Buffer writes for Hardnested, set state to Log when finished and sum property matches
+// TODO FL-3926: Set state to Log when Hardnested is finished and sum property matches
 // TODO FL-3926: Store target key in CUID dictionary
 // TODO FL-3926: Dead code for malloc returning NULL?
 // TODO FL-3926: Auth1 static encrypted exists (rare)
@@ -49,6 +49,44 @@ MfClassicPoller* mf_classic_poller_alloc(Iso14443_3aPoller* iso14443_3a_poller)
     return instance;
 }
 
+// External solvers expect the text log, binary one is only kept if export fails
+static bool mf_classic_poller_nested_log_export(void) {
+    if(!mf_classic_nonce_log_export(
+           MF_CLASSIC_NESTED_LOGS_BIN_FILE_PATH, MF_CLASSIC_NESTED_LOGS_FILE_PATH)) {
+        FURI_LOG_E(TAG, "Failed to export nonce log");
+        return false;
+    }
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_remove(storage, MF_CLASSIC_NESTED_LOGS_BIN_FILE_PATH);
+    furi_record_close(RECORD_STORAGE);
+    return true;
+}
+
+static void mf_classic_poller_nested_log_start(MfClassicPoller* instance) {
+    // Binary log of an interrupted session is exported before the new session restarts it
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    bool leftover = storage_file_exists(storage, MF_CLASSIC_NESTED_LOGS_BIN_FILE_PATH);
+    furi_record_close(RECORD_STORAGE);
+    if(leftover && mf_classic_poller_nested_log_export()) {
+        FURI_LOG_W(TAG, "Recovered nonce log of a previous session");
+    }
+
+    instance->nonce_log = mf_classic_nonce_log_alloc(MF_CLASSIC_NESTED_LOGS_BIN_FILE_PATH);
+}
+
+static void mf_classic_poller_nested_log_finish(MfClassicPoller* instance) {
+    if(!instance->nonce_log) return;
+
+    size_t record_count = mf_classic_nonce_log_get_count(instance->nonce_log);
+    mf_classic_nonce_log_free(instance->nonce_log);
+    instance->nonce_log = NULL;
+
+    if(mf_classic_poller_nested_log_export()) {
+        FURI_LOG_I(TAG, "Logged %zu nonce records", record_count);
+    }
+}
+
 void mf_classic_poller_free(MfClassicPoller* instance) {
     furi_assert(instance);
     furi_assert(instance->data);
@@ -68,15 +106,11 @@ void mf_classic_poller_free(MfClassicPoller* instance) {
     // Clean up resources in MfClassicPollerDictAttackContext
     MfClassicPollerDictAttackContext* dict_attack_ctx = &instance->mode_ctx.dict_attack_ctx;
 
-    // Free the dictionaries
-    if(dict_attack_ctx->mf_classic_system_dict) {
-        keys_dict_free(dict_attack_ctx->mf_classic_system_dict);
-        dict_attack_ctx->mf_classic_system_dict = NULL;
-    }
-    if(dict_attack_ctx->mf_classic_user_dict) {
-        keys_dict_free(dict_attack_ctx->mf_classic_user_dict);
-        dict_attack_ctx->mf_classic_user_dict = NULL;
+    if(instance->nonce_solver) {
+        mf_classic_nonce_solver_free(instance->nonce_solver);
+        instance->nonce_solver = NULL;
     }
+    mf_classic_poller_nested_log_finish(instance);
 
     // Free the nested nonce array if it exists
     if(dict_attack_ctx->nested_nonce.nonces) {
@@ -99,6 +133,15 @@ static NfcCommand mf_classic_poller_handle_data_update(MfClassicPoller* instance
     data_update->backdoor = instance->mode_ctx.dict_attack_ctx.backdoor;
     data_update->nested_target_key = instance->mode_ctx.dict_attack_ctx.nested_target_key;
     data_update->msb_count = instance->mode_ctx.dict_attack_ctx.msb_count;
+    if(instance->nonce_solver) {
+        MfClassicNonceSolverProgress progress = {};
+        mf_classic_nonce_solver_get_progress(instance->nonce_solver, &progress);
+        data_update->nonce_jobs_pending = progress.jobs_pending;
+        data_update->nonce_search_eta_s = progress.eta_s;
+    } else {
+        data_update->nonce_jobs_pending = 0;
+        data_update->nonce_search_eta_s = 0;
+    }
     instance->mfc_event.type = MfClassicPollerEventTypeDataUpdate;
     return instance->callback(instance->general_event, instance->context);
 }
@@ -159,6 +202,11 @@ NfcCommand mf_classic_poller_handler_start(MfClassicPoller* instance) {
 
     instance->sectors_total = mf_classic_get_total_sectors_num(instance->data->type);
     memset(&instance->mode_ctx, 0, sizeof(MfClassicPollerModeContext));
+    if(instance->nonce_solver) {
+        mf_classic_nonce_solver_free(instance->nonce_solver);
+        instance->nonce_solver = NULL;
+    }
+    mf_classic_poller_nested_log_finish(instance);
 
     instance->mfc_event.type = MfClassicPollerEventTypeRequestMode;
     command = instance->callback(instance->general_event, instance->context);
@@ -1510,54 +1558,66 @@ NfcCommand mf_classic_poller_handler_nested_collect_nt_enc(MfClassicPoller* inst
     return command;
 }
 
-static MfClassicKey* search_dicts_for_nonce_key(
-    MfClassicPollerDictAttackContext* dict_attack_ctx,
-    MfClassicNestedNonceArray* nonce_array,
-    KeysDict* system_dict,
-    KeysDict* user_dict,
+static void mf_classic_poller_nested_submit_nonces(
+    MfClassicPoller* instance,
+    uint8_t sector,
+    MfClassicKeyType key_type,
     bool is_weak) {
-    MfClassicKey stack_key;
-    KeysDict* dicts[] = {user_dict, system_dict};
-    bool is_resumed = dict_attack_ctx->nested_phase == MfClassicNestedPhaseDictAttackResume;
-    bool found_resume_point = false;
-
-    for(int i = 0; i < 2; i++) {
-        if(!dicts[i]) continue;
-        keys_dict_rewind(dicts[i]);
-        while(keys_dict_get_next_key(dicts[i], stack_key.data, sizeof(MfClassicKey))) {
-            if(is_resumed && !found_resume_point) {
-                found_resume_point =
-                    (memcmp(
-                         dict_attack_ctx->current_key.data,
-                         stack_key.data,
-                         sizeof(MfClassicKey)) == 0);
-                continue;
-            }
-            bool full_match = true;
-            for(uint8_t j = 0; j < nonce_array->count; j++) {
-                // Verify nonce matches encrypted parity bits for all nonces
-                uint32_t nt_enc_plain = crypto1_decrypt_nt_enc(
-                    nonce_array->nonces[j].cuid, nonce_array->nonces[j].nt_enc, stack_key);
-                if(is_weak) {
-                    full_match &= crypto1_is_weak_prng_nonce(nt_enc_plain);
-                    if(!full_match) break;
-                }
-                full_match &= crypto1_nonce_matches_encrypted_parity_bits(
-                    nt_enc_plain,
-                    nt_enc_plain ^ nonce_array->nonces[j].nt_enc,
-                    nonce_array->nonces[j].par);
-                if(!full_match) break;
-            }
-            if(full_match) {
-                MfClassicKey* new_candidate = malloc(sizeof(MfClassicKey));
-                if(new_candidate == NULL) return NULL; // malloc failed
-                memcpy(new_candidate, &stack_key, sizeof(MfClassicKey));
-                return new_candidate;
+    MfClassicPollerDictAttackContext* dict_attack_ctx = &instance->mode_ctx.dict_attack_ctx;
+    MfClassicNestedNonceArray* nonce_array = &dict_attack_ctx->nested_nonce;
+    furi_assert(nonce_array->count <= MF_CLASSIC_NONCE_SOLVER_NONCES_MAX);
+
+    MfClassicNonceSolverJob job = {
+        .sector = sector,
+        .key_type = key_type,
+        .is_weak = is_weak,
+        .nonce_count = nonce_array->count,
+    };
+    for(size_t i = 0; i < nonce_array->count; i++) {
+        job.nonces[i].cuid = nonce_array->nonces[i].cuid;
+        job.nonces[i].nt_enc = nonce_array->nonces[i].nt_enc;
+        job.nonces[i].par = nonce_array->nonces[i].par;
+    }
+    mf_classic_nonce_solver_submit(instance->nonce_solver, &job);
+
+    // Nonces for the next key are collected while solver searches for this one
+    free(nonce_array->nonces);
+    nonce_array->nonces = NULL;
+    nonce_array->count = 0;
+}
+
+static bool
+    mf_classic_poller_nested_get_key_candidate(MfClassicPoller* instance, uint32_t timeout) {
+    MfClassicPollerDictAttackContext* dict_attack_ctx = &instance->mode_ctx.dict_attack_ctx;
+    MfClassicNonceSolverResult result = {};
+    bool candidate_found = false;
+
+    while(mf_classic_nonce_solver_get_result(instance->nonce_solver, &result, timeout)) {
+        // Skip candidates for keys found while they were waiting in queue
+        if(mf_classic_is_key_found(instance->data, result.sector, result.key_type)) continue;
+
+        FURI_LOG_I(
+            TAG,
+            "Found key candidate %06llx",
+            bit_lib_bytes_to_num_be(result.key.data, sizeof(MfClassicKey)));
+        dict_attack_ctx->current_key = result.key;
+        dict_attack_ctx->reuse_key_sector = result.sector;
+        dict_attack_ctx->current_key_type = result.key_type;
+        candidate_found = true;
+        break;
+    }
+
+    return candidate_found;
+}
+
+static void mf_classic_poller_nested_update_found_keys(MfClassicPoller* instance) {
+    for(uint8_t sector = 0; sector < instance->sectors_total; sector++) {
+        for(uint8_t key_type = 0; key_type < 2; key_type++) {
+            if(mf_classic_is_key_found(instance->data, sector, key_type)) {
+                mf_classic_nonce_solver_set_key_found(instance->nonce_solver, sector, key_type);
             }
         }
     }
-
-    return NULL;
 }
 
 NfcCommand mf_classic_poller_handler_nested_dict_attack(MfClassicPoller* instance) {
@@ -1645,31 +1705,11 @@ NfcCommand mf_classic_poller_handler_nested_dict_attack(MfClassicPoller* instanc
 
             dict_attack_ctx->auth_passed = true;
         }
-        // If we have sufficient nonces, search the dictionaries for the key
+        // If we have sufficient nonces, search the dictionaries for the key in background
         if((is_weak && (dict_attack_ctx->nested_nonce.count == 1)) ||
            (is_last_iter_for_hard_key && (dict_attack_ctx->nested_nonce.count == 8))) {
-            // Identify key candidates
-            MfClassicKey* key_candidate = search_dicts_for_nonce_key(
-                dict_attack_ctx,
-                &dict_attack_ctx->nested_nonce,
-                dict_attack_ctx->mf_classic_system_dict,
-                dict_attack_ctx->mf_classic_user_dict,
-                is_weak);
-            if(key_candidate != NULL) {
-                FURI_LOG_I(
-                    TAG,
-                    "Found key candidate %06llx",
-                    bit_lib_bytes_to_num_be(key_candidate->data, sizeof(MfClassicKey)));
-                dict_attack_ctx->current_key = *key_candidate;
-                dict_attack_ctx->reuse_key_sector = target_sector;
-                dict_attack_ctx->current_key_type = target_key_type;
-                free(key_candidate);
-                break;
-            } else {
-                free(dict_attack_ctx->nested_nonce.nonces);
-                dict_attack_ctx->nested_nonce.nonces = NULL;
-                dict_attack_ctx->nested_nonce.count = 0;
-            }
+            mf_classic_poller_nested_submit_nonces(
+                instance, target_sector, target_key_type, is_weak);
         }
 
         FURI_LOG_D(
@@ -1694,9 +1734,6 @@ NfcCommand mf_classic_poller_handler_nested_log(MfClassicPoller* instance) {
     NfcCommand command = NfcCommandContinue;
     bool params_saved = false;
     MfClassicPollerDictAttackContext* dict_attack_ctx = &instance->mode_ctx.dict_attack_ctx;
-    Storage* storage = furi_record_open(RECORD_STORAGE);
-    Stream* stream = buffered_file_stream_alloc(storage);
-    FuriString* temp_str = furi_string_alloc();
     bool weak_prng = dict_attack_ctx->prng_type == MfClassicPrngTypeWeak;
     bool static_encrypted = dict_attack_ctx->static_encrypted;
 
@@ -1713,9 +1750,9 @@ NfcCommand mf_classic_poller_handler_nested_log(MfClassicPoller* instance) {
                                         1 :
                                         dict_attack_ctx->nested_nonce.count;
 
-        if(!buffered_file_stream_open(
-               stream, MF_CLASSIC_NESTED_LOGS_FILE_PATH, FSAM_WRITE, FSOM_OPEN_APPEND))
-            break;
+        if(!instance->nonce_log) {
+            mf_classic_poller_nested_log_start(instance);
+        }
 
         bool params_write_success = true;
         for(size_t i = 0; i < nonce_pair_count; i++) {
@@ -1725,35 +1762,26 @@ NfcCommand mf_classic_poller_handler_nested_log(MfClassicPoller* instance) {
             MfClassicKeyType nonce_key_type =
                 (nonce->key_idx % (weak_prng ? 4 : 2) < (weak_prng ? 2 : 1)) ? MfClassicKeyTypeA :
                                                                                MfClassicKeyTypeB;
-            furi_string_printf(
-                temp_str,
-                "Sec %d key %c cuid %08lx",
-                nonce_sector,
-                (nonce_key_type == MfClassicKeyTypeA) ? 'A' : 'B',
-                nonce->cuid);
-            for(uint8_t nt_idx = 0; nt_idx < ((weak_prng && (!(static_encrypted))) ? 2 : 1);
-                nt_idx++) {
+            MfClassicNonceLogRecord record = {
+                .cuid = nonce->cuid,
+                .sector = nonce_sector,
+                .flags = (nonce_key_type == MfClassicKeyTypeB) ? MfClassicNonceLogFlagKeyB : 0,
+            };
+            size_t nt_count = (weak_prng && (!(static_encrypted))) ? 2 : 1;
+            if(nt_count == 2) record.flags |= MfClassicNonceLogFlagPair;
+            for(uint8_t nt_idx = 0; nt_idx < nt_count; nt_idx++) {
                 if(nt_idx == 1) {
                     nonce = &dict_attack_ctx->nested_nonce.nonces[i + 1];
                 }
-                furi_string_cat_printf(
-                    temp_str,
-                    " nt%u %08lx ks%u %08lx par%u ",
-                    nt_idx,
-                    nonce->nt,
-                    nt_idx,
-                    nonce->nt_enc ^ nonce->nt,
-                    nt_idx);
-                for(uint8_t pb = 0; pb < 4; pb++) {
-                    furi_string_cat_printf(temp_str, "%u", (nonce->par >> (3 - pb)) & 1);
-                }
+                record.nonces[nt_idx].nt = nonce->nt;
+                record.nonces[nt_idx].ks = nonce->nt_enc ^ nonce->nt;
+                record.nonces[nt_idx].par = nonce->par;
             }
-            if(dict_attack_ctx->prng_type == MfClassicPrngTypeWeak) {
-                furi_string_cat_printf(temp_str, " dist %u\n", nonce->dist);
-            } else {
-                furi_string_cat_printf(temp_str, "\n");
+            if(weak_prng) {
+                record.flags |= MfClassicNonceLogFlagDist;
+                record.dist = nonce->dist;
             }
-            if(!stream_write_string(stream, temp_str)) {
+            if(!mf_classic_nonce_log_add(instance->nonce_log, &record)) {
                 params_write_success = false;
                 break;
             }
@@ -1767,10 +1795,6 @@ NfcCommand mf_classic_poller_handler_nested_log(MfClassicPoller* instance) {
     free(dict_attack_ctx->nested_nonce.nonces);
     dict_attack_ctx->nested_nonce.nonces = NULL;
     dict_attack_ctx->nested_nonce.count = 0;
-    furi_string_free(temp_str);
-    buffered_file_stream_close(stream);
-    stream_free(stream);
-    furi_record_close(RECORD_STORAGE);
     instance->state = MfClassicPollerStateNestedController;
     return command;
 }
@@ -1879,74 +1903,55 @@ NfcCommand mf_classic_poller_handler_nested_controller(MfClassicPoller* instance
     uint16_t dict_target_key_max = (dict_attack_ctx->prng_type == MfClassicPrngTypeWeak) ?
                                        (instance->sectors_total * 2) :
                                        (instance->sectors_total * 16);
+    bool candidate_verified = false;
     if(dict_attack_ctx->nested_phase == MfClassicNestedPhaseDictAttackVerify) {
-        if(!(mf_classic_nested_is_target_key_found(instance, true)) &&
-           (dict_attack_ctx->nested_nonce.count > 0)) {
-            dict_attack_ctx->nested_phase = MfClassicNestedPhaseDictAttackResume;
-            instance->state = MfClassicPollerStateNestedDictAttack;
-            return command;
-        } else {
-            dict_attack_ctx->auth_passed = true;
-            if(dict_attack_ctx->nested_nonce.count > 0) {
-                // Free nonce array
-                furi_assert(dict_attack_ctx->nested_nonce.nonces);
-                free(dict_attack_ctx->nested_nonce.nonces);
-                dict_attack_ctx->nested_nonce.nonces = NULL;
-                dict_attack_ctx->nested_nonce.count = 0;
-            }
-            dict_attack_ctx->nested_phase = MfClassicNestedPhaseDictAttack;
+        // Key reuse is over, let solver skip keys it has found
+        mf_classic_poller_nested_update_found_keys(instance);
+        if((dict_attack_ctx->nested_nonce.count > 0) &&
+           mf_classic_nested_is_target_key_found(instance, true)) {
+            // Partially collected nonces are useless now
+            free(dict_attack_ctx->nested_nonce.nonces);
+            dict_attack_ctx->nested_nonce.nonces = NULL;
+            dict_attack_ctx->nested_nonce.count = 0;
         }
+        dict_attack_ctx->nested_phase = MfClassicNestedPhaseDictAttack;
+        dict_attack_ctx->auth_passed = true;
+        candidate_verified = true;
     }
-    if((dict_attack_ctx->nested_phase == MfClassicNestedPhaseDictAttack ||
-        dict_attack_ctx->nested_phase == MfClassicNestedPhaseDictAttackResume) &&
-       (dict_attack_ctx->nested_target_key < dict_target_key_max)) {
-        bool is_last_iter_for_hard_key =
-            ((!is_weak) && ((dict_attack_ctx->nested_target_key % 8) == 7));
+    if(dict_attack_ctx->nested_phase == MfClassicNestedPhaseDictAttack) {
         if(initial_dict_attack_iter) {
-            // Initialize dictionaries
             // Note: System dict should always exist
-            dict_attack_ctx->mf_classic_system_dict =
-                keys_dict_check_presence(MF_CLASSIC_NESTED_SYSTEM_DICT_PATH) ?
-                    keys_dict_alloc(
-                        MF_CLASSIC_NESTED_SYSTEM_DICT_PATH,
-                        KeysDictModeOpenExisting,
-                        sizeof(MfClassicKey)) :
-                    NULL;
-
-            dict_attack_ctx->mf_classic_user_dict =
-                keys_dict_check_presence(MF_CLASSIC_NESTED_USER_DICT_PATH) ?
-                    keys_dict_alloc(
-                        MF_CLASSIC_NESTED_USER_DICT_PATH,
-                        KeysDictModeOpenExisting,
-                        sizeof(MfClassicKey)) :
-                    NULL;
-        }
-        if((is_weak || is_last_iter_for_hard_key) && dict_attack_ctx->nested_nonce.count > 0) {
+            instance->nonce_solver = mf_classic_nonce_solver_alloc(
+                MF_CLASSIC_NESTED_SYSTEM_DICT_PATH, MF_CLASSIC_NESTED_USER_DICT_PATH);
+        }
+        if(dict_attack_ctx->nested_target_key < dict_target_key_max) {
+            // Verification of a candidate interrupts collection, target is not done yet
+            if(!(dict_attack_ctx->auth_passed)) {
+                dict_attack_ctx->attempt_count++;
+            } else if(!(initial_dict_attack_iter) && !(candidate_verified)) {
+                dict_attack_ctx->nested_target_key++;
+                dict_attack_ctx->attempt_count = 0;
+            }
+            dict_attack_ctx->auth_passed = true;
+        }
+        // Once all nonces are collected, wait for the solver with the card in the field
+        uint32_t timeout = (dict_attack_ctx->nested_target_key == dict_target_key_max) ?
+                               MF_CLASSIC_NESTED_SOLVER_WAIT_MS :
+                               0;
+        if(mf_classic_poller_nested_get_key_candidate(instance, timeout)) {
             // Key verify and reuse
             dict_attack_ctx->nested_phase = MfClassicNestedPhaseDictAttackVerify;
             dict_attack_ctx->auth_passed = false;
             instance->state = MfClassicPollerStateKeyReuseStartNoOffset;
             return command;
-        } else if(dict_attack_ctx->nested_phase == MfClassicNestedPhaseDictAttackResume) {
-            dict_attack_ctx->nested_phase = MfClassicNestedPhaseDictAttack;
-            dict_attack_ctx->auth_passed = true;
-        }
-        if(!(dict_attack_ctx->auth_passed)) {
-            dict_attack_ctx->attempt_count++;
-        } else if(!(initial_dict_attack_iter)) {
-            dict_attack_ctx->nested_target_key++;
-            dict_attack_ctx->attempt_count = 0;
         }
-        dict_attack_ctx->auth_passed = true;
         if(dict_attack_ctx->nested_target_key == dict_target_key_max) {
-            if(dict_attack_ctx->mf_classic_system_dict) {
-                keys_dict_free(dict_attack_ctx->mf_classic_system_dict);
-                dict_attack_ctx->mf_classic_system_dict = NULL;
-            }
-            if(dict_attack_ctx->mf_classic_user_dict) {
-                keys_dict_free(dict_attack_ctx->mf_classic_user_dict);
-                dict_attack_ctx->mf_classic_user_dict = NULL;
+            if(mf_classic_nonce_solver_is_busy(instance->nonce_solver)) {
+                instance->state = MfClassicPollerStateNestedController;
+                return command;
             }
+            mf_classic_nonce_solver_free(instance->nonce_solver);
+            instance->nonce_solver = NULL;
             dict_attack_ctx->nested_target_key = 0;
             if(mf_classic_is_card_read(instance->data)) {
                 // All keys have been collected
@@ -2120,6 +2125,7 @@ NfcCommand mf_classic_poller_handler_nested_controller(MfClassicPoller* instance
             return command;
         }
     }
+    mf_classic_poller_nested_log_finish(instance);
     dict_attack_ctx->nested_target_key = 0;
     dict_attack_ctx->nested_phase = MfClassicNestedPhaseFinished;
     instance->state = MfClassicPollerStateSuccess;
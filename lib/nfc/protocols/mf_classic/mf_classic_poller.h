@@ -56,7 +56,6 @@ typedef enum {
     MfClassicNestedPhaseAnalyzePRNG, /**< Analyze nonces produced by the PRNG to determine if they fit a weak PRNG */
     MfClassicNestedPhaseDictAttack, /**< Search keys which match the expected PRNG properties and parity for collected nonces */
     MfClassicNestedPhaseDictAttackVerify, /**< Verify candidate keys by authenticating to the sector with the key */
-    MfClassicNestedPhaseDictAttackResume, /**< Resume nested dictionary attack from the last tested (invalid) key */
     MfClassicNestedPhaseCalibrate, /**< Perform necessary calculations to recover the plaintext nonce during later collection phase (weak PRNG tags only) */
     MfClassicNestedPhaseRecalibrate, /**< Collect the next plaintext static encrypted nonce for backdoor static encrypted nonce nested attack */
     MfClassicNestedPhaseCollectNtEnc, /**< Log nonces collected during nested authentication for key recovery */
@@ -120,6 +119,8 @@ typedef struct {
     uint16_t nested_target_key; /**< Target key for nested attack. */
     uint16_t
         msb_count; /**< Number of unique most significant bytes seen during Hardnested attack. */
+    uint16_t nonce_jobs_pending; /**< Nonce sets waiting for background key search. */
+    uint32_t nonce_search_eta_s; /**< Estimated time left for background key search. */
 } MfClassicPollerEventDataUpdate;
 
 /**
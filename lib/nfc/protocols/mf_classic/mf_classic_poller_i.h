@@ -1,6 +1,8 @@
 #pragma once
 
 #include "mf_classic_poller.h"
+#include "mf_classic_nonce_solver.h"
+#include "mf_classic_nonce_log.h"
 #include <lib/nfc/protocols/iso14443_3a/iso14443_3a_poller_i.h>
 #include <bit_lib/bit_lib.h>
 #include <nfc/helpers/iso14443_crc.h>
@@ -22,10 +24,14 @@ extern "C" {
 #define MF_CLASSIC_NESTED_RETRY_MAXIMUM         (60)
 #define MF_CLASSIC_NESTED_HARD_RETRY_MAXIMUM    (3)
 #define MF_CLASSIC_NESTED_CALIBRATION_COUNT     (21)
+#define MF_CLASSIC_NESTED_SOLVER_WAIT_MS        (100)
 #define MF_CLASSIC_NESTED_LOGS_FILE_NAME        ".nested.log"
+#define MF_CLASSIC_NESTED_LOGS_BIN_FILE_NAME    ".nested.bin"
 #define MF_CLASSIC_NESTED_SYSTEM_DICT_FILE_NAME "mf_classic_dict_nested.nfc"
 #define MF_CLASSIC_NESTED_USER_DICT_FILE_NAME   "mf_classic_dict_user_nested.nfc"
 #define MF_CLASSIC_NESTED_LOGS_FILE_PATH        (NFC_FOLDER "/" MF_CLASSIC_NESTED_LOGS_FILE_NAME)
+#define MF_CLASSIC_NESTED_LOGS_BIN_FILE_PATH \
+    (NFC_FOLDER "/" MF_CLASSIC_NESTED_LOGS_BIN_FILE_NAME)
 #define MF_CLASSIC_NESTED_SYSTEM_DICT_PATH \
     (NFC_ASSETS_FOLDER "/" MF_CLASSIC_NESTED_SYSTEM_DICT_FILE_NAME)
 #define MF_CLASSIC_NESTED_USER_DICT_PATH \
@@ -148,8 +154,6 @@ typedef struct {
     uint16_t d_min;
     uint16_t d_max;
     uint8_t attempt_count;
-    KeysDict* mf_classic_system_dict;
-    KeysDict* mf_classic_user_dict;
     // Hardnested
     uint8_t nt_enc_msb
         [32]; // Bit-packed array to track which unique most significant bytes have been seen (256 bits = 32 bytes)
@@ -182,6 +186,10 @@ struct MfClassicPoller {
     MfClassicType current_type_check;
     uint8_t sectors_total;
     MfClassicPollerModeContext mode_ctx;
+    // Searches keys for nested nonces in background, outlives mode context
+    MfClassicNonceSolver* nonce_solver;
+    // Buffers collected nonces, exported to text log when collection ends
+    MfClassicNonceLog* nonce_log;
 
     Crypto1* crypto;
     BitBuffer* tx_plain_buffer;
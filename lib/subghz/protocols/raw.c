@@ -10,7 +10,7 @@
 
 #define TAG "SubGhzProtocolRaw"
 
-#define SUBGHZ_DOWNLOAD_MAX_SIZE 512
+#define SUBGHZ_DOWNLOAD_MAX_SIZE SUBGHZ_RAW_CODEC_BLOCK_SAMPLES
 
 static const SubGhzBlockConst subghz_protocol_raw_const = {
     .te_short = 50,
@@ -26,6 +26,8 @@ struct SubGhzProtocolDecoderRAW {
     uint16_t ind_write;
     Storage* storage;
     FlipperFormat* flipper_file;
+    SubGhzRawWriter* raw_writer;
+    SubGhzRawEncoding record_encoding;
     uint32_t file_is_open;
     FuriString* file_name;
     size_t sample_write;
@@ -157,6 +159,8 @@ bool subghz_protocol_raw_save_to_file_init(
         }
 
         instance->upload_raw = malloc(SUBGHZ_DOWNLOAD_MAX_SIZE * sizeof(int32_t));
+        instance->raw_writer = subghz_raw_writer_alloc(
+            flipper_format_get_raw_stream(instance->flipper_file), instance->record_encoding);
         instance->file_is_open = RAWFileIsOpenWrite;
         instance->sample_write = 0;
         instance->last_level = false;
@@ -174,9 +178,9 @@ static bool subghz_protocol_raw_save_to_file_write(SubGhzProtocolDecoderRAW* ins
 
     bool is_write = false;
     if(instance->file_is_open == RAWFileIsOpenWrite) {
-        if(!flipper_format_write_int32(
-               instance->flipper_file, "RAW_Data", instance->upload_raw, instance->ind_write)) {
-            FURI_LOG_E(TAG, "Unable to add RAW_Data");
+        if(!subghz_raw_writer_write(
+               instance->raw_writer, instance->upload_raw, instance->ind_write)) {
+            FURI_LOG_E(TAG, "Unable to add RAW data");
         } else {
             instance->sample_write += instance->ind_write;
             instance->ind_write = 0;
@@ -194,6 +198,10 @@ void subghz_protocol_raw_save_to_file_stop(SubGhzProtocolDecoderRAW* instance) {
     if(instance->file_is_open != RAWFileIsOpenClose) {
         free(instance->upload_raw);
         instance->upload_raw = NULL;
+        if(instance->raw_writer) {
+            subghz_raw_writer_free(instance->raw_writer);
+            instance->raw_writer = NULL;
+        }
         flipper_format_file_close(instance->flipper_file);
         flipper_format_free(instance->flipper_file);
         furi_record_close(RECORD_STORAGE);
@@ -215,6 +223,13 @@ size_t subghz_protocol_raw_get_sample_write(SubGhzProtocolDecoderRAW* instance)
     return instance->sample_write + instance->ind_write;
 }
 
+void subghz_protocol_raw_set_record_encoding(
+    SubGhzProtocolDecoderRAW* instance,
+    SubGhzRawEncoding encoding) {
+    furi_check(instance);
+    instance->record_encoding = encoding;
+}
+
 void* subghz_protocol_decoder_raw_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     SubGhzProtocolDecoderRAW* instance = malloc(sizeof(SubGhzProtocolDecoderRAW));
@@ -222,6 +237,7 @@ void* subghz_protocol_decoder_raw_alloc(SubGhzEnvironment* environment) {
     instance->upload_raw = NULL;
     instance->ind_write = 0;
     instance->last_level = false;
+    instance->record_encoding = SubGhzRawEncodingText;
     instance->file_is_open = RAWFileIsOpenClose;
     instance->file_name = furi_string_alloc();
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "base.h"
+#include "../subghz_raw_codec.h"
 
 #define SUBGHZ_PROTOCOL_RAW_NAME "RAW"
 
@@ -42,6 +43,15 @@ void subghz_protocol_raw_save_to_file_stop(SubGhzProtocolDecoderRAW* instance);
  */
 size_t subghz_protocol_raw_get_sample_write(SubGhzProtocolDecoderRAW* instance);
 
+/**
+ * Set samples encoding for the next recording, text by default.
+ * @param instance Pointer to a SubGhzProtocolDecoderRAW instance
+ * @param encoding Samples encoding
+ */
+void subghz_protocol_raw_set_record_encoding(
+    SubGhzProtocolDecoderRAW* instance,
+    SubGhzRawEncoding encoding);
+
 /**
  * Allocate SubGhzProtocolDecoderRAW.
  * @param environment Pointer to a SubGhzEnvironment instance
@@ -1,14 +1,14 @@
 #include "subghz_file_encoder_worker.h"
+#include "subghz_raw_codec.h"
 
 #include <toolbox/stream/stream.h>
 #include <flipper_format/flipper_format.h>
 #include <flipper_format/flipper_format_i.h>
 #include <lib/subghz/devices/devices.h>
-#include <lib/toolbox/strint.h>
 
 #define TAG "SubGhzFileEncoderWorker"
 
-#define SUBGHZ_FILE_ENCODER_LOAD 512
+#define SUBGHZ_FILE_ENCODER_LOAD SUBGHZ_RAW_CODEC_BLOCK_SAMPLES
 
 struct SubGhzFileEncoderWorker {
     FuriThread* thread;
@@ -16,6 +16,7 @@ struct SubGhzFileEncoderWorker {
 
     Storage* storage;
     FlipperFormat* flipper_format;
+    int32_t* samples;
 
     volatile bool worker_running;
     volatile bool worker_stoping;
@@ -45,28 +46,13 @@ void subghz_file_encoder_worker_add_level_duration(
     if(sizeof(int32_t) != ret) FURI_LOG_E(TAG, "Invalid add duration in the stream");
 }
 
-bool subghz_file_encoder_worker_data_parse(SubGhzFileEncoderWorker* instance, const char* strStart) {
-    // Line sample: "RAW_Data: -1, 2, -2..."
-
-    // Look for the key in the line
-    char* str = strstr(strStart, "RAW_Data: ");
-    bool res = false;
-
-    if(str) {
-        // Skip key
-        str = strchr(str, ' ');
-
-        // Parse next element
-        int32_t duration;
-        while(strint_to_int32(str, &str, &duration, 10) == StrintParseNoError) {
-            subghz_file_encoder_worker_add_level_duration(instance, duration);
-            if(*str == ',') str++; // could also be `\0`
-        }
-
-        res = true;
-    }
-
-    return res;
+static void subghz_file_encoder_worker_add_level_durations(
+    SubGhzFileEncoderWorker* instance,
+    const int32_t* durations,
+    size_t count) {
+    size_t size = count * sizeof(int32_t);
+    size_t ret = furi_stream_buffer_send(instance->stream, durations, size, 100);
+    if(size != ret) FURI_LOG_E(TAG, "Invalid add duration in the stream");
 }
 
 LevelDuration subghz_file_encoder_worker_get_level_duration(void* context) {
@@ -103,8 +89,9 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
     bool res = false;
     instance->is_storage_slow = false;
     Stream* stream = flipper_format_get_raw_stream(instance->flipper_format);
+    SubGhzRawReader* reader = NULL;
     do {
-        if(!flipper_format_file_open_existing(
+        if(!flipper_format_buffered_file_open_existing(
                instance->flipper_format, furi_string_get_cstr(instance->file_path))) {
             FURI_LOG_E(
                 TAG,
@@ -119,6 +106,7 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
 
         //skip the end of the previous line "\n"
         stream_seek(stream, 1, StreamOffsetFromCurrent);
+        reader = subghz_raw_reader_alloc(stream);
         res = true;
         instance->worker_stoping = false;
         FURI_LOG_I(TAG, "Start transmission");
@@ -127,13 +115,10 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
     while(res && instance->worker_running) {
         size_t stream_free_byte = furi_stream_buffer_spaces_available(instance->stream);
         if((stream_free_byte / sizeof(int32_t)) >= SUBGHZ_FILE_ENCODER_LOAD) {
-            if(stream_read_line(stream, instance->str_data)) {
-                furi_string_trim(instance->str_data);
-                if(!subghz_file_encoder_worker_data_parse(
-                       instance, furi_string_get_cstr(instance->str_data))) {
-                    subghz_file_encoder_worker_add_level_duration(instance, LEVEL_DURATION_RESET);
-                    break;
-                }
+            size_t count =
+                subghz_raw_reader_read(reader, instance->samples, SUBGHZ_FILE_ENCODER_LOAD);
+            if(count) {
+                subghz_file_encoder_worker_add_level_durations(instance, instance->samples, count);
             } else {
                 subghz_file_encoder_worker_add_level_duration(instance, LEVEL_DURATION_RESET);
                 break;
@@ -142,6 +127,8 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
             furi_delay_ms(1);
         }
     }
+    if(reader) subghz_raw_reader_free(reader);
+
     //waiting for the end of the transfer
     if(instance->is_storage_slow) {
         FURI_LOG_E(TAG, "Storage is slow");
@@ -160,7 +147,7 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
         }
         furi_delay_ms(50);
     }
-    flipper_format_file_close(instance->flipper_format);
+    flipper_format_buffered_file_close(instance->flipper_format);
 
     FURI_LOG_I(TAG, "Worker stop");
     return 0;
@@ -174,7 +161,8 @@ SubGhzFileEncoderWorker* subghz_file_encoder_worker_alloc(void) {
     instance->stream = furi_stream_buffer_alloc(sizeof(int32_t) * 2048, sizeof(int32_t));
 
     instance->storage = furi_record_open(RECORD_STORAGE);
-    instance->flipper_format = flipper_format_file_alloc(instance->storage);
+    instance->flipper_format = flipper_format_buffered_file_alloc(instance->storage);
+    instance->samples = malloc(SUBGHZ_FILE_ENCODER_LOAD * sizeof(int32_t));
 
     instance->str_data = furi_string_alloc();
     instance->file_path = furi_string_alloc();
@@ -193,6 +181,7 @@ void subghz_file_encoder_worker_free(SubGhzFileEncoderWorker* instance) {
     furi_string_free(instance->file_path);
 
     flipper_format_free(instance->flipper_format);
+    free(instance->samples);
     furi_record_close(RECORD_STORAGE);
 
     free(instance);
@@ -0,0 +1,419 @@
+#include "subghz_raw_codec.h"
+
+#include <furi.h>
+#include <toolbox/varint.h>
+#include <toolbox/compress.h>
+#include <toolbox/strint.h>
+#include <toolbox/stream/buffered_file_stream.h>
+
+#define TAG "SubGhzRawCodec"
+
+#define SUBGHZ_RAW_CODEC_TEXT_KEY   "RAW_Data: "
+#define SUBGHZ_RAW_CODEC_BINARY_KEY "RAW_Binary: "
+
+#define SUBGHZ_RAW_CODEC_ENCODING_VARINT     "Varint"
+#define SUBGHZ_RAW_CODEC_ENCODING_HEATSHRINK "Heatshrink"
+
+// Worst case of zig-zag varint is 5 bytes per sample
+#define SUBGHZ_RAW_CODEC_PACKED_MAX (SUBGHZ_RAW_CODEC_BLOCK_SAMPLES * 5)
+// Heatshrink spends 9 bits on every literal byte, plus compression header
+#define SUBGHZ_RAW_CODEC_PAYLOAD_MAX \
+    (SUBGHZ_RAW_CODEC_PACKED_MAX + SUBGHZ_RAW_CODEC_PACKED_MAX / 8 + 1 + 4)
+
+typedef struct FURI_PACKED {
+    uint16_t payload_size;
+    uint16_t sample_count;
+} SubGhzRawBlockHeader;
+
+struct SubGhzRawWriter {
+    Stream* stream;
+    SubGhzRawEncoding encoding;
+    bool marker_written;
+
+    FuriString* line;
+    uint8_t* packed;
+    uint8_t* payload;
+    Compress* compress;
+};
+
+struct SubGhzRawReader {
+    Stream* stream;
+    SubGhzRawEncoding encoding;
+    bool finished;
+    bool error;
+
+    FuriString* line;
+    const char* cursor;
+    uint8_t* packed;
+    uint8_t* payload;
+    Compress* compress;
+};
+
+static const char* subghz_raw_codec_get_encoding_name(SubGhzRawEncoding encoding) {
+    return encoding == SubGhzRawEncodingHeatshrink ? SUBGHZ_RAW_CODEC_ENCODING_HEATSHRINK :
+                                                     SUBGHZ_RAW_CODEC_ENCODING_VARINT;
+}
+
+SubGhzRawWriter* subghz_raw_writer_alloc(Stream* stream, SubGhzRawEncoding encoding) {
+    furi_check(stream);
+
+    SubGhzRawWriter* instance = malloc(sizeof(SubGhzRawWriter));
+    instance->stream = stream;
+    instance->encoding = encoding;
+    instance->line = furi_string_alloc();
+
+    if(encoding != SubGhzRawEncodingText) {
+        instance->packed = malloc(SUBGHZ_RAW_CODEC_PACKED_MAX);
+    }
+    if(encoding == SubGhzRawEncodingHeatshrink) {
+        instance->payload = malloc(SUBGHZ_RAW_CODEC_PAYLOAD_MAX);
+        instance->compress =
+            compress_alloc(CompressTypeHeatshrink, &compress_config_heatshrink_default);
+    }
+
+    return instance;
+}
+
+void subghz_raw_writer_free(SubGhzRawWriter* instance) {
+    furi_check(instance);
+
+    if(instance->compress) compress_free(instance->compress);
+    free(instance->payload);
+    free(instance->packed);
+    furi_string_free(instance->line);
+    free(instance);
+}
+
+static bool subghz_raw_writer_write_text(
+    SubGhzRawWriter* instance,
+    const int32_t* samples,
+    size_t count) {
+    furi_string_set(instance->line, "RAW_Data:");
+    for(size_t i = 0; i < count; i++) {
+        furi_string_cat_printf(instance->line, " %ld", samples[i]);
+    }
+    furi_string_push_back(instance->line, '\n');
+
+    return stream_write_string(instance->stream, instance->line) ==
+           furi_string_size(instance->line);
+}
+
+static bool subghz_raw_writer_write_block(
+    SubGhzRawWriter* instance,
+    const int32_t* samples,
+    size_t count) {
+    if(!instance->marker_written) {
+        furi_string_printf(
+            instance->line,
+            "%s%s\n",
+            SUBGHZ_RAW_CODEC_BINARY_KEY,
+            subghz_raw_codec_get_encoding_name(instance->encoding));
+        if(stream_write_string(instance->stream, instance->line) !=
+           furi_string_size(instance->line)) {
+            return false;
+        }
+        instance->marker_written = true;
+    }
+
+    size_t packed_size = 0;
+    for(size_t i = 0; i < count; i++) {
+        packed_size += varint_int32_pack(samples[i], &instance->packed[packed_size]);
+    }
+
+    const uint8_t* payload = instance->packed;
+    size_t payload_size = packed_size;
+    if(instance->encoding == SubGhzRawEncodingHeatshrink) {
+        if(!compress_encode(
+               instance->compress,
+               instance->packed,
+               packed_size,
+               instance->payload,
+               SUBGHZ_RAW_CODEC_PAYLOAD_MAX,
+               &payload_size)) {
+            FURI_LOG_E(TAG, "Block compression failed");
+            return false;
+        }
+        payload = instance->payload;
+    }
+
+    SubGhzRawBlockHeader header = {
+        .payload_size = payload_size,
+        .sample_count = count,
+    };
+
+    return stream_write(instance->stream, (const uint8_t*)&header, sizeof(header)) ==
+               sizeof(header) &&
+           stream_write(instance->stream, payload, payload_size) == payload_size;
+}
+
+bool subghz_raw_writer_write(SubGhzRawWriter* instance, const int32_t* samples, size_t count) {
+    furi_check(instance);
+    furi_check(samples);
+    furi_check(count <= SUBGHZ_RAW_CODEC_BLOCK_SAMPLES);
+
+    if(!count) return true;
+
+    if(instance->encoding == SubGhzRawEncodingText) {
+        return subghz_raw_writer_write_text(instance, samples, count);
+    } else {
+        return subghz_raw_writer_write_block(instance, samples, count);
+    }
+}
+
+static void subghz_raw_reader_seek_text(SubGhzRawReader* instance) {
+    instance->cursor = strstr(furi_string_get_cstr(instance->line), SUBGHZ_RAW_CODEC_TEXT_KEY);
+    if(instance->cursor) {
+        instance->cursor += strlen(SUBGHZ_RAW_CODEC_TEXT_KEY);
+    } else {
+        instance->finished = true;
+    }
+}
+
+SubGhzRawReader* subghz_raw_reader_alloc(Stream* stream) {
+    furi_check(stream);
+
+    SubGhzRawReader* instance = malloc(sizeof(SubGhzRawReader));
+    instance->stream = stream;
+    instance->encoding = SubGhzRawEncodingText;
+    instance->line = furi_string_alloc();
+
+    if(!stream_read_line(stream, instance->line)) {
+        instance->finished = true;
+    } else if(furi_string_start_with_str(instance->line, SUBGHZ_RAW_CODEC_BINARY_KEY)) {
+        furi_string_right(instance->line, strlen(SUBGHZ_RAW_CODEC_BINARY_KEY));
+        furi_string_trim(instance->line);
+
+        if(furi_string_cmp_str(instance->line, SUBGHZ_RAW_CODEC_ENCODING_VARINT) == 0) {
+            instance->encoding = SubGhzRawEncodingVarint;
+        } else if(furi_string_cmp_str(instance->line, SUBGHZ_RAW_CODEC_ENCODING_HEATSHRINK) == 0) {
+            instance->encoding = SubGhzRawEncodingHeatshrink;
+            instance->payload = malloc(SUBGHZ_RAW_CODEC_PAYLOAD_MAX);
+            instance->compress =
+                compress_alloc(CompressTypeHeatshrink, &compress_config_heatshrink_default);
+        } else {
+            FURI_LOG_E(TAG, "Unknown encoding: %s", furi_string_get_cstr(instance->line));
+            instance->finished = true;
+            instance->error = true;
+        }
+        instance->packed = malloc(SUBGHZ_RAW_CODEC_PAYLOAD_MAX);
+    } else {
+        subghz_raw_reader_seek_text(instance);
+    }
+
+    return instance;
+}
+
+void subghz_raw_reader_free(SubGhzRawReader* instance) {
+    furi_check(instance);
+
+    if(instance->compress) compress_free(instance->compress);
+    free(instance->payload);
+    free(instance->packed);
+    furi_string_free(instance->line);
+    free(instance);
+}
+
+SubGhzRawEncoding subghz_raw_reader_get_encoding(SubGhzRawReader* instance) {
+    furi_check(instance);
+    return instance->encoding;
+}
+
+bool subghz_raw_reader_is_error(SubGhzRawReader* instance) {
+    furi_check(instance);
+    return instance->error;
+}
+
+static size_t
+    subghz_raw_reader_read_text(SubGhzRawReader* instance, int32_t* samples, size_t count) {
+    size_t read = 0;
+
+    while(read < count && !instance->finished) {
+        if(!instance->cursor) {
+            // Previous line is over, return it before taking the next one
+            if(read) break;
+            if(!stream_read_line(instance->stream, instance->line)) {
+                instance->finished = true;
+                break;
+            }
+            subghz_raw_reader_seek_text(instance);
+            continue;
+        }
+
+        char* end;
+        int32_t duration;
+        if(strint_to_int32(instance->cursor, &end, &duration, 10) == StrintParseNoError) {
+            samples[read++] = duration;
+            instance->cursor = (*end == ',') ? end + 1 : end;
+        } else {
+            instance->cursor = NULL;
+        }
+    }
+
+    return read;
+}
+
+static size_t
+    subghz_raw_reader_read_block(SubGhzRawReader* instance, int32_t* samples, size_t count) {
+    size_t read = 0;
+
+    do {
+        SubGhzRawBlockHeader header;
+        const size_t header_size =
+            stream_read(instance->stream, (uint8_t*)&header, sizeof(header));
+        if(header_size != sizeof(header)) {
+            // Data may only end between blocks
+            if(header_size) {
+                FURI_LOG_E(TAG, "Truncated block header");
+                instance->error = true;
+            }
+            break;
+        }
+        if(!header.sample_count || header.sample_count > count ||
+           header.payload_size > SUBGHZ_RAW_CODEC_PAYLOAD_MAX) {
+            FURI_LOG_E(TAG, "Invalid block: %u samples", header.sample_count);
+            instance->error = true;
+            break;
+        }
+
+        uint8_t* packed = instance->packed;
+        size_t packed_size = header.payload_size;
+        uint8_t* payload = instance->payload ? instance->payload : instance->packed;
+        if(stream_read(instance->stream, payload, header.payload_size) != header.payload_size) {
+            FURI_LOG_E(TAG, "Truncated block");
+            instance->error = true;
+            break;
+        }
+
+        if(instance->compress &&
+           !compress_decode(
+               instance->compress,
+               payload,
+               header.payload_size,
+               packed,
+               SUBGHZ_RAW_CODEC_PAYLOAD_MAX,
+               &packed_size)) {
+            FURI_LOG_E(TAG, "Block decompression failed");
+            instance->error = true;
+            break;
+        }
+
+        size_t offset = 0;
+        for(; read < header.sample_count && offset < packed_size; read++) {
+            offset += varint_int32_unpack(&samples[read], &packed[offset], packed_size - offset);
+        }
+        if(read != header.sample_count) {
+            FURI_LOG_E(TAG, "Malformed block");
+            instance->error = true;
+            read = 0;
+        }
+    } while(false);
+
+    if(!read) instance->finished = true;
+
+    return read;
+}
+
+size_t subghz_raw_reader_read(SubGhzRawReader* instance, int32_t* samples, size_t count) {
+    furi_check(instance);
+    furi_check(samples);
+    furi_check(count >= SUBGHZ_RAW_CODEC_BLOCK_SAMPLES);
+
+    if(instance->finished) return 0;
+
+    if(instance->encoding == SubGhzRawEncodingText) {
+        return subghz_raw_reader_read_text(instance, samples, count);
+    } else {
+        return subghz_raw_reader_read_block(instance, samples, count);
+    }
+}
+
+bool subghz_raw_convert(
+    Storage* storage,
+    const char* src_path,
+    const char* dst_path,
+    SubGhzRawEncoding encoding) {
+    furi_check(storage);
+    furi_check(src_path);
+    furi_check(dst_path);
+    furi_check(strcmp(src_path, dst_path) != 0);
+
+    Stream* src = buffered_file_stream_alloc(storage);
+    Stream* dst = buffered_file_stream_alloc(storage);
+    FuriString* line = furi_string_alloc();
+    bool dst_created = false;
+    bool success = false;
+
+    do {
+        if(!buffered_file_stream_open(src, src_path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+            FURI_LOG_E(TAG, "Unable to open %s", src_path);
+            break;
+        }
+        if(!buffered_file_stream_open(dst, dst_path, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+            FURI_LOG_E(TAG, "Unable to open %s", dst_path);
+            break;
+        }
+        dst_created = true;
+
+        // Header is copied as is, samples follow the Protocol line
+        bool header_copied = false;
+        bool header_error = false;
+        while(stream_read_line(src, line)) {
+            if(stream_write_string(dst, line) != furi_string_size(line)) {
+                header_error = true;
+                break;
+            }
+            if(furi_string_start_with_str(line, "Protocol: ")) {
+                furi_string_trim(line);
+                header_copied = furi_string_cmp_str(line, "Protocol: RAW") == 0;
+                break;
+            }
+        }
+        if(header_error || !header_copied) {
+            FURI_LOG_E(TAG, "Not a RAW file");
+            break;
+        }
+
+        uint32_t start_tick = furi_get_tick();
+        size_t total = 0;
+        int32_t* samples = malloc(SUBGHZ_RAW_CODEC_BLOCK_SAMPLES * sizeof(int32_t));
+        SubGhzRawReader* reader = subghz_raw_reader_alloc(src);
+        SubGhzRawWriter* writer = subghz_raw_writer_alloc(dst, encoding);
+
+        success = true;
+        size_t count;
+        while((count = subghz_raw_reader_read(reader, samples, SUBGHZ_RAW_CODEC_BLOCK_SAMPLES))) {
+            if(!subghz_raw_writer_write(writer, samples, count)) {
+                success = false;
+                break;
+            }
+            total += count;
+        }
+        // Shortened output would look like a valid recording
+        if(subghz_raw_reader_is_error(reader)) success = false;
+
+        subghz_raw_writer_free(writer);
+        subghz_raw_reader_free(reader);
+        free(samples);
+
+        FURI_LOG_I(
+            TAG,
+            "Converted %zu samples, %lu -> %lu bytes in %lums",
+            total,
+            (uint32_t)stream_size(src),
+            (uint32_t)stream_size(dst),
+            furi_get_tick() - start_tick);
+    } while(false);
+
+    furi_string_free(line);
+    buffered_file_stream_close(dst);
+    buffered_file_stream_close(src);
+    stream_free(dst);
+    stream_free(src);
+
+    if(!success && dst_created) {
+        FURI_LOG_E(TAG, "Conversion failed, removing %s", dst_path);
+        storage_simply_remove(storage, dst_path);
+    }
+
+    return success;
+}
@@ -0,0 +1,112 @@
+/**
+ * @file subghz_raw_codec.h
+ * SubGhz RAW samples reader and writer
+ *
+ * RAW file consists of regular FlipperFormat header followed by samples.
+ * Samples are stored either as text `RAW_Data: 1 -2 ...` lines or, after
+ * `RAW_Binary: <encoding>` marker line, as binary blocks up to the end of file.
+ *
+ * Binary block: uint16 payload size, uint16 sample count (both little endian),
+ * payload. Payload is a sequence of zig-zag varint durations, optionally
+ * compressed with heatshrink.
+ */
+#pragma once
+
+#include <toolbox/stream/stream.h>
+#include <storage/storage.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum samples in one line or block */
+#define SUBGHZ_RAW_CODEC_BLOCK_SAMPLES 512
+
+typedef enum {
+    SubGhzRawEncodingText, /**< `RAW_Data` text lines */
+    SubGhzRawEncodingVarint, /**< Binary blocks of varint durations */
+    SubGhzRawEncodingHeatshrink, /**< Binary blocks of compressed varint durations */
+} SubGhzRawEncoding;
+
+typedef struct SubGhzRawWriter SubGhzRawWriter;
+
+typedef struct SubGhzRawReader SubGhzRawReader;
+
+/** Allocate SubGhzRawWriter
+ *
+ * @param stream Stream positioned right after the file header
+ * @param encoding Samples encoding
+ * @return SubGhzRawWriter* pointer to a SubGhzRawWriter instance
+ */
+SubGhzRawWriter* subghz_raw_writer_alloc(Stream* stream, SubGhzRawEncoding encoding);
+
+/** Free SubGhzRawWriter
+ *
+ * @param instance Pointer to a SubGhzRawWriter instance
+ */
+void subghz_raw_writer_free(SubGhzRawWriter* instance);
+
+/** Write samples, one line or block per call
+ *
+ * @param instance Pointer to a SubGhzRawWriter instance
+ * @param samples Signed durations, positive for high level
+ * @param count Number of samples, up to SUBGHZ_RAW_CODEC_BLOCK_SAMPLES
+ * @return true on success
+ */
+bool subghz_raw_writer_write(SubGhzRawWriter* instance, const int32_t* samples, size_t count);
+
+/** Allocate SubGhzRawReader, detects encoding of samples
+ *
+ * @param stream Stream positioned at the beginning of the line following `Protocol`
+ * @return SubGhzRawReader* pointer to a SubGhzRawReader instance
+ */
+SubGhzRawReader* subghz_raw_reader_alloc(Stream* stream);
+
+/** Free SubGhzRawReader
+ *
+ * @param instance Pointer to a SubGhzRawReader instance
+ */
+void subghz_raw_reader_free(SubGhzRawReader* instance);
+
+/** Get encoding of samples
+ *
+ * @param instance Pointer to a SubGhzRawReader instance
+ * @return SubGhzRawEncoding
+ */
+SubGhzRawEncoding subghz_raw_reader_get_encoding(SubGhzRawReader* instance);
+
+/** Check if reading stopped on malformed or truncated data
+ *
+ * @param instance Pointer to a SubGhzRawReader instance
+ * @return true if samples did not end cleanly
+ */
+bool subghz_raw_reader_is_error(SubGhzRawReader* instance);
+
+/** Read next portion of samples
+ *
+ * @param instance Pointer to a SubGhzRawReader instance
+ * @param samples Output buffer
+ * @param count Output buffer size in samples, at least SUBGHZ_RAW_CODEC_BLOCK_SAMPLES
+ * @return number of samples read, 0 on end of data or error
+ */
+size_t subghz_raw_reader_read(SubGhzRawReader* instance, int32_t* samples, size_t count);
+
+/** Convert RAW file to another samples encoding
+ *
+ * Destination file is removed on failure, including malformed or truncated source samples.
+ *
+ * @param storage Storage instance
+ * @param src_path Source RAW file path
+ * @param dst_path Destination RAW file path, must differ from source
+ * @param encoding Destination encoding
+ * @return true on success
+ */
+bool subghz_raw_convert(
+    Storage* storage,
+    const char* src_path,
+    const char* dst_path,
+    SubGhzRawEncoding encoding);
+
+#ifdef __cplusplus
+}
+#endif
@@ -52,6 +52,7 @@ static int32_t subghz_worker_thread_callback(void* context) {
             instance->stream, &level_duration, sizeof(LevelDuration), 10);
         if(ret == sizeof(LevelDuration)) {
             if(level_duration_is_reset(level_duration)) {
+                FURI_TRACE_INSTANT("SubGhzWorkerOverrun");
                 FURI_LOG_E(TAG, "Overrun buffer");
                 if(instance->overrun_callback) instance->overrun_callback(instance->context);
             } else {
@@ -63,11 +64,13 @@ static int32_t subghz_worker_thread_callback(void* context) {
                     instance->filter_level_duration.duration += duration;
 
                 } else if(instance->filter_level_duration.level != level) {
+                    FURI_TRACE_BEGIN("SubGhzWorkerPair");
                     if(instance->pair_callback)
                         instance->pair_callback(
                             instance->context,
                             instance->filter_level_duration.level,
                             instance->filter_level_duration.duration);
+                    FURI_TRACE_END("SubGhzWorkerPair");
 
                     instance->filter_level_duration.duration = duration;
                     instance->filter_level_duration.level = level;
@@ -1,7 +1,8 @@
 #include "compress.h"
 
+#include "compress_hs_encoder.h"
+
 #include <furi.h>
-#include <lib/heatshrink/heatshrink_encoder.h>
 #include <lib/heatshrink/heatshrink_decoder.h>
 #include <stdint.h>
 
@@ -90,7 +91,8 @@ void compress_icon_decode(CompressIcon* instance, const uint8_t* icon_data, uint
 
 struct Compress {
     const void* config;
-    heatshrink_encoder* encoder;
+    size_t encoder_memory;
+    CompressHsEncoder* encoder;
     heatshrink_decoder* decoder;
 };
 
@@ -100,6 +102,7 @@ Compress* compress_alloc(CompressType type, const void* config) {
 
     Compress* compress = malloc(sizeof(Compress));
     compress->config = config;
+    compress->encoder_memory = 0;
     compress->encoder = NULL;
     compress->decoder = NULL;
 
@@ -110,7 +113,7 @@ void compress_free(Compress* compress) {
     furi_check(compress);
 
     if(compress->encoder) {
-        heatshrink_encoder_free(compress->encoder);
+        compress_hs_encoder_free(compress->encoder);
     }
     if(compress->decoder) {
         heatshrink_decoder_free(compress->decoder);
@@ -118,8 +121,18 @@ void compress_free(Compress* compress) {
     free(compress);
 }
 
+void compress_set_encoder_memory(Compress* compress, size_t memory) {
+    furi_check(compress);
+
+    compress->encoder_memory = memory;
+    if(compress->encoder) {
+        compress_hs_encoder_free(compress->encoder);
+        compress->encoder = NULL;
+    }
+}
+
 static bool compress_encode_internal(
-    heatshrink_encoder* encoder,
+    CompressHsEncoder* encoder,
     uint8_t* data_in,
     size_t data_in_size,
     uint8_t* data_out,
@@ -129,52 +142,16 @@ static bool compress_encode_internal(
     furi_check(data_in);
     furi_check(data_in_size);
 
-    size_t sink_size = 0;
-    size_t poll_size = 0;
-    HSE_sink_res sink_res;
-    HSE_poll_res poll_res;
-    HSE_finish_res finish_res;
-    bool encode_failed = false;
-    size_t sunk = 0;
-    size_t res_buff_size = sizeof(CompressHeader);
-
-    heatshrink_encoder_reset(encoder);
-    /* Sink data to encoding buffer */
-    while((sunk < data_in_size) && !encode_failed) {
-        sink_res =
-            heatshrink_encoder_sink(encoder, &data_in[sunk], data_in_size - sunk, &sink_size);
-        if(sink_res != HSER_SINK_OK) {
-            encode_failed = true;
-            break;
-        }
-        sunk += sink_size;
-        do {
-            poll_res = heatshrink_encoder_poll(
-                encoder, &data_out[res_buff_size], data_out_size - res_buff_size, &poll_size);
-            if(poll_res < 0) {
-                encode_failed = true;
-                break;
-            }
-            res_buff_size += poll_size;
-        } while(poll_res == HSER_POLL_MORE);
-    }
-
-    /* Notify sinking complete and poll encoded data */
-    finish_res = heatshrink_encoder_finish(encoder);
-    if(finish_res < 0) {
-        encode_failed = true;
-    } else {
-        do {
-            poll_res = heatshrink_encoder_poll(
-                encoder, &data_out[res_buff_size], data_out_size - res_buff_size, &poll_size);
-            if(poll_res < 0) {
-                encode_failed = true;
-                break;
-            }
-            res_buff_size += poll_size;
-            finish_res = heatshrink_encoder_finish(encoder);
-        } while(finish_res != HSER_FINISH_DONE);
-    }
+    size_t encoded_size = 0;
+    bool encode_failed = data_out_size <= sizeof(CompressHeader) ||
+                         !compress_hs_encoder_encode(
+                             encoder,
+                             data_in,
+                             data_in_size,
+                             &data_out[sizeof(CompressHeader)],
+                             data_out_size - sizeof(CompressHeader),
+                             &encoded_size);
+    size_t res_buff_size = sizeof(CompressHeader) + encoded_size;
 
     bool result = true;
     /* Write encoded data to output buffer if compression is efficient. Otherwise, write header and original data */
@@ -359,8 +336,9 @@ bool compress_encode(
     size_t* data_res_size) {
     if(!compress->encoder) {
         CompressConfigHeatshrink* hs_config = (CompressConfigHeatshrink*)compress->config;
-        compress->encoder =
-            heatshrink_encoder_alloc(hs_config->window_sz2, hs_config->lookahead_sz2);
+        compress->encoder = compress_hs_encoder_alloc(
+            hs_config->window_sz2, hs_config->lookahead_sz2, compress->encoder_memory);
+        furi_check(compress->encoder);
     }
     return compress_encode_internal(
         compress->encoder, data_in, data_in_size, data_out, data_out_size, data_res_size);
@@ -414,6 +392,11 @@ struct CompressStreamDecoder {
     uint8_t* decode_buffer;
     CompressIoCallback read_cb;
     void* read_context;
+    const CompressStreamCheckpoint* checkpoints;
+    size_t checkpoint_count;
+    size_t checkpoint_index; /* Block being decoded */
+    CompressSeekCallback seek_cb;
+    void* seek_context;
 };
 
 CompressStreamDecoder* compress_stream_decoder_alloc(
@@ -434,10 +417,32 @@ CompressStreamDecoder* compress_stream_decoder_alloc(
     instance->decode_buffer = malloc(hs_config->input_buffer_sz);
     instance->read_cb = read_cb;
     instance->read_context = read_context;
+    instance->checkpoints = NULL;
+    instance->checkpoint_count = 0;
+    instance->checkpoint_index = 0;
+    instance->seek_cb = NULL;
+    instance->seek_context = NULL;
 
     return instance;
 }
 
+void compress_stream_decoder_set_checkpoints(
+    CompressStreamDecoder* instance,
+    const CompressStreamCheckpoint* checkpoints,
+    size_t count,
+    CompressSeekCallback seek_cb,
+    void* seek_context) {
+    furi_check(instance);
+    furi_check(!count || (checkpoints && seek_cb));
+    furi_check(!count || checkpoints[0].uncompressed_offset == 0);
+
+    instance->checkpoints = count ? checkpoints : NULL;
+    instance->checkpoint_count = count;
+    instance->checkpoint_index = 0;
+    instance->seek_cb = seek_cb;
+    instance->seek_context = seek_context;
+}
+
 void compress_stream_decoder_free(CompressStreamDecoder* instance) {
     furi_check(instance);
     heatshrink_decoder_free(instance->decoder);
@@ -515,6 +520,41 @@ static bool compress_decode_stream_chunk(
     return decomp_chunk_size == 0;
 }
 
+/* Start decoding from scratch at the checkpoint */
+static bool compress_stream_decoder_restart(CompressStreamDecoder* instance, size_t index) {
+    const CompressStreamCheckpoint* checkpoint = &instance->checkpoints[index];
+
+    heatshrink_decoder_reset(instance->decoder);
+    instance->decode_buffer_position = 0;
+    instance->checkpoint_index = index;
+    instance->stream_position = checkpoint->uncompressed_offset;
+
+    return instance->seek_cb(instance->seek_context, checkpoint->compressed_offset);
+}
+
+/* Uncompressed position where the current block ends */
+static size_t compress_stream_decoder_block_end(CompressStreamDecoder* instance) {
+    const size_t next = instance->checkpoint_index + 1;
+    return next < instance->checkpoint_count ? instance->checkpoints[next].uncompressed_offset :
+                                               SIZE_MAX;
+}
+
+/* Last checkpoint at or before the position */
+static size_t compress_stream_decoder_find_checkpoint(
+    CompressStreamDecoder* instance,
+    size_t position) {
+    size_t low = 0, high = instance->checkpoint_count;
+    while(high - low > 1) {
+        const size_t middle = (low + high) / 2;
+        if(instance->checkpoints[middle].uncompressed_offset <= position) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
 bool compress_stream_decoder_read(
     CompressStreamDecoder* instance,
     uint8_t* data_out,
@@ -522,17 +562,45 @@ bool compress_stream_decoder_read(
     furi_check(instance);
     furi_check(data_out);
 
-    if(compress_decode_stream_chunk(
-           instance, instance->read_cb, instance->read_context, data_out, data_out_size)) {
-        instance->stream_position += data_out_size;
-        return true;
+    while(data_out_size) {
+        size_t chunk_size = data_out_size;
+
+        if(instance->checkpoints) {
+            /* Blocks are compressed separately, decoder state can't cross the boundary */
+            while(instance->stream_position >= compress_stream_decoder_block_end(instance)) {
+                if(!compress_stream_decoder_restart(instance, instance->checkpoint_index + 1)) {
+                    return false;
+                }
+            }
+            chunk_size =
+                MIN(chunk_size,
+                    compress_stream_decoder_block_end(instance) - instance->stream_position);
+        }
+
+        if(!compress_decode_stream_chunk(
+               instance, instance->read_cb, instance->read_context, data_out, chunk_size)) {
+            return false;
+        }
+        instance->stream_position += chunk_size;
+        data_out += chunk_size;
+        data_out_size -= chunk_size;
     }
-    return false;
+    return true;
 }
 
 bool compress_stream_decoder_seek(CompressStreamDecoder* instance, size_t position) {
     furi_check(instance);
 
+    if(instance->checkpoints) {
+        /* Restart from the nearest checkpoint if it is closer than current position */
+        const size_t index = compress_stream_decoder_find_checkpoint(instance, position);
+        if(position < instance->stream_position || index > instance->checkpoint_index) {
+            if(!compress_stream_decoder_restart(instance, index)) {
+                return false;
+            }
+        }
+    }
+
     /* Check if requested position is ahead of current position 
        we can't rewind the input stream */
     furi_check(position >= instance->stream_position);
@@ -564,6 +632,10 @@ size_t compress_stream_decoder_tell(CompressStreamDecoder* instance) {
 bool compress_stream_decoder_rewind(CompressStreamDecoder* instance) {
     furi_check(instance);
 
+    if(instance->checkpoints) {
+        return compress_stream_decoder_restart(instance, 0);
+    }
+
     /* Reset decoder and read buffer */
     heatshrink_decoder_reset(instance->decoder);
     instance->stream_position = 0;
@@ -79,6 +79,17 @@ Compress* compress_alloc(CompressType type, const void* config);
  */
 void compress_free(Compress* compress);
 
+/** Set encoder match finder memory budget
+ *
+ * By default, the whole window is indexed, taking 4 bytes per window byte, and output is
+ * identical to the reference heatshrink encoder. Smaller budget limits match distance:
+ * encoding is faster, compression ratio is lower.
+ *
+ * @param      compress  Compress instance
+ * @param[in]  memory    Memory budget in bytes, 0 for the default
+ */
+void compress_set_encoder_memory(Compress* compress, size_t memory);
+
 /** Encode data
  *
  * @param      compress       Compress instance
@@ -130,6 +141,15 @@ bool compress_decode(
  */
 typedef int32_t (*CompressIoCallback)(void* context, uint8_t* buffer, size_t size);
 
+/** Seek callback for streamed decompression
+ *
+ * @param context user context
+ * @param offset offset in compressed data stream
+ *
+ * @return true on success
+ */
+typedef bool (*CompressSeekCallback)(void* context, size_t offset);
+
 /** Decompress streamed data
  *
  * @param      compress       Compress instance
@@ -153,6 +173,12 @@ bool compress_decode_streamed(
 /** CompressStreamDecoder control structure */
 typedef struct CompressStreamDecoder CompressStreamDecoder;
 
+/** Stream checkpoint: position where encoder was reset and decoding can start from scratch */
+typedef struct {
+    uint32_t compressed_offset;
+    uint32_t uncompressed_offset;
+} CompressStreamCheckpoint;
+
 /** Allocate stream decoder
  *
  * @param      type          Compression type
@@ -187,13 +213,34 @@ bool compress_stream_decoder_read(
     uint8_t* data_out,
     size_t data_out_size);
 
+/** Set checkpoints of the stream, enabling random access
+ *
+ * Stream must consist of independently compressed blocks, one checkpoint per block, sorted by
+ * offset, the first one at the start of the stream. Decoder restarts at block boundaries and
+ * seeks from the nearest checkpoint instead of decoding the stream from the beginning.
+ *
+ * @warning    Checkpoints array must stay valid while decoder is in use
+ *
+ * @param      instance      The CompressStreamDecoder instance
+ * @param[in]  checkpoints   The checkpoints
+ * @param[in]  count         The checkpoints count
+ * @param      seek_cb       The seek callback for input (compressed) data
+ * @param      seek_context  The seek context
+ */
+void compress_stream_decoder_set_checkpoints(
+    CompressStreamDecoder* instance,
+    const CompressStreamCheckpoint* checkpoints,
+    size_t count,
+    CompressSeekCallback seek_cb,
+    void* seek_context);
+
 /** Seek to position in uncompressed data stream
  *
  * @param      instance   The CompressStreamDecoder instance
  * @param[in]  position   The position
  * 
  * @return     true on success
- * @warning    Backward seeking is not supported
+ * @warning    Backward seeking is only supported for streams with checkpoints
  */
 bool compress_stream_decoder_seek(CompressStreamDecoder* instance, size_t position);
 
@@ -206,7 +253,8 @@ bool compress_stream_decoder_seek(CompressStreamDecoder* instance, size_t positi
 size_t compress_stream_decoder_tell(CompressStreamDecoder* instance);
 
 /** Reset stream decoder to the beginning
- * @warning    Read callback must be repositioned by caller separately
+ * @warning    Read callback must be repositioned by caller separately, unless stream has
+ *             checkpoints
  *
  * @param      instance  The CompressStreamDecoder instance
  *
@@ -0,0 +1,252 @@
+#include "compress_hs_encoder.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* Limits of the heatshrink format */
+#define HS_WINDOW_SZ2_MIN    (4U)
+#define HS_WINDOW_SZ2_MAX    (15U)
+#define HS_LOOKAHEAD_SZ2_MIN (3U)
+
+/* Match finder table size limits, log2 */
+#define HS_TABLE_SZ2_MIN (4U)
+#define HS_TABLE_SZ2_MAX (15U)
+
+/* Knuth's multiplicative hash constant */
+#define HS_HASH_MULTIPLIER (2654435761UL)
+
+#define HS_MIN(a, b) ((a) < (b) ? (a) : (b))
+
+/*
+ * Positions are stored modulo 2^16 in two tables: head holds the last position for each hash
+ * of the first bytes, chain links each position to the previous one with the same hash.
+ * Chain is a ring of the last positions: older entries are overwritten, so the walk stops at
+ * the ring size. Stale entries alias to random positions and are rejected by comparison.
+ */
+struct CompressHsEncoder {
+    uint8_t window_sz2;
+    uint8_t lookahead_sz2;
+    uint8_t hash_sz2;
+    uint8_t chain_sz2;
+    size_t min_match;
+    size_t hash_length;
+    uint16_t* head;
+    uint16_t* chain;
+};
+
+typedef struct {
+    uint8_t* data;
+    size_t size;
+    size_t position;
+    uint32_t bits;
+    uint8_t bit_count;
+} HsBitWriter;
+
+static uint8_t hs_log2_floor(size_t value) {
+    uint8_t result = 0;
+    while(value >>= 1) {
+        result++;
+    }
+    return result;
+}
+
+CompressHsEncoder*
+    compress_hs_encoder_alloc(uint8_t window_sz2, uint8_t lookahead_sz2, size_t memory) {
+    if(window_sz2 < HS_WINDOW_SZ2_MIN || window_sz2 > HS_WINDOW_SZ2_MAX ||
+       lookahead_sz2 < HS_LOOKAHEAD_SZ2_MIN || lookahead_sz2 >= window_sz2) {
+        return NULL;
+    }
+
+    CompressHsEncoder* encoder = malloc(sizeof(CompressHsEncoder));
+    if(!encoder) return NULL;
+
+    encoder->window_sz2 = window_sz2;
+    encoder->lookahead_sz2 = lookahead_sz2;
+
+    /* Budget is split evenly between the tables, 2 bytes per entry */
+    uint8_t table_sz2 = memory ? hs_log2_floor(memory / (2 * sizeof(uint16_t))) : window_sz2;
+    if(table_sz2 < HS_TABLE_SZ2_MIN) table_sz2 = HS_TABLE_SZ2_MIN;
+    if(table_sz2 > HS_TABLE_SZ2_MAX) table_sz2 = HS_TABLE_SZ2_MAX;
+    encoder->hash_sz2 = table_sz2;
+    encoder->chain_sz2 = HS_MIN(table_sz2, window_sz2);
+
+    /* Same break-even point as the stock encoder: match must be shorter than its literals */
+    encoder->min_match = (1 + window_sz2 + lookahead_sz2) / 8 + 1;
+    encoder->hash_length = HS_MIN(encoder->min_match, 3U);
+
+    encoder->head = malloc(sizeof(uint16_t) << encoder->hash_sz2);
+    encoder->chain = malloc(sizeof(uint16_t) << encoder->chain_sz2);
+    if(!encoder->head || !encoder->chain) {
+        compress_hs_encoder_free(encoder);
+        return NULL;
+    }
+
+    return encoder;
+}
+
+void compress_hs_encoder_free(CompressHsEncoder* encoder) {
+    if(encoder) {
+        free(encoder->head);
+        free(encoder->chain);
+        free(encoder);
+    }
+}
+
+size_t compress_hs_encoder_get_memory(const CompressHsEncoder* encoder) {
+    return (sizeof(uint16_t) << encoder->hash_sz2) + (sizeof(uint16_t) << encoder->chain_sz2);
+}
+
+static inline uint32_t hs_hash(const CompressHsEncoder* encoder, const uint8_t* data) {
+    uint32_t value = 0;
+    for(size_t i = 0; i < encoder->hash_length; i++) {
+        value = (value << 8) | data[i];
+    }
+    return (uint32_t)(value * HS_HASH_MULTIPLIER) >> (32 - encoder->hash_sz2);
+}
+
+static inline void hs_bit_writer_push(HsBitWriter* writer, uint32_t value, uint8_t count) {
+    writer->bits = (writer->bits << count) | (value & ((1UL << count) - 1));
+    writer->bit_count += count;
+    while(writer->bit_count >= 8) {
+        writer->bit_count -= 8;
+        if(writer->position < writer->size) {
+            writer->data[writer->position] = writer->bits >> writer->bit_count;
+        }
+        writer->position++;
+    }
+}
+
+static void hs_bit_writer_flush(HsBitWriter* writer) {
+    if(writer->bit_count) {
+        hs_bit_writer_push(writer, 0, 8 - writer->bit_count);
+    }
+}
+
+static size_t hs_match_length(const uint8_t* a, const uint8_t* b, size_t max_length) {
+    size_t length = 0;
+    while(length < max_length && a[length] == b[length]) {
+        length++;
+    }
+    return length;
+}
+
+/* Stock encoder starts with a zeroed window, so data can refer to zeros before the start */
+static size_t hs_find_zero_prefix_match(
+    const uint8_t* data,
+    size_t position,
+    size_t window,
+    size_t max_length,
+    size_t* distance) {
+    const uint8_t* needle = &data[position];
+    size_t zeros = 0;
+    while(zeros < max_length && needle[zeros] == 0) {
+        zeros++;
+    }
+
+    /* Candidates further than zeros + 1 bytes before the start match exactly zeros bytes */
+    size_t best_length = 0;
+    const size_t max_offset = HS_MIN(zeros + 1, window - position);
+    for(size_t offset = 1; offset <= max_offset; offset++) {
+        size_t length = HS_MIN(offset, zeros);
+        if(length == offset) {
+            length += hs_match_length(data, &needle[offset], max_length - offset);
+        }
+        if(length > best_length) {
+            best_length = length;
+            *distance = position + offset;
+        }
+    }
+    return best_length;
+}
+
+bool compress_hs_encoder_encode(
+    CompressHsEncoder* encoder,
+    const uint8_t* data_in,
+    size_t data_in_size,
+    uint8_t* data_out,
+    size_t data_out_size,
+    size_t* data_res_size) {
+    const size_t window = 1UL << encoder->window_sz2;
+    const size_t lookahead = 1UL << encoder->lookahead_sz2;
+    const size_t chain_mask = (1UL << encoder->chain_sz2) - 1;
+    const size_t max_distance = HS_MIN(window, chain_mask + 1);
+
+    HsBitWriter writer = {.data = data_out, .size = data_out_size};
+    memset(encoder->head, 0, sizeof(uint16_t) << encoder->hash_sz2);
+
+    size_t position = 0;
+    size_t indexed = 0;
+    while(position < data_in_size) {
+        const uint8_t* needle = &data_in[position];
+        const size_t max_length = HS_MIN(lookahead, data_in_size - position);
+        size_t best_length = 0;
+        size_t best_distance = 0;
+
+        if(max_length >= encoder->min_match) {
+            /* Nearest candidates first, longer match wins: same choice as the stock encoder */
+            uint16_t candidate = encoder->head[hs_hash(encoder, needle)];
+            size_t last_distance = 0;
+            while(true) {
+                const size_t distance = (uint16_t)(position - candidate);
+                if(distance <= last_distance || distance > max_distance || distance > position) {
+                    break;
+                }
+                last_distance = distance;
+
+                const uint8_t* match = needle - distance;
+                if(match[best_length] == needle[best_length]) {
+                    const size_t length = hs_match_length(match, needle, max_length);
+                    if(length > best_length) {
+                        best_length = length;
+                        best_distance = distance;
+                        if(length == max_length) break;
+                    }
+                }
+                candidate = encoder->chain[candidate & chain_mask];
+            }
+
+            if(best_length < max_length && position < window && needle[0] == 0) {
+                size_t distance = 0;
+                const size_t length =
+                    hs_find_zero_prefix_match(data_in, position, window, max_length, &distance);
+                if(length > best_length) {
+                    best_length = length;
+                    best_distance = distance;
+                }
+            }
+        }
+
+        if(best_length >= encoder->min_match) {
+            hs_bit_writer_push(&writer, 0, 1);
+            hs_bit_writer_push(&writer, best_distance - 1, encoder->window_sz2);
+            hs_bit_writer_push(&writer, best_length - 1, encoder->lookahead_sz2);
+            position += best_length;
+        } else {
+            hs_bit_writer_push(&writer, 1, 1);
+            hs_bit_writer_push(&writer, *needle, 8);
+            position++;
+        }
+
+        if(writer.position > data_out_size) {
+            return false;
+        }
+
+        /* Index passed positions, while there are enough bytes left to hash */
+        const size_t index_end = data_in_size >= encoder->hash_length ?
+                                     HS_MIN(position, data_in_size - encoder->hash_length + 1) :
+                                     0;
+        for(; indexed < index_end; indexed++) {
+            const uint32_t hash = hs_hash(encoder, &data_in[indexed]);
+            encoder->chain[indexed & chain_mask] = encoder->head[hash];
+            encoder->head[hash] = indexed;
+        }
+    }
+
+    hs_bit_writer_flush(&writer);
+    if(writer.position > data_out_size) {
+        return false;
+    }
+
+    *data_res_size = writer.position;
+    return true;
+}
@@ -0,0 +1,68 @@
+/**
+ * @file compress_hs_encoder.h
+ * Heatshrink encoder with hash chain match finder
+ *
+ * Produces streams for the stock heatshrink decoder. With the whole window indexed,
+ * output is identical to the stock encoder, which scans the whole window for every byte.
+ * Has no Furi dependencies: scripts/hs.py builds it on the host for benchmarks.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct CompressHsEncoder CompressHsEncoder;
+
+/** Allocate encoder
+ *
+ * @param[in]  window_sz2     Window size, log2
+ * @param[in]  lookahead_sz2  Lookahead size, log2
+ * @param[in]  memory         Match finder memory budget in bytes, 0 to index the whole window.
+ *                            Smaller budget limits match distance and speeds up the search.
+ *
+ * @return     CompressHsEncoder instance
+ */
+CompressHsEncoder*
+    compress_hs_encoder_alloc(uint8_t window_sz2, uint8_t lookahead_sz2, size_t memory);
+
+/** Free encoder
+ *
+ * @param      encoder  The CompressHsEncoder instance
+ */
+void compress_hs_encoder_free(CompressHsEncoder* encoder);
+
+/** Get match finder memory size
+ *
+ * @param      encoder  The CompressHsEncoder instance
+ *
+ * @return     memory size in bytes
+ */
+size_t compress_hs_encoder_get_memory(const CompressHsEncoder* encoder);
+
+/** Encode data as a single heatshrink stream, without header
+ *
+ * @param      encoder        The CompressHsEncoder instance
+ * @param[in]  data_in        The input data
+ * @param[in]  data_in_size   The input data size
+ * @param      data_out       The output buffer
+ * @param[in]  data_out_size  The output buffer size
+ * @param[out] data_res_size  The encoded data size
+ *
+ * @return     true on success, false if output buffer is too small
+ */
+bool compress_hs_encoder_encode(
+    CompressHsEncoder* encoder,
+    const uint8_t* data_in,
+    size_t data_in_size,
+    uint8_t* data_out,
+    size_t data_out_size,
+    size_t* data_res_size);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,44 @@
+/** CRC-16 Calculation
+ *
+ * Table driven CRC-16 with polynomial 0x1021, MSB and LSB first.
+ *
+ * @file crc16_calc.h
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Update CRC-16 with polynomial 0x1021 processed MSB first (CCITT, XMODEM, FeliCa)
+ *
+ * Initial value and final XOR are up to the caller, so that calculation can be
+ * split into several calls.
+ *
+ * @param      crc     current CRC register value
+ * @param      buffer  data to process
+ * @param      size    data size in bytes
+ *
+ * @return     updated CRC register value
+ */
+uint16_t crc16_calc_ccitt(uint16_t crc, const void* buffer, size_t size);
+
+/** Update CRC-16 with polynomial 0x1021 processed LSB first (X.25, ISO14443, ISO13239)
+ *
+ * Initial value and final XOR are up to the caller, so that calculation can be
+ * split into several calls.
+ *
+ * @param      crc     current CRC register value
+ * @param      buffer  data to process
+ * @param      size    data size in bytes
+ *
+ * @return     updated CRC register value
+ */
+uint16_t crc16_calc_ccitt_reflected(uint16_t crc, const void* buffer, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,10 +1,19 @@
 #include "dir_walk.h"
 #include <m-list.h>
 
+/** Amount of directory levels that keep their own open handle.
+ * Deeper levels share a single handle and are restored by re-reading
+ * the parent up to the saved index on the way back. The same is done
+ * for a level whose handle had to be closed to open its subdirectory.
+ */
+#define DIR_WALK_OPEN_DIRS_MAX 4
+
 LIST_DEF(DirIndexList, uint32_t);
 
 struct DirWalk {
     File* file;
+    File* level_files[DIR_WALK_OPEN_DIRS_MAX];
+    File* deep_file;
     FuriString* path;
     DirIndexList_t index_list;
     uint32_t current_index;
@@ -18,7 +27,11 @@ DirWalk* dir_walk_alloc(Storage* storage) {
 
     DirWalk* dir_walk = malloc(sizeof(DirWalk));
     dir_walk->path = furi_string_alloc();
-    dir_walk->file = storage_file_alloc(storage);
+    for(size_t i = 0; i < DIR_WALK_OPEN_DIRS_MAX; i++) {
+        dir_walk->level_files[i] = storage_file_alloc(storage);
+    }
+    dir_walk->deep_file = storage_file_alloc(storage);
+    dir_walk->file = dir_walk->level_files[0];
     DirIndexList_init(dir_walk->index_list);
     dir_walk->recursive = true;
     dir_walk->filter_cb = NULL;
@@ -28,7 +41,10 @@ DirWalk* dir_walk_alloc(Storage* storage) {
 void dir_walk_free(DirWalk* dir_walk) {
     furi_check(dir_walk);
 
-    storage_file_free(dir_walk->file);
+    for(size_t i = 0; i < DIR_WALK_OPEN_DIRS_MAX; i++) {
+        storage_file_free(dir_walk->level_files[i]);
+    }
+    storage_file_free(dir_walk->deep_file);
     furi_string_free(dir_walk->path);
     DirIndexList_clear(dir_walk->index_list);
     free(dir_walk);
@@ -49,9 +65,18 @@ bool dir_walk_open(DirWalk* dir_walk, const char* path) {
     furi_check(dir_walk);
     furi_string_set(dir_walk->path, path);
     dir_walk->current_index = 0;
+    dir_walk->file = dir_walk->level_files[0];
     return storage_dir_open(dir_walk->file, path);
 }
 
+static File* dir_walk_get_level_file(DirWalk* dir_walk, size_t level) {
+    if(level < DIR_WALK_OPEN_DIRS_MAX) {
+        return dir_walk->level_files[level];
+    } else {
+        return dir_walk->deep_file;
+    }
+}
+
 static bool dir_walk_filter(DirWalk* dir_walk, const char* name, FileInfo* fileinfo) {
     if(dir_walk->filter_cb) {
         return dir_walk->filter_cb(name, fileinfo, dir_walk->filter_context);
@@ -91,13 +116,24 @@ static DirWalkResult
             }
 
             if(file_info_is_dir(&info) && dir_walk->recursive) {
-                // step into
+                // step into, parent handle stays open if it has its own level slot
                 DirIndexList_push_back(dir_walk->index_list, dir_walk->current_index);
                 dir_walk->current_index = 0;
-                storage_dir_close(dir_walk->file);
+                size_t level = DirIndexList_size(dir_walk->index_list);
+                File* parent_file = dir_walk->file;
+                if(level > DIR_WALK_OPEN_DIRS_MAX) {
+                    storage_dir_close(parent_file);
+                }
+                dir_walk->file = dir_walk_get_level_file(dir_walk, level);
 
                 furi_string_cat_printf(dir_walk->path, "/%s", name);
-                storage_dir_open(dir_walk->file, furi_string_get_cstr(dir_walk->path));
+                const char* path = furi_string_get_cstr(dir_walk->path);
+                if(!storage_dir_open(dir_walk->file, path) && (parent_file != dir_walk->file)) {
+                    // Out of handles: parent is reopened and rewound on the way back
+                    storage_dir_close(dir_walk->file);
+                    storage_dir_close(parent_file);
+                    storage_dir_open(dir_walk->file, path);
+                }
             }
         } else if(storage_file_get_error(dir_walk->file) == FSE_NOT_EXIST) {
             if(DirIndexList_size(dir_walk->index_list) == 0) {
@@ -108,7 +144,6 @@ static DirWalkResult
                 // step out
                 uint32_t index;
                 DirIndexList_pop_back(&index, dir_walk->index_list);
-                dir_walk->current_index = 0;
 
                 storage_dir_close(dir_walk->file);
 
@@ -117,6 +152,16 @@ static DirWalkResult
                     furi_string_left(dir_walk->path, last_char);
                 }
 
+                size_t level = DirIndexList_size(dir_walk->index_list);
+                dir_walk->file = dir_walk_get_level_file(dir_walk, level);
+                if(storage_file_is_open(dir_walk->file)) {
+                    // parent handle is still open right after the entry we stepped into
+                    dir_walk->current_index = index;
+                    result = DirWalkOK;
+                    continue;
+                }
+
+                dir_walk->current_index = 0;
                 storage_dir_open(dir_walk->file, furi_string_get_cstr(dir_walk->path));
 
                 // rewind
@@ -157,9 +202,15 @@ DirWalkResult dir_walk_read(DirWalk* dir_walk, FuriString* return_path, FileInfo
 
 void dir_walk_close(DirWalk* dir_walk) {
     furi_check(dir_walk);
-    if(storage_file_is_open(dir_walk->file)) {
-        storage_dir_close(dir_walk->file);
+    for(size_t i = 0; i < DIR_WALK_OPEN_DIRS_MAX; i++) {
+        if(storage_file_is_open(dir_walk->level_files[i])) {
+            storage_dir_close(dir_walk->level_files[i]);
+        }
+    }
+    if(storage_file_is_open(dir_walk->deep_file)) {
+        storage_dir_close(dir_walk->deep_file);
     }
+    dir_walk->file = dir_walk->level_files[0];
 
     DirIndexList_reset(dir_walk->index_list);
     furi_string_reset(dir_walk->path);
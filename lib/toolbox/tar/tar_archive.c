@@ -14,6 +14,13 @@
 #define FILE_OPEN_NTRIES      10
 #define FILE_OPEN_RETRY_DELAY 25
 
+#define EXTRACT_BLOCK_SIZE        (8 * 1024)
+#define EXTRACT_BLOCK_COUNT       (2)
+#define EXTRACT_WRITER_STACK_SIZE (1024)
+
+/* Compressed data is read from the card in chunks of this size */
+#define HEATSHRINK_INPUT_BUFFER_SIZE (2048)
+
 TarOpenMode tar_archive_get_mode_for_path(const char* path) {
     char ext[8];
 
@@ -34,6 +41,8 @@ typedef struct TarArchive {
     mtar_t tar;
     tar_unpack_file_cb unpack_cb;
     void* unpack_cb_context;
+    TarArchiveProgressCallback progress_cb;
+    void* progress_cb_context;
 } TarArchive;
 
 /* Plain file backend - uncompressed, supports read and write */
@@ -72,11 +81,19 @@ typedef struct {
     CompressConfigHeatshrink heatshrink_config;
     File* stream;
     CompressStreamDecoder* decoder;
+    CompressStreamCheckpoint* checkpoints;
 } HeatshrinkStream;
 
 /* HSDS 'heatshrink data stream' header magic */
 static const uint32_t HEATSHRINK_MAGIC = 0x53445348;
 
+/* Version 1 is a single compressed stream. Version 2 consists of separately compressed blocks,
+ * followed by checkpoint index and footer, and allows random access. */
+#define HEATSHRINK_VERSION_INDEXED (2)
+
+/* HSDI 'heatshrink data index' footer magic */
+static const uint32_t HEATSHRINK_INDEX_MAGIC = 0x49445348;
+
 typedef struct {
     uint32_t magic;
     uint8_t version;
@@ -85,12 +102,23 @@ typedef struct {
 } FURI_PACKED HeatshrinkStreamHeader;
 _Static_assert(sizeof(HeatshrinkStreamHeader) == 7, "Invalid HeatshrinkStreamHeader size");
 
+/* Last bytes of indexed stream, preceded by checkpoints. Offsets of compressed data are
+ * counted from the end of the header. */
+typedef struct {
+    uint32_t magic;
+    uint32_t checkpoint_count;
+    uint32_t uncompressed_size;
+} FURI_PACKED HeatshrinkStreamFooter;
+_Static_assert(sizeof(HeatshrinkStreamFooter) == 12, "Invalid HeatshrinkStreamFooter size");
+_Static_assert(sizeof(CompressStreamCheckpoint) == 8, "Invalid CompressStreamCheckpoint size");
+
 static int mtar_heatshrink_file_close(void* stream) {
     HeatshrinkStream* hs_stream = stream;
     if(hs_stream) {
         if(hs_stream->decoder) {
             compress_stream_decoder_free(hs_stream->decoder);
         }
+        free(hs_stream->checkpoints);
         storage_file_close(hs_stream->stream);
         free(hs_stream);
     }
@@ -106,7 +134,9 @@ static int mtar_heatshrink_file_read(void* stream, void* data, unsigned size) {
 static int mtar_heatshrink_file_seek(void* stream, unsigned offset) {
     HeatshrinkStream* hs_stream = stream;
     bool success = false;
-    if(offset == 0) {
+    if(hs_stream->checkpoints) {
+        success = compress_stream_decoder_seek(hs_stream->decoder, offset);
+    } else if(offset == 0) {
         success = storage_file_seek(hs_stream->stream, sizeof(HeatshrinkStreamHeader), true) &&
                   compress_stream_decoder_rewind(hs_stream->decoder);
     } else {
@@ -130,6 +160,7 @@ TarArchive* tar_archive_alloc(Storage* storage) {
     archive->storage = storage;
     archive->stream = storage_file_alloc(archive->storage);
     archive->unpack_cb = NULL;
+    archive->progress_cb = NULL;
     return archive;
 }
 
@@ -138,6 +169,59 @@ static int32_t file_read_cb(void* context, uint8_t* buffer, size_t buffer_size)
     return storage_file_read(file, buffer, buffer_size);
 }
 
+static bool file_seek_cb(void* context, size_t offset) {
+    File* file = context;
+    return storage_file_seek(file, sizeof(HeatshrinkStreamHeader) + offset, true);
+}
+
+/* Load checkpoint index from the end of the file. Leaves file position undefined. */
+static CompressStreamCheckpoint* heatshrink_stream_load_index(File* stream, size_t* count) {
+    CompressStreamCheckpoint* checkpoints = NULL;
+    const uint64_t file_size = storage_file_size(stream);
+
+    do {
+        HeatshrinkStreamFooter footer;
+        if(file_size < sizeof(HeatshrinkStreamHeader) + sizeof(footer)) break;
+        if(!storage_file_seek(stream, file_size - sizeof(footer), true) ||
+           storage_file_read(stream, &footer, sizeof(footer)) != sizeof(footer) ||
+           footer.magic != HEATSHRINK_INDEX_MAGIC || footer.checkpoint_count == 0) {
+            break;
+        }
+
+        const size_t index_size = footer.checkpoint_count * sizeof(CompressStreamCheckpoint);
+        if(footer.checkpoint_count > file_size / sizeof(CompressStreamCheckpoint) ||
+           file_size < sizeof(HeatshrinkStreamHeader) + index_size + sizeof(footer)) {
+            break;
+        }
+
+        checkpoints = malloc(index_size);
+        if(!storage_file_seek(stream, file_size - sizeof(footer) - index_size, true) ||
+           storage_file_read(stream, checkpoints, index_size) != index_size) {
+            free(checkpoints);
+            checkpoints = NULL;
+            break;
+        }
+
+        bool is_valid = checkpoints[0].compressed_offset == 0 &&
+                        checkpoints[0].uncompressed_offset == 0;
+        for(size_t i = 1; (i < footer.checkpoint_count) && is_valid; i++) {
+            is_valid = checkpoints[i].compressed_offset > checkpoints[i - 1].compressed_offset &&
+                       checkpoints[i].uncompressed_offset >
+                           checkpoints[i - 1].uncompressed_offset;
+        }
+        if(!is_valid) {
+            FURI_LOG_E(TAG, "Invalid checkpoint index");
+            free(checkpoints);
+            checkpoints = NULL;
+            break;
+        }
+
+        *count = footer.checkpoint_count;
+    } while(false);
+
+    return checkpoints;
+}
+
 bool tar_archive_open(TarArchive* archive, const char* path, TarOpenMode mode) {
     furi_check(archive);
     FS_AccessMode access_mode;
@@ -176,18 +260,34 @@ bool tar_archive_open(TarArchive* archive, const char* path, TarOpenMode mode) {
         HeatshrinkStreamHeader header;
         if(storage_file_read(stream, &header, sizeof(HeatshrinkStreamHeader)) !=
                sizeof(HeatshrinkStreamHeader) ||
-           header.magic != HEATSHRINK_MAGIC) {
+           header.magic != HEATSHRINK_MAGIC || header.version > HEATSHRINK_VERSION_INDEXED) {
             storage_file_close(stream);
             return false;
         }
 
+        size_t checkpoint_count = 0;
+        CompressStreamCheckpoint* checkpoints = NULL;
+        if(header.version == HEATSHRINK_VERSION_INDEXED) {
+            checkpoints = heatshrink_stream_load_index(stream, &checkpoint_count);
+            if(!checkpoints || !file_seek_cb(stream, 0)) {
+                free(checkpoints);
+                storage_file_close(stream);
+                return false;
+            }
+        }
+
         HeatshrinkStream* hs_stream = malloc(sizeof(HeatshrinkStream));
         hs_stream->stream = stream;
+        hs_stream->checkpoints = checkpoints;
         hs_stream->heatshrink_config.window_sz2 = header.window_sz2;
         hs_stream->heatshrink_config.lookahead_sz2 = header.lookahead_sz2;
-        hs_stream->heatshrink_config.input_buffer_sz = FILE_BLOCK_SIZE;
+        hs_stream->heatshrink_config.input_buffer_sz = HEATSHRINK_INPUT_BUFFER_SIZE;
         hs_stream->decoder = compress_stream_decoder_alloc(
             CompressTypeHeatshrink, &hs_stream->heatshrink_config, file_read_cb, stream);
+        if(checkpoints) {
+            compress_stream_decoder_set_checkpoints(
+                hs_stream->decoder, checkpoints, checkpoint_count, file_seek_cb, stream);
+        }
         mtar_init(&archive->tar, mtar_access, &heatshrink_ops, hs_stream);
     } else {
         mtar_init(&archive->tar, mtar_access, &filesystem_ops, stream);
@@ -211,6 +311,15 @@ void tar_archive_set_file_callback(TarArchive* archive, tar_unpack_file_cb callb
     archive->unpack_cb_context = context;
 }
 
+void tar_archive_set_progress_callback(
+    TarArchive* archive,
+    TarArchiveProgressCallback callback,
+    void* context) {
+    furi_check(archive);
+    archive->progress_cb = callback;
+    archive->progress_cb_context = context;
+}
+
 static int tar_archive_entry_counter(mtar_t* tar, const mtar_header_t* header, void* param) {
     UNUSED(tar);
     UNUSED(header);
@@ -286,16 +395,117 @@ bool tar_archive_file_finalize(TarArchive* archive) {
     return mtar_end_data(&archive->tar) == MTAR_ESUCCESS;
 }
 
+/* Extraction writer: file data is passed in blocks to a separate thread, so SD writes overlap
+ * with reading and decompression of the next block. Blocks start at multiples of their size in
+ * the file, so writes are sector-aligned and do not straddle clusters. */
 typedef struct {
-    TarArchive* archive;
-    const char* work_dir;
-    TarArchiveNameConverter converter;
-} TarArchiveDirectoryOpParams;
+    File* file;
+    uint8_t* data;
+    size_t size;
+} TarExtractBlock;
+
+typedef struct {
+    FuriThread* thread;
+    FuriMessageQueue* free_blocks;
+    FuriMessageQueue* filled_blocks;
+    TarExtractBlock blocks[EXTRACT_BLOCK_COUNT];
+    bool write_failed;
+    size_t bytes_written;
+} TarExtractWriter;
+
+static int32_t tar_extract_writer_thread(void* context) {
+    TarExtractWriter* writer = context;
+    TarExtractBlock* block;
+
+    while(true) {
+        furi_check(
+            furi_message_queue_get(writer->filled_blocks, &block, FuriWaitForever) ==
+            FuriStatusOk);
+        /* NULL block stops the thread */
+        if(!block) break;
+
+        /* After a failure, blocks of the same file are only returned */
+        if(!writer->write_failed &&
+           storage_file_write(block->file, block->data, block->size) != block->size) {
+            writer->write_failed = true;
+        }
+        furi_check(
+            furi_message_queue_put(writer->free_blocks, &block, FuriWaitForever) == FuriStatusOk);
+    }
 
-static bool archive_extract_current_file(TarArchive* archive, const char* dst_path) {
+    return 0;
+}
+
+static TarExtractWriter* tar_extract_writer_alloc(void) {
+    TarExtractWriter* writer = malloc(sizeof(TarExtractWriter));
+    writer->free_blocks = furi_message_queue_alloc(EXTRACT_BLOCK_COUNT, sizeof(TarExtractBlock*));
+    writer->filled_blocks =
+        furi_message_queue_alloc(EXTRACT_BLOCK_COUNT + 1, sizeof(TarExtractBlock*));
+    writer->write_failed = false;
+    writer->bytes_written = 0;
+
+    for(size_t i = 0; i < EXTRACT_BLOCK_COUNT; i++) {
+        TarExtractBlock* block = &writer->blocks[i];
+        block->file = NULL;
+        block->data = malloc(EXTRACT_BLOCK_SIZE);
+        block->size = 0;
+        furi_check(furi_message_queue_put(writer->free_blocks, &block, 0) == FuriStatusOk);
+    }
+
+    writer->thread = furi_thread_alloc_ex(
+        "TarExtractWriter", EXTRACT_WRITER_STACK_SIZE, tar_extract_writer_thread, writer);
+    furi_thread_start(writer->thread);
+    return writer;
+}
+
+static void tar_extract_writer_free(TarExtractWriter* writer) {
+    TarExtractBlock* stop = NULL;
+    furi_check(
+        furi_message_queue_put(writer->filled_blocks, &stop, FuriWaitForever) == FuriStatusOk);
+    furi_thread_join(writer->thread);
+    furi_thread_free(writer->thread);
+
+    for(size_t i = 0; i < EXTRACT_BLOCK_COUNT; i++) {
+        free(writer->blocks[i].data);
+    }
+    furi_message_queue_free(writer->free_blocks);
+    furi_message_queue_free(writer->filled_blocks);
+    free(writer);
+}
+
+/* Wait until all queued blocks are written. Returns false if any of them failed. */
+static bool tar_extract_writer_flush(TarExtractWriter* writer) {
+    TarExtractBlock* blocks[EXTRACT_BLOCK_COUNT];
+    for(size_t i = 0; i < EXTRACT_BLOCK_COUNT; i++) {
+        furi_check(
+            furi_message_queue_get(writer->free_blocks, &blocks[i], FuriWaitForever) ==
+            FuriStatusOk);
+    }
+    for(size_t i = 0; i < EXTRACT_BLOCK_COUNT; i++) {
+        furi_check(furi_message_queue_put(writer->free_blocks, &blocks[i], 0) == FuriStatusOk);
+    }
+
+    const bool success = !writer->write_failed;
+    writer->write_failed = false;
+    return success;
+}
+
+static void tar_archive_report_progress(TarArchive* archive) {
+    if(archive->progress_cb) {
+        int32_t processed = 0, total = 0;
+        tar_archive_get_read_progress(archive, &processed, &total);
+        archive->progress_cb(processed, total, archive->progress_cb_context);
+    }
+}
+
+/* Size is used to pre-allocate the file, 0 if unknown */
+static bool archive_extract_current_file(
+    TarArchive* archive,
+    TarExtractWriter* writer,
+    const char* dst_path,
+    size_t size) {
     mtar_t* tar = &archive->tar;
     File* out_file = storage_file_alloc(archive->storage);
-    uint8_t* readbuf = malloc(FILE_BLOCK_SIZE);
 
     bool success = true;
     uint8_t n_tries = FILE_OPEN_NTRIES;
@@ -314,24 +524,73 @@ static bool archive_extract_current_file(TarArchive* archive, const char* dst_pa
             break;
         }
 
+        /* Seeking past the end allocates the cluster chain at once, instead of cluster by
+         * cluster between writes. Failure is not fatal: writes will report a full card. */
+        if(size > EXTRACT_BLOCK_SIZE) {
+            storage_file_seek(out_file, size, true);
+            if(!storage_file_seek(out_file, 0, true)) {
+                success = false;
+                break;
+            }
+        }
+
         while(!mtar_eof_data(tar)) {
-            int32_t readcnt = mtar_read_data(tar, readbuf, FILE_BLOCK_SIZE);
-            if(!readcnt || !storage_file_write(out_file, readbuf, readcnt)) {
+            if(writer->write_failed) {
+                success = false;
+                break;
+            }
+
+            TarExtractBlock* block;
+            furi_check(
+                furi_message_queue_get(writer->free_blocks, &block, FuriWaitForever) ==
+                FuriStatusOk);
+
+            int32_t readcnt = mtar_read_data(tar, block->data, EXTRACT_BLOCK_SIZE);
+            if(readcnt <= 0) {
+                furi_check(
+                    furi_message_queue_put(writer->free_blocks, &block, 0) == FuriStatusOk);
                 success = false;
                 break;
             }
+
+            block->file = out_file;
+            block->size = readcnt;
+            writer->bytes_written += readcnt;
+            furi_check(
+                furi_message_queue_put(writer->filled_blocks, &block, FuriWaitForever) ==
+                FuriStatusOk);
+            tar_archive_report_progress(archive);
         }
     } while(false);
+
+    /* File must stay open until its last block is written */
+    if(!tar_extract_writer_flush(writer)) {
+        FURI_LOG_E(TAG, "Failed to write '%s'", dst_path);
+        success = false;
+    }
+    const bool created = storage_file_is_open(out_file);
     storage_file_free(out_file);
-    free(readbuf);
+
+    /* Pre-allocated file has its full size, partial contents would look complete */
+    if(!success && created) {
+        storage_common_remove(archive->storage, dst_path);
+    }
 
     return success;
 }
 
+typedef struct {
+    TarArchive* archive;
+    const char* work_dir;
+    TarArchiveNameConverter converter;
+    TarExtractWriter* writer;
+} TarArchiveDirectoryOpParams;
+
 static int archive_extract_foreach_cb(mtar_t* tar, const mtar_header_t* header, void* param) {
     UNUSED(tar);
     TarArchiveDirectoryOpParams* op_params = param;
     TarArchive* archive = op_params->archive;
+    tar_archive_report_progress(archive);
 
     bool skip_entry = false;
     if(archive->unpack_cb) {
@@ -340,7 +599,7 @@ static int archive_extract_foreach_cb(mtar_t* tar, const mtar_header_t* header,
     }
 
     if(skip_entry) {
-        FURI_LOG_W(TAG, "filter: skipping entry \"%s\"", header->name);
+        FURI_LOG_D(TAG, "filter: skipping entry \"%s\"", header->name);
         return 0;
     }
 
@@ -375,8 +634,8 @@ static int archive_extract_foreach_cb(mtar_t* tar, const mtar_header_t* header,
     full_extracted_fname = furi_string_alloc();
     path_concat(op_params->work_dir, furi_string_get_cstr(converted_fname), full_extracted_fname);
 
-    bool success =
-        archive_extract_current_file(archive, furi_string_get_cstr(full_extracted_fname));
+    bool success = archive_extract_current_file(
+        archive, op_params->writer, furi_string_get_cstr(full_extracted_fname), header->size);
 
     furi_string_free(converted_fname);
     furi_string_free(full_extracted_fname);
@@ -392,11 +651,22 @@ bool tar_archive_unpack_to(
         .archive = archive,
         .work_dir = destination,
         .converter = converter,
+        .writer = tar_extract_writer_alloc(),
     };
 
     FURI_LOG_I(TAG, "Restoring '%s'", destination);
+    const uint32_t start_tick = furi_get_tick();
+
+    const bool success =
+        mtar_foreach(&archive->tar, archive_extract_foreach_cb, &param) == MTAR_ESUCCESS;
 
-    return mtar_foreach(&archive->tar, archive_extract_foreach_cb, &param) == MTAR_ESUCCESS;
+    FURI_LOG_I(
+        TAG,
+        "Unpacked %zu bytes in %lums",
+        param.writer->bytes_written,
+        furi_get_tick() - start_tick);
+    tar_extract_writer_free(param.writer);
+    return success;
 }
 
 bool tar_archive_add_file(
@@ -511,5 +781,9 @@ bool tar_archive_unpack_file(
     if(mtar_find(&archive->tar, archive_fname) != MTAR_ESUCCESS) {
         return false;
     }
-    return archive_extract_current_file(archive, destination);
+
+    TarExtractWriter* writer = tar_extract_writer_alloc();
+    const bool success = archive_extract_current_file(archive, writer, destination, 0);
+    tar_extract_writer_free(writer);
+    return success;
 }
@@ -107,8 +107,8 @@ int32_t tar_archive_get_entries_count(TarArchive* archive);
 /** Get read progress
  *
  * @param       archive Tar archive object. Must be opened in read mode
- * @param[in]   processed Number of processed entries
- * @param[in]   total Total number of entries
+ * @param[out]  processed Number of processed archive bytes
+ * @param[out]  total Archive size in bytes
  *
  * @return true if successful
  */
@@ -142,6 +142,23 @@ typedef bool (*tar_unpack_file_cb)(const char* name, bool is_directory, void* co
  */
 void tar_archive_set_file_callback(TarArchive* archive, tar_unpack_file_cb callback, void* context);
 
+/** Optional progress callback on unpacking, called for each entry and each written data block
+ * @param       processed     Number of processed archive bytes
+ * @param       total         Archive size in bytes
+ * @param[in]   context       User context
+ */
+typedef void (*TarArchiveProgressCallback)(int32_t processed, int32_t total, void* context);
+
+/** Set progress callback on unpacking
+ * @param       archive       Tar archive object
+ * @param       callback      Callback function
+ * @param[in]   context       User context
+ */
+void tar_archive_set_progress_callback(
+    TarArchive* archive,
+    TarArchiveProgressCallback callback,
+    void* context);
+
 /* Low-level API */
 
 /** Add tar archive directory header
@@ -1,17 +1,22 @@
 import struct
 
+import heatshrink2
+
 
 class HeatshrinkDataStreamHeader:
     MAGIC = 0x53445348
     VERSION = 1
+    # Separately compressed blocks, followed by HeatshrinkDataStreamIndex
+    VERSION_INDEXED = 2
 
-    def __init__(self, window_size, lookahead_size):
+    def __init__(self, window_size, lookahead_size, version=VERSION):
         self.window_size = window_size
         self.lookahead_size = lookahead_size
+        self.version = version
 
     def pack(self):
         return struct.pack(
-            "<IBBB", self.MAGIC, self.VERSION, self.window_size, self.lookahead_size
+            "<IBBB", self.MAGIC, self.version, self.window_size, self.lookahead_size
         )
 
     @staticmethod
@@ -21,6 +26,99 @@ class HeatshrinkDataStreamHeader:
         magic, version, window_size, lookahead_size = struct.unpack("<IBBB", data)
         if magic != HeatshrinkDataStreamHeader.MAGIC:
             raise ValueError("Invalid magic number")
-        if version != HeatshrinkDataStreamHeader.VERSION:
+        if version not in (
+            HeatshrinkDataStreamHeader.VERSION,
+            HeatshrinkDataStreamHeader.VERSION_INDEXED,
+        ):
             raise ValueError("Invalid version")
-        return HeatshrinkDataStreamHeader(window_size, lookahead_size)
+        return HeatshrinkDataStreamHeader(window_size, lookahead_size, version)
+
+
+class HeatshrinkDataStreamIndex:
+    """Checkpoints of an indexed stream, stored at the end of the file.
+
+    Each checkpoint is a block start, as (compressed offset from the end of the
+    header, uncompressed offset). Decoder can start from any of them.
+    """
+
+    MAGIC = 0x49445348
+    CHECKPOINT = struct.Struct("<II")
+    FOOTER = struct.Struct("<III")
+
+    def __init__(self, checkpoints, uncompressed_size):
+        self.checkpoints = checkpoints
+        self.uncompressed_size = uncompressed_size
+
+    def pack(self):
+        data = b"".join(self.CHECKPOINT.pack(*c) for c in self.checkpoints)
+        return data + self.FOOTER.pack(
+            self.MAGIC, len(self.checkpoints), self.uncompressed_size
+        )
+
+    @staticmethod
+    def unpack(data):
+        """Parse index from the end of stream data, returns index and its size"""
+        cls = HeatshrinkDataStreamIndex
+        if len(data) < cls.FOOTER.size:
+            raise ValueError("Stream is too short for index")
+        magic, count, uncompressed_size = cls.FOOTER.unpack(data[-cls.FOOTER.size :])
+        if magic != cls.MAGIC:
+            raise ValueError("Invalid index magic number")
+        size = count * cls.CHECKPOINT.size + cls.FOOTER.size
+        if size > len(data):
+            raise ValueError("Invalid index size")
+        checkpoints = list(cls.CHECKPOINT.iter_unpack(data[-size : -cls.FOOTER.size]))
+        return cls(checkpoints, uncompressed_size), size
+
+
+def compress_stream(data, window_size, lookahead_size, block_size=0):
+    """Compress data to heatshrink data stream with header.
+
+    With non-zero block_size, data is compressed in independent blocks with an
+    index, allowing random access on the device at some cost in ratio.
+    """
+    if not block_size:
+        header = HeatshrinkDataStreamHeader(window_size, lookahead_size)
+        compressed = heatshrink2.compress(
+            data, window_sz2=window_size, lookahead_sz2=lookahead_size
+        )
+        return header.pack() + compressed
+
+    header = HeatshrinkDataStreamHeader(
+        window_size, lookahead_size, HeatshrinkDataStreamHeader.VERSION_INDEXED
+    )
+    blocks = []
+    checkpoints = []
+    compressed_size = 0
+    for offset in range(0, max(len(data), 1), block_size):
+        block = heatshrink2.compress(
+            data[offset : offset + block_size],
+            window_sz2=window_size,
+            lookahead_sz2=lookahead_size,
+        )
+        checkpoints.append((compressed_size, offset))
+        compressed_size += len(block)
+        blocks.append(block)
+    index = HeatshrinkDataStreamIndex(checkpoints, len(data))
+    return header.pack() + b"".join(blocks) + index.pack()
+
+
+def decompress_stream(data):
+    """Decompress heatshrink data stream with header, returns header and data"""
+    header = HeatshrinkDataStreamHeader.unpack(data[:7])
+    compressed = data[7:]
+    params = dict(window_sz2=header.window_size, lookahead_sz2=header.lookahead_size)
+
+    if header.version != HeatshrinkDataStreamHeader.VERSION_INDEXED:
+        return header, heatshrink2.decompress(compressed, **params)
+
+    index, index_size = HeatshrinkDataStreamIndex.unpack(compressed)
+    compressed = compressed[:-index_size]
+    offsets = [c[0] for c in index.checkpoints] + [len(compressed)]
+    decompressed = b"".join(
+        heatshrink2.decompress(compressed[start:end], **params)
+        for start, end in zip(offsets, offsets[1:])
+    )
+    if len(decompressed) != index.uncompressed_size:
+        raise ValueError("Decompressed size mismatch")
+    return header, decompressed
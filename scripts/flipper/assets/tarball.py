@@ -1,9 +1,7 @@
 import io
 import tarfile
 
-import heatshrink2
-
-from .heatshrink_stream import HeatshrinkDataStreamHeader
+from .heatshrink_stream import compress_stream
 
 FLIPPER_TAR_FORMAT = tarfile.USTAR_FORMAT
 TAR_HEATSRINK_EXTENSION = ".ths"
@@ -16,9 +14,7 @@ def tar_sanitizer_filter(tarinfo: tarfile.TarInfo):
     return tarinfo
 
 
-def compress_tree_tarball(
-    src_dir, output_name, filter=tar_sanitizer_filter, hs_window=13, hs_lookahead=6
-):
+def tar_tree(src_dir, filter=tar_sanitizer_filter):
     plain_tar = io.BytesIO()
     with tarfile.open(
         fileobj=plain_tar,
@@ -26,16 +22,21 @@ def compress_tree_tarball(
         format=FLIPPER_TAR_FORMAT,
     ) as tarball:
         tarball.add(src_dir, arcname="", filter=filter)
-    plain_tar.seek(0)
+    return plain_tar.getvalue()
 
-    src_data = plain_tar.read()
-    compressed = heatshrink2.compress(
-        src_data, window_sz2=hs_window, lookahead_sz2=hs_lookahead
-    )
 
-    header = HeatshrinkDataStreamHeader(hs_window, hs_lookahead)
+def compress_tree_tarball(
+    src_dir,
+    output_name,
+    filter=tar_sanitizer_filter,
+    hs_window=13,
+    hs_lookahead=6,
+    hs_block_size=0,
+):
+    src_data = tar_tree(src_dir, filter)
+    compressed = compress_stream(src_data, hs_window, hs_lookahead, hs_block_size)
+
     with open(output_name, "wb") as f:
-        f.write(header.pack())
         f.write(compressed)
 
     return len(src_data), len(compressed)
@@ -0,0 +1,293 @@
+#!/usr/bin/env python3
+
+import bisect
+import os
+import struct
+from collections import defaultdict
+
+from elftools.elf.elffile import ELFFile
+from flipper.app import App
+
+# Must match furi/core/memmgr_heap.h and furi/core/memmgr_heap.c
+DUMP_MAGIC = 0x50484D46
+DUMP_VERSION = 1
+HEADER = struct.Struct("<IHHIII")
+RECORD = struct.Struct("<IIII")
+NAME = struct.Struct("<IBB")
+
+EVENT_MALLOC = 0
+EVENT_FREE = 1
+EVENT_IMAGE = 2
+
+NAME_THREAD = 0
+NAME_IMAGE = 1
+
+THREAD_UNKNOWN = 63
+
+
+class ProfileDump:
+    def __init__(self, data):
+        magic, version, record_size, self.tick_rate, count, self.lost = (
+            HEADER.unpack_from(data, 0)
+        )
+        if magic != DUMP_MAGIC:
+            raise ValueError(f"Invalid magic {magic:#010x}")
+        if version != DUMP_VERSION or record_size != RECORD.size:
+            raise ValueError(
+                f"Unsupported version {version}, record size {record_size}"
+            )
+
+        offset = HEADER.size
+        self.records = []
+        for i in range(count):
+            tick, address, caller, info = RECORD.unpack_from(
+                data, offset + i * RECORD.size
+            )
+            size = info & 0xFFFFFF
+            thread = (info >> 24) & 0x3F
+            event = info >> 30
+            self.records.append((tick, event, address, caller, size, thread))
+        offset += count * RECORD.size
+
+        self.thread_names = {THREAD_UNKNOWN: "Unknown thread"}
+        self.image_names = {}
+        while offset + NAME.size <= len(data):
+            index, type, size = NAME.unpack_from(data, offset)
+            offset += NAME.size
+            if index == 0 and size == 0:
+                break
+            name = data[offset : offset + size].decode("utf-8", errors="replace")
+            offset += size
+            names = self.thread_names if type == NAME_THREAD else self.image_names
+            names[index] = name
+
+
+class Symbols:
+    def __init__(self, path):
+        self.name = os.path.basename(path)
+        self.addresses = []
+        self.functions = []
+        self.text_size = 0
+        with open(path, "rb") as file:
+            elf = ELFFile(file)
+            # Applications are relocatable, their symbols are offsets in .text
+            relocatable = elf["e_type"] == "ET_REL"
+            text_index = None
+            for index, section in enumerate(elf.iter_sections()):
+                if section.name == ".text":
+                    text_index = index
+                    self.text_size = section["sh_size"]
+
+            symtab = elf.get_section_by_name(".symtab")
+            if not symtab:
+                raise ValueError(f"{path} has no symbols")
+            for symbol in symtab.iter_symbols():
+                if symbol["st_info"]["type"] != "STT_FUNC" or not symbol.name:
+                    continue
+                if relocatable and symbol["st_shndx"] != text_index:
+                    continue
+                # Thumb bit
+                address = symbol["st_value"] & ~1
+                self.functions.append((address, symbol["st_size"], symbol.name))
+        self.functions.sort()
+        self.addresses = [function[0] for function in self.functions]
+
+    def lookup(self, address):
+        index = bisect.bisect_right(self.addresses, address) - 1
+        if index < 0:
+            return None
+        start, size, name = self.functions[index]
+        if size and address >= start + size:
+            return None
+        return name
+
+
+class Symbolizer:
+    def __init__(self, firmware, apps):
+        self.firmware = firmware
+        self.apps = apps
+        # Loaded images by .text address, an address can be reused by the next app
+        self.images = {}
+        self.cache = {}
+
+    def load_image(self, name, address):
+        self.images = {
+            base: image
+            for base, image in self.images.items()
+            if base + image.text_size <= address or base >= address
+        }
+        self.cache = {}
+        if name in self.apps:
+            self.images[address] = self.apps[name]
+
+    def lookup(self, caller):
+        if caller in self.cache:
+            return self.cache[caller]
+        # Return address points after the call, a Thumb call is 2 or 4 bytes long
+        address = (caller & ~1) - 2
+        site = None
+        for base, image in self.images.items():
+            if base <= address < base + image.text_size:
+                function = image.lookup(address - base)
+                site = f"{image.name}`{function or hex(caller)}"
+                break
+        else:
+            if self.firmware:
+                site = self.firmware.lookup(address)
+        site = site or f"{caller:#010x}"
+        self.cache[caller] = site
+        return site
+
+
+class HeapReplay:
+    def __init__(self, dump, symbolizer):
+        self.dump = dump
+        self.symbolizer = symbolizer
+        self.live = {}
+        self.live_size = 0
+        self.unknown_frees = 0
+        self.allocated = defaultdict(lambda: [0, 0])
+
+    def replay(self, count):
+        for tick, event, address, caller, size, thread in self.dump.records[:count]:
+            if event == EVENT_IMAGE:
+                name = self.dump.image_names.get(caller, "")
+                self.symbolizer.load_image(name, address)
+            elif event == EVENT_MALLOC:
+                site = self.symbolizer.lookup(caller)
+                self.live[address] = (size, site, thread)
+                self.live_size += size
+                self.allocated[site][0] += size
+                self.allocated[site][1] += 1
+            elif event == EVENT_FREE:
+                block = self.live.pop(address, None)
+                if block:
+                    self.live_size -= block[0]
+                else:
+                    # Allocated before the recording has started
+                    self.unknown_frees += 1
+
+    def sites(self):
+        sites = defaultdict(lambda: [0, 0])
+        for size, site, thread in self.live.values():
+            sites[site][0] += size
+            sites[site][1] += 1
+        return sites
+
+    def stacks(self):
+        stacks = defaultdict(int)
+        for size, site, thread in self.live.values():
+            thread_name = self.dump.thread_names.get(thread, str(thread))
+            stacks[f"{thread_name};{site}"] += size
+        return stacks
+
+
+def find_peak(dump):
+    live = {}
+    live_size = 0
+    peak_size = 0
+    peak = 0
+    for index, (tick, event, address, caller, size, thread) in enumerate(
+        dump.records
+    ):
+        if event == EVENT_MALLOC:
+            live[address] = size
+            live_size += size
+        elif event == EVENT_FREE:
+            live_size -= live.pop(address, 0)
+        if live_size > peak_size:
+            peak_size = live_size
+            peak = index + 1
+    return peak
+
+
+def load_apps(paths):
+    apps = {}
+    for path in paths:
+        for root, _, files in os.walk(path):
+            for file in files:
+                if file.endswith("_d.elf"):
+                    apps[file] = os.path.join(root, file)
+    return apps
+
+
+class Main(App):
+    def init(self):
+        self.parser.add_argument("dump", help="Dump saved with <heap_profile dump>")
+        self.parser.add_argument(
+            "elf", help="Firmware ELF the profile was captured with", nargs="?"
+        )
+        self.parser.add_argument(
+            "--apps",
+            help="Directory with application debug ELFs, build/<target>/.extapps",
+            action="append",
+            default=[],
+        )
+        self.parser.add_argument(
+            "--at",
+            help="Show memory allocated at the end of the recording or at its peak",
+            choices=["end", "peak"],
+            default="end",
+        )
+        self.parser.add_argument(
+            "--top", help="Number of call sites to list", type=int, default=20
+        )
+        self.parser.add_argument(
+            "--folded",
+            help="Save live memory as folded stacks for flamegraph.pl or speedscope",
+        )
+        self.parser.set_defaults(func=self.report)
+
+    def report(self):
+        with open(self.args.dump, "rb") as file:
+            dump = ProfileDump(file.read())
+
+        if dump.lost:
+            self.logger.warning(
+                f"{dump.lost} events were dropped after the buffer was full, "
+                "memory freed after that is shown as live"
+            )
+
+        firmware = Symbols(self.args.elf) if self.args.elf else None
+        app_paths = load_apps(self.args.apps)
+        apps = {}
+        for name in set(dump.image_names.values()):
+            if name in app_paths:
+                apps[name] = Symbols(app_paths[name])
+            else:
+                self.logger.warning(f"Debug ELF for {name} was not found")
+
+        count = len(dump.records)
+        if self.args.at == "peak":
+            count = find_peak(dump)
+        replay = HeapReplay(dump, Symbolizer(firmware, apps))
+        replay.replay(count)
+
+        duration = 0
+        if count:
+            ticks = dump.records[count - 1][0] - dump.records[0][0]
+            duration = ticks / dump.tick_rate
+        print(
+            f"{count} events, {duration:.3f}s: {replay.live_size} bytes in "
+            f"{len(replay.live)} blocks allocated at the {self.args.at}"
+        )
+        if replay.unknown_frees:
+            print(f"{replay.unknown_frees} blocks allocated before recording freed")
+
+        print(f"{'Live':>8} {'Blocks':>7} {'Total':>9} {'Allocs':>7}  Call site")
+        sites = sorted(replay.sites().items(), key=lambda item: -item[1][0])
+        for site, (size, blocks) in sites[: self.args.top]:
+            total, allocs = replay.allocated[site]
+            print(f"{size:>8} {blocks:>7} {total:>9} {allocs:>7}  {site}")
+
+        if self.args.folded:
+            with open(self.args.folded, "w") as file:
+                for stack, size in sorted(replay.stacks().items()):
+                    file.write(f"{stack} {size}\n")
+            self.logger.info(f"Folded stacks saved to {self.args.folded}")
+
+        return 0
+
+
+if __name__ == "__main__":
+    Main()()
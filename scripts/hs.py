@@ -1,14 +1,77 @@
 #!/usr/bin/env python3
 
-import heatshrink2 as hs
+import ctypes
+import os
+import subprocess
+import tempfile
+import time
+
+import heatshrink2
 from flipper.app import App
-from flipper.assets.heatshrink_stream import HeatshrinkDataStreamHeader
-from flipper.assets.tarball import compress_tree_tarball
+from flipper.assets.heatshrink_stream import (
+    HeatshrinkDataStreamHeader,
+    HeatshrinkDataStreamIndex,
+    compress_stream,
+    decompress_stream,
+)
+from flipper.assets.tarball import compress_tree_tarball, tar_tree
+
+ENCODER_SOURCE = os.path.join(
+    os.path.dirname(__file__), "..", "lib", "toolbox", "compress_hs_encoder.c"
+)
+
+
+class HashEncoder:
+    """Firmware encoder from lib/toolbox, built for the host"""
+
+    def __init__(self, build_dir):
+        library = os.path.join(build_dir, "compress_hs_encoder.so")
+        compiler = os.environ.get("CC", "cc")
+        subprocess.check_call(
+            [compiler, "-O2", "-shared", "-fPIC", "-o", library, ENCODER_SOURCE]
+        )
+        self.lib = ctypes.CDLL(library)
+        self.lib.compress_hs_encoder_alloc.restype = ctypes.c_void_p
+        self.lib.compress_hs_encoder_alloc.argtypes = [
+            ctypes.c_uint8,
+            ctypes.c_uint8,
+            ctypes.c_size_t,
+        ]
+        self.lib.compress_hs_encoder_free.argtypes = [ctypes.c_void_p]
+        self.lib.compress_hs_encoder_get_memory.restype = ctypes.c_size_t
+        self.lib.compress_hs_encoder_get_memory.argtypes = [ctypes.c_void_p]
+        self.lib.compress_hs_encoder_encode.restype = ctypes.c_bool
+        self.lib.compress_hs_encoder_encode.argtypes = [
+            ctypes.c_void_p,
+            ctypes.c_char_p,
+            ctypes.c_size_t,
+            ctypes.c_char_p,
+            ctypes.c_size_t,
+            ctypes.POINTER(ctypes.c_size_t),
+        ]
+
+    def compress(self, data, window, lookahead, memory):
+        """Returns compressed data and match finder memory size"""
+        encoder = self.lib.compress_hs_encoder_alloc(window, lookahead, memory)
+        if not encoder:
+            raise ValueError("Invalid encoder parameters")
+        try:
+            memory = self.lib.compress_hs_encoder_get_memory(encoder)
+            output = ctypes.create_string_buffer(len(data) * 9 // 8 + 16)
+            size = ctypes.c_size_t()
+            if not self.lib.compress_hs_encoder_encode(
+                encoder, data, len(data), output, len(output), ctypes.byref(size)
+            ):
+                raise ValueError("Output buffer overflow")
+            return output.raw[: size.value], memory
+        finally:
+            self.lib.compress_hs_encoder_free(encoder)
 
 
 class HSWrapper(App):
     DEFAULT_WINDOW = 13
     DEFAULT_LOOKAHEAD = 6
+    DEFAULT_BLOCK_SIZE = 0
 
     def init(self):
         self.subparsers = self.parser.add_subparsers(
@@ -28,6 +91,13 @@ class HSWrapper(App):
             type=int,
             default=self.DEFAULT_LOOKAHEAD,
         )
+        self.parser_compress.add_argument(
+            "-b",
+            "--block-size",
+            help="compress in independent blocks of this size, with index for seeking",
+            type=int,
+            default=self.DEFAULT_BLOCK_SIZE,
+        )
         self.parser_compress.add_argument("file", help="file to compress")
         self.parser_compress.add_argument(
             "-o", "--output", help="output file", required=True
@@ -64,21 +134,51 @@ class HSWrapper(App):
             type=int,
             default=self.DEFAULT_LOOKAHEAD,
         )
+        self.parser_tar.add_argument(
+            "-b",
+            "--block-size",
+            help="compress in independent blocks of this size, with index for seeking",
+            type=int,
+            default=self.DEFAULT_BLOCK_SIZE,
+        )
         self.parser_tar.set_defaults(func=self.tar)
 
+        self.parser_bench = self.subparsers.add_parser(
+            "bench",
+            help="compare firmware hash chain encoder with the stock one",
+        )
+        self.parser_bench.add_argument(
+            "source", help="file or directory to tar, e.g. resources"
+        )
+        self.parser_bench.add_argument(
+            "-w", "--window", help="window size", type=int, default=self.DEFAULT_WINDOW
+        )
+        self.parser_bench.add_argument(
+            "-l",
+            "--lookahead",
+            help="lookahead size",
+            type=int,
+            default=self.DEFAULT_LOOKAHEAD,
+        )
+        self.parser_bench.add_argument(
+            "-m",
+            "--memory",
+            help="match finder memory budgets to try, 0 for whole window",
+            type=int,
+            nargs="+",
+            default=[0, 8192, 2048],
+        )
+        self.parser_bench.set_defaults(func=self.bench)
+
     def compress(self):
         args = self.args
 
         with open(args.file, "rb") as f:
             data = f.read()
 
-        compressed = hs.compress(
-            data, window_sz2=args.window, lookahead_sz2=args.lookahead
-        )
+        compressed = compress_stream(data, args.window, args.lookahead, args.block_size)
 
         with open(args.output, "wb") as f:
-            header = HeatshrinkDataStreamHeader(args.window, args.lookahead)
-            f.write(header.pack())
             f.write(compressed)
 
         self.logger.info(
@@ -91,17 +191,11 @@ class HSWrapper(App):
         args = self.args
 
         with open(args.file, "rb") as f:
-            header = HeatshrinkDataStreamHeader.unpack(f.read(7))
             compressed = f.read()
 
+        header, data = decompress_stream(compressed)
         self.logger.info(
-            f"Decompressing with window size {header.window_size} and lookahead size {header.lookahead_size}"
-        )
-
-        data = hs.decompress(
-            compressed,
-            window_sz2=header.window_size,
-            lookahead_sz2=header.lookahead_size,
+            f"Decompressed with window size {header.window_size} and lookahead size {header.lookahead_size}"
         )
 
         with open(args.output, "wb") as f:
@@ -116,6 +210,9 @@ class HSWrapper(App):
         try:
             with open(args.file, "rb") as f:
                 header = HeatshrinkDataStreamHeader.unpack(f.read(7))
+                index = None
+                if header.version == HeatshrinkDataStreamHeader.VERSION_INDEXED:
+                    index, _ = HeatshrinkDataStreamIndex.unpack(f.read())
         except Exception as e:
             self.logger.error(f"Error: {e}")
             return 1
@@ -123,6 +220,11 @@ class HSWrapper(App):
         self.logger.info(
             f"Window size: {header.window_size}, lookahead size: {header.lookahead_size}"
         )
+        if index:
+            self.logger.info(
+                f"Blocks: {len(index.checkpoints)}, "
+                f"uncompressed size: {index.uncompressed_size}"
+            )
 
         return 0
 
@@ -130,7 +232,11 @@ class HSWrapper(App):
         args = self.args
 
         orig_size, compressed_size = compress_tree_tarball(
-            args.dir, args.output, hs_window=args.window, hs_lookahead=args.lookahead
+            args.dir,
+            args.output,
+            hs_window=args.window,
+            hs_lookahead=args.lookahead,
+            hs_block_size=args.block_size,
         )
 
         self.logger.info(
@@ -141,5 +247,52 @@ class HSWrapper(App):
         return 0
 
 
+    def bench(self):
+        args = self.args
+
+        if os.path.isdir(args.source):
+            data = tar_tree(args.source)
+        else:
+            with open(args.source, "rb") as f:
+                data = f.read()
+        params = dict(window_sz2=args.window, lookahead_sz2=args.lookahead)
+        self.logger.info(
+            f"{len(data)} bytes, window size {args.window}, "
+            f"lookahead size {args.lookahead}"
+        )
+
+        start = time.perf_counter()
+        reference = heatshrink2.compress(data, **params)
+        elapsed = time.perf_counter() - start
+        print(f"{'Encoder':<8} {'Memory':>7} {'Size':>9} {'Ratio':>7} {'MB/s':>8}")
+        print(
+            f"{'stock':<8} {'-':>7} {len(reference):>9} "
+            f"{len(reference) * 100 / len(data):>6.2f}% "
+            f"{len(data) / elapsed / 1e6:>8.2f}"
+        )
+
+        with tempfile.TemporaryDirectory() as build_dir:
+            encoder = HashEncoder(build_dir)
+            for memory in args.memory:
+                start = time.perf_counter()
+                compressed, used = encoder.compress(
+                    data, args.window, args.lookahead, memory
+                )
+                elapsed = time.perf_counter() - start
+
+                # Must stay readable by the stock decoder
+                if heatshrink2.decompress(compressed, **params) != data:
+                    self.logger.error(f"Memory {memory}: decoded data mismatch")
+                    return 1
+                note = " identical" if compressed == reference else ""
+                print(
+                    f"{'hash':<8} {used:>7} {len(compressed):>9} "
+                    f"{len(compressed) * 100 / len(data):>6.2f}% "
+                    f"{len(data) / elapsed / 1e6:>8.2f}{note}"
+                )
+
+        return 0
+
+
 if __name__ == "__main__":
     HSWrapper()()
@@ -0,0 +1,211 @@
+#!/usr/bin/env python3
+
+import re
+import struct
+import sys
+
+from elftools.elf.elffile import ELFFile
+from flipper.app import App
+
+# Must match furi/core/log.h and furi/core/log_deferred.c
+BINARY_MAGIC = struct.pack("<I", 0x474C4246)
+
+FLAG_COMMITTED = 1 << 0
+FLAG_PADDING = 1 << 1
+FLAG_TAG_INLINE = 1 << 2
+FLAG_FORMAT_INLINE = 1 << 3
+
+LEVEL_LETTERS = {2: "E", 3: "W", 4: "I", 5: "D", 6: "T"}
+
+SPEC_RE = re.compile(
+    r"%(?P<flags>[-+ #0]*)(?P<width>\*|\d+)?(?:\.(?P<precision>\*|\d*))?"
+    r"(?P<length>hh|h|ll|l|j|z|t|L)?(?P<conversion>.)?"
+)
+
+
+class DecodeError(Exception):
+    pass
+
+
+class FirmwareStrings:
+    def __init__(self, elf_path):
+        self.sections = []
+        with open(elf_path, "rb") as file:
+            elf = ELFFile(file)
+            for section in elf.iter_sections():
+                # Loadable sections with contents
+                if not section["sh_flags"] & 0x2 or section["sh_type"] == "SHT_NOBITS":
+                    continue
+                self.sections.append((section["sh_addr"], section.data()))
+        self.cache = {}
+
+    def get(self, address):
+        if address in self.cache:
+            return self.cache[address]
+        for start, data in self.sections:
+            if start <= address < start + len(data):
+                offset = address - start
+                end = data.find(b"\0", offset)
+                value = data[offset : end if end >= 0 else len(data)]
+                value = value.decode("utf-8", errors="replace")
+                self.cache[address] = value
+                return value
+        raise DecodeError(f"Address {address:#010x} is not in the firmware image")
+
+
+class RecordReader:
+    def __init__(self, words):
+        self.words = words
+        self.position = 0
+
+    def word(self):
+        if self.position >= len(self.words):
+            raise DecodeError("Record is too short")
+        value = self.words[self.position]
+        self.position += 1
+        return value
+
+    def quad(self):
+        low = self.word()
+        return low | (self.word() << 32)
+
+    def string(self):
+        length = self.word()
+        count = length // 4 + 1
+        words = self.words[self.position : self.position + count]
+        if len(words) < count:
+            raise DecodeError("String is out of record")
+        data = struct.pack(f"<{count}I", *words)
+        self.position += count
+        return data[:length].decode("utf-8", errors="replace")
+
+
+def to_signed(value, bits):
+    value &= (1 << bits) - 1
+    return value - (1 << bits) if value & (1 << (bits - 1)) else value
+
+
+def format_message(format, reader):
+    result = []
+    position = 0
+    while True:
+        index = format.find("%", position)
+        if index < 0:
+            result.append(format[position:])
+            break
+        result.append(format[position:index])
+        match = SPEC_RE.match(format, index)
+        position = match.end()
+
+        conversion = match["conversion"]
+        length = match["length"] or ""
+        width = match["width"] or ""
+        precision = match["precision"]
+        if width == "*":
+            width = str(to_signed(reader.word(), 32))
+        if precision == "*":
+            precision = str(to_signed(reader.word(), 32))
+
+        if conversion == "%":
+            result.append("%")
+            continue
+
+        spec = "%" + match["flags"] + width
+        if precision is not None:
+            spec += "." + precision
+
+        if conversion in "diuoxXc":
+            if length in ("ll", "j"):
+                value, bits = reader.quad(), 64
+            else:
+                value, bits = reader.word(), {"hh": 8, "h": 16}.get(length, 32)
+            if conversion == "c":
+                result.append((spec + "c") % chr(value & 0xFF))
+            elif conversion in "di":
+                result.append((spec + "d") % to_signed(value, bits))
+            else:
+                result.append((spec + conversion) % (value & ((1 << bits) - 1)))
+        elif conversion in "fFeEgGaA":
+            value = struct.unpack("<d", struct.pack("<Q", reader.quad()))[0]
+            if conversion in "aA":
+                value = value.hex()
+                result.append(value.upper() if conversion == "A" else value)
+            else:
+                result.append((spec + conversion) % value)
+        elif conversion == "p":
+            result.append((spec + "s") % f"{reader.word():#x}")
+        elif conversion == "s":
+            result.append((spec + "s") % reader.string())
+        else:
+            raise DecodeError(f"Unsupported conversion in '{format}'")
+
+    return "".join(result)
+
+
+def decode_record(words, strings):
+    header = words[0]
+    size = header & 0xFFFF
+    level = (header >> 16) & 0xFF
+    flags = header >> 24
+    if not flags & FLAG_COMMITTED or flags & FLAG_PADDING or size < 4:
+        raise DecodeError(f"Invalid record header {header:#010x}")
+
+    reader = RecordReader(words[:size])
+    reader.position = 1
+    tick = reader.word()
+    tag = reader.string() if flags & FLAG_TAG_INLINE else strings.get(reader.word())
+    if flags & FLAG_FORMAT_INLINE:
+        format = reader.string()
+    else:
+        format = strings.get(reader.word())
+    message = format_message(format, reader)
+
+    return f"{tick} [{LEVEL_LETTERS.get(level, ' ')}][{tag}] {message}"
+
+
+class Main(App):
+    def init(self):
+        self.parser.add_argument("elf", help="Firmware ELF the log was captured with")
+        self.parser.add_argument(
+            "capture", help="Raw log capture, '-' for stdin", nargs="?", default="-"
+        )
+        self.parser.set_defaults(func=self.decode)
+
+    def decode(self):
+        strings = FirmwareStrings(self.args.elf)
+        if self.args.capture == "-":
+            data = sys.stdin.buffer.read()
+        else:
+            with open(self.args.capture, "rb") as file:
+                data = file.read()
+
+        errors = 0
+        position = 0
+        while position < len(data):
+            index = data.find(BINARY_MAGIC, position)
+            # Immediate records and other output are passed through as is
+            text = data[position : index if index >= 0 else len(data)]
+            sys.stdout.write(text.decode("utf-8", errors="replace"))
+            if index < 0:
+                break
+
+            position = index + len(BINARY_MAGIC)
+            if position + 4 > len(data):
+                break
+            size = struct.unpack_from("<I", data, position)[0] & 0xFFFF
+            if position + size * 4 > len(data):
+                self.logger.warning("Capture ends in the middle of a record")
+                break
+            words = struct.unpack_from(f"<{size}I", data, position)
+            try:
+                print(decode_record(words, strings))
+                position += size * 4
+            except (DecodeError, IndexError, TypeError, ValueError) as error:
+                self.logger.error(f"Record at {index:#x}: {error}")
+                errors += 1
+
+        return 1 if errors else 0
+
+
+if __name__ == "__main__":
+    Main()()
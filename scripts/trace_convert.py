@@ -0,0 +1,224 @@
+#!/usr/bin/env python3
+
+import json
+import os
+import re
+import struct
+
+from flipper.app import App
+
+# Must match furi/core/trace.h and furi/core/trace.c
+DUMP_MAGIC = 0x43525446
+DUMP_VERSION = 1
+HEADER = struct.Struct("<IHHIII")
+RECORD = struct.Struct("<IIII")
+NAME = struct.Struct("<IBB")
+
+EVENT_THREAD_SWITCH = 0
+EVENT_ISR_ENTER = 1
+EVENT_ISR_EXIT = 2
+EVENT_BEGIN = 3
+EVENT_END = 4
+EVENT_INSTANT = 5
+EVENT_COUNTER = 6
+
+NAME_THREAD = 0
+NAME_POINT = 1
+
+INTERRUPT_HEADER = os.path.join(
+    os.path.dirname(__file__), "..", "targets", "f7", "furi_hal", "furi_hal_interrupt.h"
+)
+
+PID = 1
+TID_CPU = 1
+TID_UNKNOWN = 2
+TID_ISR_BASE = 0x10000
+
+
+class TraceDump:
+    def __init__(self, data):
+        header = HEADER.unpack_from(data, 0)
+        magic, version, record_size, self.frequency, count, self.lost = header
+        if magic != DUMP_MAGIC:
+            raise ValueError(f"Invalid magic {magic:#010x}")
+        if version != DUMP_VERSION or record_size != RECORD.size:
+            raise ValueError(
+                f"Unsupported version {version}, record size {record_size}"
+            )
+
+        offset = HEADER.size
+        self.records = [
+            RECORD.unpack_from(data, offset + i * RECORD.size) for i in range(count)
+        ]
+        offset += count * RECORD.size
+
+        self.thread_names = {}
+        self.point_names = {}
+        while offset + NAME.size <= len(data):
+            id, type, size = NAME.unpack_from(data, offset)
+            offset += NAME.size
+            if id == 0 and size == 0:
+                break
+            name = data[offset : offset + size].decode("utf-8", errors="replace")
+            offset += size
+            names = self.thread_names if type == NAME_THREAD else self.point_names
+            names[id] = name
+
+
+def load_interrupt_names():
+    try:
+        with open(INTERRUPT_HEADER, "r") as file:
+            header = file.read()
+    except OSError:
+        return []
+    enum = re.search(r"typedef enum \{(.*?)\} FuriHalInterruptId;", header, re.S)
+    return re.findall(r"FuriHalInterruptId(\w+),", enum.group(1)) if enum else []
+
+
+class ChromeTrace:
+    def __init__(self, dump, interrupt_names):
+        self.dump = dump
+        self.interrupt_names = interrupt_names
+        self.events = []
+        self.tids = {}
+        self.open_spans = {}
+
+    def thread_tid(self, handle):
+        # Handles are even addresses, shift them away from the reserved tids
+        tid = handle >> 1
+        if tid not in self.tids:
+            name = self.dump.thread_names.get(handle, f"Thread {handle:#010x}")
+            self.tids[tid] = name
+        return tid
+
+    def isr_tid(self, index):
+        tid = TID_ISR_BASE + index
+        if tid not in self.tids:
+            name = (
+                self.interrupt_names[index]
+                if index < len(self.interrupt_names)
+                else str(index)
+            )
+            self.tids[tid] = f"IRQ {name}"
+        return tid
+
+    def point_name(self, id):
+        return self.dump.point_names.get(id, f"{id:#010x}")
+
+    def add(self, phase, name, tid, ts, **kwargs):
+        self.events.append(
+            {"ph": phase, "name": name, "pid": PID, "tid": tid, "ts": ts, **kwargs}
+        )
+
+    def begin(self, name, tid, ts):
+        self.open_spans.setdefault(tid, []).append(name)
+        self.add("B", name, tid, ts)
+
+    def end(self, name, tid, ts):
+        # Span may have started before the oldest recorded event
+        spans = self.open_spans.get(tid)
+        if not spans or name not in spans:
+            return
+        # Spans left open inside are closed too, so they stay nested
+        while True:
+            span = spans.pop()
+            self.add("E", span, tid, ts)
+            if span == name:
+                break
+
+    def convert(self):
+        cycles_per_us = self.dump.frequency / 1000000
+        self.tids[TID_CPU] = "CPU"
+        self.tids[TID_UNKNOWN] = "Unknown thread"
+
+        thread = TID_UNKNOWN
+        thread_name = None
+        isr_stack = []
+        timestamp = None
+        last = 0
+
+        for raw, id, value, type in self.dump.records:
+            # Cycle counter wraps around every 2^32 cycles
+            if timestamp is None:
+                timestamp = raw
+            else:
+                timestamp += (raw - last) & 0xFFFFFFFF
+            last = raw
+            ts = timestamp / cycles_per_us
+            context = isr_stack[-1] if isr_stack else thread
+
+            if type == EVENT_THREAD_SWITCH:
+                if thread_name:
+                    self.end(thread_name, TID_CPU, ts)
+                thread = self.thread_tid(id)
+                thread_name = self.tids[thread]
+                self.begin(thread_name, TID_CPU, ts)
+            elif type == EVENT_ISR_ENTER:
+                tid = self.isr_tid(id)
+                isr_stack.append(tid)
+                self.begin(self.tids[tid], tid, ts)
+            elif type == EVENT_ISR_EXIT:
+                tid = self.isr_tid(id)
+                if tid in isr_stack:
+                    isr_stack.remove(tid)
+                self.end(self.tids[tid], tid, ts)
+            elif type == EVENT_BEGIN:
+                self.begin(self.point_name(id), context, ts)
+            elif type == EVENT_END:
+                self.end(self.point_name(id), context, ts)
+            elif type == EVENT_INSTANT:
+                self.add("i", self.point_name(id), context, ts, s="t")
+            elif type == EVENT_COUNTER:
+                name = self.point_name(id)
+                self.add("C", name, context, ts, args={name: value})
+
+        metadata = [
+            {"ph": "M", "name": "process_name", "pid": PID, "args": {"name": "Flipper"}}
+        ]
+        for tid, name in self.tids.items():
+            metadata.append(
+                {
+                    "ph": "M",
+                    "name": "thread_name",
+                    "pid": PID,
+                    "tid": tid,
+                    "args": {"name": name},
+                }
+            )
+
+        return {
+            "traceEvents": metadata + self.events,
+            "displayTimeUnit": "ns",
+            "otherData": {
+                "cpu_frequency": self.dump.frequency,
+                "lost_events": self.dump.lost,
+            },
+        }
+
+
+class Main(App):
+    def init(self):
+        self.parser.add_argument("dump", help="Dump saved with <trace dump>")
+        self.parser.add_argument("output", help="Chrome trace JSON output")
+        self.parser.set_defaults(func=self.convert)
+
+    def convert(self):
+        with open(self.args.dump, "rb") as file:
+            dump = TraceDump(file.read())
+
+        if dump.lost:
+            self.logger.warning(f"{dump.lost} oldest events were overwritten")
+
+        trace = ChromeTrace(dump, load_interrupt_names()).convert()
+        with open(self.args.output, "w") as file:
+            json.dump(trace, file)
+
+        self.logger.info(
+            f"{len(dump.records)} events converted, open {self.args.output} "
+            "in chrome://tracing or ui.perfetto.dev"
+        )
+        return 0
+
+
+if __name__ == "__main__":
+    Main()()
@@ -24,6 +24,8 @@ class Main(App):
     RESOURCE_TAR_MODE = "w:"
     RESOURCE_FILE_NAME = "resources.ths"  # .Tar.HeatShrink
     RESOURCE_ENTRY_NAME_MAX_LENGTH = 100
+    # Uncompressed size of independently compressed blocks, for random access
+    RESOURCE_BLOCK_SIZE = 32 * 1024
 
     WHITELISTED_STACK_TYPES = set(
         map(
@@ -248,7 +250,10 @@ class Main(App):
     def package_resources(self, srcdir: str, dst_name: str):
         try:
             src_size, compressed_size = compress_tree_tarball(
-                srcdir, dst_name, filter=self._tar_filter
+                srcdir,
+                dst_name,
+                filter=self._tar_filter,
+                hs_block_size=self.RESOURCE_BLOCK_SIZE,
             )
 
             self.logger.info(
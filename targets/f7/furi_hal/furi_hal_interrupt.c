@@ -89,9 +89,11 @@ FURI_ALWAYS_INLINE static void furi_hal_interrupt_call(FuriHalInterruptId index)
     const FuriHalInterruptISRPair* isr_descr = &furi_hal_interrupt.isr[index];
     furi_check(isr_descr->isr);
 
+    furi_trace_event(FuriTraceEventTypeIsrEnter, index, 0);
     FURI_HAL_INTERRUPT_ACCOUNT_START();
     isr_descr->isr(isr_descr->context);
     FURI_HAL_INTERRUPT_ACCOUNT_END();
+    furi_trace_event(FuriTraceEventTypeIsrExit, index, 0);
 }
 
 FURI_ALWAYS_INLINE static void
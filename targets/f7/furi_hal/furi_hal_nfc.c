@@ -5,6 +5,7 @@
 
 #include <furi.h>
 #include <furi_hal_spi.h>
+#include <furi_hal_cortex.h>
 
 #define TAG "FuriHalNfc"
 
@@ -619,3 +620,54 @@ FuriHalNfcError furi_hal_nfc_listener_enable_rx(void) {
 
     return FuriHalNfcErrorNone;
 }
+
+void furi_hal_nfc_reply_stats_rx_end(FuriHalNfcReplyStats* stats) {
+    furi_check(stats);
+
+    stats->rx_end = DWT->CYCCNT;
+    stats->rx_end_valid = true;
+}
+
+void furi_hal_nfc_reply_stats_tx_start(
+    FuriHalNfcReplyStats* stats,
+    uint32_t tx_start,
+    uint32_t encode_cycles) {
+    furi_check(stats);
+
+    if(!stats->rx_end_valid) return;
+
+    const uint32_t reply_cycles = tx_start - stats->rx_end + encode_cycles;
+    stats->rx_end_valid = false;
+    stats->replies++;
+    stats->reply_cycles_max = MAX(stats->reply_cycles_max, reply_cycles);
+    stats->reply_cycles_total += reply_cycles;
+}
+
+void furi_hal_nfc_reply_stats_log(
+    const char* tag,
+    const FuriHalNfcReplyStats* stats,
+    const DigitalSequenceCacheStats* cache_stats) {
+    furi_check(tag);
+    furi_check(stats);
+    furi_check(cache_stats);
+
+    if(cache_stats->frames == 0) return;
+
+    const uint32_t cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+    FURI_LOG_D(
+        tag,
+        "Frames %lu, cached %lu, encode avg %lu max %lu us",
+        cache_stats->frames,
+        cache_stats->hits,
+        (uint32_t)(cache_stats->encode_cycles_total / cache_stats->frames / cycles_per_us),
+        cache_stats->encode_cycles_max / cycles_per_us);
+
+    if(stats->replies == 0) return;
+
+    FURI_LOG_D(
+        tag,
+        "Replies %lu, latency avg %lu max %lu us",
+        stats->replies,
+        (uint32_t)(stats->reply_cycles_total / stats->replies / cycles_per_us),
+        stats->reply_cycles_max / cycles_per_us);
+}
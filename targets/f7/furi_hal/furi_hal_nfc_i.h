@@ -14,6 +14,8 @@
 #include <drivers/st25r3916.h>
 #include <drivers/st25r3916_reg.h>
 
+#include <digital_signal/digital_sequence_cache.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -66,6 +68,17 @@ typedef struct {
  */
 extern FuriHalNfc furi_hal_nfc;
 
+/**
+ * @brief Reply latency statistics of listeners transmitting in transparent mode.
+ */
+typedef struct {
+    uint32_t rx_end; /**< CPU cycle counter value at the end of the last reception. */
+    bool rx_end_valid; /**< Last reception was not replied to yet. */
+    uint32_t replies; /**< Number of replies. */
+    uint32_t reply_cycles_max; /**< Maximum CPU cycles from reception end to reply start. */
+    uint64_t reply_cycles_total; /**< Total CPU cycles from reception end to reply start. */
+} FuriHalNfcReplyStats;
+
 /**
  * @brief Initialise NFC HAL event system.
  */
@@ -186,6 +199,39 @@ FuriHalNfcError furi_hal_nfc_poller_tx_common(
     const uint8_t* tx_data,
     size_t tx_bits);
 
+/**
+ * @brief Record the end of reception in reply latency statistics.
+ *
+ * @param[in,out] stats pointer to the statistics to be updated.
+ */
+void furi_hal_nfc_reply_stats_rx_end(FuriHalNfcReplyStats* stats);
+
+/**
+ * @brief Record the start of reply in reply latency statistics.
+ *
+ * Reply is not recorded if there was no reception since the last reply.
+ *
+ * @param[in,out] stats pointer to the statistics to be updated.
+ * @param[in] tx_start CPU cycle counter value on entry to the transmit function.
+ * @param[in] encode_cycles CPU cycles spent on frame encoding before transmission start.
+ */
+void furi_hal_nfc_reply_stats_tx_start(
+    FuriHalNfcReplyStats* stats,
+    uint32_t tx_start,
+    uint32_t encode_cycles);
+
+/**
+ * @brief Log reply latency and frame encoding statistics.
+ *
+ * @param[in] tag log tag to be used.
+ * @param[in] stats pointer to the reply latency statistics.
+ * @param[in] cache_stats pointer to the frame encoding statistics.
+ */
+void furi_hal_nfc_reply_stats_log(
+    const char* tag,
+    const FuriHalNfcReplyStats* stats,
+    const DigitalSequenceCacheStats* cache_stats);
+
 #ifdef __cplusplus
 }
 #endif
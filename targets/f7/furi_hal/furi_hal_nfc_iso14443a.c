@@ -12,6 +12,7 @@
 #define FURI_HAL_NFC_ISO14443A_LISTENER_FDT_COMP_FC (INT32_MAX)
 
 static Iso14443_3aSignal* iso14443_3a_signal = NULL;
+static FuriHalNfcReplyStats iso14443_3a_reply_stats = {};
 
 static FuriHalNfcError furi_hal_nfc_iso14443a_common_init(FuriHalSpiBusHandle* handle) {
     // Common NFC-A settings, 106 kbps
@@ -70,6 +71,7 @@ static FuriHalNfcError furi_hal_nfc_iso14443a_poller_deinit(FuriHalSpiBusHandle*
 static FuriHalNfcError furi_hal_nfc_iso14443a_listener_init(FuriHalSpiBusHandle* handle) {
     furi_check(iso14443_3a_signal == NULL);
     iso14443_3a_signal = iso14443_3a_signal_alloc(&gpio_spi_r_mosi);
+    memset(&iso14443_3a_reply_stats, 0, sizeof(FuriHalNfcReplyStats));
 
     st25r3916_write_reg(
         handle,
@@ -109,6 +111,10 @@ static FuriHalNfcError furi_hal_nfc_iso14443a_listener_deinit(FuriHalSpiBusHandl
     UNUSED(handle);
 
     if(iso14443_3a_signal) {
+        DigitalSequenceCacheStats cache_stats;
+        iso14443_3a_signal_get_stats(iso14443_3a_signal, &cache_stats);
+        furi_hal_nfc_reply_stats_log(TAG, &iso14443_3a_reply_stats, &cache_stats);
+
         iso14443_3a_signal_free(iso14443_3a_signal);
         iso14443_3a_signal = NULL;
     }
@@ -120,6 +126,9 @@ static FuriHalNfcEvent furi_hal_nfc_iso14443_3a_listener_wait_event(uint32_t tim
     FuriHalNfcEvent event = furi_hal_nfc_wait_event_common(timeout_ms);
     FuriHalSpiBusHandle* handle = &furi_hal_spi_bus_handle_nfc;
 
+    if(event & FuriHalNfcEventRxEnd) {
+        furi_hal_nfc_reply_stats_rx_end(&iso14443_3a_reply_stats);
+    }
     if(event & FuriHalNfcEventListenerActive) {
         st25r3916_set_reg_bits(
             handle, ST25R3916_REG_PASSIVE_TARGET, ST25R3916_REG_PASSIVE_TARGET_d_106_ac_a);
@@ -291,8 +300,14 @@ FuriHalNfcError furi_hal_nfc_iso14443a_listener_tx_custom_parity(
     furi_hal_spi_bus_handle_deinit(&furi_hal_spi_bus_handle_nfc);
 
     // Send signal
+    const uint32_t tx_start = DWT->CYCCNT;
     iso14443_3a_signal_tx(iso14443_3a_signal, tx_data, tx_parity, tx_bits);
 
+    DigitalSequenceCacheStats cache_stats;
+    iso14443_3a_signal_get_stats(iso14443_3a_signal, &cache_stats);
+    furi_hal_nfc_reply_stats_tx_start(
+        &iso14443_3a_reply_stats, tx_start, cache_stats.encode_cycles_last);
+
     // Exit transparent mode
     furi_hal_gpio_write(&gpio_spi_r_mosi, false);
 
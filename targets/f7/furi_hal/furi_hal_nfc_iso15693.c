@@ -30,6 +30,7 @@
 typedef struct {
     Iso15693Signal* signal;
     Iso15693Parser* parser;
+    FuriHalNfcReplyStats reply_stats;
 } FuriHalNfcIso15693Listener;
 
 typedef struct {
@@ -333,6 +334,11 @@ static FuriHalNfcError furi_hal_nfc_iso15693_listener_deinit(FuriHalSpiBusHandle
 
     furi_hal_nfc_iso15693_listener_transparent_mode_exit(handle);
 
+    DigitalSequenceCacheStats cache_stats;
+    iso15693_signal_get_stats(furi_hal_nfc_iso15693_listener->signal, &cache_stats);
+    furi_hal_nfc_reply_stats_log(
+        TAG, &furi_hal_nfc_iso15693_listener->reply_stats, &cache_stats);
+
     furi_hal_nfc_iso15693_listener_free(furi_hal_nfc_iso15693_listener);
     furi_hal_nfc_iso15693_listener = NULL;
 
@@ -341,9 +347,18 @@ static FuriHalNfcError furi_hal_nfc_iso15693_listener_deinit(FuriHalSpiBusHandle
 
 static FuriHalNfcError
     furi_hal_nfc_iso15693_listener_tx_transparent(const uint8_t* data, size_t data_size) {
+    const uint32_t tx_start = DWT->CYCCNT;
+
     iso15693_signal_tx(
         furi_hal_nfc_iso15693_listener->signal, Iso15693SignalDataRateHi, data, data_size);
 
+    DigitalSequenceCacheStats cache_stats;
+    iso15693_signal_get_stats(furi_hal_nfc_iso15693_listener->signal, &cache_stats);
+    furi_hal_nfc_reply_stats_tx_start(
+        &furi_hal_nfc_iso15693_listener->reply_stats,
+        tx_start,
+        cache_stats.encode_cycles_last);
+
     return FuriHalNfcErrorNone;
 }
 
@@ -376,6 +391,7 @@ static FuriHalNfcEvent furi_hal_nfc_iso15693_wait_event(uint32_t timeout_ms) {
         }
         if(flag & FuriHalNfcEventInternalTypeTransparentDataReceived) {
             if(iso15693_parser_run(furi_hal_nfc_iso15693_listener->parser)) {
+                furi_hal_nfc_reply_stats_rx_end(&furi_hal_nfc_iso15693_listener->reply_stats);
                 event = FuriHalNfcEventRxEnd;
                 break;
             }
@@ -406,6 +422,19 @@ FuriHalNfcError furi_hal_nfc_iso15693_listener_tx_sof(void) {
     return FuriHalNfcErrorNone;
 }
 
+FuriHalNfcError furi_hal_nfc_iso15693_listener_tx_prepare(const uint8_t* tx_data, size_t tx_bits) {
+    furi_check(tx_data);
+    furi_check(furi_hal_nfc_iso15693_listener);
+
+    iso15693_signal_prepare(
+        furi_hal_nfc_iso15693_listener->signal,
+        Iso15693SignalDataRateHi,
+        tx_data,
+        tx_bits / BITS_IN_BYTE);
+
+    return FuriHalNfcErrorNone;
+}
+
 static FuriHalNfcError furi_hal_nfc_iso15693_listener_rx(
     FuriHalSpiBusHandle* handle,
     uint8_t* rx_data,
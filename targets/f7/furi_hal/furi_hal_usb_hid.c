@@ -300,6 +300,22 @@ bool furi_hal_hid_kb_release(uint16_t button) {
     return hid_send_report(ReportIdKeyboard);
 }
 
+bool furi_hal_hid_kb_set_pressed(const uint16_t* buttons, size_t count) {
+    furi_check(buttons || (count == 0));
+    furi_check(count <= HID_KB_MAX_KEYS);
+
+    hid_report.keyboard.boot.mods = 0;
+    for(uint8_t key_nb = 0; key_nb < HID_KB_MAX_KEYS; key_nb++) {
+        if(key_nb < count) {
+            hid_report.keyboard.boot.btn[key_nb] = buttons[key_nb] & 0xFF;
+            hid_report.keyboard.boot.mods |= (buttons[key_nb] >> 8);
+        } else {
+            hid_report.keyboard.boot.btn[key_nb] = 0;
+        }
+    }
+    return hid_send_report(ReportIdKeyboard);
+}
+
 bool furi_hal_hid_kb_release_all(void) {
     for(uint8_t key_nb = 0; key_nb < HID_KB_MAX_KEYS; key_nb++) {
         hid_report.keyboard.boot.btn[key_nb] = 0;
@@ -138,6 +138,8 @@ standard names. */
 #define traceTASK_SWITCHED_IN()                                          \
     extern void furi_hal_mpu_set_stack_protection(uint32_t* stack);      \
     furi_hal_mpu_set_stack_protection((uint32_t*)pxCurrentTCB->pxStack); \
+    extern void furi_trace_thread_switch(void* task);                    \
+    furi_trace_thread_switch(pxCurrentTCB);                              \
     errno = pxCurrentTCB->iTaskErrno
 //  ^^^^^   acquire errno directly from TCB because FreeRTOS assigns its `FreeRTOS_errno' _after_ our hook is called
 
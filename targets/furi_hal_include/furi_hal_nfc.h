@@ -452,6 +452,18 @@ FuriHalNfcError furi_hal_nfc_iso14443a_listener_tx_custom_parity(
 */
 FuriHalNfcError furi_hal_nfc_iso15693_listener_tx_sof(void);
 
+/**
+ * @brief Encode an ISO15693 frame which is likely to be transmitted next.
+ *
+ * Encoded frame is cached, so that furi_hal_nfc_listener_tx() with the same data
+ * starts transmission sooner after the reader request.
+ *
+ * @param[in] tx_data pointer to a byte array containing the data to be prepared.
+ * @param[in] tx_bits data size, in bits.
+ * @return FuriHalNfcError
+*/
+FuriHalNfcError furi_hal_nfc_iso15693_listener_tx_prepare(const uint8_t* tx_data, size_t tx_bits);
+
 /**
  * @brief Set FeliCa collision resolution parameters in listener mode.
  * 
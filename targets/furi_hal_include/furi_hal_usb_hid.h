@@ -222,6 +222,16 @@ bool furi_hal_hid_kb_press(uint16_t button);
  */
 bool furi_hal_hid_kb_release(uint16_t button);
 
+/** Replace the whole set of pressed keys and send a single HID report
+ *
+ * Keys that are not listed are released, modifiers are taken from the high
+ * byte of each key code. Keys appear in the report in the given order.
+ *
+ * @param      buttons  array of key codes
+ * @param      count    number of key codes, up to HID_KB_MAX_KEYS
+ */
+bool furi_hal_hid_kb_set_pressed(const uint16_t* buttons, size_t count);
+
 /** Clear all pressed keys and send HID report
  *
  */